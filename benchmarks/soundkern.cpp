@@ -0,0 +1,104 @@
+#include "benchmark/benchmark_api.h"
+#include "osdcomm.h"
+#include "soundkern.h"
+#include <vector>
+
+// pseudo-random samples with a bit more than 16 bits of range
+static std::vector<INT32> make_samples(int count)
+{
+	std::vector<INT32> samples(count);
+	UINT32 seed = 0x332533;
+	for (auto &sample : samples)
+	{
+		seed = seed * 1103515245 + 12345;
+		sample = INT32(seed >> 8) - 0x800000;
+	}
+	return samples;
+}
+
+static void BM_soundkern_copy_generic(benchmark::State& state) {
+	std::vector<INT32> source = make_samples(4096), dest(4096);
+	while (state.KeepRunning())
+		soundkern_copy_generic(&dest[0], &source[0], 4096, state.range_x());
+	state.SetItemsProcessed(state.iterations() * 4096);
+}
+BENCHMARK(BM_soundkern_copy_generic)->Arg(0x100)->Arg(0xc0);
+
+static void BM_soundkern_copy(benchmark::State& state) {
+	std::vector<INT32> source = make_samples(4096), dest(4096);
+	while (state.KeepRunning())
+		soundkern_copy(&dest[0], &source[0], 4096, state.range_x());
+	state.SetItemsProcessed(state.iterations() * 4096);
+}
+BENCHMARK(BM_soundkern_copy)->Arg(0x100)->Arg(0xc0);
+
+// the argument is the input sample rate, resampled to 48kHz
+static void BM_soundkern_point_generic(benchmark::State& state) {
+	std::vector<INT32> source = make_samples(4096), dest(4096 + 16);
+	UINT32 step = (UINT64(state.range_x()) << SOUNDKERN_FRAC_BITS) / 48000;
+	while (state.KeepRunning())
+		soundkern_point_generic(&dest[0], &source[0], 4096, 0xc0, 0, step);
+	state.SetItemsProcessed(state.iterations() * 4096);
+}
+BENCHMARK(BM_soundkern_point_generic)->Arg(8000)->Arg(22050)->Arg(44100);
+
+static void BM_soundkern_point(benchmark::State& state) {
+	std::vector<INT32> source = make_samples(4096), dest(4096);
+	UINT32 step = (UINT64(state.range_x()) << SOUNDKERN_FRAC_BITS) / 48000;
+	while (state.KeepRunning())
+		soundkern_point(&dest[0], &source[0], 4096, 0xc0, 0, step);
+	state.SetItemsProcessed(state.iterations() * 4096);
+}
+BENCHMARK(BM_soundkern_point)->Arg(8000)->Arg(22050)->Arg(44100);
+
+static void BM_soundkern_average_generic(benchmark::State& state) {
+	std::vector<INT32> source = make_samples(1024 * 64), dest(1024);
+	UINT32 step = (UINT64(state.range_x()) << SOUNDKERN_FRAC_BITS) / 48000;
+	while (state.KeepRunning())
+		soundkern_average_generic(&dest[0], &source[0], 1024, 0xc0, 0, step);
+	state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_soundkern_average_generic)->Arg(55930)->Arg(223722)->Arg(1789773);
+
+static void BM_soundkern_average(benchmark::State& state) {
+	std::vector<INT32> source = make_samples(1024 * 64), dest(1024);
+	UINT32 step = (UINT64(state.range_x()) << SOUNDKERN_FRAC_BITS) / 48000;
+	while (state.KeepRunning())
+		soundkern_average(&dest[0], &source[0], 1024, 0xc0, 0, step);
+	state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_soundkern_average)->Arg(55930)->Arg(223722)->Arg(1789773);
+
+static void BM_soundkern_mix_generic(benchmark::State& state) {
+	std::vector<INT32> source = make_samples(960), dest(960);
+	while (state.KeepRunning())
+		soundkern_mix_generic(&dest[0], &source[0], 960);
+	state.SetItemsProcessed(state.iterations() * 960);
+}
+BENCHMARK(BM_soundkern_mix_generic);
+
+static void BM_soundkern_mix(benchmark::State& state) {
+	std::vector<INT32> source = make_samples(960), dest(960);
+	while (state.KeepRunning())
+		soundkern_mix(&dest[0], &source[0], 960);
+	state.SetItemsProcessed(state.iterations() * 960);
+}
+BENCHMARK(BM_soundkern_mix);
+
+static void BM_soundkern_clamp_interleave_generic(benchmark::State& state) {
+	std::vector<INT32> left = make_samples(960), right = make_samples(960);
+	std::vector<INT16> dest(960 * 2);
+	while (state.KeepRunning())
+		soundkern_clamp_interleave_generic(&dest[0], &left[0], &right[0], 960);
+	state.SetItemsProcessed(state.iterations() * 960);
+}
+BENCHMARK(BM_soundkern_clamp_interleave_generic);
+
+static void BM_soundkern_clamp_interleave(benchmark::State& state) {
+	std::vector<INT32> left = make_samples(960), right = make_samples(960);
+	std::vector<INT16> dest(960 * 2);
+	while (state.KeepRunning())
+		soundkern_clamp_interleave(&dest[0], &left[0], &right[0], 960);
+	state.SetItemsProcessed(state.iterations() * 960);
+}
+BENCHMARK(BM_soundkern_clamp_interleave);
@@ -0,0 +1,186 @@
+#include "benchmark/benchmark_api.h"
+#include "osdcore.h"
+#include "drawkern.h"
+#include <algorithm>
+#include <vector>
+
+extern int osd_num_processors;
+
+// a 512x256 tilemap of 8x8 tiles, roughly half opaque, a quarter transparent
+// and a quarter mixed, drawn the way tilemap_t::draw_instance walks it
+static const int TM_WIDTH = 512;
+static const int TM_HEIGHT = 256;
+static const int TM_TILE = 8;
+static const UINT8 TM_OPAQUE = 0x10;
+
+enum tm_kind { TM_NULL, TM_IND16, TM_RGB32, TM_RGB32_ALPHA };
+
+struct tm_layout
+{
+	tm_layout()
+		: pixmap(TM_WIDTH * TM_HEIGHT), flagsmap(TM_WIDTH * TM_HEIGHT), tiletrans((TM_WIDTH / TM_TILE) * (TM_HEIGHT / TM_TILE)), pens(0x1000)
+	{
+		UINT32 seed = 0x332533;
+		for (int row = 0; row < TM_HEIGHT / TM_TILE; row++)
+			for (int col = 0; col < TM_WIDTH / TM_TILE; col++)
+			{
+				seed = seed * 1103515245 + 12345;
+				int trans = (seed >> 16) & 3;
+				tiletrans[row * (TM_WIDTH / TM_TILE) + col] = (trans == 3) ? 2 : (trans == 2) ? 0 : 1;
+				for (int y = row * TM_TILE; y < (row + 1) * TM_TILE; y++)
+					for (int x = col * TM_TILE; x < (col + 1) * TM_TILE; x++)
+					{
+						seed = seed * 1103515245 + 12345;
+						pixmap[y * TM_WIDTH + x] = (seed >> 16) & 0xff;
+						bool opaque = (trans == 3) ? ((seed >> 28) & 1) != 0 : trans != 2;
+						flagsmap[y * TM_WIDTH + x] = opaque ? TM_OPAQUE : 0;
+					}
+			}
+		for (int i = 0; i < int(pens.size()); i++)
+			pens[i] = rgb_t(i * 7, i * 13, i * 29);
+	}
+
+	std::vector<UINT16> pixmap;
+	std::vector<UINT8> flagsmap;
+	std::vector<UINT8> tiletrans;   // 0 = transparent, 1 = opaque, 2 = masked
+	std::vector<rgb_t> pens;
+};
+
+struct tm_target
+{
+	tm_target() : ind16(TM_WIDTH * TM_HEIGHT), rgb32(TM_WIDTH * TM_HEIGHT), pri(TM_WIDTH * TM_HEIGHT) { }
+
+	std::vector<UINT16> ind16;
+	std::vector<UINT32> rgb32;
+	std::vector<UINT8> pri;
+};
+
+// draw one run of pixels that share a transparency state
+template<tm_kind _Kind>
+static void draw_run(const tm_layout &layout, tm_target &target, int offs, int count, bool masked, UINT32 pcode)
+{
+	const UINT16 *source = &layout.pixmap[offs];
+	const UINT8 *maskptr = &layout.flagsmap[offs];
+	UINT8 *pri = &target.pri[offs];
+	switch (_Kind)
+	{
+	case TM_NULL:
+		if (masked)
+			drawkern_scanline_masked_null(maskptr, TM_OPAQUE, TM_OPAQUE, count, pri, pcode);
+		else
+			drawkern_scanline_opaque_null(count, pri, pcode);
+		break;
+
+	case TM_IND16:
+		if (masked)
+			drawkern_scanline_masked_ind16(&target.ind16[offs], source, maskptr, TM_OPAQUE, TM_OPAQUE, count, pri, pcode);
+		else
+			drawkern_scanline_opaque_ind16(&target.ind16[offs], source, count, pri, pcode);
+		break;
+
+	case TM_RGB32:
+		if (masked)
+			drawkern_scanline_masked_rgb32(&target.rgb32[offs], source, maskptr, TM_OPAQUE, TM_OPAQUE, count, &layout.pens[0], pri, pcode);
+		else
+			drawkern_scanline_opaque_rgb32(&target.rgb32[offs], source, count, &layout.pens[0], pri, pcode);
+		break;
+
+	case TM_RGB32_ALPHA:
+		if (masked)
+			drawkern_scanline_masked_rgb32_alpha(&target.rgb32[offs], source, maskptr, TM_OPAQUE, TM_OPAQUE, count, &layout.pens[0], pri, pcode, 0x80);
+		else
+			drawkern_scanline_opaque_rgb32_alpha(&target.rgb32[offs], source, count, &layout.pens[0], pri, pcode, 0x80);
+		break;
+	}
+}
+
+// draw a range of rows, merging neighbouring tiles with the same transparency
+template<tm_kind _Kind>
+static void draw_rows(const tm_layout &layout, tm_target &target, int top, int bottom, UINT32 pcode)
+{
+	for (int y = top; y < bottom; y++)
+	{
+		const UINT8 *trans = &layout.tiletrans[(y / TM_TILE) * (TM_WIDTH / TM_TILE)];
+		int start = 0;
+		for (int col = 1; col <= TM_WIDTH / TM_TILE; col++)
+			if (col == TM_WIDTH / TM_TILE || trans[col] != trans[start / TM_TILE])
+			{
+				int end = col * TM_TILE;
+				if (trans[start / TM_TILE] != 0)
+					draw_run<_Kind>(layout, target, y * TM_WIDTH + start, end - start, trans[start / TM_TILE] == 2, pcode);
+				start = end;
+			}
+	}
+}
+
+// the argument selects whether the priority bitmap is updated
+template<tm_kind _Kind>
+static void run_tilemap(benchmark::State& state)
+{
+	tm_layout layout;
+	tm_target target;
+	UINT32 pcode = state.range_x() ? 0x0302 : 0xff00;
+	while (state.KeepRunning())
+		draw_rows<_Kind>(layout, target, 0, TM_HEIGHT, pcode);
+	state.SetItemsProcessed(state.iterations() * TM_WIDTH * TM_HEIGHT);
+}
+
+static void BM_tilemap_null(benchmark::State& state) {
+	run_tilemap<TM_NULL>(state);
+}
+BENCHMARK(BM_tilemap_null)->Arg(1);
+
+static void BM_tilemap_ind16(benchmark::State& state) {
+	run_tilemap<TM_IND16>(state);
+}
+BENCHMARK(BM_tilemap_ind16)->Arg(0)->Arg(1);
+
+static void BM_tilemap_rgb32(benchmark::State& state) {
+	run_tilemap<TM_RGB32>(state);
+}
+BENCHMARK(BM_tilemap_rgb32)->Arg(0)->Arg(1);
+
+static void BM_tilemap_rgb32_alpha(benchmark::State& state) {
+	run_tilemap<TM_RGB32_ALPHA>(state);
+}
+BENCHMARK(BM_tilemap_rgb32_alpha)->Arg(0)->Arg(1);
+
+// split into bands the way tilemap_t::draw_instances does, with the waiting
+// thread drawing the first band itself
+struct tm_band
+{
+	const tm_layout *layout;
+	tm_target *target;
+	int top, bottom;
+};
+
+static void *draw_band(void *param, int threadid)
+{
+	const tm_band &band = *reinterpret_cast<const tm_band *>(param);
+	draw_rows<TM_RGB32>(*band.layout, *band.target, band.top, band.bottom, 0x0302);
+	return nullptr;
+}
+
+// the argument is the number of threads drawing, including the waiting one
+static void BM_tilemap_rgb32_banded(benchmark::State& state) {
+	tm_layout layout;
+	tm_target target;
+	osd_num_processors = state.range_x();
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	int bands = std::min(int(state.range_x()), TM_HEIGHT / 16);
+	std::vector<tm_band> params(bands);
+	for (int band = 0; band < bands; band++)
+		params[band] = { &layout, &target, TM_HEIGHT * band / bands, TM_HEIGHT * (band + 1) / bands };
+
+	while (state.KeepRunning())
+	{
+		if (bands > 1)
+			osd_work_item_queue_multiple(queue, draw_band, bands - 1, &params[1], sizeof(params[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		draw_band(&params[0], 0);
+		osd_work_queue_wait(queue, 100 * osd_ticks_per_second());
+	}
+	osd_work_queue_free(queue);
+	osd_num_processors = 0;
+	state.SetItemsProcessed(state.iterations() * TM_WIDTH * TM_HEIGHT);
+}
+BENCHMARK(BM_tilemap_rgb32_banded)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
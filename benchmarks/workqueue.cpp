@@ -0,0 +1,69 @@
+#include "benchmark/benchmark_api.h"
+#include "osdcore.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+extern int osd_num_processors;
+
+// each item bumps its own counter so we can check that everything ran exactly once
+static void *count_item(void *param, int threadid)
+{
+	std::atomic<UINT32> &counter = *reinterpret_cast<std::atomic<UINT32> *>(param);
+
+	// a little arithmetic so the items aren't pure queue overhead
+	UINT32 value = UINT32(threadid) + 1;
+	for (int i = 0; i < 64; i++)
+		value = value * 1103515245 + 12345;
+	benchmark::DoNotOptimize(value);
+
+	counter.fetch_add(1, std::memory_order_relaxed);
+	return nullptr;
+}
+
+// the first argument is the number of threads working on the queue, including
+// the waiting one; the second is the number of items queued at a time
+static void run_work_queue(benchmark::State& state, int queueflags)
+{
+	osd_num_processors = state.range_x();
+	osd_work_queue *queue = osd_work_queue_alloc(queueflags);
+	std::vector<std::atomic<UINT32>> counters(state.range_y());
+	for (auto &counter : counters)
+		counter = 0;
+
+	UINT32 batches = 0;
+	while (state.KeepRunning())
+	{
+		osd_work_item_queue_multiple(queue, count_item, state.range_y(), &counters[0], sizeof(counters[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(queue, 100 * osd_ticks_per_second());
+		batches++;
+	}
+	osd_work_queue_free(queue);
+	osd_num_processors = 0;
+
+	for (auto &counter : counters)
+		if (counter != batches)
+		{
+			fprintf(stderr, "work queue ran an item %u times in %u batches\n", counter.load(), batches);
+			abort();
+		}
+	state.SetItemsProcessed(state.iterations() * state.range_y());
+}
+
+static void work_queue_args(benchmark::internal::Benchmark* b)
+{
+	for (int threads = 1; threads <= WORK_MAX_THREADS; threads *= 2)
+		for (int items : { 1, 16, 256 })
+			b->ArgPair(threads, items);
+}
+
+static void BM_work_queue_multi(benchmark::State& state) {
+	run_work_queue(state, WORK_QUEUE_FLAG_MULTI);
+}
+BENCHMARK(BM_work_queue_multi)->Apply(work_queue_args)->UseRealTime();
+
+static void BM_work_queue_high_freq(benchmark::State& state) {
+	run_work_queue(state, WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+}
+BENCHMARK(BM_work_queue_high_freq)->Apply(work_queue_args)->UseRealTime();
@@ -59,16 +59,22 @@ project("benchmarks")
 
 	links {
 		"benchmark",
+		"ocore_" .. _OPTIONS["osd"],
 	}
 
 	includedirs {
 		MAME_DIR .. "3rdparty/benchmark/include",
 		MAME_DIR .. "src/osd",
+		MAME_DIR .. "src/emu",
+		MAME_DIR .. "src/lib/util",
 	}
 
 	files {
 		MAME_DIR .. "benchmarks/main.cpp",
 		MAME_DIR .. "benchmarks/eminline_native.cpp",
 		MAME_DIR .. "benchmarks/eminline_noasm.cpp",
+		MAME_DIR .. "benchmarks/soundkern.cpp",
+		MAME_DIR .. "benchmarks/tilemap.cpp",
+		MAME_DIR .. "benchmarks/workqueue.cpp",
 	}
 
@@ -13,7 +13,7 @@
 -- Dynamic recompiler objects
 --------------------------------------------------
 
-if (CPUS["SH2"]~=null or CPUS["MIPS"]~=null or CPUS["POWERPC"]~=null or CPUS["RSP"]~=null or CPUS["ARM7"]~=null or CPUS["ADSP21062"]~=null) then
+if (CPUS["SH2"]~=null or CPUS["SH4"]~=null or CPUS["MIPS"]~=null or CPUS["POWERPC"]~=null or CPUS["RSP"]~=null or CPUS["ARM7"]~=null or CPUS["ADSP21062"]~=null or CPUS["I386"]~=null) then
 	files {
 		MAME_DIR .. "src/devices/cpu/drcbec.cpp",
 		MAME_DIR .. "src/devices/cpu/drcbec.h",
@@ -25,6 +25,8 @@ if (CPUS["SH2"]~=null or CPUS["MIPS"]~=null or CPUS["POWERPC"]~=null or CPUS["RS
 		MAME_DIR .. "src/devices/cpu/drcfe.h",
 		MAME_DIR .. "src/devices/cpu/drcuml.cpp",
 		MAME_DIR .. "src/devices/cpu/drcuml.h",
+		MAME_DIR .. "src/devices/cpu/drcumlopt.cpp",
+		MAME_DIR .. "src/devices/cpu/drcumlopt.h",
 		MAME_DIR .. "src/devices/cpu/uml.cpp",
 		MAME_DIR .. "src/devices/cpu/uml.h",
 		MAME_DIR .. "src/devices/cpu/i386/i386dasm.cpp",
@@ -665,6 +667,8 @@ if (CPUS["SH4"]~=null) then
 	files {
 		MAME_DIR .. "src/devices/cpu/sh4/sh4.cpp",
 		MAME_DIR .. "src/devices/cpu/sh4/sh4.h",
+		MAME_DIR .. "src/devices/cpu/sh4/sh4fe.cpp",
+		--MAME_DIR .. "src/devices/cpu/sh4/sh4drc.cpp",
 		MAME_DIR .. "src/devices/cpu/sh4/sh4comn.cpp",
 		MAME_DIR .. "src/devices/cpu/sh4/sh4comn.h",
 		MAME_DIR .. "src/devices/cpu/sh4/sh3comn.cpp",
@@ -917,6 +921,8 @@ if (CPUS["I386"]~=null) then
 	files {
 		MAME_DIR .. "src/devices/cpu/i386/i386.cpp",
 		MAME_DIR .. "src/devices/cpu/i386/i386.h",
+		MAME_DIR .. "src/devices/cpu/i386/i386fe.cpp",
+		--MAME_DIR .. "src/devices/cpu/i386/i386drc.cpp",
 		MAME_DIR .. "src/devices/cpu/i386/cycles.h",
 		MAME_DIR .. "src/devices/cpu/i386/i386op16.hxx",
 		MAME_DIR .. "src/devices/cpu/i386/i386op32.hxx",
@@ -103,6 +103,7 @@ files {
 	MAME_DIR .. "src/emu/drawgfx.cpp",
 	MAME_DIR .. "src/emu/drawgfx.h",
 	MAME_DIR .. "src/emu/drawgfxm.h",
+	MAME_DIR .. "src/emu/drawkern.h",
 	MAME_DIR .. "src/emu/driver.cpp",
 	MAME_DIR .. "src/emu/driver.h",
 	MAME_DIR .. "src/emu/drivenum.cpp",
@@ -119,6 +120,8 @@ files {
 	MAME_DIR .. "src/emu/emupal.h",
 	MAME_DIR .. "src/emu/fileio.cpp",
 	MAME_DIR .. "src/emu/fileio.h",
+	MAME_DIR .. "src/emu/hashcache.cpp",
+	MAME_DIR .. "src/emu/hashcache.h",
 	MAME_DIR .. "src/emu/image.cpp",
 	MAME_DIR .. "src/emu/image.h",
 	MAME_DIR .. "src/emu/input.cpp",
@@ -132,6 +135,8 @@ files {
 	MAME_DIR .. "src/emu/mconfig.h",
 	MAME_DIR .. "src/emu/memarray.cpp",
 	MAME_DIR .. "src/emu/memarray.h",
+	MAME_DIR .. "src/emu/movierec.cpp",
+	MAME_DIR .. "src/emu/movierec.h",
 	MAME_DIR .. "src/emu/network.cpp",
 	MAME_DIR .. "src/emu/network.h",
 	MAME_DIR .. "src/emu/parameters.cpp",
@@ -162,8 +167,11 @@ files {
 	MAME_DIR .. "src/emu/softlist.h",
 	MAME_DIR .. "src/emu/softlist_dev.cpp",
 	MAME_DIR .. "src/emu/softlist_dev.h",
+	MAME_DIR .. "src/emu/softlist_index.cpp",
+	MAME_DIR .. "src/emu/softlist_index.h",
 	MAME_DIR .. "src/emu/sound.cpp",
 	MAME_DIR .. "src/emu/sound.h",
+	MAME_DIR .. "src/emu/soundkern.h",
 	MAME_DIR .. "src/emu/speaker.cpp",
 	MAME_DIR .. "src/emu/speaker.h",
 	MAME_DIR .. "src/emu/tilemap.cpp",
@@ -62,6 +62,8 @@ project "netlist"
 		MAME_DIR .. "src/lib/netlist/plib/pstring.h",
 		MAME_DIR .. "src/lib/netlist/plib/pstream.cpp",
 		MAME_DIR .. "src/lib/netlist/plib/pstream.h",
+		MAME_DIR .. "src/lib/netlist/plib/pthreadpool.cpp",
+		MAME_DIR .. "src/lib/netlist/plib/pthreadpool.h",
 		MAME_DIR .. "src/lib/netlist/plib/ptypes.h",
     MAME_DIR .. "src/lib/netlist/plib/putil.cpp",
     MAME_DIR .. "src/lib/netlist/plib/putil.h",
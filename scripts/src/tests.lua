@@ -71,6 +71,7 @@ project("mametests")
 		MAME_DIR .. "3rdparty/googletest/googletest/include",
 		MAME_DIR .. "src/osd",
 		MAME_DIR .. "src/emu",
+		MAME_DIR .. "src/devices",
 		MAME_DIR .. "src/lib/util",
 		ext_includedir("expat"),
 		ext_includedir("zlib"),
@@ -80,5 +81,11 @@ project("mametests")
 		MAME_DIR .. "tests/main.cpp",
 		MAME_DIR .. "tests/lib/util/corestr.cpp",
 		MAME_DIR .. "tests/emu/attotime.cpp",
+		MAME_DIR .. "tests/emu/drawkern.cpp",
+		MAME_DIR .. "tests/devices/cpu/umlopt.cpp",
+		MAME_DIR .. "src/emu/emucore.cpp",
+		MAME_DIR .. "src/devices/cpu/drccache.cpp",
+		MAME_DIR .. "src/devices/cpu/drcumlopt.cpp",
+		MAME_DIR .. "src/devices/cpu/uml.cpp",
 	}
 
@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
 #include "debugger.h"
 #include "drcbec.h"
 
@@ -124,7 +125,12 @@ enum
 	OP_FFRI4,
 	OP_FFRI8,
 	OP_FFRFS,
-	OP_FFRFD
+	OP_FFRFD,
+
+	// superinstructions, only generated for threaded code
+	OP_CMPJMP,
+	OP_SUBEXH,
+	OP_MOV2
 };
 
 
@@ -157,6 +163,45 @@ enum
 #define OPCODE_FAIL_CONDITION(op,f) (((op) & s_condition_map[f]) == 0)
 #define OPCODE_GET_PWORDS(op)       ((op) >> 28)
 
+// threaded dispatch needs the GCC/clang labels-as-values extension
+#if defined(__GNUC__)
+#define DRCBEC_THREADED             (1)
+#else
+#define DRCBEC_THREADED             (0)
+#endif
+
+//
+// opcode handlers are written once and compiled into both forms of the
+// interpreter: a switch on the opcode, and (where supported) direct threaded
+// code that starts each instruction with the address of its handler and
+// jumps straight from one handler to the next
+//
+#if DRCBEC_THREADED
+
+// jump to the handler of the instruction at inst
+#define THREADED_DISPATCH() \
+	do { const void *handler = (inst++)->v; opcode = (inst++)->i; goto *handler; } while (0)
+
+// a case label that also records its handler address during registration
+#define OPCODE_CASE(op, size, cond) \
+	case MAKE_OPCODE_SHORT(op, size, cond): \
+		if (Threaded && registering) { s_handlers[MAKE_OPCODE_SHORT(op, size, cond)] = &&handler_##op##_##size##_##cond; regop.i++; goto register_next; } \
+	handler_##op##_##size##_##cond
+
+// finish an instruction and move on to the next one
+#define OPCODE_NEXT                 { if (Threaded) { inst += OPCODE_GET_PWORDS(opcode); THREADED_DISPATCH(); } break; }
+
+// continue at a new instruction pointer
+#define OPCODE_BRANCH               { if (Threaded) THREADED_DISPATCH(); continue; }
+
+#else
+
+#define OPCODE_CASE(op, size, cond) case MAKE_OPCODE_SHORT(op, size, cond)
+#define OPCODE_NEXT                 break
+#define OPCODE_BRANCH               continue
+
+#endif
+
 // shorthand for accessing parameters in the instruction stream
 #define PARAM0                      (*inst[0].puint32)
 #define PARAM1                      (*inst[1].puint32)
@@ -236,6 +281,7 @@ union drcbec_instruction
 //**************************************************************************
 
 UINT64 drcbe_c::s_immediate_zero = 0;
+void *drcbe_c::s_handlers[0x1000];
 
 const UINT32 drcbe_c::s_condition_map[] =
 {
@@ -288,8 +334,14 @@ drcbe_c::drcbe_c(drcuml_state &drcuml, device_t &device, drc_cache &cache, UINT3
 		m_hash(cache, modes, addrbits, ignorebits),
 		m_map(cache, 0),
 		m_labels(cache),
-		m_fixup_delegate(FUNC(drcbe_c::fixup_label), this)
+		m_fixup_delegate(FUNC(drcbe_c::fixup_label), this),
+		m_threaded(DRCBEC_THREADED && device.machine().options().drc_c_threaded())
 {
+#if DRCBEC_THREADED
+	// the first threaded back-end builds the handler table
+	if (m_threaded && s_handlers[0] == nullptr)
+		execute_loop<true>(nullptr);
+#endif
 }
 
 
@@ -326,7 +378,7 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, UINT32
 	m_map.block_begin(block);
 
 	// begin codegen; fail if we can't
-	drccodeptr *cachetop = m_cache.begin_codegen(numinst * sizeof(drcbec_instruction) * 4);
+	drccodeptr *cachetop = m_cache.begin_codegen(numinst * sizeof(drcbec_instruction) * (m_threaded ? 5 : 4));
 	if (cachetop == nullptr)
 		block.abort();
 
@@ -371,7 +423,7 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, UINT32
 
 			// JMP instructions need to resolve their labels
 			case OP_JMP:
-				(dst++)->i = MAKE_OPCODE_FULL(opcode, inst.size(), inst.condition(), inst.flags(), 1);
+				output_opcode(&dst, MAKE_OPCODE_FULL(opcode, inst.size(), inst.condition(), inst.flags(), 1));
 				dst->inst = (drcbec_instruction *)m_labels.get_codeptr(inst.param(0).label(), m_fixup_delegate, dst);
 				dst++;
 				break;
@@ -379,6 +431,13 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, UINT32
 			// generically handle everything else
 			default:
 
+				// threaded code fuses common pairs into a single instruction
+				if (m_threaded && inum + 1 < numinst && output_superinstruction(&dst, inst, instlist[inum + 1]))
+				{
+					inum++;
+					break;
+				}
+
 				// determine the operand size for each operand; mostly this is just the instruction size
 				for (int pnum = 0; pnum < inst.numparams(); pnum++)
 					psize[pnum] = inst.size();
@@ -421,29 +480,13 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, UINT32
 				if (opcode == OP_FFRFLT)
 					opcode = (opcode_t)(OP_FFRFS + (inst.param(2).size() - 2));
 
-				// count how many bytes of immediates we need
-				int immedbytes = 0;
-				for (int pnum = 0; pnum < inst.numparams(); pnum++)
-					if (inst.param(pnum).is_mapvar() ||
-						(inst.param(pnum).is_immediate() && inst.param(pnum).immediate() != 0) ||
-						(inst.param(pnum).is_size_space() && inst.param(pnum).space() != 0))
-						immedbytes += psize[pnum];
-
-				// compute how many instruction words we need for that
-				int immedwords = (immedbytes + sizeof(drcbec_instruction) - 1) / sizeof(drcbec_instruction);
-
-				// first item is the opcode, size, condition flags and length
-				(dst++)->i = MAKE_OPCODE_FULL(opcode, inst.size(), inst.condition(), inst.flags(), inst.numparams() + immedwords);
-
-				// immediates start after parameters
-				void *immed = dst + inst.numparams();
-
-				// output each of the parameters
-				for (int pnum = 0; pnum < inst.numparams(); pnum++)
-					output_parameter(&dst, &immed, psize[pnum], inst.param(pnum));
-
-				// point past the end of the immediates
-				dst += immedwords;
+				// output the opcode and its parameters
+				{
+					parameter params[instruction::MAX_PARAMS];
+					for (int pnum = 0; pnum < inst.numparams(); pnum++)
+						params[pnum] = inst.param(pnum);
+					output_instruction(&dst, opcode, inst.size(), inst.condition(), inst.flags(), inst.numparams(), params, psize);
+				}
 				break;
 		}
 	}
@@ -470,6 +513,17 @@ bool drcbe_c::hash_exists(UINT32 mode, UINT32 pc)
 }
 
 
+//-------------------------------------------------
+//  invalidate_code - forget about code that has
+//  been evicted from the cache
+//-------------------------------------------------
+
+void drcbe_c::invalidate_code(drccodeptr start, drccodeptr end)
+{
+	m_hash.invalidate_range(start, end);
+}
+
+
 //-------------------------------------------------
 //  get_info - return information about the
 //  back-end implementation
@@ -493,36 +547,72 @@ int drcbe_c::execute(code_handle &entry)
 	const drcbec_instruction *inst = (const drcbec_instruction *)entry.codeptr();
 	assert_in_cache(m_cache, inst);
 
+#if DRCBEC_THREADED
+	if (m_threaded)
+		return execute_loop<true>(inst);
+#endif
+	return execute_loop<false>(inst);
+}
+
+
+//-------------------------------------------------
+//  execute_loop - run code starting at the given
+//  instruction, in either threaded or switch form
+//-------------------------------------------------
+
+template <bool Threaded>
+int drcbe_c::execute_loop(const drcbec_instruction *inst)
+{
 	// loop while we have cycles
 	const drcbec_instruction *callstack[32];
 	const drcbec_instruction *newinst;
+	UINT32 opcode;
 	UINT32 temp32;
 	UINT64 temp64;
 	int shift;
 	UINT8 flags = 0;
 	UINT8 sp = 0;
+
+#if DRCBEC_THREADED
+	// with no entry point, feed every short opcode through the switch so that
+	// each case records the address of its handler
+	drcbec_instruction regop;
+	bool registering = Threaded && (inst == nullptr);
+	regop.i = 0;
+register_next:
+	if (registering)
+	{
+		if (regop.i == ARRAY_LENGTH(s_handlers))
+			return 0;
+		s_handlers[regop.i] = &&handler_unexpected;
+		inst = &regop;
+	}
+	else if (Threaded)
+		THREADED_DISPATCH();
+#endif
+
 	while (true)
 	{
-		UINT32 opcode = (inst++)->i;
+		opcode = (inst++)->i;
 
 		switch (OPCODE_GET_SHORT(opcode))
 		{
 			// ----------------------- Control Flow Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_HANDLE, 4, 0):    // HANDLE  handle
-			case MAKE_OPCODE_SHORT(OP_HASH, 4, 0):      // HASH    mode,pc
-			case MAKE_OPCODE_SHORT(OP_LABEL, 4, 0):     // LABEL   imm
-			case MAKE_OPCODE_SHORT(OP_COMMENT, 4, 0):   // COMMENT string
-			case MAKE_OPCODE_SHORT(OP_MAPVAR, 4, 0):    // MAPVAR  mapvar,value
+			OPCODE_CASE(OP_HANDLE, 4, 0):               // HANDLE  handle
+			OPCODE_CASE(OP_HASH, 4, 0):                 // HASH    mode,pc
+			OPCODE_CASE(OP_LABEL, 4, 0):                // LABEL   imm
+			OPCODE_CASE(OP_COMMENT, 4, 0):              // COMMENT string
+			OPCODE_CASE(OP_MAPVAR, 4, 0):               // MAPVAR  mapvar,value
 
 				// these opcodes should be processed at compile-time only
 				fatalerror("Unexpected opcode\n");
 
-			case MAKE_OPCODE_SHORT(OP_DEBUG, 4, 0):     // DEBUG   pc
+			OPCODE_CASE(OP_DEBUG, 4, 0):                // DEBUG   pc
 				debugger_instruction_hook(&m_device, PARAM0);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_HASHJMP, 4, 0):   // HASHJMP mode,pc,handle
+			OPCODE_CASE(OP_HASHJMP, 4, 0):              // HASHJMP mode,pc,handle
 				sp = 0;
 				newinst = (const drcbec_instruction *)m_hash.get_codeptr(PARAM0, PARAM1);
 				if (newinst == nullptr)
@@ -534,373 +624,373 @@ int drcbe_c::execute(code_handle &entry)
 				}
 				assert_in_cache(m_cache, newinst);
 				inst = newinst;
-				continue;
+				OPCODE_BRANCH;
 
-			case MAKE_OPCODE_SHORT(OP_EXIT, 4, 1):      // EXIT    src1[,c]
+			OPCODE_CASE(OP_EXIT, 4, 1):                 // EXIT    src1[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
-					break;
+					OPCODE_NEXT;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_EXIT, 4, 0):
+			OPCODE_CASE(OP_EXIT, 4, 0):
 				return PARAM0;
 
-			case MAKE_OPCODE_SHORT(OP_JMP, 4, 1):       // JMP     imm[,c]
+			OPCODE_CASE(OP_JMP, 4, 1):                  // JMP     imm[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
-					break;
+					OPCODE_NEXT;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_JMP, 4, 0):
+			OPCODE_CASE(OP_JMP, 4, 0):
 				newinst = inst[0].inst;
 				assert_in_cache(m_cache, newinst);
 				inst = newinst;
-				continue;
+				OPCODE_BRANCH;
 
-			case MAKE_OPCODE_SHORT(OP_CALLH, 4, 1):     // CALLH   handle[,c]
+			OPCODE_CASE(OP_CALLH, 4, 1):                // CALLH   handle[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
-					break;
+					OPCODE_NEXT;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_CALLH, 4, 0):
+			OPCODE_CASE(OP_CALLH, 4, 0):
 				assert(sp < ARRAY_LENGTH(callstack));
 				newinst = (const drcbec_instruction *)inst[0].handle->codeptr();
 				assert_in_cache(m_cache, newinst);
 				callstack[sp++] = inst + OPCODE_GET_PWORDS(opcode);
 				inst = newinst;
-				continue;
+				OPCODE_BRANCH;
 
-			case MAKE_OPCODE_SHORT(OP_RET, 4, 1):       // RET     [c]
+			OPCODE_CASE(OP_RET, 4, 1):                  // RET     [c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
-					break;
+					OPCODE_NEXT;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_RET, 4, 0):
+			OPCODE_CASE(OP_RET, 4, 0):
 				assert(sp > 0);
 				newinst = callstack[--sp];
 				assert_in_cache(m_cache, newinst);
 				inst = newinst;
-				continue;
+				OPCODE_BRANCH;
 
-			case MAKE_OPCODE_SHORT(OP_EXH, 4, 1):       // EXH     handle,param[,c]
+			OPCODE_CASE(OP_EXH, 4, 1):                  // EXH     handle,param[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
-					break;
+					OPCODE_NEXT;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_EXH, 4, 0):
+			OPCODE_CASE(OP_EXH, 4, 0):
 				assert(sp < ARRAY_LENGTH(callstack));
 				newinst = (const drcbec_instruction *)inst[0].handle->codeptr();
 				assert_in_cache(m_cache, newinst);
 				m_state.exp = PARAM1;
 				callstack[sp++] = inst;
 				inst = newinst;
-				continue;
+				OPCODE_BRANCH;
 
-			case MAKE_OPCODE_SHORT(OP_CALLC, 4, 1):     // CALLC   func,ptr[,c]
+			OPCODE_CASE(OP_CALLC, 4, 1):                // CALLC   func,ptr[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
-					break;
+					OPCODE_NEXT;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_CALLC, 4, 0):
+			OPCODE_CASE(OP_CALLC, 4, 0):
 				(*inst[0].cfunc)(inst[1].v);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_RECOVER, 4, 0):   // RECOVER dst,mapvar
+			OPCODE_CASE(OP_RECOVER, 4, 0):              // RECOVER dst,mapvar
 				assert(sp > 0);
 				PARAM0 = m_map.get_value((drccodeptr)callstack[0], MAPVAR_M0 + PARAM1);
-				break;
+				OPCODE_NEXT;
 
 
 			// ----------------------- Internal Register Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_SETFMOD, 4, 0):   // SETFMOD src
+			OPCODE_CASE(OP_SETFMOD, 4, 0):              // SETFMOD src
 				m_state.fmod = PARAM0;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_GETFMOD, 4, 0):   // GETFMOD dst
+			OPCODE_CASE(OP_GETFMOD, 4, 0):              // GETFMOD dst
 				PARAM0 = m_state.fmod;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_GETEXP, 4, 0):    // GETEXP  dst
+			OPCODE_CASE(OP_GETEXP, 4, 0):               // GETEXP  dst
 				PARAM0 = m_state.exp;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_GETFLGS, 4, 0):   // GETFLGS dst[,f]
+			OPCODE_CASE(OP_GETFLGS, 4, 0):              // GETFLGS dst[,f]
 				PARAM0 = flags & PARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SAVE, 4, 0):      // SAVE    dst
+			OPCODE_CASE(OP_SAVE, 4, 0):                 // SAVE    dst
 				*inst[0].state = m_state;
 				inst[0].state->flags = flags;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_RESTORE, 4, 0):   // RESTORE dst
-			case MAKE_OPCODE_SHORT(OP_RESTORE, 4, 1):   // RESTORE dst
+			OPCODE_CASE(OP_RESTORE, 4, 0):              // RESTORE dst
+			OPCODE_CASE(OP_RESTORE, 4, 1):              // RESTORE dst
 				m_state = *inst[0].state;
 				flags = inst[0].state->flags;
-				break;
+				OPCODE_NEXT;
 
 
 			// ----------------------- 32-Bit Integer Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1, 4, 0):     // LOAD    dst,base,index,BYTE
+			OPCODE_CASE(OP_LOAD1, 4, 0):                // LOAD    dst,base,index,BYTE
 				PARAM0 = inst[1].puint8[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x2, 4, 0):   // LOAD    dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_LOAD1x2, 4, 0):              // LOAD    dst,base,index,BYTE_x2
 				PARAM0 = *(UINT8 *)&inst[1].puint16[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x4, 4, 0):   // LOAD    dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_LOAD1x4, 4, 0):              // LOAD    dst,base,index,BYTE_x4
 				PARAM0 = *(UINT8 *)&inst[1].puint32[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x8, 4, 0):   // LOAD    dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_LOAD1x8, 4, 0):              // LOAD    dst,base,index,BYTE_x8
 				PARAM0 = *(UINT8 *)&inst[1].puint64[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x1, 4, 0):   // LOAD    dst,base,index,WORD_x1
+			OPCODE_CASE(OP_LOAD2x1, 4, 0):              // LOAD    dst,base,index,WORD_x1
 				PARAM0 = *(UINT16 *)&inst[1].puint8[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2, 4, 0):     // LOAD    dst,base,index,WORD
+			OPCODE_CASE(OP_LOAD2, 4, 0):                // LOAD    dst,base,index,WORD
 				PARAM0 = inst[1].puint16[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x4, 4, 0):   // LOAD    dst,base,index,WORD_x4
+			OPCODE_CASE(OP_LOAD2x4, 4, 0):              // LOAD    dst,base,index,WORD_x4
 				PARAM0 = *(UINT16 *)&inst[1].puint32[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x8, 4, 0):   // LOAD    dst,base,index,WORD_x8
+			OPCODE_CASE(OP_LOAD2x8, 4, 0):              // LOAD    dst,base,index,WORD_x8
 				PARAM0 = *(UINT16 *)&inst[1].puint64[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x1, 4, 0):   // LOAD    dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_LOAD4x1, 4, 0):              // LOAD    dst,base,index,DWORD_x1
 				PARAM0 = *(UINT32 *)&inst[1].puint8[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x2, 4, 0):   // LOAD    dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_LOAD4x2, 4, 0):              // LOAD    dst,base,index,DWORD_x2
 				PARAM0 = *(UINT32 *)&inst[1].puint16[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4, 4, 0):     // LOAD    dst,base,index,DWORD
+			OPCODE_CASE(OP_LOAD4, 4, 0):                // LOAD    dst,base,index,DWORD
 				PARAM0 = inst[1].puint32[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x8, 4, 0):   // LOAD    dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_LOAD4x8, 4, 0):              // LOAD    dst,base,index,DWORD_x8
 				PARAM0 = *(UINT32 *)&inst[1].puint64[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1, 4, 0):    // LOADS   dst,base,index,BYTE
+			OPCODE_CASE(OP_LOADS1, 4, 0):               // LOADS   dst,base,index,BYTE
 				PARAM0 = inst[1].pint8[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x2, 4, 0):  // LOADS   dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_LOADS1x2, 4, 0):             // LOADS   dst,base,index,BYTE_x2
 				PARAM0 = *(INT8 *)&inst[1].pint16[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x4, 4, 0):  // LOADS   dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_LOADS1x4, 4, 0):             // LOADS   dst,base,index,BYTE_x4
 				PARAM0 = *(INT8 *)&inst[1].pint32[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x8, 4, 0):  // LOADS   dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_LOADS1x8, 4, 0):             // LOADS   dst,base,index,BYTE_x8
 				PARAM0 = *(INT8 *)&inst[1].pint64[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x1, 4, 0):  // LOADS   dst,base,index,WORD_x1
+			OPCODE_CASE(OP_LOADS2x1, 4, 0):             // LOADS   dst,base,index,WORD_x1
 				PARAM0 = *(INT16 *)&inst[1].pint8[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2, 4, 0):    // LOADS   dst,base,index,WORD
+			OPCODE_CASE(OP_LOADS2, 4, 0):               // LOADS   dst,base,index,WORD
 				PARAM0 = inst[1].pint16[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x4, 4, 0):  // LOADS   dst,base,index,WORD_x4
+			OPCODE_CASE(OP_LOADS2x4, 4, 0):             // LOADS   dst,base,index,WORD_x4
 				PARAM0 = *(INT16 *)&inst[1].pint32[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x8, 4, 0):  // LOADS   dst,base,index,WORD_x8
+			OPCODE_CASE(OP_LOADS2x8, 4, 0):             // LOADS   dst,base,index,WORD_x8
 				PARAM0 = *(INT16 *)&inst[1].pint64[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x1, 4, 0):  // LOADS   dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_LOADS4x1, 4, 0):             // LOADS   dst,base,index,DWORD_x1
 				PARAM0 = *(INT32 *)&inst[1].pint8[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x2, 4, 0):  // LOADS   dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_LOADS4x2, 4, 0):             // LOADS   dst,base,index,DWORD_x2
 				PARAM0 = *(INT32 *)&inst[1].pint16[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4, 4, 0):    // LOADS   dst,base,index,DWORD
+			OPCODE_CASE(OP_LOADS4, 4, 0):               // LOADS   dst,base,index,DWORD
 				PARAM0 = inst[1].pint32[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x8, 4, 0):  // LOADS   dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_LOADS4x8, 4, 0):             // LOADS   dst,base,index,DWORD_x8
 				PARAM0 = *(INT32 *)&inst[1].pint64[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1, 4, 0):    // STORE   dst,base,index,BYTE
+			OPCODE_CASE(OP_STORE1, 4, 0):               // STORE   dst,base,index,BYTE
 				inst[0].puint8[PARAM1] = PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x2, 4, 0):  // STORE   dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_STORE1x2, 4, 0):             // STORE   dst,base,index,BYTE_x2
 				*(UINT8 *)&inst[0].puint16[PARAM1] = PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x4, 4, 0):  // STORE   dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_STORE1x4, 4, 0):             // STORE   dst,base,index,BYTE_x4
 				*(UINT8 *)&inst[0].puint32[PARAM1] = PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x8, 4, 0):  // STORE   dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_STORE1x8, 4, 0):             // STORE   dst,base,index,BYTE_x8
 				*(UINT8 *)&inst[0].puint64[PARAM1] = PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x1, 4, 0):  // STORE   dst,base,index,WORD_x1
+			OPCODE_CASE(OP_STORE2x1, 4, 0):             // STORE   dst,base,index,WORD_x1
 				*(UINT16 *)&inst[0].puint8[PARAM1] = PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2, 4, 0):    // STORE   dst,base,index,WORD
+			OPCODE_CASE(OP_STORE2, 4, 0):               // STORE   dst,base,index,WORD
 				inst[0].puint16[PARAM1] = PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x4, 4, 0):  // STORE   dst,base,index,WORD_x4
+			OPCODE_CASE(OP_STORE2x4, 4, 0):             // STORE   dst,base,index,WORD_x4
 				*(UINT16 *)&inst[0].puint32[PARAM1] = PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x8, 4, 0):  // STORE   dst,base,index,WORD_x8
+			OPCODE_CASE(OP_STORE2x8, 4, 0):             // STORE   dst,base,index,WORD_x8
 				*(UINT16 *)&inst[0].puint64[PARAM1] = PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x1, 4, 0):  // STORE   dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_STORE4x1, 4, 0):             // STORE   dst,base,index,DWORD_x1
 				*(UINT32 *)&inst[0].puint8[PARAM1] = PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x2, 4, 0):  // STORE   dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_STORE4x2, 4, 0):             // STORE   dst,base,index,DWORD_x2
 				*(UINT32 *)&inst[0].puint16[PARAM1] = PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4, 4, 0):    // STORE   dst,base,index,DWORD
+			OPCODE_CASE(OP_STORE4, 4, 0):               // STORE   dst,base,index,DWORD
 				inst[0].puint32[PARAM1] = PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x8, 4, 0):  // STORE   dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_STORE4x8, 4, 0):             // STORE   dst,base,index,DWORD_x8
 				*(UINT32 *)&inst[0].puint64[PARAM1] = PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_READ1, 4, 0):     // READ    dst,src1,space_BYTE
+			OPCODE_CASE(OP_READ1, 4, 0):                // READ    dst,src1,space_BYTE
 				PARAM0 = m_space[PARAM2]->read_byte(PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_READ2, 4, 0):     // READ    dst,src1,space_WORD
+			OPCODE_CASE(OP_READ2, 4, 0):                // READ    dst,src1,space_WORD
 				PARAM0 = m_space[PARAM2]->read_word(PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_READ4, 4, 0):     // READ    dst,src1,space_DWORD
+			OPCODE_CASE(OP_READ4, 4, 0):                // READ    dst,src1,space_DWORD
 				PARAM0 = m_space[PARAM2]->read_dword(PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_READM2, 4, 0):    // READM   dst,src1,mask,space_WORD
+			OPCODE_CASE(OP_READM2, 4, 0):               // READM   dst,src1,mask,space_WORD
 				PARAM0 = m_space[PARAM3]->read_word(PARAM1, PARAM2);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_READM4, 4, 0):    // READM   dst,src1,mask,space_DWORD
+			OPCODE_CASE(OP_READM4, 4, 0):               // READM   dst,src1,mask,space_DWORD
 				PARAM0 = m_space[PARAM3]->read_dword(PARAM1, PARAM2);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE1, 4, 0):    // WRITE   dst,src1,space_BYTE
+			OPCODE_CASE(OP_WRITE1, 4, 0):               // WRITE   dst,src1,space_BYTE
 				m_space[PARAM2]->write_byte(PARAM0, PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE2, 4, 0):    // WRITE   dst,src1,space_WORD
+			OPCODE_CASE(OP_WRITE2, 4, 0):               // WRITE   dst,src1,space_WORD
 				m_space[PARAM2]->write_word(PARAM0, PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE4, 4, 0):    // WRITE   dst,src1,space_DWORD
+			OPCODE_CASE(OP_WRITE4, 4, 0):               // WRITE   dst,src1,space_DWORD
 				m_space[PARAM2]->write_dword(PARAM0, PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_WRITEM2, 4, 0):   // WRITEM  dst,src1,mask,space_WORD
+			OPCODE_CASE(OP_WRITEM2, 4, 0):              // WRITEM  dst,src1,mask,space_WORD
 				m_space[PARAM3]->write_word(PARAM0, PARAM1, PARAM2);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_WRITEM4, 4, 0):   // WRITEM  dst,src1,mask,space_DWORD
+			OPCODE_CASE(OP_WRITEM4, 4, 0):              // WRITEM  dst,src1,mask,space_DWORD
 				m_space[PARAM3]->write_dword(PARAM0, PARAM1, PARAM2);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_CARRY, 4, 1):     // CARRY   src,bitnum
+			OPCODE_CASE(OP_CARRY, 4, 1):                // CARRY   src,bitnum
 				flags = (flags & ~FLAG_C) | ((PARAM0 >> (PARAM1 & 31)) & FLAG_C);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_MOV, 4, 1):       // MOV     dst,src[,c]
+			OPCODE_CASE(OP_MOV, 4, 1):                  // MOV     dst,src[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
-					break;
+					OPCODE_NEXT;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_MOV, 4, 0):
+			OPCODE_CASE(OP_MOV, 4, 0):
 				PARAM0 = PARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SET, 4, 1):       // SET     dst,c
+			OPCODE_CASE(OP_SET, 4, 1):                  // SET     dst,c
 				PARAM0 = OPCODE_FAIL_CONDITION(opcode, flags) ? 0 : 1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT1, 4, 0):     // SEXT1   dst,src
+			OPCODE_CASE(OP_SEXT1, 4, 0):                // SEXT1   dst,src
 				PARAM0 = (INT8)PARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT1, 4, 1):
+			OPCODE_CASE(OP_SEXT1, 4, 1):
 				temp32 = (INT8)PARAM1;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT2, 4, 0):     // SEXT2   dst,src
+			OPCODE_CASE(OP_SEXT2, 4, 0):                // SEXT2   dst,src
 				PARAM0 = (INT16)PARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT2, 4, 1):
+			OPCODE_CASE(OP_SEXT2, 4, 1):
 				temp32 = (INT16)PARAM1;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROLAND, 4, 0):    // ROLAND  dst,src,count,mask[,f]
+			OPCODE_CASE(OP_ROLAND, 4, 0):               // ROLAND  dst,src,count,mask[,f]
 				shift = PARAM2 & 31;
 				PARAM0 = ((PARAM1 << shift) | (PARAM1 >> (32 - shift))) & PARAM3;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROLAND, 4, 1):
+			OPCODE_CASE(OP_ROLAND, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = ((PARAM1 << shift) | (PARAM1 >> (32 - shift))) & PARAM3;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROLINS, 4, 0):    // ROLINS  dst,src,count,mask[,f]
+			OPCODE_CASE(OP_ROLINS, 4, 0):               // ROLINS  dst,src,count,mask[,f]
 				shift = PARAM2 & 31;
 				PARAM0 = (PARAM0 & ~PARAM3) | (((PARAM1 << shift) | (PARAM1 >> (32 - shift))) & PARAM3);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROLINS, 4, 1):
+			OPCODE_CASE(OP_ROLINS, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = (PARAM0 & ~PARAM3) | (((PARAM1 << shift) | (PARAM1 >> (32 - shift))) & PARAM3);
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ADD, 4, 0):       // ADD     dst,src1,src2[,f]
+			OPCODE_CASE(OP_ADD, 4, 0):                  // ADD     dst,src1,src2[,f]
 				PARAM0 = PARAM1 + PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ADD, 4, 1):
+			OPCODE_CASE(OP_ADD, 4, 1):
 				temp32 = PARAM1 + PARAM2;
 				flags = FLAGS32_NZCV_ADD(temp32, PARAM1, PARAM2);
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ADDC, 4, 0):      // ADDC    dst,src1,src2[,f]
+			OPCODE_CASE(OP_ADDC, 4, 0):                 // ADDC    dst,src1,src2[,f]
 				PARAM0 = PARAM1 + PARAM2 + (flags & FLAG_C);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ADDC, 4, 1):
+			OPCODE_CASE(OP_ADDC, 4, 1):
 				temp32 = PARAM1 + PARAM2 + (flags & FLAG_C);
 				if (PARAM2 + 1 != 0)
 					flags = FLAGS32_NZCV_ADD(temp32, PARAM1, PARAM2 + (flags & FLAG_C));
@@ -915,23 +1005,23 @@ int drcbe_c::execute(code_handle &entry)
 						flags = FLAGS32_NZCV_ADD(temp32, PARAM1 + (flags & FLAG_C), PARAM2);
 				}
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SUB, 4, 0):       // SUB     dst,src1,src2[,f]
+			OPCODE_CASE(OP_SUB, 4, 0):                  // SUB     dst,src1,src2[,f]
 				PARAM0 = PARAM1 - PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SUB, 4, 1):
+			OPCODE_CASE(OP_SUB, 4, 1):
 				temp32 = PARAM1 - PARAM2;
 				flags = FLAGS32_NZCV_SUB(temp32, PARAM1, PARAM2);
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SUBB, 4, 0):      // SUBB    dst,src1,src2[,f]
+			OPCODE_CASE(OP_SUBB, 4, 0):                 // SUBB    dst,src1,src2[,f]
 				PARAM0 = PARAM1 - PARAM2 - (flags & FLAG_C);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SUBB, 4, 1):
+			OPCODE_CASE(OP_SUBB, 4, 1):
 				temp32 = PARAM1 - PARAM2 - (flags & FLAG_C);
 				temp64 = (UINT64)PARAM1 - (UINT64)PARAM2 - (UINT64)(flags & FLAG_C);
 				if (PARAM2 + 1 != 0)
@@ -944,36 +1034,36 @@ int drcbe_c::execute(code_handle &entry)
 					flags |= (((PARAM1) ^ (PARAM2)) & ((PARAM1) ^ (temp64)) & 0x80000000) ? FLAG_V : 0;
 				}
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_CMP, 4, 1):       // CMP     src1,src2[,f]
+			OPCODE_CASE(OP_CMP, 4, 1):                  // CMP     src1,src2[,f]
 				temp32 = PARAM0 - PARAM1;
 				flags = FLAGS32_NZCV_SUB(temp32, PARAM0, PARAM1);
 //                printf("CMP: %08x - %08x = flags %x\n", PARAM0, PARAM1, flags);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_MULU, 4, 0):      // MULU    dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_MULU, 4, 0):                 // MULU    dst,edst,src1,src2[,f]
 				temp64 = (UINT64)(UINT32)PARAM2 * (UINT64)(UINT32)PARAM3;
 				PARAM1 = temp64 >> 32;
 				PARAM0 = (UINT32)temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_MULU, 4, 1):
+			OPCODE_CASE(OP_MULU, 4, 1):
 				temp64 = (UINT64)(UINT32)PARAM2 * (UINT64)(UINT32)PARAM3;
 				flags = FLAGS64_NZ(temp64);
 				PARAM1 = temp64 >> 32;
 				PARAM0 = (UINT32)temp64;
 				if (temp64 != (UINT32)temp64)
 					flags |= FLAG_V;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_MULS, 4, 0):      // MULS    dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_MULS, 4, 0):                 // MULS    dst,edst,src1,src2[,f]
 				temp64 = (INT64)(INT32)PARAM2 * (INT64)(INT32)PARAM3;
 				PARAM1 = temp64 >> 32;
 				PARAM0 = (UINT32)temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_MULS, 4, 1):
+			OPCODE_CASE(OP_MULS, 4, 1):
 				temp64 = (INT64)(INT32)PARAM2 * (INT64)(INT32)PARAM3;
 				temp32 = (INT32)temp64;
 				flags = FLAGS32_NZ(temp32);
@@ -981,18 +1071,18 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = (UINT32)temp64;
 				if (temp64 != (INT32)temp64)
 					flags |= FLAG_V;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_DIVU, 4, 0):      // DIVU    dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_DIVU, 4, 0):                 // DIVU    dst,edst,src1,src2[,f]
 				if (PARAM3 != 0)
 				{
 					temp32 = (UINT32)PARAM2 / (UINT32)PARAM3;
 					PARAM1 = (UINT32)PARAM2 % (UINT32)PARAM3;
 					PARAM0 = temp32;
 				}
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_DIVU, 4, 1):
+			OPCODE_CASE(OP_DIVU, 4, 1):
 				if (PARAM3 != 0)
 				{
 					temp32 = (UINT32)PARAM2 / (UINT32)PARAM3;
@@ -1002,18 +1092,18 @@ int drcbe_c::execute(code_handle &entry)
 				}
 				else
 					flags = FLAG_V;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_DIVS, 4, 0):      // DIVS    dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_DIVS, 4, 0):                 // DIVS    dst,edst,src1,src2[,f]
 				if (PARAM3 != 0)
 				{
 					temp32 = (INT32)PARAM2 / (INT32)PARAM3;
 					PARAM1 = (INT32)PARAM2 % (INT32)PARAM3;
 					PARAM0 = temp32;
 				}
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_DIVS, 4, 1):
+			OPCODE_CASE(OP_DIVS, 4, 1):
 				if (PARAM3 != 0)
 				{
 					temp32 = (INT32)PARAM2 / (INT32)PARAM3;
@@ -1023,79 +1113,79 @@ int drcbe_c::execute(code_handle &entry)
 				}
 				else
 					flags = FLAG_V;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_AND, 4, 0):       // AND     dst,src1,src2[,f]
+			OPCODE_CASE(OP_AND, 4, 0):                  // AND     dst,src1,src2[,f]
 				PARAM0 = PARAM1 & PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_AND, 4, 1):
+			OPCODE_CASE(OP_AND, 4, 1):
 				temp32 = PARAM1 & PARAM2;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_TEST, 4, 1):      // TEST    src1,src2[,f]
+			OPCODE_CASE(OP_TEST, 4, 1):                 // TEST    src1,src2[,f]
 				temp32 = PARAM0 & PARAM1;
 				flags = FLAGS32_NZ(temp32);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_OR, 4, 0):        // OR      dst,src1,src2[,f]
+			OPCODE_CASE(OP_OR, 4, 0):                   // OR      dst,src1,src2[,f]
 				PARAM0 = PARAM1 | PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_OR, 4, 1):
+			OPCODE_CASE(OP_OR, 4, 1):
 				temp32 = PARAM1 | PARAM2;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_XOR, 4, 0):       // XOR     dst,src1,src2[,f]
+			OPCODE_CASE(OP_XOR, 4, 0):                  // XOR     dst,src1,src2[,f]
 				PARAM0 = PARAM1 ^ PARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_XOR, 4, 1):
+			OPCODE_CASE(OP_XOR, 4, 1):
 				temp32 = PARAM1 ^ PARAM2;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LZCNT, 4, 0):     // LZCNT   dst,src
+			OPCODE_CASE(OP_LZCNT, 4, 0):                // LZCNT   dst,src
 				PARAM0 = count_leading_zeros(PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LZCNT, 4, 1):
+			OPCODE_CASE(OP_LZCNT, 4, 1):
 				temp32 = count_leading_zeros(PARAM1);
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_TZCNT, 4, 0):     // TZCNT   dst,src
+			OPCODE_CASE(OP_TZCNT, 4, 0):                // TZCNT   dst,src
 				PARAM0 = tzcount32(PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_TZCNT, 4, 1):
+			OPCODE_CASE(OP_TZCNT, 4, 1):
 				temp32 = tzcount32(PARAM1);
 				flags = (temp32 == 32) ? FLAG_Z : 0;
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_BSWAP, 4, 0):     // BSWAP   dst,src
+			OPCODE_CASE(OP_BSWAP, 4, 0):                // BSWAP   dst,src
 				temp32 = PARAM1;
 				PARAM0 = flipendian_int32(temp32);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_BSWAP, 4, 1):
+			OPCODE_CASE(OP_BSWAP, 4, 1):
 				temp32 = PARAM1;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = flipendian_int32(temp32);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SHL, 4, 0):       // SHL     dst,src,count[,f]
+			OPCODE_CASE(OP_SHL, 4, 0):                  // SHL     dst,src,count[,f]
 				PARAM0 = PARAM1 << (PARAM2 & 31);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SHL, 4, 1):
+			OPCODE_CASE(OP_SHL, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = PARAM1 << shift;
 				if (shift != 0)
@@ -1104,13 +1194,13 @@ int drcbe_c::execute(code_handle &entry)
 					flags |= ((PARAM1 << (shift - 1)) >> 31) & FLAG_C;
 				}
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SHR, 4, 0):       // SHR     dst,src,count[,f]
+			OPCODE_CASE(OP_SHR, 4, 0):                  // SHR     dst,src,count[,f]
 				PARAM0 = PARAM1 >> (PARAM2 & 31);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SHR, 4, 1):
+			OPCODE_CASE(OP_SHR, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = PARAM1 >> shift;
 				if (shift != 0)
@@ -1119,13 +1209,13 @@ int drcbe_c::execute(code_handle &entry)
 					flags |= (PARAM1 >> (shift - 1)) & FLAG_C;
 				}
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SAR, 4, 0):       // SAR     dst,src,count[,f]
+			OPCODE_CASE(OP_SAR, 4, 0):                  // SAR     dst,src,count[,f]
 				PARAM0 = (INT32)PARAM1 >> (PARAM2 & 31);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SAR, 4, 1):
+			OPCODE_CASE(OP_SAR, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = (INT32)PARAM1 >> shift;
 				if (shift != 0)
@@ -1134,14 +1224,14 @@ int drcbe_c::execute(code_handle &entry)
 					flags |= (PARAM1 >> (shift - 1)) & FLAG_C;
 				}
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROL, 4, 0):       // ROL     dst,src,count[,f]
+			OPCODE_CASE(OP_ROL, 4, 0):                  // ROL     dst,src,count[,f]
 				shift = PARAM2 & 31;
 				PARAM0 = (PARAM1 << shift) | (PARAM1 >> ((32 - shift) & 31));
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROL, 4, 1):
+			OPCODE_CASE(OP_ROL, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = (PARAM1 << shift) | (PARAM1 >> ((32 - shift) & 31));
 				if (shift != 0)
@@ -1150,17 +1240,17 @@ int drcbe_c::execute(code_handle &entry)
 					flags |= ((PARAM1 << (shift - 1)) >> 31) & FLAG_C;
 				}
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROLC, 4, 0):      // ROLC    dst,src,count[,f]
+			OPCODE_CASE(OP_ROLC, 4, 0):                 // ROLC    dst,src,count[,f]
 				shift = PARAM2 & 31;
 				if (shift > 1)
 					PARAM0 = (PARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (PARAM1 >> (33 - shift));
 				else if (shift == 1)
 					PARAM0 = (PARAM1 << shift) | (flags & FLAG_C);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROLC, 4, 1):
+			OPCODE_CASE(OP_ROLC, 4, 1):
 				shift = PARAM2 & 31;
 				if (shift > 1)
 					temp32 = (PARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (PARAM1 >> (33 - shift));
@@ -1171,30 +1261,30 @@ int drcbe_c::execute(code_handle &entry)
 				flags = FLAGS32_NZ(temp32);
 				if (shift != 0) flags |= ((PARAM1 << (shift - 1)) >> 31) & FLAG_C;
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROR, 4, 0):       // ROR     dst,src,count[,f]
+			OPCODE_CASE(OP_ROR, 4, 0):                  // ROR     dst,src,count[,f]
 				shift = PARAM2 & 31;
 				PARAM0 = (PARAM1 >> shift) | (PARAM1 << ((32 - shift) & 31));
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROR, 4, 1):
+			OPCODE_CASE(OP_ROR, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = (PARAM1 >> shift) | (PARAM1 << ((32 - shift) & 31));
 				flags = FLAGS32_NZ(temp32);
 				if (shift != 0) flags |= (PARAM1 >> (shift - 1)) & FLAG_C;
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_RORC, 4, 0):      // RORC    dst,src,count[,f]
+			OPCODE_CASE(OP_RORC, 4, 0):                 // RORC    dst,src,count[,f]
 				shift = PARAM2 & 31;
 				if (shift > 1)
 					PARAM0 = (PARAM1 >> shift) | (((flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
 				else if (shift == 1)
 					PARAM0 = (PARAM1 >> shift) | ((flags & FLAG_C) << 31);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_RORC, 4, 1):
+			OPCODE_CASE(OP_RORC, 4, 1):
 				shift = PARAM2 & 31;
 				if (shift > 1)
 					temp32 = (PARAM1 >> shift) | (((flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
@@ -1205,407 +1295,407 @@ int drcbe_c::execute(code_handle &entry)
 				flags = FLAGS32_NZ(temp32);
 				if (shift != 0) flags |= (PARAM1 >> (shift - 1)) & FLAG_C;
 				PARAM0 = temp32;
-				break;
+				OPCODE_NEXT;
 
 
 			// ----------------------- 64-Bit Integer Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1, 8, 0):     // DLOAD   dst,base,index,BYTE
+			OPCODE_CASE(OP_LOAD1, 8, 0):                // DLOAD   dst,base,index,BYTE
 				DPARAM0 = inst[1].puint8[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x2, 8, 0):   // DLOAD   dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_LOAD1x2, 8, 0):              // DLOAD   dst,base,index,BYTE_x2
 				DPARAM0 = *(UINT8 *)&inst[1].puint16[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x4, 8, 0):   // DLOAD   dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_LOAD1x4, 8, 0):              // DLOAD   dst,base,index,BYTE_x4
 				DPARAM0 = *(UINT8 *)&inst[1].puint32[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x8, 8, 0):   // DLOAD   dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_LOAD1x8, 8, 0):              // DLOAD   dst,base,index,BYTE_x8
 				DPARAM0 = *(UINT8 *)&inst[1].puint64[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x1, 8, 0):   // DLOAD   dst,base,index,WORD_x1
+			OPCODE_CASE(OP_LOAD2x1, 8, 0):              // DLOAD   dst,base,index,WORD_x1
 				DPARAM0 = *(UINT16 *)&inst[1].puint8[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2, 8, 0):     // DLOAD   dst,base,index,WORD
+			OPCODE_CASE(OP_LOAD2, 8, 0):                // DLOAD   dst,base,index,WORD
 				DPARAM0 = inst[1].puint16[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x4, 8, 0):   // DLOAD   dst,base,index,WORD_x4
+			OPCODE_CASE(OP_LOAD2x4, 8, 0):              // DLOAD   dst,base,index,WORD_x4
 				DPARAM0 = *(UINT16 *)&inst[1].puint32[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x8, 8, 0):   // DLOAD   dst,base,index,WORD_x8
+			OPCODE_CASE(OP_LOAD2x8, 8, 0):              // DLOAD   dst,base,index,WORD_x8
 				DPARAM0 = *(UINT16 *)&inst[1].puint64[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x1, 8, 0):   // DLOAD   dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_LOAD4x1, 8, 0):              // DLOAD   dst,base,index,DWORD_x1
 				DPARAM0 = *(UINT32 *)&inst[1].puint8[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x2, 8, 0):   // DLOAD   dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_LOAD4x2, 8, 0):              // DLOAD   dst,base,index,DWORD_x2
 				DPARAM0 = *(UINT32 *)&inst[1].puint16[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4, 8, 0):     // DLOAD   dst,base,index,DWORD
+			OPCODE_CASE(OP_LOAD4, 8, 0):                // DLOAD   dst,base,index,DWORD
 				DPARAM0 = inst[1].puint32[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x8, 8, 0):   // DLOAD   dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_LOAD4x8, 8, 0):              // DLOAD   dst,base,index,DWORD_x8
 				DPARAM0 = *(UINT32 *)&inst[1].puint64[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD8x1, 8, 0):   // DLOAD   dst,base,index,QWORD_x1
+			OPCODE_CASE(OP_LOAD8x1, 8, 0):              // DLOAD   dst,base,index,QWORD_x1
 				DPARAM0 = *(UINT64 *)&inst[1].puint8[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD8x2, 8, 0):   // DLOAD   dst,base,index,QWORD_x2
+			OPCODE_CASE(OP_LOAD8x2, 8, 0):              // DLOAD   dst,base,index,QWORD_x2
 				DPARAM0 = *(UINT64 *)&inst[1].puint16[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD8x4, 8, 0):   // DLOAD   dst,base,index,QWORD_x4
+			OPCODE_CASE(OP_LOAD8x4, 8, 0):              // DLOAD   dst,base,index,QWORD_x4
 				DPARAM0 = *(UINT64 *)&inst[1].puint32[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD8, 8, 0):     // DLOAD   dst,base,index,QWORD
+			OPCODE_CASE(OP_LOAD8, 8, 0):                // DLOAD   dst,base,index,QWORD
 				DPARAM0 = inst[1].puint64[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1, 8, 0):    // DLOADS  dst,base,index,BYTE
+			OPCODE_CASE(OP_LOADS1, 8, 0):               // DLOADS  dst,base,index,BYTE
 				DPARAM0 = inst[1].pint8[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x2, 8, 0):  // DLOADS  dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_LOADS1x2, 8, 0):             // DLOADS  dst,base,index,BYTE_x2
 				DPARAM0 = *(INT8 *)&inst[1].pint16[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x4, 8, 0):  // DLOADS  dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_LOADS1x4, 8, 0):             // DLOADS  dst,base,index,BYTE_x4
 				DPARAM0 = *(INT8 *)&inst[1].pint32[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x8, 8, 0):  // DLOADS  dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_LOADS1x8, 8, 0):             // DLOADS  dst,base,index,BYTE_x8
 				DPARAM0 = *(INT8 *)&inst[1].pint64[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x1, 8, 0):  // DLOADS  dst,base,index,WORD_x1
+			OPCODE_CASE(OP_LOADS2x1, 8, 0):             // DLOADS  dst,base,index,WORD_x1
 				DPARAM0 = *(INT16 *)&inst[1].pint8[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2, 8, 0):    // DLOADS  dst,base,index,WORD
+			OPCODE_CASE(OP_LOADS2, 8, 0):               // DLOADS  dst,base,index,WORD
 				DPARAM0 = inst[1].pint16[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x4, 8, 0):  // DLOADS  dst,base,index,WORD_x4
+			OPCODE_CASE(OP_LOADS2x4, 8, 0):             // DLOADS  dst,base,index,WORD_x4
 				DPARAM0 = *(INT16 *)&inst[1].pint32[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x8, 8, 0):  // DLOADS  dst,base,index,WORD_x8
+			OPCODE_CASE(OP_LOADS2x8, 8, 0):             // DLOADS  dst,base,index,WORD_x8
 				DPARAM0 = *(INT16 *)&inst[1].pint64[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x1, 8, 0):  // DLOADS  dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_LOADS4x1, 8, 0):             // DLOADS  dst,base,index,DWORD_x1
 				DPARAM0 = *(INT32 *)&inst[1].pint8[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x2, 8, 0):  // DLOADS  dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_LOADS4x2, 8, 0):             // DLOADS  dst,base,index,DWORD_x2
 				DPARAM0 = *(INT32 *)&inst[1].pint16[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4, 8, 0):    // DLOADS  dst,base,index,DWORD
+			OPCODE_CASE(OP_LOADS4, 8, 0):               // DLOADS  dst,base,index,DWORD
 				DPARAM0 = inst[1].pint32[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x8, 8, 0):  // DLOADS  dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_LOADS4x8, 8, 0):             // DLOADS  dst,base,index,DWORD_x8
 				DPARAM0 = *(INT32 *)&inst[1].pint64[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS8x1, 8, 0):  // DLOADS  dst,base,index,QWORD_x1
+			OPCODE_CASE(OP_LOADS8x1, 8, 0):             // DLOADS  dst,base,index,QWORD_x1
 				DPARAM0 = *(INT64 *)&inst[1].pint8[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS8x2, 8, 0):  // DLOADS  dst,base,index,QWORD_x2
+			OPCODE_CASE(OP_LOADS8x2, 8, 0):             // DLOADS  dst,base,index,QWORD_x2
 				DPARAM0 = *(INT64 *)&inst[1].pint16[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS8x4, 8, 0):  // DLOADS  dst,base,index,QWORD_x4
+			OPCODE_CASE(OP_LOADS8x4, 8, 0):             // DLOADS  dst,base,index,QWORD_x4
 				DPARAM0 = *(INT64 *)&inst[1].pint32[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS8, 8, 0):    // DLOADS  dst,base,index,QWORD
+			OPCODE_CASE(OP_LOADS8, 8, 0):               // DLOADS  dst,base,index,QWORD
 				DPARAM0 = inst[1].pint64[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1, 8, 0):    // DSTORE  dst,base,index,BYTE
+			OPCODE_CASE(OP_STORE1, 8, 0):               // DSTORE  dst,base,index,BYTE
 				inst[0].puint8[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x2, 8, 0):  // DSTORE  dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_STORE1x2, 8, 0):             // DSTORE  dst,base,index,BYTE_x2
 				*(UINT8 *)&inst[0].puint16[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x4, 8, 0):  // DSTORE  dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_STORE1x4, 8, 0):             // DSTORE  dst,base,index,BYTE_x4
 				*(UINT8 *)&inst[0].puint32[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x8, 8, 0):  // DSTORE  dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_STORE1x8, 8, 0):             // DSTORE  dst,base,index,BYTE_x8
 				*(UINT8 *)&inst[0].puint64[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x1, 8, 0):  // DSTORE  dst,base,index,WORD_x1
+			OPCODE_CASE(OP_STORE2x1, 8, 0):             // DSTORE  dst,base,index,WORD_x1
 				*(UINT16 *)&inst[0].puint8[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2, 8, 0):    // DSTORE  dst,base,index,WORD
+			OPCODE_CASE(OP_STORE2, 8, 0):               // DSTORE  dst,base,index,WORD
 				inst[0].puint16[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x4, 8, 0):  // DSTORE  dst,base,index,WORD_x4
+			OPCODE_CASE(OP_STORE2x4, 8, 0):             // DSTORE  dst,base,index,WORD_x4
 				*(UINT16 *)&inst[0].puint32[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x8, 8, 0):  // DSTORE  dst,base,index,WORD_x8
+			OPCODE_CASE(OP_STORE2x8, 8, 0):             // DSTORE  dst,base,index,WORD_x8
 				*(UINT16 *)&inst[0].puint64[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x1, 8, 0):  // DSTORE  dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_STORE4x1, 8, 0):             // DSTORE  dst,base,index,DWORD_x1
 				*(UINT32 *)&inst[0].puint8[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x2, 8, 0):  // DSTORE  dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_STORE4x2, 8, 0):             // DSTORE  dst,base,index,DWORD_x2
 				*(UINT32 *)&inst[0].puint16[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4, 8, 0):    // DSTORE  dst,base,index,DWORD
+			OPCODE_CASE(OP_STORE4, 8, 0):               // DSTORE  dst,base,index,DWORD
 				inst[0].puint32[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x8, 8, 0):  // DSTORE  dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_STORE4x8, 8, 0):             // DSTORE  dst,base,index,DWORD_x8
 				*(UINT32 *)&inst[0].puint64[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE8x1, 8, 0):  // DSTORE  dst,base,index,QWORD_x1
+			OPCODE_CASE(OP_STORE8x1, 8, 0):             // DSTORE  dst,base,index,QWORD_x1
 				*(UINT64 *)&inst[0].puint8[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE8x2, 8, 0):  // DSTORE  dst,base,index,QWORD_x2
+			OPCODE_CASE(OP_STORE8x2, 8, 0):             // DSTORE  dst,base,index,QWORD_x2
 				*(UINT64 *)&inst[0].puint16[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE8x4, 8, 0):  // DSTORE  dst,base,index,QWORD_x4
+			OPCODE_CASE(OP_STORE8x4, 8, 0):             // DSTORE  dst,base,index,QWORD_x4
 				*(UINT64 *)&inst[0].puint32[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_STORE8, 8, 0):    // DSTORE  dst,base,index,QWORD
+			OPCODE_CASE(OP_STORE8, 8, 0):               // DSTORE  dst,base,index,QWORD
 				inst[0].puint64[PARAM1] = DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_READ1, 8, 0):     // DREAD   dst,src1,space_BYTE
+			OPCODE_CASE(OP_READ1, 8, 0):                // DREAD   dst,src1,space_BYTE
 				DPARAM0 = m_space[PARAM2]->read_byte(PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_READ2, 8, 0):     // DREAD   dst,src1,space_WORD
+			OPCODE_CASE(OP_READ2, 8, 0):                // DREAD   dst,src1,space_WORD
 				DPARAM0 = m_space[PARAM2]->read_word(PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_READ4, 8, 0):     // DREAD   dst,src1,space_DWORD
+			OPCODE_CASE(OP_READ4, 8, 0):                // DREAD   dst,src1,space_DWORD
 				DPARAM0 = m_space[PARAM2]->read_dword(PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_READ8, 8, 0):     // DREAD   dst,src1,space_QOWRD
+			OPCODE_CASE(OP_READ8, 8, 0):                // DREAD   dst,src1,space_QOWRD
 				DPARAM0 = m_space[PARAM2]->read_qword(PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_READM2, 8, 0):    // DREADM  dst,src1,mask,space_WORD
+			OPCODE_CASE(OP_READM2, 8, 0):               // DREADM  dst,src1,mask,space_WORD
 				DPARAM0 = m_space[PARAM3]->read_word(PARAM1, PARAM2);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_READM4, 8, 0):    // DREADM  dst,src1,mask,space_DWORD
+			OPCODE_CASE(OP_READM4, 8, 0):               // DREADM  dst,src1,mask,space_DWORD
 				DPARAM0 = m_space[PARAM3]->read_dword(PARAM1, PARAM2);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_READM8, 8, 0):    // DREADM  dst,src1,mask,space_QWORD
+			OPCODE_CASE(OP_READM8, 8, 0):               // DREADM  dst,src1,mask,space_QWORD
 				DPARAM0 = m_space[PARAM3]->read_qword(PARAM1, PARAM2);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE1, 8, 0):    // DWRITE  dst,src1,space_BYTE
+			OPCODE_CASE(OP_WRITE1, 8, 0):               // DWRITE  dst,src1,space_BYTE
 				m_space[PARAM2]->write_byte(PARAM0, PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE2, 8, 0):    // DWRITE  dst,src1,space_WORD
+			OPCODE_CASE(OP_WRITE2, 8, 0):               // DWRITE  dst,src1,space_WORD
 				m_space[PARAM2]->write_word(PARAM0, PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE4, 8, 0):    // DWRITE  dst,src1,space_DWORD
+			OPCODE_CASE(OP_WRITE4, 8, 0):               // DWRITE  dst,src1,space_DWORD
 				m_space[PARAM2]->write_dword(PARAM0, PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE8, 8, 0):    // DWRITE  dst,src1,space_QWORD
+			OPCODE_CASE(OP_WRITE8, 8, 0):               // DWRITE  dst,src1,space_QWORD
 				m_space[PARAM2]->write_qword(PARAM0, DPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_WRITEM2, 8, 0):   // DWRITEM dst,src1,mask,space_WORD
+			OPCODE_CASE(OP_WRITEM2, 8, 0):              // DWRITEM dst,src1,mask,space_WORD
 				m_space[PARAM3]->write_word(PARAM0, DPARAM1, DPARAM2);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_WRITEM4, 8, 0):   // DWRITEM dst,src1,mask,space_DWORD
+			OPCODE_CASE(OP_WRITEM4, 8, 0):              // DWRITEM dst,src1,mask,space_DWORD
 				m_space[PARAM3]->write_dword(PARAM0, DPARAM1, DPARAM2);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_WRITEM8, 8, 0):   // DWRITEM dst,src1,mask,space_QWORD
+			OPCODE_CASE(OP_WRITEM8, 8, 0):              // DWRITEM dst,src1,mask,space_QWORD
 				m_space[PARAM3]->write_qword(PARAM0, DPARAM1, DPARAM2);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_CARRY, 8, 0):     // DCARRY  src,bitnum
+			OPCODE_CASE(OP_CARRY, 8, 0):                // DCARRY  src,bitnum
 				flags = (flags & ~FLAG_C) | ((DPARAM0 >> (DPARAM1 & 63)) & FLAG_C);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_MOV, 8, 1):       // DMOV    dst,src[,c]
+			OPCODE_CASE(OP_MOV, 8, 1):                  // DMOV    dst,src[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
-					break;
+					OPCODE_NEXT;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_MOV, 8, 0):
+			OPCODE_CASE(OP_MOV, 8, 0):
 				DPARAM0 = DPARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SET, 8, 1):       // DSET    dst,c
+			OPCODE_CASE(OP_SET, 8, 1):                  // DSET    dst,c
 				DPARAM0 = OPCODE_FAIL_CONDITION(opcode, flags) ? 0 : 1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT1, 8, 0):     // DSEXT   dst,src,BYTE
+			OPCODE_CASE(OP_SEXT1, 8, 0):                // DSEXT   dst,src,BYTE
 				DPARAM0 = (INT8)PARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT1, 8, 1):
+			OPCODE_CASE(OP_SEXT1, 8, 1):
 				temp64 = (INT8)PARAM1;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT2, 8, 0):     // DSEXT   dst,src,WORD
+			OPCODE_CASE(OP_SEXT2, 8, 0):                // DSEXT   dst,src,WORD
 				DPARAM0 = (INT16)PARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT2, 8, 1):
+			OPCODE_CASE(OP_SEXT2, 8, 1):
 				temp64 = (INT16)PARAM1;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT4, 8, 0):     // DSEXT   dst,src,DWORD
+			OPCODE_CASE(OP_SEXT4, 8, 0):                // DSEXT   dst,src,DWORD
 				DPARAM0 = (INT32)PARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT4, 8, 1):
+			OPCODE_CASE(OP_SEXT4, 8, 1):
 				temp64 = (INT32)PARAM1;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROLAND, 8, 0):    // DROLAND dst,src,count,mask[,f]
+			OPCODE_CASE(OP_ROLAND, 8, 0):               // DROLAND dst,src,count,mask[,f]
 				shift = DPARAM2 & 63;
 				DPARAM0 = ((DPARAM1 << shift) | (DPARAM1 >> (64 - shift))) & DPARAM3;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROLAND, 8, 1):
+			OPCODE_CASE(OP_ROLAND, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = ((DPARAM1 << shift) | (DPARAM1 >> (64 - shift))) & DPARAM3;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROLINS, 8, 0):    // DROLINS dst,src,count,mask[,f]
+			OPCODE_CASE(OP_ROLINS, 8, 0):               // DROLINS dst,src,count,mask[,f]
 				shift = DPARAM2 & 63;
 				DPARAM0 = (DPARAM0 & ~DPARAM3) | (((DPARAM1 << shift) | (DPARAM1 >> (64 - shift))) & DPARAM3);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROLINS, 8, 1):
+			OPCODE_CASE(OP_ROLINS, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = (DPARAM0 & ~DPARAM3) | (((DPARAM1 << shift) | (DPARAM1 >> (64 - shift))) & DPARAM3);
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ADD, 8, 0):       // DADD    dst,src1,src2[,f]
+			OPCODE_CASE(OP_ADD, 8, 0):                  // DADD    dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 + DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ADD, 8, 1):
+			OPCODE_CASE(OP_ADD, 8, 1):
 				temp64 = DPARAM1 + DPARAM2;
 				flags = FLAGS64_NZCV_ADD(temp64, DPARAM1, DPARAM2);
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ADDC, 8, 0):      // DADDC   dst,src1,src2[,f]
+			OPCODE_CASE(OP_ADDC, 8, 0):                 // DADDC   dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 + DPARAM2 + (flags & FLAG_C);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ADDC, 8, 1):
+			OPCODE_CASE(OP_ADDC, 8, 1):
 				temp64 = DPARAM1 + DPARAM2 + (flags & FLAG_C);
 				if (DPARAM2 + 1 != 0)
 					flags = FLAGS64_NZCV_ADD(temp64, DPARAM1, DPARAM2 + (flags & FLAG_C));
 				else
 					flags = FLAGS64_NZCV_ADD(temp64, DPARAM1 + (flags & FLAG_C), DPARAM2);
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SUB, 8, 0):       // DSUB    dst,src1,src2[,f]
+			OPCODE_CASE(OP_SUB, 8, 0):                  // DSUB    dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 - DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SUB, 8, 1):
+			OPCODE_CASE(OP_SUB, 8, 1):
 				temp64 = DPARAM1 - DPARAM2;
 				flags = FLAGS64_NZCV_SUB(temp64, DPARAM1, DPARAM2);
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SUBB, 8, 0):      // DSUBB   dst,src1,src2[,f]
+			OPCODE_CASE(OP_SUBB, 8, 0):                 // DSUBB   dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 - DPARAM2 - (flags & FLAG_C);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SUBB, 8, 1):
+			OPCODE_CASE(OP_SUBB, 8, 1):
 				temp64 = DPARAM1 - DPARAM2 - (flags & FLAG_C);
 				if (DPARAM2 + 1 != 0)
 					flags = FLAGS64_NZCV_SUB(temp64, DPARAM1, DPARAM2 + (flags & FLAG_C));
 				else
 					flags = FLAGS64_NZCV_SUB(temp64, DPARAM1 - (flags & FLAG_C), DPARAM2);
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_CMP, 8, 1):       // DCMP    src1,src2[,f]
+			OPCODE_CASE(OP_CMP, 8, 1):                  // DCMP    src1,src2[,f]
 				temp64 = DPARAM0 - DPARAM1;
 				flags = FLAGS64_NZCV_SUB(temp64, DPARAM0, DPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_MULU, 8, 0):      // DMULU   dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_MULU, 8, 0):                 // DMULU   dst,edst,src1,src2[,f]
 				dmulu(*inst[0].puint64, *inst[1].puint64, DPARAM2, DPARAM3, FALSE);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_MULU, 8, 1):
+			OPCODE_CASE(OP_MULU, 8, 1):
 				flags = dmulu(*inst[0].puint64, *inst[1].puint64, DPARAM2, DPARAM3, TRUE);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_MULS, 8, 0):      // DMULS   dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_MULS, 8, 0):                 // DMULS   dst,edst,src1,src2[,f]
 				dmuls(*inst[0].puint64, *inst[1].puint64, DPARAM2, DPARAM3, FALSE);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_MULS, 8, 1):
+			OPCODE_CASE(OP_MULS, 8, 1):
 				flags = dmuls(*inst[0].puint64, *inst[1].puint64, DPARAM2, DPARAM3, TRUE);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_DIVU, 8, 0):      // DDIVU   dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_DIVU, 8, 0):                 // DDIVU   dst,edst,src1,src2[,f]
 				if (DPARAM3 != 0)
 				{
 					temp64 = (UINT64)DPARAM2 / (UINT64)DPARAM3;
 					DPARAM1 = (UINT64)DPARAM2 % (UINT64)DPARAM3;
 					DPARAM0 = temp64;
 				}
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_DIVU, 8, 1):
+			OPCODE_CASE(OP_DIVU, 8, 1):
 				if (DPARAM3 != 0)
 				{
 					temp64 = (UINT64)DPARAM2 / (UINT64)DPARAM3;
@@ -1615,18 +1705,18 @@ int drcbe_c::execute(code_handle &entry)
 				}
 				else
 					flags = FLAG_V;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_DIVS, 8, 0):      // DDIVS   dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_DIVS, 8, 0):                 // DDIVS   dst,edst,src1,src2[,f]
 				if (DPARAM3 != 0)
 				{
 					temp64 = (INT64)DPARAM2 / (INT64)DPARAM3;
 					DPARAM1 = (INT64)DPARAM2 % (INT64)DPARAM3;
 					DPARAM0 = temp64;
 				}
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_DIVS, 8, 1):
+			OPCODE_CASE(OP_DIVS, 8, 1):
 				if (DPARAM3 != 0)
 				{
 					temp64 = (INT64)DPARAM2 / (INT64)DPARAM3;
@@ -1636,138 +1726,138 @@ int drcbe_c::execute(code_handle &entry)
 				}
 				else
 					flags = FLAG_V;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_AND, 8, 0):       // DAND    dst,src1,src2[,f]
+			OPCODE_CASE(OP_AND, 8, 0):                  // DAND    dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 & DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_AND, 8, 1):
+			OPCODE_CASE(OP_AND, 8, 1):
 				temp64 = DPARAM1 & DPARAM2;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_TEST, 8, 1):      // DTEST   src1,src2[,f]
+			OPCODE_CASE(OP_TEST, 8, 1):                 // DTEST   src1,src2[,f]
 				temp64 = DPARAM1 & DPARAM2;
 				flags = FLAGS64_NZ(temp64);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_OR, 8, 0):        // DOR     dst,src1,src2[,f]
+			OPCODE_CASE(OP_OR, 8, 0):                   // DOR     dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 | DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_OR, 8, 1):
+			OPCODE_CASE(OP_OR, 8, 1):
 				temp64 = DPARAM1 | DPARAM2;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_XOR, 8, 0):       // DXOR    dst,src1,src2[,f]
+			OPCODE_CASE(OP_XOR, 8, 0):                  // DXOR    dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 ^ DPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_XOR, 8, 1):
+			OPCODE_CASE(OP_XOR, 8, 1):
 				temp64 = DPARAM1 ^ DPARAM2;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LZCNT, 8, 0):     // DLZCNT  dst,src
+			OPCODE_CASE(OP_LZCNT, 8, 0):                // DLZCNT  dst,src
 				if ((UINT32)(DPARAM1 >> 32) != 0)
 					DPARAM0 = count_leading_zeros(DPARAM1 >> 32);
 				else
 					DPARAM0 = 32 + count_leading_zeros(DPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_LZCNT, 8, 1):
+			OPCODE_CASE(OP_LZCNT, 8, 1):
 				if ((UINT32)(DPARAM1 >> 32) != 0)
 					temp64 = count_leading_zeros(DPARAM1 >> 32);
 				else
 					temp64 = 32 + count_leading_zeros(DPARAM1);
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_TZCNT, 8, 0):     // DTZCNT  dst,src
+			OPCODE_CASE(OP_TZCNT, 8, 0):                // DTZCNT  dst,src
 				DPARAM0 = tzcount64(DPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_TZCNT, 8, 1):
+			OPCODE_CASE(OP_TZCNT, 8, 1):
 				temp64 = tzcount64(DPARAM1);
 				flags = (temp64 == 64) ? FLAG_Z : 0;
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_BSWAP, 8, 0):     // DBSWAP  dst,src
+			OPCODE_CASE(OP_BSWAP, 8, 0):                // DBSWAP  dst,src
 				temp64 = DPARAM1;
 				DPARAM0 = flipendian_int64(temp64);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_BSWAP, 8, 1):
+			OPCODE_CASE(OP_BSWAP, 8, 1):
 				temp64 = DPARAM1;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = flipendian_int64(temp64);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SHL, 8, 0):       // DSHL    dst,src,count[,f]
+			OPCODE_CASE(OP_SHL, 8, 0):                  // DSHL    dst,src,count[,f]
 				DPARAM0 = DPARAM1 << (DPARAM2 & 63);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SHL, 8, 1):
+			OPCODE_CASE(OP_SHL, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = DPARAM1 << shift;
 				flags = FLAGS64_NZ(temp64);
 				if (shift != 0) flags |= ((DPARAM1 << (shift - 1)) >> 63) & FLAG_C;
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SHR, 8, 0):       // DSHR    dst,src,count[,f]
+			OPCODE_CASE(OP_SHR, 8, 0):                  // DSHR    dst,src,count[,f]
 				DPARAM0 = DPARAM1 >> (DPARAM2 & 63);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SHR, 8, 1):
+			OPCODE_CASE(OP_SHR, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = DPARAM1 >> shift;
 				flags = FLAGS64_NZ(temp64);
 				if (shift != 0) flags |= (DPARAM1 >> (shift - 1)) & FLAG_C;
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SAR, 8, 0):       // DSAR    dst,src,count[,f]
+			OPCODE_CASE(OP_SAR, 8, 0):                  // DSAR    dst,src,count[,f]
 				DPARAM0 = (INT64)DPARAM1 >> (DPARAM2 & 63);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_SAR, 8, 1):
+			OPCODE_CASE(OP_SAR, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = (INT32)DPARAM1 >> shift;
 				flags = FLAGS64_NZ(temp64);
 				if (shift != 0) flags |= (DPARAM1 >> (shift - 1)) & FLAG_C;
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROL, 8, 0):       // DROL    dst,src,count[,f]
+			OPCODE_CASE(OP_ROL, 8, 0):                  // DROL    dst,src,count[,f]
 				shift = DPARAM2 & 31;
 				DPARAM0 = (DPARAM1 << shift) | (DPARAM1 >> ((64 - shift) & 63));
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROL, 8, 1):
+			OPCODE_CASE(OP_ROL, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = (DPARAM1 << shift) | (DPARAM1 >> ((64 - shift) & 63));
 				flags = FLAGS64_NZ(temp64);
 				if (shift != 0) flags |= ((DPARAM1 << (shift - 1)) >> 63) & FLAG_C;
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROLC, 8, 0):      // DROLC   dst,src,count[,f]
+			OPCODE_CASE(OP_ROLC, 8, 0):                 // DROLC   dst,src,count[,f]
 				shift = DPARAM2 & 63;
 				if (shift > 1)
 					DPARAM0 = (DPARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
 				else if (shift == 1)
 					DPARAM0 = (DPARAM1 << shift) | (flags & FLAG_C);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROLC, 8, 1):
+			OPCODE_CASE(OP_ROLC, 8, 1):
 				shift = DPARAM2 & 63;
 				if (shift > 1)
 					temp64 = (DPARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
@@ -1778,30 +1868,30 @@ int drcbe_c::execute(code_handle &entry)
 				flags = FLAGS64_NZ(temp64);
 				if (shift != 0) flags |= ((DPARAM1 << (shift - 1)) >> 63) & FLAG_C;
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROR, 8, 0):       // DROR    dst,src,count[,f]
+			OPCODE_CASE(OP_ROR, 8, 0):                  // DROR    dst,src,count[,f]
 				shift = DPARAM2 & 63;
 				DPARAM0 = (DPARAM1 >> shift) | (DPARAM1 << ((64 - shift) & 63));
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ROR, 8, 1):
+			OPCODE_CASE(OP_ROR, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = (DPARAM1 >> shift) | (DPARAM1 << ((64 - shift) & 63));
 				flags = FLAGS64_NZ(temp64);
 				if (shift != 0) flags |= (DPARAM1 >> (shift - 1)) & FLAG_C;
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_RORC, 8, 0):      // DRORC   dst,src,count[,f]
+			OPCODE_CASE(OP_RORC, 8, 0):                 // DRORC   dst,src,count[,f]
 				shift = DPARAM2 & 63;
 				if (shift > 1)
 					DPARAM0 = (DPARAM1 >> shift) | ((((UINT64)flags & FLAG_C) << 63) >> (shift - 1)) | (DPARAM1 << (65 - shift));
 				else if (shift == 1)
 					DPARAM0 = (DPARAM1 >> shift) | (((UINT64)flags & FLAG_C) << 63);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_RORC, 8, 1):
+			OPCODE_CASE(OP_RORC, 8, 1):
 				shift = DPARAM2 & 63;
 				if (shift > 1)
 					temp64 = (DPARAM1 >> shift) | ((((UINT64)flags & FLAG_C) << 63) >> (shift - 1)) | (DPARAM1 << (65 - shift));
@@ -1812,299 +1902,355 @@ int drcbe_c::execute(code_handle &entry)
 				flags = FLAGS64_NZ(temp64);
 				if (shift != 0) flags |= (DPARAM1 >> (shift - 1)) & FLAG_C;
 				DPARAM0 = temp64;
-				break;
+				OPCODE_NEXT;
 
 
 			// ----------------------- 32-Bit Floating Point Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_FLOAD, 4, 0):     // FSLOAD  dst,base,index
+			OPCODE_CASE(OP_FLOAD, 4, 0):                // FSLOAD  dst,base,index
 				FSPARAM0 = inst[1].pfloat[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FSTORE, 4, 0):    // FSSTORE dst,base,index
+			OPCODE_CASE(OP_FSTORE, 4, 0):               // FSSTORE dst,base,index
 				inst[0].pfloat[PARAM1] = FSPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FREAD, 4, 0):     // FSREAD  dst,src1,space
+			OPCODE_CASE(OP_FREAD, 4, 0):                // FSREAD  dst,src1,space
 				PARAM0 = m_space[PARAM2]->read_dword(PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FWRITE, 4, 0):    // FSWRITE dst,src1,space
+			OPCODE_CASE(OP_FWRITE, 4, 0):               // FSWRITE dst,src1,space
 				m_space[PARAM2]->write_dword(PARAM0, PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FMOV, 4, 1):      // FSMOV   dst,src[,c]
+			OPCODE_CASE(OP_FMOV, 4, 1):                 // FSMOV   dst,src[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
-					break;
+					OPCODE_NEXT;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_FMOV, 4, 0):
+			OPCODE_CASE(OP_FMOV, 4, 0):
 				FSPARAM0 = FSPARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4T, 4, 0):    // FSTOI4T dst,src1
+			OPCODE_CASE(OP_FTOI4T, 4, 0):               // FSTOI4T dst,src1
 				if (FSPARAM1 >= 0)
 					*inst[0].pint32 = floor(FSPARAM1);
 				else
 					*inst[0].pint32 = ceil(FSPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4R, 4, 0):    // FSTOI4R dst,src1
+			OPCODE_CASE(OP_FTOI4R, 4, 0):               // FSTOI4R dst,src1
 				if (FSPARAM1 >= 0)
 					*inst[0].pint32 = floor(FSPARAM1 + 0.5f);
 				else
 					*inst[0].pint32 = ceil(FSPARAM1 - 0.5f);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4F, 4, 0):    // FSTOI4F dst,src1
+			OPCODE_CASE(OP_FTOI4F, 4, 0):               // FSTOI4F dst,src1
 				*inst[0].pint32 = floor(FSPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4C, 4, 0):    // FSTOI4C dst,src1
+			OPCODE_CASE(OP_FTOI4C, 4, 0):               // FSTOI4C dst,src1
 				*inst[0].pint32 = ceil(FSPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4, 4, 0):     // FSTOI4  dst,src1
+			OPCODE_CASE(OP_FTOI4, 4, 0):                // FSTOI4  dst,src1
 				*inst[0].pint32 = FSPARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8T, 4, 0):    // FSTOI8T dst,src1
+			OPCODE_CASE(OP_FTOI8T, 4, 0):               // FSTOI8T dst,src1
 				if (FSPARAM1 >= 0)
 					*inst[0].pint64 = floor(FSPARAM1);
 				else
 					*inst[0].pint64 = ceil(FSPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8R, 4, 0):    // FSTOI8R dst,src1
+			OPCODE_CASE(OP_FTOI8R, 4, 0):               // FSTOI8R dst,src1
 				if (FSPARAM1 >= 0)
 					*inst[0].pint64 = floor(FSPARAM1 + 0.5f);
 				else
 					*inst[0].pint64 = ceil(FSPARAM1 - 0.5f);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8F, 4, 0):    // FSTOI8F dst,src1
+			OPCODE_CASE(OP_FTOI8F, 4, 0):               // FSTOI8F dst,src1
 				*inst[0].pint64 = floor(FSPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8C, 4, 0):    // FSTOI8C dst,src1
+			OPCODE_CASE(OP_FTOI8C, 4, 0):               // FSTOI8C dst,src1
 				*inst[0].pint64 = ceil(FSPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8, 4, 0):     // FSTOI8  dst,src1
+			OPCODE_CASE(OP_FTOI8, 4, 0):                // FSTOI8  dst,src1
 				*inst[0].pint64 = FSPARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FFRI4, 4, 0):     // FSFRI4  dst,src1
+			OPCODE_CASE(OP_FFRI4, 4, 0):                // FSFRI4  dst,src1
 				FSPARAM0 = *inst[1].pint32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FFRI8, 4, 0):     // FSFRI8  dst,src1
+			OPCODE_CASE(OP_FFRI8, 4, 0):                // FSFRI8  dst,src1
 				FSPARAM0 = *inst[1].pint64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FFRFD, 4, 0):     // FSFRFD  dst,src1
+			OPCODE_CASE(OP_FFRFD, 4, 0):                // FSFRFD  dst,src1
 				FSPARAM0 = FDPARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FADD, 4, 0):      // FSADD   dst,src1,src2
+			OPCODE_CASE(OP_FADD, 4, 0):                 // FSADD   dst,src1,src2
 				FSPARAM0 = FSPARAM1 + FSPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FSUB, 4, 0):      // FSSUB   dst,src1,src2
+			OPCODE_CASE(OP_FSUB, 4, 0):                 // FSSUB   dst,src1,src2
 				FSPARAM0 = FSPARAM1 - FSPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FCMP, 4, 1):      // FSCMP   src1,src2
+			OPCODE_CASE(OP_FCMP, 4, 1):                 // FSCMP   src1,src2
 				if (std::isnan(FSPARAM0) || std::isnan(FSPARAM1))
 					flags = FLAG_U;
 				else
 					flags = (FSPARAM0 < FSPARAM1) | ((FSPARAM0 == FSPARAM1) << 2);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FMUL, 4, 0):      // FSMUL   dst,src1,src2
+			OPCODE_CASE(OP_FMUL, 4, 0):                 // FSMUL   dst,src1,src2
 				FSPARAM0 = FSPARAM1 * FSPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FDIV, 4, 0):      // FSDIV   dst,src1,src2
+			OPCODE_CASE(OP_FDIV, 4, 0):                 // FSDIV   dst,src1,src2
 				FSPARAM0 = FSPARAM1 / FSPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FNEG, 4, 0):      // FSNEG   dst,src1
+			OPCODE_CASE(OP_FNEG, 4, 0):                 // FSNEG   dst,src1
 				FSPARAM0 = -FSPARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FABS, 4, 0):      // FSABS   dst,src1
+			OPCODE_CASE(OP_FABS, 4, 0):                 // FSABS   dst,src1
 				FSPARAM0 = fabs(FSPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FSQRT, 4, 0):     // FSSQRT  dst,src1
+			OPCODE_CASE(OP_FSQRT, 4, 0):                // FSSQRT  dst,src1
 				FSPARAM0 = sqrt(FSPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FRECIP, 4, 0):    // FSRECIP dst,src1
+			OPCODE_CASE(OP_FRECIP, 4, 0):               // FSRECIP dst,src1
 				FSPARAM0 = 1.0f / FSPARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FRSQRT, 4, 0):    // FSRSQRT dst,src1
+			OPCODE_CASE(OP_FRSQRT, 4, 0):               // FSRSQRT dst,src1
 				FSPARAM0 = 1.0f / sqrtf(FSPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FCOPYI, 4, 0):    // FSCOPYI dst,src
+			OPCODE_CASE(OP_FCOPYI, 4, 0):               // FSCOPYI dst,src
 				FSPARAM0 = u2f(*inst[1].pint32);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ICOPYF, 4, 0):    // ICOPYFS dst,src
+			OPCODE_CASE(OP_ICOPYF, 4, 0):               // ICOPYFS dst,src
 				*inst[0].pint32 = f2u(FSPARAM1);
-				break;
+				OPCODE_NEXT;
 
 
 			// ----------------------- 64-Bit Floating Point Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_FLOAD, 8, 0):     // FDLOAD  dst,base,index
+			OPCODE_CASE(OP_FLOAD, 8, 0):                // FDLOAD  dst,base,index
 				FDPARAM0 = inst[1].pdouble[PARAM2];
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FSTORE, 8, 0):    // FDSTORE dst,base,index
+			OPCODE_CASE(OP_FSTORE, 8, 0):               // FDSTORE dst,base,index
 				inst[0].pdouble[PARAM1] = FDPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FREAD, 8, 0):     // FDREAD  dst,src1,space
+			OPCODE_CASE(OP_FREAD, 8, 0):                // FDREAD  dst,src1,space
 				DPARAM0 = m_space[PARAM2]->read_qword(PARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FWRITE, 8, 0):    // FDWRITE dst,src1,space
+			OPCODE_CASE(OP_FWRITE, 8, 0):               // FDWRITE dst,src1,space
 				m_space[PARAM2]->write_qword(PARAM0, DPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FMOV, 8, 1):      // FDMOV   dst,src[,c]
+			OPCODE_CASE(OP_FMOV, 8, 1):                 // FDMOV   dst,src[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
-					break;
+					OPCODE_NEXT;
 				// fall through...
 
-			case MAKE_OPCODE_SHORT(OP_FMOV, 8, 0):
+			OPCODE_CASE(OP_FMOV, 8, 0):
 				FDPARAM0 = FDPARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4T, 8, 0):    // FDTOI4T dst,src1
+			OPCODE_CASE(OP_FTOI4T, 8, 0):               // FDTOI4T dst,src1
 				if (FDPARAM1 >= 0)
 					*inst[0].pint32 = floor(FDPARAM1);
 				else
 					*inst[0].pint32 = ceil(FDPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4R, 8, 0):    // FDTOI4R dst,src1
+			OPCODE_CASE(OP_FTOI4R, 8, 0):               // FDTOI4R dst,src1
 				if (FDPARAM1 >= 0)
 					*inst[0].pint32 = floor(FDPARAM1 + 0.5);
 				else
 					*inst[0].pint32 = ceil(FDPARAM1 - 0.5);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4F, 8, 0):    // FDTOI4F dst,src1
+			OPCODE_CASE(OP_FTOI4F, 8, 0):               // FDTOI4F dst,src1
 				*inst[0].pint32 = floor(FDPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4C, 8, 0):    // FDTOI4C dst,src1
+			OPCODE_CASE(OP_FTOI4C, 8, 0):               // FDTOI4C dst,src1
 				*inst[0].pint32 = ceil(FDPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4, 8, 0):     // FDTOI4  dst,src1
+			OPCODE_CASE(OP_FTOI4, 8, 0):                // FDTOI4  dst,src1
 				*inst[0].pint32 = FDPARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8T, 8, 0):    // FDTOI8T dst,src1
+			OPCODE_CASE(OP_FTOI8T, 8, 0):               // FDTOI8T dst,src1
 				if (FDPARAM1 >= 0)
 					*inst[0].pint64 = floor(FDPARAM1);
 				else
 					*inst[0].pint64 = ceil(FDPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8R, 8, 0):    // FDTOI8R  dst,src1
+			OPCODE_CASE(OP_FTOI8R, 8, 0):               // FDTOI8R  dst,src1
 				if (FDPARAM1 >= 0)
 					*inst[0].pint64 = floor(FDPARAM1 + 0.5);
 				else
 					*inst[0].pint64 = ceil(FDPARAM1 - 0.5);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8F, 8, 0):    // FDTOI8F dst,src1
+			OPCODE_CASE(OP_FTOI8F, 8, 0):               // FDTOI8F dst,src1
 				*inst[0].pint64 = floor(FDPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8C, 8, 0):    // FDTOI8C dst,src1
+			OPCODE_CASE(OP_FTOI8C, 8, 0):               // FDTOI8C dst,src1
 				*inst[0].pint64 = ceil(FDPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8, 8, 0):     // FDTOI8  dst,src1
+			OPCODE_CASE(OP_FTOI8, 8, 0):                // FDTOI8  dst,src1
 				*inst[0].pint64 = FDPARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FFRI4, 8, 0):     // FDFRI4  dst,src1
+			OPCODE_CASE(OP_FFRI4, 8, 0):                // FDFRI4  dst,src1
 				FDPARAM0 = *inst[1].pint32;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FFRI8, 8, 0):     // FDFRI8  dst,src1
+			OPCODE_CASE(OP_FFRI8, 8, 0):                // FDFRI8  dst,src1
 				FDPARAM0 = *inst[1].pint64;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FFRFS, 8, 0):     // FDFRFS  dst,src1
+			OPCODE_CASE(OP_FFRFS, 8, 0):                // FDFRFS  dst,src1
 				FDPARAM0 = FSPARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FRNDS, 8, 0):     // FDRNDS  dst,src1
+			OPCODE_CASE(OP_FRNDS, 8, 0):                // FDRNDS  dst,src1
 				FDPARAM0 = (float)FDPARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FADD, 8, 0):      // FDADD   dst,src1,src2
+			OPCODE_CASE(OP_FADD, 8, 0):                 // FDADD   dst,src1,src2
 				FDPARAM0 = FDPARAM1 + FDPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FSUB, 8, 0):      // FDSUB   dst,src1,src2
+			OPCODE_CASE(OP_FSUB, 8, 0):                 // FDSUB   dst,src1,src2
 				FDPARAM0 = FDPARAM1 - FDPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FCMP, 8, 1):      // FDCMP   src1,src2
+			OPCODE_CASE(OP_FCMP, 8, 1):                 // FDCMP   src1,src2
 				if (std::isnan(FDPARAM0) || std::isnan(FDPARAM1))
 					flags = FLAG_U;
 				else
 					flags = (FDPARAM0 < FDPARAM1) | ((FDPARAM0 == FDPARAM1) << 2);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FMUL, 8, 0):      // FDMUL   dst,src1,src2
+			OPCODE_CASE(OP_FMUL, 8, 0):                 // FDMUL   dst,src1,src2
 				FDPARAM0 = FDPARAM1 * FDPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FDIV, 8, 0):      // FDDIV   dst,src1,src2
+			OPCODE_CASE(OP_FDIV, 8, 0):                 // FDDIV   dst,src1,src2
 				FDPARAM0 = FDPARAM1 / FDPARAM2;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FNEG, 8, 0):      // FDNEG   dst,src1
+			OPCODE_CASE(OP_FNEG, 8, 0):                 // FDNEG   dst,src1
 				FDPARAM0 = -FDPARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FABS, 8, 0):      // FDABS   dst,src1
+			OPCODE_CASE(OP_FABS, 8, 0):                 // FDABS   dst,src1
 				FDPARAM0 = fabs(FDPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FSQRT, 8, 0):     // FDSQRT  dst,src1
+			OPCODE_CASE(OP_FSQRT, 8, 0):                // FDSQRT  dst,src1
 				FDPARAM0 = sqrt(FDPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FRECIP, 8, 0):    // FDRECIP dst,src1
+			OPCODE_CASE(OP_FRECIP, 8, 0):               // FDRECIP dst,src1
 				FDPARAM0 = 1.0 / FDPARAM1;
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FRSQRT, 8, 0):    // FDRSQRT dst,src1
+			OPCODE_CASE(OP_FRSQRT, 8, 0):               // FDRSQRT dst,src1
 				FDPARAM0 = 1.0 / sqrt(FDPARAM1);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_FCOPYI, 8, 0):    // FDCOPYI dst,src
+			OPCODE_CASE(OP_FCOPYI, 8, 0):               // FDCOPYI dst,src
 				FDPARAM0 = u2d(*inst[1].pint64);
-				break;
+				OPCODE_NEXT;
 
-			case MAKE_OPCODE_SHORT(OP_ICOPYF, 8, 0):    // ICOPYFD dst,src
+			OPCODE_CASE(OP_ICOPYF, 8, 0):               // ICOPYFD dst,src
 				*inst[0].pint64 = d2u(FDPARAM1);
-				break;
+				OPCODE_NEXT;
+
+
+
+			// ----------------------- Superinstructions -----------------------
+
+			OPCODE_CASE(OP_CMPJMP, 4, 1):               // CMP     src1,src2 / JMP imm,c
+				temp32 = PARAM0 - PARAM1;
+				flags = FLAGS32_NZCV_SUB(temp32, PARAM0, PARAM1);
+				if (OPCODE_FAIL_CONDITION(opcode, flags))
+					OPCODE_NEXT;
+				newinst = inst[2].inst;
+				assert_in_cache(m_cache, newinst);
+				inst = newinst;
+				OPCODE_BRANCH;
+
+			OPCODE_CASE(OP_CMPJMP, 8, 1):               // DCMP    src1,src2 / JMP imm,c
+				temp64 = DPARAM0 - DPARAM1;
+				flags = FLAGS64_NZCV_SUB(temp64, DPARAM0, DPARAM1);
+				if (OPCODE_FAIL_CONDITION(opcode, flags))
+					OPCODE_NEXT;
+				newinst = inst[2].inst;
+				assert_in_cache(m_cache, newinst);
+				inst = newinst;
+				OPCODE_BRANCH;
+
+			OPCODE_CASE(OP_SUBEXH, 4, 1):               // SUB     dst,src1,src2,f / EXH handle,param,c
+				temp32 = PARAM1 - PARAM2;
+				flags = FLAGS32_NZCV_SUB(temp32, PARAM1, PARAM2);
+				PARAM0 = temp32;
+				if (OPCODE_FAIL_CONDITION(opcode, flags))
+					OPCODE_NEXT;
+				assert(sp < ARRAY_LENGTH(callstack));
+				newinst = (const drcbec_instruction *)inst[3].handle->codeptr();
+				assert_in_cache(m_cache, newinst);
+				m_state.exp = *inst[4].puint32;
+				callstack[sp++] = inst;
+				inst = newinst;
+				OPCODE_BRANCH;
+
+			OPCODE_CASE(OP_MOV2, 4, 0):                 // MOV     dst1,src1 / MOV dst2,src2
+				PARAM0 = PARAM1;
+				PARAM2 = PARAM3;
+				OPCODE_NEXT;
+
+			OPCODE_CASE(OP_MOV2, 8, 0):                 // DMOV    dst1,src1 / DMOV dst2,src2
+				DPARAM0 = DPARAM1;
+				DPARAM2 = DPARAM3;
+				OPCODE_NEXT;
 
 			default:
+#if DRCBEC_THREADED
+				if (Threaded && registering)
+				{
+					regop.i++;
+					goto register_next;
+				}
+			handler_unexpected:
+#endif
 				fatalerror("Unexpected opcode!\n");
 		}
 
@@ -2117,6 +2263,113 @@ int drcbe_c::execute(code_handle &entry)
 }
 
 
+//-------------------------------------------------
+//  output_opcode - output an opcode word, preceded
+//  by its handler address for threaded code
+//-------------------------------------------------
+
+void drcbe_c::output_opcode(drcbec_instruction **dstptr, UINT32 opcode)
+{
+	drcbec_instruction *dst = *dstptr;
+
+	if (m_threaded)
+		(dst++)->v = s_handlers[OPCODE_GET_SHORT(opcode)];
+	(dst++)->i = opcode;
+	*dstptr = dst;
+}
+
+
+//-------------------------------------------------
+//  output_instruction - output an opcode along
+//  with its parameters and immediates; returns
+//  a pointer to the first parameter
+//-------------------------------------------------
+
+drcbec_instruction *drcbe_c::output_instruction(drcbec_instruction **dstptr, int opcode, UINT8 size, condition_t condition, UINT8 flags, int numparams, const parameter *params, const UINT8 *psize)
+{
+	// count how many bytes of immediates we need
+	int immedbytes = 0;
+	for (int pnum = 0; pnum < numparams; pnum++)
+		if (params[pnum].is_mapvar() ||
+			(params[pnum].is_immediate() && params[pnum].immediate() != 0) ||
+			(params[pnum].is_size_space() && params[pnum].space() != 0))
+			immedbytes += psize[pnum];
+
+	// compute how many instruction words we need for that
+	int immedwords = (immedbytes + sizeof(drcbec_instruction) - 1) / sizeof(drcbec_instruction);
+
+	// first item is the opcode, size, condition flags and length
+	output_opcode(dstptr, MAKE_OPCODE_FULL(opcode, size, condition, flags, numparams + immedwords));
+
+	// immediates start after parameters
+	drcbec_instruction *paramstart = *dstptr;
+	void *immed = paramstart + numparams;
+
+	// output each of the parameters
+	for (int pnum = 0; pnum < numparams; pnum++)
+		output_parameter(dstptr, &immed, psize[pnum], params[pnum]);
+
+	// point past the end of the immediates
+	*dstptr += immedwords;
+	return paramstart;
+}
+
+
+//-------------------------------------------------
+//  output_superinstruction - output a fused form
+//  of two adjacent instructions if there is one;
+//  returns false if not
+//-------------------------------------------------
+
+bool drcbe_c::output_superinstruction(drcbec_instruction **dstptr, const instruction &first, const instruction &second)
+{
+	parameter params[5];
+	UINT8 psize[5];
+
+	// CMP followed by a conditional JMP
+	if (first.opcode() == OP_CMP && first.flags() != 0 && second.opcode() == OP_JMP && second.condition() != COND_ALWAYS)
+	{
+		params[0] = first.param(0);
+		params[1] = first.param(1);
+		params[2] = 0;
+		psize[0] = psize[1] = first.size();
+		psize[2] = 4;
+		drcbec_instruction *target = output_instruction(dstptr, OP_CMPJMP, first.size(), second.condition(), first.flags(), 3, params, psize) + 2;
+
+		// the third parameter is the branch target, which may need fixing up later
+		target->inst = (drcbec_instruction *)m_labels.get_codeptr(second.param(0).label(), m_fixup_delegate, target);
+		return true;
+	}
+
+	// SUB setting flags followed by a conditional EXH, as used to count cycles
+	if (first.opcode() == OP_SUB && first.size() == 4 && first.flags() != 0 && second.opcode() == OP_EXH && second.condition() != COND_ALWAYS)
+	{
+		params[0] = first.param(0);
+		params[1] = first.param(1);
+		params[2] = first.param(2);
+		params[3] = second.param(0);
+		params[4] = second.param(1);
+		psize[0] = psize[1] = psize[2] = psize[3] = psize[4] = 4;
+		output_instruction(dstptr, OP_SUBEXH, 4, second.condition(), first.flags(), 5, params, psize);
+		return true;
+	}
+
+	// two unconditional moves of the same size
+	if (first.opcode() == OP_MOV && second.opcode() == OP_MOV && first.condition() == COND_ALWAYS && second.condition() == COND_ALWAYS && first.size() == second.size())
+	{
+		params[0] = first.param(0);
+		params[1] = first.param(1);
+		params[2] = second.param(0);
+		params[3] = second.param(1);
+		psize[0] = psize[1] = psize[2] = psize[3] = first.size();
+		output_instruction(dstptr, OP_MOV2, first.size(), COND_ALWAYS, 0, 4, params, psize);
+		return true;
+	}
+
+	return false;
+}
+
+
 //-------------------------------------------------
 //  output_parameter - output a parameter
 //-------------------------------------------------
@@ -36,10 +36,17 @@ public:
 	virtual int execute(uml::code_handle &entry) override;
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst) override;
 	virtual bool hash_exists(UINT32 mode, UINT32 pc) override;
+	virtual void invalidate_code(drccodeptr start, drccodeptr end) override;
 	virtual void get_info(drcbe_info &info) override;
 
 private:
+	// execution
+	template <bool Threaded> int execute_loop(const drcbec_instruction *inst);
+
 	// helpers
+	void output_opcode(drcbec_instruction **dstptr, UINT32 opcode);
+	drcbec_instruction *output_instruction(drcbec_instruction **dstptr, int opcode, UINT8 size, uml::condition_t condition, UINT8 flags, int numparams, const uml::parameter *params, const UINT8 *psize);
+	bool output_superinstruction(drcbec_instruction **dstptr, const uml::instruction &first, const uml::instruction &second);
 	void output_parameter(drcbec_instruction **dstptr, void **immedptr, int size, const uml::parameter &param);
 	void fixup_label(void *parameter, drccodeptr labelcodeptr);
 	int dmulu(UINT64 &dstlo, UINT64 &dsthi, UINT64 src1, UINT64 src2, int flags);
@@ -52,9 +59,11 @@ private:
 	drc_map_variables       m_map;                  // code map
 	drc_label_list          m_labels;               // label list
 	drc_label_fixup_delegate m_fixup_delegate;      // precomputed delegate
+	bool                    m_threaded;             // generate and run threaded code
 
 	static const UINT32     s_condition_map[32];
 	static UINT64           s_immediate_zero;
+	static void *           s_handlers[0x1000];     // threaded handler for each short opcode
 };
 
 
@@ -188,6 +188,28 @@ bool drc_hash_table::set_codeptr(UINT32 mode, UINT32 pc, drccodeptr code)
 }
 
 
+//-------------------------------------------------
+//  invalidate_range - point every entry that
+//  refers to code in the given range back at the
+//  default codeptr
+//-------------------------------------------------
+
+void drc_hash_table::invalidate_range(drccodeptr start, drccodeptr end)
+{
+	for (int modenum = 0; modenum < m_modes; modenum++)
+		if (m_base[modenum] != m_emptyl1)
+			for (int l1entry = 0; l1entry < (1 << m_l1bits); l1entry++)
+			{
+				// several l1 entries may share an l2 table only if it is the empty one
+				drccodeptr *l2table = m_base[modenum][l1entry];
+				if (l2table != m_emptyl2)
+					for (int l2entry = 0; l2entry < (1 << m_l2bits); l2entry++)
+						if (l2table[l2entry] >= start && l2table[l2entry] < end)
+							l2table[l2entry] = m_nocodeptr;
+			}
+}
+
+
 
 //**************************************************************************
 //  DRC MAP VARIABLES
@@ -356,7 +378,7 @@ UINT32 drc_map_variables::get_value(drccodeptr codebase, UINT32 mapvar) const
 
 	// get an aligned pointer to start scanning
 	UINT64 *curscan = (UINT64 *)(((FPTR)codebase | 7) + 1);
-	UINT64 *endscan = (UINT64 *)m_cache.top();
+	UINT64 *endscan = (UINT64 *)m_cache.extent_end(codebase);
 
 	// look for the signature
 	while (curscan < endscan && *curscan++ != m_uniquevalue) {};
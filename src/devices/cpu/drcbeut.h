@@ -49,6 +49,7 @@ public:
 
 	// code pointer access
 	bool set_codeptr(UINT32 mode, UINT32 pc, drccodeptr code);
+	void invalidate_range(drccodeptr start, drccodeptr end);
 	drccodeptr get_codeptr(UINT32 mode, UINT32 pc) { assert(mode < m_modes); return m_base[mode][(pc >> m_l1shift) & m_l1mask][(pc >> m_l2shift) & m_l2mask]; }
 	bool code_exists(UINT32 mode, UINT32 pc) { return get_codeptr(mode, pc) != m_nocodeptr; }
 
@@ -867,6 +867,17 @@ bool drcbe_x64::hash_exists(UINT32 mode, UINT32 pc)
 }
 
 
+//-------------------------------------------------
+//  invalidate_code - forget about code that has
+//  been evicted from the cache
+//-------------------------------------------------
+
+void drcbe_x64::invalidate_code(drccodeptr start, drccodeptr end)
+{
+	m_hash.invalidate_range(start, end);
+}
+
+
 //-------------------------------------------------
 //  get_info - return information about the
 //  back-end implementation
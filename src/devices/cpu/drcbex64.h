@@ -40,6 +40,7 @@ public:
 	virtual int execute(uml::code_handle &entry) override;
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst) override;
 	virtual bool hash_exists(UINT32 mode, UINT32 pc) override;
+	virtual void invalidate_code(drccodeptr start, drccodeptr end) override;
 	virtual void get_info(drcbe_info &info) override;
 	virtual bool logging() const override { return m_log != nullptr; }
 
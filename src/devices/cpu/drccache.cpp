@@ -38,10 +38,15 @@ drc_cache::drc_cache(size_t bytes)
 		m_top(m_base),
 		m_end(m_near + bytes),
 		m_codegen(nullptr),
-		m_size(bytes)
+		m_size(bytes),
+		m_block(nullptr),
+		m_inblock(false),
+		m_block_evictable(false),
+		m_live_bytes(0)
 {
 	memset(m_free, 0, sizeof(m_free));
 	memset(m_nearfree, 0, sizeof(m_nearfree));
+	memset(&m_stats, 0, sizeof(m_stats));
 }
 
 
@@ -68,6 +73,13 @@ void drc_cache::flush()
 
 	// just reset the top back to the base and re-seed
 	m_top = m_base;
+
+	// forget everything that was live
+	m_extents.clear();
+	m_block = nullptr;
+	m_inblock = false;
+	m_live_bytes = 0;
+	m_stats.flushes++;
 }
 
 
@@ -97,6 +109,20 @@ void *drc_cache::alloc(size_t bytes)
 	if (m_top > ptr)
 		return nullptr;
 
+	// reclaim any code that is in the way, as long as none of it is pinned
+	extent_map::iterator first = m_extents.upper_bound(ptr);
+	if (first != m_extents.begin() && std::prev(first)->second.m_end > ptr)
+		--first;
+	if (first != m_extents.end())
+	{
+		if (m_evict.isnull())
+			return nullptr;
+		for (extent_map::iterator scan = first; scan != m_extents.end(); ++scan)
+			if (!scan->second.m_evictable)
+				return nullptr;
+		evict(first, m_extents.end());
+	}
+
 	// otherwise update the end of the cache
 	m_end = ptr;
 	return ptr;
@@ -146,11 +172,40 @@ void *drc_cache::alloc_temporary(size_t bytes)
 	assert(m_codegen == nullptr);
 
 	// if no space, we just fail
-	drccodeptr ptr = m_top;
-	if (ptr + bytes >= m_end)
+	if (!make_room(bytes, m_block == nullptr))
 		return nullptr;
 
 	// otherwise, update the cache top
+	drccodeptr ptr = m_top;
+	m_top = (drccodeptr)ALIGN_PTR_UP(ptr + bytes);
+
+	// this memory lives until the next flush; if it lands in the middle of
+	// a block's code, the whole block has to stay
+	if (m_block != nullptr)
+		m_block_evictable = false;
+	else
+		add_extent(ptr, m_top, false);
+	return ptr;
+}
+
+
+//-------------------------------------------------
+//  alloc_scratch - allocate memory from the cache
+//  that is only needed until the current block
+//  has been generated
+//-------------------------------------------------
+
+void *drc_cache::alloc_scratch(size_t bytes)
+{
+	// can't allocate in the middle of codegen
+	assert(m_codegen == nullptr);
+
+	// if no space, we just fail
+	if (!make_room(bytes, m_block == nullptr))
+		return nullptr;
+
+	// otherwise, update the cache top; nothing keeps this live
+	drccodeptr ptr = m_top;
 	m_top = (drccodeptr)ALIGN_PTR_UP(ptr + bytes);
 	return ptr;
 }
@@ -190,12 +245,14 @@ drccodeptr *drc_cache::begin_codegen(UINT32 reserve_bytes)
 	assert(m_codegen == nullptr);
 	assert(m_ooblist.first() == nullptr);
 
-	// if still no space, we just fail
-	drccodeptr ptr = m_top;
-	if (ptr + reserve_bytes >= m_end)
+	// if still no space, we just fail; once a block has started generating
+	// code it has to stay contiguous, so it can't wrap
+	if (!make_room(reserve_bytes, m_block == nullptr))
 		return nullptr;
 
 	// otherwise, return a pointer to the cache top
+	if (m_inblock && m_block == nullptr)
+		m_block = m_top;
 	m_codegen = m_top;
 	return &m_top;
 }
@@ -225,6 +282,10 @@ drccodeptr drc_cache::end_codegen()
 	m_top = (drccodeptr)ALIGN_PTR_UP(m_top);
 	m_codegen = nullptr;
 
+	// code generated outside of a block is back-end glue that has to stay
+	if (!m_inblock)
+		add_extent(result, m_top, false);
+
 	return result;
 }
 
@@ -250,3 +311,166 @@ void drc_cache::request_oob_codegen(drc_oob_delegate callback, void *param1, voi
 	// add to the tail
 	m_ooblist.append(*oob);
 }
+
+
+//-------------------------------------------------
+//  begin_block - note the start of a UML block;
+//  everything generated until end_block is
+//  tracked as a single unit
+//-------------------------------------------------
+
+void drc_cache::begin_block(UINT32 reserve_bytes, bool evictable)
+{
+	assert(!m_inblock);
+	assert(m_codegen == nullptr);
+
+	m_inblock = true;
+	m_block = nullptr;
+	m_block_evictable = evictable && !m_evict.isnull();
+
+	// make room up front, while we are still allowed to wrap; if this fails
+	// begin_codegen will fail as well and the owner will flush the cache
+	make_room(reserve_bytes, true);
+}
+
+
+//-------------------------------------------------
+//  end_block - commit the block started by
+//  begin_block
+//-------------------------------------------------
+
+void drc_cache::end_block()
+{
+	assert(m_inblock);
+	assert(m_codegen == nullptr);
+
+	if (m_block != nullptr)
+		add_extent(m_block, m_top, m_block_evictable);
+	m_block = nullptr;
+	m_inblock = false;
+	m_stats.blocks++;
+}
+
+
+//-------------------------------------------------
+//  cancel_block - abandon the block started by
+//  begin_block after an aborted compilation
+//-------------------------------------------------
+
+void drc_cache::cancel_block()
+{
+	assert(m_inblock);
+
+	// keep track of whatever was generated so it can still be reclaimed later
+	if (m_block != nullptr && m_codegen == nullptr)
+		add_extent(m_block, m_top, m_block_evictable);
+	m_block = nullptr;
+	m_inblock = false;
+}
+
+
+//-------------------------------------------------
+//  extent_end - return the end of the live range
+//  containing the given pointer, or the cache top
+//  if it isn't in one
+//-------------------------------------------------
+
+drccodeptr drc_cache::extent_end(const void *ptr) const
+{
+	extent_map::const_iterator found = m_extents.upper_bound(drccodeptr(ptr));
+	if (found != m_extents.begin() && std::prev(found)->second.m_end > drccodeptr(ptr))
+		return std::prev(found)->second.m_end;
+	return m_top;
+}
+
+
+//-------------------------------------------------
+//  make_room - ensure that the given number of
+//  bytes is free at the top of the cache,
+//  evicting the oldest code to get it
+//-------------------------------------------------
+
+bool drc_cache::make_room(size_t bytes, bool allow_wrap)
+{
+	// without anyone to tell about evicted code, just fail when full
+	if (m_evict.isnull())
+		return (m_top + bytes < m_end);
+
+	bool wrapped = false;
+	while (true)
+	{
+		// if we ran off the end, go back to the base; the code there is the oldest
+		if (m_top + bytes >= m_end)
+		{
+			if (!allow_wrap || wrapped)
+				return false;
+			wrapped = true;
+			m_top = m_base;
+			m_stats.wraps++;
+			continue;
+		}
+
+		// find the first live range overlapping the space we want
+		drccodeptr want = m_top + bytes;
+		extent_map::iterator first = m_extents.upper_bound(m_top);
+		if (first != m_extents.begin() && std::prev(first)->second.m_end > m_top)
+			--first;
+		if (first == m_extents.end() || first->first >= want)
+			return true;
+
+		// step over anything that must stay
+		if (!first->second.m_evictable)
+		{
+			m_top = (drccodeptr)ALIGN_PTR_UP(first->second.m_end);
+			continue;
+		}
+
+		// evict a run of blocks; take a good-sized chunk so we don't have to come back soon
+		drccodeptr limit = std::max(want, m_top + EVICT_MIN_BYTES);
+		extent_map::iterator last = first;
+		while (last != m_extents.end() && last->second.m_evictable && last->first < limit)
+			++last;
+		evict(first, last);
+	}
+}
+
+
+//-------------------------------------------------
+//  add_extent - record a live range
+//-------------------------------------------------
+
+void drc_cache::add_extent(drccodeptr start, drccodeptr end, bool evictable)
+{
+	if (end <= start)
+		return;
+
+	extent &ext = m_extents[start];
+	ext.m_end = end;
+	ext.m_evictable = evictable;
+	m_live_bytes += end - start;
+}
+
+
+//-------------------------------------------------
+//  evict - drop a run of live ranges and tell
+//  the owner to forget about the code in them
+//-------------------------------------------------
+
+void drc_cache::evict(extent_map::iterator first, extent_map::iterator last)
+{
+	drccodeptr start = first->first;
+	drccodeptr end = start;
+
+	for (extent_map::iterator scan = first; scan != last; ++scan)
+	{
+		size_t size = scan->second.m_end - scan->first;
+		m_live_bytes -= size;
+		m_stats.evictions++;
+		m_stats.evicted_bytes += size;
+		end = scan->second.m_end;
+	}
+	m_extents.erase(first, last);
+
+	// let the owner remove any references into the range
+	m_evict(start, end);
+}
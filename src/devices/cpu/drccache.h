@@ -13,6 +13,7 @@
 #ifndef __DRCCACHE_H__
 #define __DRCCACHE_H__
 
+#include <map>
 
 
 //**************************************************************************
@@ -37,6 +38,21 @@ typedef UINT8 *drccodeptr;
 typedef delegate<void (drccodeptr *, void *, void *)> drc_oob_delegate;
 
 
+// callback to invalidate all references to a range of evicted code
+typedef delegate<void (drccodeptr, drccodeptr)> drc_evict_delegate;
+
+
+// statistics about cache usage
+struct drc_cache_stats
+{
+	UINT64              blocks;             // blocks committed since startup
+	UINT64              evictions;          // blocks evicted to make room for new code
+	UINT64              evicted_bytes;      // bytes reclaimed by eviction
+	UINT32              wraps;              // times allocation wrapped back to the base
+	UINT32              flushes;            // full flushes of the cache
+};
+
+
 // drc_cache
 class drc_cache
 {
@@ -49,6 +65,9 @@ public:
 	drccodeptr near() const { return m_near; }
 	drccodeptr base() const { return m_base; }
 	drccodeptr top() const { return m_top; }
+	drccodeptr end() const { return m_end; }
+	size_t live_bytes() const { return m_live_bytes; }
+	const drc_cache_stats &stats() const { return m_stats; }
 
 	// pointer checking
 	bool contains_pointer(const void *ptr) const { return ((const drccodeptr)ptr >= m_near && (const drccodeptr)ptr < m_near + m_size); }
@@ -60,6 +79,7 @@ public:
 	void *alloc(size_t bytes);
 	void *alloc_near(size_t bytes);
 	void *alloc_temporary(size_t bytes);
+	void *alloc_scratch(size_t bytes);
 	void dealloc(void *memory, size_t bytes);
 
 	// codegen helpers
@@ -67,7 +87,30 @@ public:
 	drccodeptr end_codegen();
 	void request_oob_codegen(drc_oob_delegate callback, void *param1 = nullptr, void *param2 = nullptr);
 
+	// eviction
+	void set_evict_callback(drc_evict_delegate callback) { m_evict = callback; }
+	void begin_block(UINT32 reserve_bytes, bool evictable);
+	void end_block();
+	void cancel_block();
+	drccodeptr extent_end(const void *ptr) const;
+
 private:
+	// a range of live allocations at the bottom of the cache
+	struct extent
+	{
+		drccodeptr          m_end;              // end of the range
+		bool                m_evictable;        // true if the range may be reclaimed
+	};
+	typedef std::map<drccodeptr, extent> extent_map;
+
+	// internal helpers
+	bool make_room(size_t bytes, bool allow_wrap);
+	void add_extent(drccodeptr start, drccodeptr end, bool evictable);
+	void evict(extent_map::iterator first, extent_map::iterator last);
+
+	// least amount of code reclaimed whenever we have to evict
+	static const size_t EVICT_MIN_BYTES = 256 * 1024;
+
 	// largest block of code that can be generated at once
 	static const size_t CODEGEN_MAX_BYTES = 65536;
 
@@ -89,6 +132,15 @@ private:
 	drccodeptr          m_codegen;          // start of generated code
 	size_t              m_size;             // size of the cache in bytes
 
+	// eviction management
+	drc_evict_delegate  m_evict;            // called to invalidate evicted code
+	extent_map          m_extents;          // live ranges between the base and the end
+	drccodeptr          m_block;            // start of the current block's code, or nullptr
+	bool                m_inblock;          // true if between begin_block and end_block
+	bool                m_block_evictable;  // true if the current block may later be reclaimed
+	size_t              m_live_bytes;       // bytes held by live ranges
+	drc_cache_stats     m_stats;            // usage statistics
+
 	// oob management
 	struct oob_handler
 	{
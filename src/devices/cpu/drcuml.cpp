@@ -10,9 +10,6 @@
 
     Future improvements/changes:
 
-    * UML optimizer:
-        - constant folding
-
     * Write a back-end validator:
         - checks all combinations of memory/register/immediate on all params
         - checks behavior of all opcodes
@@ -33,6 +30,8 @@
 
 #include "emu.h"
 #include "emuopts.h"
+#include "debugger.h"
+#include "debug/debugcon.h"
 #include "drcuml.h"
 #include "drcbec.h"
 #include "drcbex86.h"
@@ -63,6 +62,10 @@ typedef NATIVE_DRC drcbe_native;
 #endif
 
 
+// live states, for the debugger
+std::vector<drcuml_state *> drcuml_state::s_instances;
+
+
 // structure describing back-end validation test
 struct bevalidate_test
 {
@@ -131,7 +134,13 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int
 			std::unique_ptr<drcbe_interface>{ std::make_unique<drcbe_c>(*this, device, cache, flags, modes, addrbits, ignorebits) } :
 			std::unique_ptr<drcbe_interface>{ std::make_unique<drcbe_native>(*this, device, cache, flags, modes, addrbits, ignorebits) }),
 		m_beintf(*m_drcbe_interface.get()),
-		m_umllog(nullptr)
+		m_umllog(nullptr),
+		m_optimizations(DRCUML_OPT_DEFAULT),
+		m_cacheregs(0),
+		m_blocks_compiled(0),
+		m_rate_start(osd_ticks()),
+		m_rate_count(0),
+		m_last_rate(0)
 {
 	// if we're to log, create the logfile
 	if (device.machine().options().drc_log_uml())
@@ -139,6 +148,22 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int
 		std::string filename = std::string("drcuml_").append(m_device.shortname()).append(".asm");
 		m_umllog = fopen(filename.c_str(), "w");
 	}
+
+	// when the cache fills up, evict the oldest blocks instead of starting over
+	m_cache.set_evict_callback(drc_evict_delegate(FUNC(drcuml_state::evict_code), this));
+
+	// the first recompiler in a machine adds the debugger command
+	running_machine &machine = device.machine();
+	if ((machine.debug_flags & DEBUG_FLAG_ENABLED) != 0 && machine.phase() == MACHINE_PHASE_INIT)
+	{
+		bool registered = false;
+		for (drcuml_state *state : s_instances)
+			if (&state->m_device.machine() == &machine)
+				registered = true;
+		if (!registered)
+			machine.debugger().console().register_command("drcstats", CMDFLAG_NONE, 0, 0, 0, [&machine](int ref, int params, const char **param) { debug_drcstats(machine); });
+	}
+	s_instances.push_back(this);
 }
 
 
@@ -151,6 +176,8 @@ drcuml_state::~drcuml_state()
 	// close any files
 	if (m_umllog != nullptr)
 		fclose(m_umllog);
+
+	s_instances.erase(std::remove(s_instances.begin(), s_instances.end(), this), s_instances.end());
 }
 
 
@@ -214,6 +241,96 @@ drcuml_block *drcuml_state::begin_block(UINT32 maxinst)
 }
 
 
+//-------------------------------------------------
+//  generate - hand a finished block to the
+//  back-end, letting the cache track the code
+//-------------------------------------------------
+
+void drcuml_state::generate(drcuml_block &block, instruction *instructions, UINT32 count)
+{
+	// blocks that define handles can be reached without going through the hash
+	// table, so they have to stay put until the next full reset
+	bool evictable = true;
+	for (UINT32 inum = 0; inum < count; inum++)
+		if (instructions[inum].opcode() == OP_HANDLE)
+			evictable = false;
+
+	// the back-ends reserve 32 bytes per instruction; leave a little extra for map data
+	m_cache.begin_block(count * 32 + 4096, evictable);
+	try
+	{
+		m_beintf.generate(block, instructions, count);
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		m_cache.cancel_block();
+		throw;
+	}
+	m_cache.end_block();
+	m_optstats += block.opt_stats();
+
+	// update the compile rate once a second
+	osd_ticks_t now = osd_ticks();
+	m_blocks_compiled++;
+	m_rate_count++;
+	if (now - m_rate_start >= osd_ticks_per_second())
+	{
+		m_last_rate = double(m_rate_count) * double(osd_ticks_per_second()) / double(now - m_rate_start);
+		m_rate_start = now;
+		m_rate_count = 0;
+	}
+}
+
+
+//-------------------------------------------------
+//  compile_rate - return recently compiled blocks
+//  per second of host time
+//-------------------------------------------------
+
+double drcuml_state::compile_rate() const
+{
+	// if the current window has run long, it is more accurate than the last one
+	osd_ticks_t elapsed = osd_ticks() - m_rate_start;
+	if (elapsed >= 2 * osd_ticks_per_second())
+		return double(m_rate_count) * double(osd_ticks_per_second()) / double(elapsed);
+	return m_last_rate;
+}
+
+
+//-------------------------------------------------
+//  evict_code - called by the cache when it
+//  reclaims a range of old code
+//-------------------------------------------------
+
+void drcuml_state::evict_code(drccodeptr start, drccodeptr end)
+{
+	m_beintf.invalidate_code(start, end);
+}
+
+
+//-------------------------------------------------
+//  debug_drcstats - print cache statistics for
+//  every recompiler in the machine
+//-------------------------------------------------
+
+void drcuml_state::debug_drcstats(running_machine &machine)
+{
+	debugger_console &console = machine.debugger().console();
+
+	for (drcuml_state *state : s_instances)
+		if (&state->m_device.machine() == &machine)
+		{
+			const drc_cache_stats &stats = state->m_cache.stats();
+			console.printf("%s: %uK live, %u blocks compiled (%.1f/sec)\n",
+					state->m_device.tag(), UINT32(state->m_cache.live_bytes() / 1024), UINT32(state->m_blocks_compiled), state->compile_rate());
+			console.printf("  %u evictions (%uK), %u wraps, %u resets\n",
+					UINT32(stats.evictions), UINT32(stats.evicted_bytes / 1024), stats.wraps, stats.flushes);
+			console.printf("  optimizer: %u flags, %u constants, %u loads, %u stores, %u cached\n",
+					UINT32(state->m_optstats.flags), UINT32(state->m_optstats.constants), UINT32(state->m_optstats.loads), UINT32(state->m_optstats.stores), UINT32(state->m_optstats.cached));
+		}
+}
+
+
 //-------------------------------------------------
 //  handle_alloc - allocate a new handle
 //-------------------------------------------------
@@ -383,49 +500,18 @@ uml::instruction &drcuml_block::append()
 
 
 //-------------------------------------------------
-//  optimize - apply various optimizations to a
-//  block of code
+//  optimize - apply the enabled optimization
+//  passes to the block
 //-------------------------------------------------
 
 void drcuml_block::optimize()
 {
-	UINT32 mapvar[MAPVAR_COUNT] = { 0 };
-
-	// iterate over instructions
-	for (int instnum = 0; instnum < m_nextinst; instnum++)
-	{
-		instruction &inst = m_inst[instnum];
-
-		// first compute what flags we need
-		UINT8 accumflags = 0;
-		UINT8 remainingflags = inst.output_flags();
-
-		// scan ahead until we run out of possible remaining flags
-		for (int scannum = instnum + 1; remainingflags != 0 && scannum < m_nextinst; scannum++)
-		{
-			// any input flags are required
-			const instruction &scan = m_inst[scannum];
-			accumflags |= scan.input_flags();
-
-			// if the scanahead instruction is unconditional, assume his flags are modified
-			if (scan.condition() == COND_ALWAYS)
-				remainingflags &= ~scan.modified_flags();
-		}
-		inst.set_flags(accumflags);
-
-		// track mapvars
-		if (inst.opcode() == OP_MAPVAR)
-			mapvar[inst.param(0).mapvar() - MAPVAR_M0] = inst.param(1).immediate();
+	drcbe_info info;
+	m_drcuml.get_backend_info(info);
 
-		// convert all mapvar parameters to immediates
-		else if (inst.opcode() != OP_RECOVER)
-			for (int pnum = 0; pnum < inst.numparams(); pnum++)
-				if (inst.param(pnum).is_mapvar())
-					inst.set_mapvar(pnum, mapvar[inst.param(pnum).mapvar() - MAPVAR_M0]);
-
-		// now that flags are correct, simplify the instruction
-		inst.simplify();
-	}
+	drcuml_optimizer optimizer(m_inst, m_nextinst, m_drcuml.optimizations(), m_drcuml.cache_registers(), info.direct_iregs);
+	optimizer.optimize();
+	m_optstats = optimizer.stats();
 }
 
 
@@ -488,6 +574,10 @@ void drcuml_block::disassemble()
 			firstcomment = -1;
 		}
 	}
+
+	// summarize what the optimizer did
+	m_drcuml.log_printf("\t; optimizer: %u flags, %u constants, %u loads, %u stores, %u cached\n",
+			UINT32(m_optstats.flags), UINT32(m_optstats.constants), UINT32(m_optstats.loads), UINT32(m_optstats.stores), UINT32(m_optstats.cached));
 	m_drcuml.log_printf("\n\n");
 	m_drcuml.log_flush();
 }
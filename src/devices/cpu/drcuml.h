@@ -15,6 +15,7 @@
 
 #include "drccache.h"
 #include "uml.h"
+#include "drcumlopt.h"
 
 
 //**************************************************************************
@@ -24,7 +25,6 @@
 // these options are passed into drcuml_alloc() and control global behaviors
 
 
-
 //**************************************************************************
 //  TYPE DEFINITIONS
 //**************************************************************************
@@ -90,6 +90,7 @@ public:
 	drcuml_block *next() const { return m_next; }
 	bool inuse() const { return m_inuse; }
 	UINT32 maxinst() const { return m_maxinst; }
+	const drcuml_opt_stats &opt_stats() const { return m_optstats; }
 
 	// code generation
 	void begin();
@@ -120,6 +121,7 @@ private:
 	UINT32                  m_maxinst;          // maximum number of instructions
 	std::vector<uml::instruction> m_inst;     // pointer to the instruction list
 	bool                    m_inuse;            // this block is in use
+	drcuml_opt_stats        m_optstats;         // optimizations applied to this block
 };
 
 
@@ -136,6 +138,7 @@ public:
 	virtual int execute(uml::code_handle &entry) = 0;
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst) = 0;
 	virtual bool hash_exists(UINT32 mode, UINT32 pc) = 0;
+	virtual void invalidate_code(drccodeptr start, drccodeptr end) = 0;
 	virtual void get_info(drcbe_info &info) = 0;
 	virtual bool logging() const { return false; }
 
@@ -172,7 +175,18 @@ public:
 	// back-end interface
 	void get_backend_info(drcbe_info &info) { m_beintf.get_info(info); }
 	bool hash_exists(UINT32 mode, UINT32 pc) { return m_beintf.hash_exists(mode, pc); }
-	void generate(drcuml_block &block, uml::instruction *instructions, UINT32 count) { m_beintf.generate(block, instructions, count); }
+	void generate(drcuml_block &block, uml::instruction *instructions, UINT32 count);
+
+	// optimization control
+	UINT32 optimizations() const { return m_optimizations; }
+	void set_optimizations(UINT32 optimizations) { m_optimizations = optimizations; }
+	UINT32 cache_registers() const { return m_cacheregs; }
+	void set_cache_registers(UINT32 iregmask) { m_cacheregs = iregmask; }
+
+	// statistics
+	UINT64 blocks_compiled() const { return m_blocks_compiled; }
+	double compile_rate() const;
+	const drcuml_opt_stats &opt_stats() const { return m_optstats; }
 
 	// handle management
 	uml::code_handle *handle_alloc(const char *name);
@@ -188,6 +202,10 @@ public:
 	bool logging_native() const { return m_beintf.logging(); }
 
 private:
+	// internal helpers
+	void evict_code(drccodeptr start, drccodeptr end);
+	static void debug_drcstats(running_machine &machine);
+
 	// symbol class
 	class symbol
 	{
@@ -222,6 +240,17 @@ private:
 	simple_list<drcuml_block>   m_blocklist;        // list of active blocks
 	simple_list<uml::code_handle> m_handlelist;     // list of active handles
 	simple_list<symbol>         m_symlist;          // list of symbols
+	UINT32                      m_optimizations;    // DRCUML_OPT_* passes to run
+	UINT32                      m_cacheregs;        // mask of integer registers free for caching
+
+	// statistics
+	UINT64                      m_blocks_compiled;  // blocks compiled since startup
+	osd_ticks_t                 m_rate_start;       // start of the current compile rate window
+	UINT32                      m_rate_count;       // blocks compiled in the current window
+	double                      m_last_rate;        // blocks per second over the last full window
+	drcuml_opt_stats            m_optstats;         // optimizations applied since startup
+
+	static std::vector<drcuml_state *> s_instances; // live states, for the debugger
 };
 
 
@@ -242,7 +271,7 @@ inline void drcuml_block::append_comment(Format &&fmt, Params &&... args)
 	std::string temp(util::string_format(std::forward<Format>(fmt), std::forward<Params>(args)...));
 
 	// allocate space in the cache to hold the comment
-	char *comment = (char *)m_drcuml.cache().alloc_temporary(temp.length() + 1);
+	char *comment = (char *)m_drcuml.cache().alloc_scratch(temp.length() + 1);
 	if (comment != nullptr)
 	{
 		strcpy(comment, temp.c_str());
@@ -0,0 +1,544 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcumlopt.cpp
+
+    Optimization passes applied to UML blocks before code generation.
+    Each pass works within a single block and must leave the results
+    the block computes unchanged.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "drcumlopt.h"
+
+using namespace uml;
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+namespace {
+
+// a value known to be in memory over a straight-line region of a block
+struct memory_value
+{
+	drccodeptr          base;               // first byte of the value
+	int                 bytes;              // number of bytes
+	opcode_t            opcode;             // LOAD, LOADS or STORE that produced it
+	UINT8               size;               // operation size of that instruction
+	parameter           holder;             // register or immediate with the same value, if any
+	int                 store;              // index of a store nobody has read yet, or -1
+};
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//  OPTIMIZER HELPERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  is_region_barrier - return true if the
+//  instruction starts or ends a straight-line
+//  region, or may touch memory behind our back
+//-------------------------------------------------
+
+static bool is_region_barrier(const instruction &inst)
+{
+	switch (inst.opcode())
+	{
+		case OP_HANDLE:
+		case OP_HASH:
+		case OP_LABEL:
+		case OP_DEBUG:
+		case OP_EXIT:
+		case OP_HASHJMP:
+		case OP_JMP:
+		case OP_EXH:
+		case OP_CALLH:
+		case OP_RET:
+		case OP_CALLC:
+		case OP_RECOVER:
+		case OP_SAVE:
+		case OP_RESTORE:
+		case OP_READ:
+		case OP_READM:
+		case OP_WRITE:
+		case OP_WRITEM:
+		case OP_FLOAD:
+		case OP_FSTORE:
+		case OP_FREAD:
+		case OP_FWRITE:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+
+//-------------------------------------------------
+//  memory_address - compute the address and size
+//  touched by a LOAD, LOADS or STORE; returns
+//  false if the index is not a constant
+//-------------------------------------------------
+
+static bool memory_address(const instruction &inst, drccodeptr &base, int &bytes)
+{
+	int basenum = (inst.opcode() == OP_STORE) ? 0 : 1;
+	const parameter &index = inst.param(basenum + 1);
+	if (!index.is_immediate() || UINT32(index.immediate()) >= 0x80000000)
+		return false;
+
+	const parameter &sizescale = inst.param(3);
+	int scale;
+	if (sizescale.scale() == SCALE_DEFAULT)
+		scale = sizescale.size();
+	else
+		scale = sizescale.scale();
+	base = drccodeptr(inst.param(basenum).memory()) + (UINT32(index.immediate()) << scale);
+	bytes = 1 << sizescale.size();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  overlaps - return true if two ranges of
+//  memory share any bytes
+//-------------------------------------------------
+
+static inline bool overlaps(drccodeptr base1, int bytes1, drccodeptr base2, int bytes2)
+{
+	return (base1 < base2 + bytes2 && base2 < base1 + bytes1);
+}
+
+
+//-------------------------------------------------
+//  writes_memory - return true if the instruction
+//  may write any of the given bytes
+//-------------------------------------------------
+
+static bool writes_memory(const instruction &inst, drccodeptr base, int bytes)
+{
+	if (inst.opcode() == OP_STORE)
+	{
+		drccodeptr stbase;
+		int stbytes;
+		if (!memory_address(inst, stbase, stbytes) || overlaps(base, bytes, stbase, stbytes))
+			return true;
+	}
+	for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		if (inst.param(pnum).is_memory() && inst.param_is_output(pnum) && overlaps(base, bytes, drccodeptr(inst.param(pnum).memory()), inst.param_size(pnum)))
+			return true;
+	return false;
+}
+
+
+
+
+//**************************************************************************
+//  DRCUML OPTIMIZER
+//**************************************************************************
+
+//-------------------------------------------------
+//  drcuml_optimizer - constructor
+//-------------------------------------------------
+
+drcuml_optimizer::drcuml_optimizer(std::vector<instruction> &inst, UINT32 &numinst, UINT32 optimizations, UINT32 cacheregs, int direct_iregs)
+	: m_inst(inst),
+		m_nextinst(numinst),
+		m_optimizations(optimizations),
+		m_cacheregs(cacheregs),
+		m_direct_iregs(direct_iregs)
+{
+}
+
+
+//-------------------------------------------------
+//  optimize - apply various optimizations to a
+//  block of code
+//-------------------------------------------------
+
+void drcuml_optimizer::optimize()
+{
+	UINT32 mapvar[MAPVAR_COUNT] = { 0 };
+	UINT32 enabled = m_optimizations;
+
+	m_optstats = drcuml_opt_stats();
+
+	// track mapvars and convert all mapvar parameters to immediates
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
+	{
+		instruction &inst = m_inst[instnum];
+		if (inst.opcode() == OP_MAPVAR)
+			mapvar[inst.param(0).mapvar() - MAPVAR_M0] = inst.param(1).immediate();
+		else if (inst.opcode() != OP_RECOVER)
+			for (int pnum = 0; pnum < inst.numparams(); pnum++)
+				if (inst.param(pnum).is_mapvar())
+					inst.set_mapvar(pnum, mapvar[inst.param(pnum).mapvar() - MAPVAR_M0]);
+	}
+
+	// simplification depends on knowing which flags are needed
+	optimize_flags();
+
+	// run the optional passes
+	if (enabled & DRCUML_OPT_CONSTPROP)
+		optimize_constants();
+	if (enabled & DRCUML_OPT_LOADSTORE)
+		optimize_loadstore();
+	if ((enabled & DRCUML_OPT_REGCACHE) && m_cacheregs != 0)
+		optimize_regcache();
+
+	// the passes may have removed flag consumers or producers, so redo the flags and simplify once more
+	optimize_flags();
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
+		m_inst[instnum].simplify();
+}
+
+
+//-------------------------------------------------
+//  optimize_flags - compute which flags each
+//  instruction actually needs to produce
+//-------------------------------------------------
+
+void drcuml_optimizer::optimize_flags()
+{
+	bool enabled = (m_optimizations & DRCUML_OPT_FLAGS) != 0;
+
+	m_optstats.flags = 0;
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
+	{
+		instruction &inst = m_inst[instnum];
+		UINT8 outflags = inst.output_flags();
+
+		// if disabled, always produce everything the opcode can
+		if (!enabled)
+		{
+			inst.set_flags(outflags);
+			continue;
+		}
+
+		// first compute what flags we need
+		UINT8 accumflags = 0;
+		UINT8 remainingflags = outflags;
+
+		// scan ahead until we run out of possible remaining flags
+		for (int scannum = instnum + 1; remainingflags != 0 && scannum < m_nextinst; scannum++)
+		{
+			// any input flags are required
+			const instruction &scan = m_inst[scannum];
+			accumflags |= scan.input_flags();
+
+			// if the scanahead instruction is unconditional, assume his flags are modified
+			if (scan.condition() == COND_ALWAYS)
+				remainingflags &= ~scan.modified_flags();
+		}
+		inst.set_flags(accumflags);
+		if ((outflags & ~accumflags) != 0)
+			m_optstats.flags++;
+	}
+}
+
+
+//-------------------------------------------------
+//  optimize_constants - replace integer register
+//  operands with immediates when their values
+//  are known, and fold the results
+//-------------------------------------------------
+
+void drcuml_optimizer::optimize_constants()
+{
+	// known register values; size is 0 if unknown, or 4 if only the low 32 bits are known
+	struct known_value
+	{
+		UINT8           size;
+		UINT64          value;
+	} known[REG_I_COUNT];
+	auto forget_all = [&known]() { for (known_value &reg : known) reg.size = 0; };
+
+	forget_all();
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
+	{
+		instruction &inst = m_inst[instnum];
+
+		// labels, hashes and handles can be reached from anywhere
+		if (inst.opcode() == OP_LABEL || inst.opcode() == OP_HASH || inst.opcode() == OP_HANDLE)
+		{
+			forget_all();
+			continue;
+		}
+
+		// substitute known values wherever an immediate is allowed
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+			if (inst.param(pnum).is_int_register() && inst.param_is_input(pnum) && !inst.param_is_output(pnum) && inst.param_allows_immediate(pnum))
+			{
+				const known_value &reg = known[inst.param(pnum).ireg() - REG_I0];
+				int size = inst.param_size(pnum);
+				if ((size == 4 || size == 8) && reg.size >= size)
+				{
+					inst.set_param(pnum, (size == 4) ? UINT64(UINT32(reg.value)) : reg.value);
+					m_optstats.constants++;
+				}
+			}
+		inst.simplify();
+
+		// anything that calls out or leaves the block may change every register
+		switch (inst.opcode())
+		{
+			case OP_EXIT:
+			case OP_HASHJMP:
+			case OP_JMP:
+			case OP_EXH:
+			case OP_CALLH:
+			case OP_RET:
+			case OP_CALLC:
+			case OP_RECOVER:
+			case OP_RESTORE:
+				forget_all();
+				continue;
+
+			default:
+				break;
+		}
+
+		// unconditional moves of immediates define a known value; all other writes forget it
+		if (inst.opcode() == OP_MOV && inst.condition() == COND_ALWAYS && inst.param(0).is_int_register() && inst.param(1).is_immediate())
+		{
+			known_value &reg = known[inst.param(0).ireg() - REG_I0];
+			reg.size = inst.size();
+			reg.value = (inst.size() == 4) ? UINT64(UINT32(inst.param(1).immediate())) : inst.param(1).immediate();
+		}
+		else
+			for (int pnum = 0; pnum < inst.numparams(); pnum++)
+				if (inst.param(pnum).is_int_register() && inst.param_is_output(pnum))
+					known[inst.param(pnum).ireg() - REG_I0].size = 0;
+	}
+}
+
+
+//-------------------------------------------------
+//  optimize_loadstore - within straight-line
+//  regions, turn loads of values already in a
+//  register into moves and drop stores that are
+//  redundant or overwritten before being read
+//-------------------------------------------------
+
+void drcuml_optimizer::optimize_loadstore()
+{
+	std::vector<memory_value> values;
+
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
+	{
+		instruction &inst = m_inst[instnum];
+		opcode_t opcode = inst.opcode();
+		bool isload = (opcode == OP_LOAD || opcode == OP_LOADS);
+		drccodeptr base = nullptr;
+		int bytes = 0;
+
+		// anything that leaves the region or touches memory we can't track ends it
+		if (is_region_barrier(inst) || ((isload || opcode == OP_STORE) && !memory_address(inst, base, bytes)))
+		{
+			values.clear();
+			continue;
+		}
+
+		// loads and memory operands read whatever is there, so pending stores are live
+		if (isload)
+		{
+			for (memory_value &value : values)
+				if (overlaps(value.base, value.bytes, base, bytes))
+					value.store = -1;
+		}
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+			if (inst.param(pnum).is_memory() && inst.param_is_input(pnum) && !((isload && pnum == 1) || (opcode == OP_STORE && pnum == 0)))
+				for (memory_value &value : values)
+					if (overlaps(value.base, value.bytes, drccodeptr(inst.param(pnum).memory()), inst.param_size(pnum)))
+						value.store = -1;
+
+		// loads of a value already in a register become moves
+		if (isload)
+		{
+			for (memory_value &value : values)
+				if (value.base == base && value.bytes == bytes && value.holder.type() != parameter::PTYPE_NONE && value.size >= inst.size() &&
+					(bytes == inst.size() || (value.opcode == opcode && value.size == inst.size())))
+				{
+					if (inst.size() == 4)
+						inst.mov(inst.param(0), value.holder);
+					else
+						inst.dmov(inst.param(0), value.holder);
+					m_optstats.loads++;
+					break;
+				}
+		}
+
+		// stores of a value memory already holds are redundant; earlier unread stores they cover are dead
+		else if (opcode == OP_STORE)
+		{
+			const parameter &src = inst.param(2);
+			UINT64 mask = (bytes == 8) ? ~U64(0) : ((U64(1) << (8 * bytes)) - 1);
+			bool redundant = false;
+
+			for (memory_value &value : values)
+				if (value.base == base && value.bytes == bytes && value.size >= bytes &&
+					((value.holder.is_int_register() && value.holder == src) ||
+					(value.holder.is_immediate() && src.is_immediate() && ((value.holder.immediate() ^ src.immediate()) & mask) == 0)))
+					redundant = true;
+			if (redundant)
+			{
+				inst.nop();
+				m_optstats.stores++;
+				continue;
+			}
+
+			for (auto it = values.begin(); it != values.end(); )
+				if (overlaps(it->base, it->bytes, base, bytes))
+				{
+					if (it->store != -1 && base <= it->base && it->base + it->bytes <= base + bytes)
+					{
+						m_inst[it->store].nop();
+						m_optstats.stores++;
+					}
+					it = values.erase(it);
+				}
+				else
+					++it;
+
+			memory_value value = { base, bytes, opcode, inst.size(), (src.is_int_register() || src.is_immediate()) ? src : parameter(), instnum };
+			values.push_back(value);
+			continue;
+		}
+
+		// account for everything the instruction writes
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		{
+			const parameter &param = inst.param(pnum);
+			if (!inst.param_is_output(pnum))
+				continue;
+			if (param.is_int_register())
+			{
+				for (memory_value &value : values)
+					if (value.holder == param)
+						value.holder = parameter();
+			}
+			else if (param.is_memory())
+			{
+				drccodeptr dstbase = drccodeptr(param.memory());
+				int dstbytes = inst.param_size(pnum);
+				values.erase(std::remove_if(values.begin(), values.end(), [dstbase, dstbytes](const memory_value &value) { return overlaps(value.base, value.bytes, dstbase, dstbytes); }), values.end());
+			}
+		}
+
+		// a load into a register leaves that register holding the value
+		if (isload && opcode == inst.opcode() && inst.param(0).is_int_register())
+		{
+			bool tracked = false;
+			for (memory_value &value : values)
+				if (value.base == base && value.bytes == bytes && value.holder.type() != parameter::PTYPE_NONE)
+					tracked = true;
+			if (!tracked)
+			{
+				memory_value value = { base, bytes, opcode, inst.size(), inst.param(0), -1 };
+				values.push_back(value);
+			}
+		}
+	}
+}
+
+
+
+//-------------------------------------------------
+//  optimize_regcache - copy values that are
+//  loaded repeatedly within a region into a
+//  spare register and load them from there
+//-------------------------------------------------
+
+void drcuml_optimizer::optimize_regcache()
+{
+	// a value must be loaded at least this many more times to be worth a register
+	static const int MIN_RELOADS = 2;
+
+	// only use registers the core has given us, the back-end maps directly, and the block leaves alone
+	UINT32 freeregs = m_cacheregs & ((1 << m_direct_iregs) - 1);
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
+		for (int pnum = 0; pnum < m_inst[instnum].numparams(); pnum++)
+			if (m_inst[instnum].param(pnum).is_int_register())
+				freeregs &= ~(1 << (m_inst[instnum].param(pnum).ireg() - REG_I0));
+	if (freeregs == 0)
+		return;
+
+	int busyuntil[REG_I_COUNT];
+	for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+		busyuntil[regnum] = -1;
+
+	for (int instnum = 0; instnum < m_nextinst && m_nextinst < m_inst.size(); instnum++)
+	{
+		const instruction &inst = m_inst[instnum];
+		drccodeptr base;
+		int bytes;
+		if ((inst.opcode() != OP_LOAD && inst.opcode() != OP_LOADS) || !inst.param(0).is_int_register() || !memory_address(inst, base, bytes))
+			continue;
+
+		// find the identical loads that follow before anything can change the value
+		auto same_load = [&inst, base, bytes](const instruction &scan)
+		{
+			drccodeptr scanbase;
+			int scanbytes;
+			return (scan.opcode() == inst.opcode() && scan.size() == inst.size() && scan.param(3) == inst.param(3) &&
+					memory_address(scan, scanbase, scanbytes) && scanbase == base && scanbytes == bytes);
+		};
+		int reloads = 0;
+		int endnum;
+		for (endnum = instnum + 1; endnum < m_nextinst; endnum++)
+		{
+			const instruction &scan = m_inst[endnum];
+			if (is_region_barrier(scan) || writes_memory(scan, base, bytes))
+				break;
+			if (same_load(scan))
+				reloads++;
+		}
+		if (reloads < MIN_RELOADS)
+			continue;
+
+		// pick a register that is not holding anything else at this point
+		int cachenum = -1;
+		for (int regnum = 0; regnum < REG_I_COUNT && cachenum == -1; regnum++)
+			if ((freeregs & (1 << regnum)) != 0 && busyuntil[regnum] < instnum)
+				cachenum = regnum;
+		if (cachenum == -1)
+			continue;
+		parameter cachereg = parameter::make_ireg(REG_I0 + cachenum);
+
+		// turn the reloads into moves from the cache register
+		for (int scannum = instnum + 1; scannum < endnum; scannum++)
+			if (same_load(m_inst[scannum]))
+			{
+				if (inst.size() == 4)
+					m_inst[scannum].mov(m_inst[scannum].param(0), cachereg);
+				else
+					m_inst[scannum].dmov(m_inst[scannum].param(0), cachereg);
+				m_optstats.loads++;
+			}
+
+		// and copy the first load into it
+		std::move_backward(m_inst.begin() + instnum + 1, m_inst.begin() + m_nextinst, m_inst.begin() + m_nextinst + 1);
+		m_nextinst++;
+		if (m_inst[instnum].size() == 4)
+			m_inst[instnum + 1].mov(cachereg, m_inst[instnum].param(0));
+		else
+			m_inst[instnum + 1].dmov(cachereg, m_inst[instnum].param(0));
+		m_optstats.cached++;
+
+		// everything past the insertion point moved down by one
+		for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+			if (busyuntil[regnum] > instnum)
+				busyuntil[regnum]++;
+		busyuntil[cachenum] = endnum + 1;
+		instnum++;
+	}
+}
+
@@ -0,0 +1,85 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcumlopt.h
+
+    Optimization passes applied to UML blocks before code generation.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef MAME_DEVICES_CPU_DRCUMLOPT_H
+#define MAME_DEVICES_CPU_DRCUMLOPT_H
+
+#include "uml.h"
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// optimization passes applied to each block before it reaches the back-end
+const UINT32 DRCUML_OPT_FLAGS           = 0x00000001;       // only compute flags that are consumed
+const UINT32 DRCUML_OPT_CONSTPROP       = 0x00000002;       // propagate known register values into operands
+const UINT32 DRCUML_OPT_LOADSTORE       = 0x00000004;       // remove redundant loads and stores within a region
+const UINT32 DRCUML_OPT_REGCACHE        = 0x00000008;       // keep frequently loaded values in spare registers
+const UINT32 DRCUML_OPT_DEFAULT         = (DRCUML_OPT_FLAGS | DRCUML_OPT_CONSTPROP | DRCUML_OPT_LOADSTORE | DRCUML_OPT_REGCACHE);
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// counts of the work done by the optimization passes
+struct drcuml_opt_stats
+{
+	drcuml_opt_stats() : flags(0), constants(0), loads(0), stores(0), cached(0) { }
+
+	drcuml_opt_stats &operator+=(const drcuml_opt_stats &rhs)
+	{
+		flags += rhs.flags; constants += rhs.constants; loads += rhs.loads; stores += rhs.stores; cached += rhs.cached;
+		return *this;
+	}
+
+	UINT64              flags;              // instructions whose flag computation was dropped or trimmed
+	UINT64              constants;          // register operands replaced by immediates
+	UINT64              loads;              // loads replaced by register moves
+	UINT64              stores;             // stores removed as redundant or dead
+	UINT64              cached;             // values placed in a cache register
+};
+
+
+// a drcuml_optimizer rewrites the instructions of one block in place
+class drcuml_optimizer
+{
+public:
+	// construction/destruction
+	drcuml_optimizer(std::vector<uml::instruction> &inst, UINT32 &numinst, UINT32 optimizations, UINT32 cacheregs, int direct_iregs);
+
+	// getters
+	const drcuml_opt_stats &stats() const { return m_optstats; }
+
+	// run the enabled passes
+	void optimize();
+
+private:
+	// internal helpers
+	void optimize_flags();
+	void optimize_constants();
+	void optimize_loadstore();
+	void optimize_regcache();
+
+	// internal state
+	std::vector<uml::instruction> & m_inst;     // the instruction list, sized to the most it may hold
+	UINT32 &                m_nextinst;         // number of instructions in use
+	UINT32                  m_optimizations;    // DRCUML_OPT_* passes to run
+	UINT32                  m_cacheregs;        // integer registers the front-end leaves free
+	int                     m_direct_iregs;     // integer registers the back-end maps directly
+	drcuml_opt_stats        m_optstats;         // optimizations applied so far
+};
+
+
+#endif /* MAME_DEVICES_CPU_DRCUMLOPT_H */
@@ -27,6 +27,17 @@
 /* seems to be defined on mingw-gcc */
 #undef i386
 
+/* recompiler tuning */
+#define SINGLE_INSTRUCTION_MODE     (0)
+
+/* size of the execution code cache */
+#define CACHE_SIZE                  (32 * 1024 * 1024)
+
+/* compilation boundaries -- how far back/forward does the analysis extend? */
+#define COMPILE_BACKWARDS_BYTES     128
+#define COMPILE_FORWARDS_BYTES      512
+#define COMPILE_MAX_SEQUENCE        64
+
 const device_type I386 = &device_creator<i386_device>;
 const device_type I386SX = &device_creator<i386SX_device>;
 const device_type I486 = &device_creator<i486_device>;
@@ -45,6 +56,12 @@ i386_device::i386_device(const machine_config &mconfig, const char *tag, device_
 	, m_program_config("program", ENDIANNESS_LITTLE, 32, 32, 0)
 	, m_io_config("io", ENDIANNESS_LITTLE, 32, 16, 0)
 	, m_smiact(*this)
+	, m_drc_requested(false)
+	, m_isdrc(false)
+	, m_cache(CACHE_SIZE)
+	, m_drcuml(nullptr)
+	, m_drcfe(nullptr)
+	, m_drcoptions(I386DRC_COMPATIBLE_OPTIONS)
 {
 	m_program_config.m_logaddr_width = 32;
 	m_program_config.m_page_shift = 12;
@@ -60,6 +77,12 @@ i386_device::i386_device(const machine_config &mconfig, device_type type, const
 	, m_program_config("program", ENDIANNESS_LITTLE, program_data_width, program_addr_width, 0)
 	, m_io_config("io", ENDIANNESS_LITTLE, io_data_width, 16, 0)
 	, m_smiact(*this)
+	, m_drc_requested(false)
+	, m_isdrc(false)
+	, m_cache(CACHE_SIZE)
+	, m_drcuml(nullptr)
+	, m_drcfe(nullptr)
+	, m_drcoptions(I386DRC_COMPATIBLE_OPTIONS)
 {
 	m_program_config.m_logaddr_width = 32;
 	m_program_config.m_page_shift = 12;
@@ -3214,6 +3237,9 @@ void i386_device::i386_common_init()
 
 	assert((sizeof(XMM_REG)/sizeof(double)) == 2);
 
+	/* the recompiler is only used by drivers that ask for it */
+	m_isdrc = m_drc_requested && allow_drc();
+
 	build_cycle_table();
 
 	for( i=0; i < 256; i++ ) {
@@ -3316,6 +3342,32 @@ void i386_device::i386_common_init()
 	m_smiact.resolve_safe();
 
 	m_icountptr = &m_cycles;
+
+	/* initialize the UML generator */
+	UINT32 flags = 0;
+	m_drcuml = std::make_unique<drcuml_state>(*this, m_cache, flags, 2, 32, 0);
+
+	/* I4 and I5 only hold temporaries within a single instruction, so blocks that don't use them may cache values there */
+	m_drcuml->set_cache_registers((1 << 4) | (1 << 5));
+
+	/* add symbols for our stuff */
+	m_drcuml->symbol_add(&m_pc, sizeof(m_pc), "pc");
+	m_drcuml->symbol_add(&m_eip, sizeof(m_eip), "eip");
+	m_drcuml->symbol_add(&m_cycles, sizeof(m_cycles), "icount");
+	for (int regnum = 0; regnum < 8; regnum++)
+	{
+		char buf[10];
+		sprintf(buf, "r%d", regnum);
+		m_drcuml->symbol_add(&m_reg.d[regnum], sizeof(m_reg.d[regnum]), buf);
+	}
+
+	/* initialize the front-end helper */
+	m_drcfe = std::make_unique<i386_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
+
+	m_lockstep_mismatches = 0;
+
+	/* mark the cache dirty so it is updated on next execute */
+	m_cache_dirty = TRUE;
 }
 
 void i386_device::device_start()
@@ -3921,6 +3973,12 @@ void i386_device::i386_set_a20_line(int state)
 
 void i386_device::execute_run()
 {
+	if (m_isdrc)
+	{
+		execute_run_drc();
+		return;
+	}
+
 	int cycles = m_cycles;
 	m_base_cycles = cycles;
 	CHANGE_PC(m_eip);
@@ -3935,48 +3993,58 @@ void i386_device::execute_run()
 	while( m_cycles > 0 )
 	{
 		i386_check_irq_line();
-		m_operand_size = m_sreg[CS].d;
-		m_xmm_operand_size = 0;
-		m_address_size = m_sreg[CS].d;
-		m_operand_prefix = 0;
-		m_address_prefix = 0;
+		debugger_instruction_hook(this, m_pc);
+		i386_execute_one();
+	}
+	m_tsc += (cycles - m_cycles);
+}
 
-		m_ext = 1;
-		int old_tf = m_TF;
+/*-------------------------------------------------
+    i386_execute_one - run a single instruction,
+    including any prefixes and the trap and fault
+    handling around it
+-------------------------------------------------*/
 
-		m_segment_prefix = 0;
-		m_prev_eip = m_eip;
+void i386_device::i386_execute_one()
+{
+	m_operand_size = m_sreg[CS].d;
+	m_xmm_operand_size = 0;
+	m_address_size = m_sreg[CS].d;
+	m_operand_prefix = 0;
+	m_address_prefix = 0;
 
-		debugger_instruction_hook(this, m_pc);
+	m_ext = 1;
+	int old_tf = m_TF;
 
-		if(m_delayed_interrupt_enable != 0)
-		{
-			m_IF = 1;
-			m_delayed_interrupt_enable = 0;
-		}
+	m_segment_prefix = 0;
+	m_prev_eip = m_eip;
+
+	if(m_delayed_interrupt_enable != 0)
+	{
+		m_IF = 1;
+		m_delayed_interrupt_enable = 0;
+	}
 #ifdef DEBUG_MISSING_OPCODE
-		m_opcode_bytes_length = 0;
-		m_opcode_pc = m_pc;
+	m_opcode_bytes_length = 0;
+	m_opcode_pc = m_pc;
 #endif
-		try
-		{
-			i386_decode_opcode();
-			if(m_TF && old_tf)
-			{
-				m_prev_eip = m_eip;
-				m_ext = 1;
-				i386_trap(1,0,0);
-			}
-			if(m_lock && (m_opcode != 0xf0))
-				m_lock = false;
-		}
-		catch(UINT64 e)
+	try
+	{
+		i386_decode_opcode();
+		if(m_TF && old_tf)
 		{
+			m_prev_eip = m_eip;
 			m_ext = 1;
-			i386_trap_with_error(e&0xffffffff,0,0,e>>32);
+			i386_trap(1,0,0);
 		}
+		if(m_lock && (m_opcode != 0xf0))
+			m_lock = false;
+	}
+	catch(UINT64 e)
+	{
+		m_ext = 1;
+		i386_trap_with_error(e&0xffffffff,0,0,e>>32);
 	}
-	m_tsc += (cycles - m_cycles);
 }
 
 /*************************************************************************/
@@ -4532,3 +4600,5 @@ void pentium4_device::device_reset()
 
 	CHANGE_PC(m_eip);
 }
+
+#include "i386drc.cpp"
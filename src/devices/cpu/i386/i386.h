@@ -9,6 +9,8 @@
 #include "softfloat/softfloat.h"
 #include "debug/debugcpu.h"
 #include "divtlb.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
 
 
 #define INPUT_LINE_A20      1
@@ -22,10 +24,25 @@
 #define MCFG_I386_SMIACT(_devcb) \
 	i386_device::set_smiact(*device, DEVCB_##_devcb);
 
+/* the recompiler hasn't been validated against the interpreter yet, so drivers have to ask for it */
+#define MCFG_I386_DRC(_drc) \
+	i386_device::set_drc(*device, _drc);
+
 #define X86_NUM_CPUS        4
 
+/* recompiler options */
+#define I386DRC_STRICT_VERIFY       0x0001          /* verify all instructions */
+#define I386DRC_LOCKSTEP            0x0002          /* run register-only instructions through the interpreter as well and compare */
+
+#define I386DRC_COMPATIBLE_OPTIONS  (I386DRC_STRICT_VERIFY)
+#define I386DRC_FASTEST_OPTIONS     (0)
+
+class i386_frontend;
+
 class i386_device : public cpu_device, public device_vtlb_interface
 {
+	friend class i386_frontend;
+
 public:
 	// construction/destruction
 	i386_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
@@ -33,12 +50,15 @@ public:
 
 	// static configuration helpers
 	template<class _Object> static devcb_base &set_smiact(device_t &device, _Object object) { return downcast<i386_device &>(device).m_smiact.set_callback(object); }
+	static void set_drc(device_t &device, bool drc) { downcast<i386_device &>(device).m_drc_requested = drc; }
 
 	UINT64 debug_segbase(symbol_table &table, int params, const UINT64 *param);
 	UINT64 debug_seglimit(symbol_table &table, int params, const UINT64 *param);
 	UINT64 debug_segofftovirt(symbol_table &table, int params, const UINT64 *param);
 	UINT64 debug_virttophys(symbol_table &table, int params, const UINT64 *param);
 
+	void i386drc_set_options(UINT32 options);
+
 protected:
 	// device-level overrides
 	virtual void device_start() override;
@@ -1415,7 +1435,105 @@ struct I386_CALL_GATE
 	void pentium_smi();
 	void zero_state();
 	void i386_set_a20_line(int state);
+	void i386_execute_one();
+
+	/* recompiler state */
+	struct drc_snapshot
+	{
+		I386_GPR        reg;                        /* general purpose registers */
+		UINT8           flags[7];                   /* CF, DF, SF, OF, ZF, PF, AF */
+	};
+
+	/* internal compiler state */
+	struct compiler_state
+	{
+		UINT32          cycles;                     /* accumulated cycles */
+		UINT8           mode;                       /* privilege mode (user or supervisor) being compiled */
+		uml::code_label labelnum;                   /* index for local labels */
+	};
+
+	bool                m_drc_requested;            /* true if the driver asked for the recompiler */
+	bool                m_isdrc;                    /* true if the recompiler is in use */
+	drc_cache           m_cache;                    /* pointer to the DRC code cache */
+	std::unique_ptr<drcuml_state> m_drcuml;         /* DRC UML generator state */
+	std::unique_ptr<i386_frontend> m_drcfe;         /* pointer to the DRC front-end state */
+	UINT32              m_drcoptions;               /* configurable DRC options */
+	UINT8               m_cache_dirty;              /* true if we need to flush the cache */
+
+	/* translation state the cache was built against */
+	UINT32              m_drc_cr0;
+	UINT32              m_drc_cr3;
+	UINT32              m_drc_cr4;
+	UINT32              m_drc_a20;
+
+	/* communication with C helpers */
+	UINT32              m_drc_arg0;                 /* pc the compiled code expects next */
+	UINT32              m_drc_arg1;                 /* mode the compiled code was built for */
+	UINT32              m_drc_result;               /* how the compiled code should continue */
+
+	uml::code_handle *  m_entry;                    /* entry point */
+	uml::code_handle *  m_nocode;                   /* nocode */
+	uml::code_handle *  m_out_of_cycles;            /* out of cycles exception handler */
+
+	/* lockstep validation against the interpreter */
+	drc_snapshot        m_lockstep_input;           /* state before the instruction */
+	drc_snapshot        m_lockstep_result;          /* state after the interpreter ran it */
+	UINT32              m_lockstep_mismatches;      /* number of instructions that disagreed */
+
+public:
+	void func_execute_one();
+	void func_lockstep_save();
+	void func_lockstep_check();
+
+protected:
+	bool drc_eligible();
+	void drc_take_snapshot(drc_snapshot &snap);
+	void drc_restore_snapshot(const drc_snapshot &snap);
+	inline void alloc_handle(drcuml_state *drcuml, uml::code_handle **handleptr, const char *name);
+	void code_flush_cache();
+	void execute_run_drc();
+	void code_compile_block(UINT8 mode, offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void log_opcode_desc(drcuml_state *drcuml, const opcode_desc *desclist);
+	void generate_set_pc(drcuml_block *block, uml::parameter param);
+	void generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception);
+	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_interpreter_call(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_flags_szp(drcuml_block *block, uml::parameter result);
+	void generate_alu(drcuml_block *block, int op, uml::parameter dst, uml::parameter src);
+	void generate_effective_address(drcuml_block *block, uml::parameter dst, const opcode_desc *desc, UINT8 modrm);
+	int generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	int generate_jcc(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT8 cond, int taken_cycles, int nottaken_cycles);
+};
+
+
+/***************************************************************************
+    COMPILER-SPECIFIC OPTIONS
+***************************************************************************/
+
+/* userflags on the descriptors handed back by the front end */
+#define I386UF_FLUSH_CACHE      0x0001      /* instruction can change address translation */
+#define I386UF_PREFIXED         0x0002      /* instruction has prefix bytes */
+#define I386UF_INCOMPLETE       0x0004      /* instruction bytes could not all be fetched */
+
+class i386_frontend : public drc_frontend
+{
+public:
+	i386_frontend(i386_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+	UINT8 m_mode;                       /* privilege mode the next describe_code runs under */
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+
+private:
+	int fetch_bytes(offs_t pc, offs_t &physpc, UINT8 *dest, int count);
+	static int modrm_length(const UINT8 *bytes, int address32);
 
+	i386_device *m_i386;
 };
 
 
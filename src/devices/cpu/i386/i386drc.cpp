@@ -0,0 +1,1108 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    i386drc.c
+    Universal machine language-based i386 emulator.
+
+    This file is #included from i386.cpp so that the recompiler can share
+    the interpreter's private helpers.
+
+    Only 32-bit protected mode code is recompiled.  Real mode, virtual 8086
+    mode and 16-bit code segments stay on the interpreter, as does every
+    instruction the generator below does not translate natively: those are
+    run one at a time through the interpreter from inside the compiled code.
+
+    Blocks are hashed on the linear PC, so the CS base is folded into the
+    key, and compiled separately for user and supervisor mode.  The cache
+    is thrown away whenever the address translation it was built against
+    changes.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "debugger.h"
+#include "i386priv.h"
+#include "i386.h"
+#include "cpu/drcumlsh.h"
+
+using namespace uml;
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* exit codes */
+#define EXECUTE_OUT_OF_CYCLES       0
+#define EXECUTE_MISSING_CODE        1
+#define EXECUTE_DISPATCH            2
+#define EXECUTE_RESET_CACHE         3
+
+/* compiler modes; blocks are compiled separately for CPL 3 */
+#define MODE_USER                   1
+
+/* how compiled code continues after running an instruction through the interpreter */
+#define DRC_RESULT_NEXT             0
+#define DRC_RESULT_BRANCH           1
+#define DRC_RESULT_EXIT             2
+
+/* CR0 bits that affect address translation */
+#define CR0_TRANSLATION_MASK        0x80010001
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define PM_CYCLES(x)        (m_cycle_table_pm[x])
+
+#define UML_LOAD_REG32(block, dst, reg)     UML_LOAD(block, dst, &m_reg.d[reg], 0, SIZE_DWORD, SCALE_x4)
+#define UML_STORE_REG32(block, reg, src)    UML_STORE(block, &m_reg.d[reg], 0, src, SIZE_DWORD, SCALE_x4)
+#define LOAD_FLAG(block, dst, flag)         UML_LOAD(block, dst, &flag, 0, SIZE_BYTE, SCALE_x1)
+#define STORE_FLAG(block, flag, src)        UML_STORE(block, &flag, 0, src, SIZE_BYTE, SCALE_x1)
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+void i386_device::alloc_handle(drcuml_state *drcuml, code_handle **handleptr, const char *name)
+{
+	if (*handleptr == nullptr)
+		*handleptr = drcuml->handle_alloc(name);
+}
+
+/*-------------------------------------------------
+    fetch_imm32 - pull a little-endian 32-bit
+    immediate out of the opcode bytes
+-------------------------------------------------*/
+
+static inline UINT32 fetch_imm32(const UINT8 *bytes)
+{
+	return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
+}
+
+/*-------------------------------------------------
+    drc_eligible - return true if the current
+    state can run compiled code
+-------------------------------------------------*/
+
+bool i386_device::drc_eligible()
+{
+	return PROTECTED_MODE && !V8086_MODE && m_sreg[CS].d && !m_TF && !m_halted && !m_lock && !m_delayed_interrupt_enable;
+}
+
+/*-------------------------------------------------
+    drc_take_snapshot - capture the state that
+    native instructions can change
+-------------------------------------------------*/
+
+void i386_device::drc_take_snapshot(drc_snapshot &snap)
+{
+	memset(&snap, 0, sizeof(snap));
+	snap.reg = m_reg;
+	snap.flags[0] = m_CF;
+	snap.flags[1] = m_DF;
+	snap.flags[2] = m_SF;
+	snap.flags[3] = m_OF;
+	snap.flags[4] = m_ZF;
+	snap.flags[5] = m_PF;
+	snap.flags[6] = m_AF;
+}
+
+/*-------------------------------------------------
+    drc_restore_snapshot - put a captured state
+    back
+-------------------------------------------------*/
+
+void i386_device::drc_restore_snapshot(const drc_snapshot &snap)
+{
+	m_reg = snap.reg;
+	m_CF = snap.flags[0];
+	m_DF = snap.flags[1];
+	m_SF = snap.flags[2];
+	m_OF = snap.flags[3];
+	m_ZF = snap.flags[4];
+	m_PF = snap.flags[5];
+	m_AF = snap.flags[6];
+}
+
+/*-------------------------------------------------
+    cfunc_execute_one - run a single instruction
+    through the interpreter
+-------------------------------------------------*/
+
+static void cfunc_execute_one(void *param)
+{
+	((i386_device *)param)->func_execute_one();
+}
+
+void i386_device::func_execute_one()
+{
+	// pc and eip already point at the instruction; arg0 is where the compiled code expects to go next
+	i386_execute_one();
+
+	// faults, mode switches and anything that changes translation go back to the dispatcher
+	if (!drc_eligible() || ((m_CPL == 3) ? MODE_USER : 0) != m_drc_arg1 || m_cache_dirty ||
+		(m_cr[0] & CR0_TRANSLATION_MASK) != m_drc_cr0 || m_cr[3] != m_drc_cr3 || m_cr[4] != m_drc_cr4 || m_a20_mask != m_drc_a20)
+		m_drc_result = DRC_RESULT_EXIT;
+	else if (m_pc != m_drc_arg0)
+		m_drc_result = DRC_RESULT_BRANCH;
+	else
+		m_drc_result = DRC_RESULT_NEXT;
+}
+
+/*-------------------------------------------------
+    cfunc_lockstep_save - remember the state
+    before a natively compiled instruction
+-------------------------------------------------*/
+
+static void cfunc_lockstep_save(void *param)
+{
+	((i386_device *)param)->func_lockstep_save();
+}
+
+void i386_device::func_lockstep_save()
+{
+	drc_take_snapshot(m_lockstep_input);
+}
+
+/*-------------------------------------------------
+    cfunc_lockstep_check - run the instruction
+    the compiled code just executed through the
+    interpreter and compare the results
+-------------------------------------------------*/
+
+static void cfunc_lockstep_check(void *param)
+{
+	((i386_device *)param)->func_lockstep_check();
+}
+
+void i386_device::func_lockstep_check()
+{
+	drc_snapshot drc;
+	UINT32 eip = m_eip, pc = m_pc;
+	int cycles = m_cycles;
+
+	drc_take_snapshot(drc);
+	drc_restore_snapshot(m_lockstep_input);
+
+	// compiled code doesn't keep pc or the cycle count up to date, so put those back afterwards
+	m_pc = m_drc_arg0;
+	m_eip = m_pc - m_sreg[CS].base;
+	i386_execute_one();
+	drc_take_snapshot(m_lockstep_result);
+	m_eip = eip;
+	m_pc = pc;
+	m_cycles = cycles;
+
+	if (memcmp(&drc, &m_lockstep_result, sizeof(drc)) != 0)
+	{
+		logerror("i386drc: lockstep mismatch at %08X\n", m_drc_arg0);
+		m_lockstep_mismatches++;
+
+		// the interpreter's result is already in place; carry on with it
+	}
+}
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void i386_device::code_flush_cache()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+
+	/* empty the transient cache contents */
+	drcuml->reset();
+
+	try
+	{
+		/* generate the entry point and out-of-cycles handlers */
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+		static_generate_entry_point();
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unable to generate i386 static code\n");
+	}
+
+	/* remember the translation the new cache belongs to */
+	m_drc_cr0 = m_cr[0] & CR0_TRANSLATION_MASK;
+	m_drc_cr3 = m_cr[3];
+	m_drc_cr4 = m_cr[4];
+	m_drc_a20 = m_a20_mask;
+	m_cache_dirty = FALSE;
+}
+
+/* Execute cycles - returns number of cycles actually run */
+void i386_device::execute_run_drc()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	int cycles = m_cycles;
+	int execute_result;
+
+	m_base_cycles = cycles;
+	CHANGE_PC(m_eip);
+
+	if (m_halted)
+	{
+		m_tsc += cycles;
+		m_cycles = 0;
+		return;
+	}
+
+	while (m_cycles > 0)
+	{
+		i386_check_irq_line();
+
+		/* reset the cache if dirty or if paging has changed under it */
+		if (m_cache_dirty || (m_cr[0] & CR0_TRANSLATION_MASK) != m_drc_cr0 || m_cr[3] != m_drc_cr3 || m_cr[4] != m_drc_cr4 || m_a20_mask != m_drc_a20)
+			code_flush_cache();
+
+		/* real mode, V86 mode and 16-bit code go through the interpreter */
+		if (!drc_eligible())
+		{
+			debugger_instruction_hook(this, m_pc);
+			i386_execute_one();
+			continue;
+		}
+
+		/* run as much as we can */
+		execute_result = drcuml->execute(*m_entry);
+
+		/* if we need to recompile, do it */
+		if (execute_result == EXECUTE_MISSING_CODE)
+			code_compile_block((m_CPL == 3) ? MODE_USER : 0, m_pc);
+		else if (execute_result == EXECUTE_RESET_CACHE)
+			m_cache_dirty = TRUE;
+	}
+	m_tsc += (cycles - m_cycles);
+}
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of the
+    given mode at the specified pc
+-------------------------------------------------*/
+
+void i386_device::code_compile_block(UINT8 mode, offs_t pc)
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqhead, *seqlast;
+	const opcode_desc *desclist;
+	int override = FALSE;
+	drcuml_block *block;
+
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* get a description of this sequence */
+	m_drcfe->m_mode = mode;
+	desclist = m_drcfe->describe_code(pc);
+	if (drcuml->logging() || drcuml->logging_native())
+		log_opcode_desc(drcuml, desclist);
+
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* start the block */
+			block = drcuml->begin_block(8192);
+
+			/* loop until we get through all instruction sequences */
+			compiler.mode = mode;
+			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				UINT32 nextpc;
+
+				/* add a code log entry */
+				if (drcuml->logging())
+					block->append_comment("-------------------------");                 // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				if (override || !drcuml->hash_exists(mode, seqhead->pc))
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = TRUE;
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);                       // hashjmp <mode>,seqhead->pc,nocode
+					continue;
+				}
+
+				/* validate this code block if we're not pointing into ROM */
+				if (!(seqhead->flags & OPFLAG_COMPILER_PAGE_FAULT) && m_program->get_write_ptr(seqhead->physpc) != nullptr)
+					generate_checksum_block(block, &compiler, seqhead, seqlast);
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, &compiler, curdesc);
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+					nextpc = pc;
+
+				/* otherwise we just go to the next instruction */
+				else
+					nextpc = seqlast->pc + seqlast->length;
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, &compiler, nextpc, TRUE);                     // <subtract cycles>
+				if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, mode, nextpc, *m_nocode);                            // hashjmp <mode>,nextpc,nocode
+			}
+
+			/* end the sequence */
+			block->end();
+			g_profiler.stop();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void i386_device::static_generate_entry_point()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(20);
+
+	/* forward references */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+	alloc_handle(drcuml, &m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                                                // handle  entry
+
+	/* generate a hash jump via the current mode and PC */
+	UML_LOAD(block, I4, &m_pc, 0, SIZE_DWORD, SCALE_x1);                        // load    i4,[pc]
+	LOAD_FLAG(block, I0, m_CPL);                                                // load    i0,[cpl]
+	UML_CMP(block, I0, 3);                                                      // cmp     i0,3
+	UML_SETc(block, COND_E, I0);                                                // sete    i0
+	UML_HASHJMP(block, I0, I4, *m_nocode);                                      // hashjmp i0,i4,nocode
+
+	block->end();
+}
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void i386_device::static_generate_nocode_handler()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(20);
+
+	/* store the PC and exit */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                               // handle  nocode
+	UML_GETEXP(block, I4);                                                      // getexp  i4
+	generate_set_pc(block, I4);
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                      // exit    EXECUTE_MISSING_CODE
+
+	block->end();
+}
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void i386_device::static_generate_out_of_cycles()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(20);
+
+	/* store the PC and exit */
+	alloc_handle(drcuml, &m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                        // handle  out_of_cycles
+	UML_GETEXP(block, I4);                                                      // getexp  i4
+	generate_set_pc(block, I4);
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                     // exit    EXECUTE_OUT_OF_CYCLES
+
+	block->end();
+}
+
+/*-------------------------------------------------
+    log_opcode_desc - log a list of descriptions
+-------------------------------------------------*/
+
+void i386_device::log_opcode_desc(drcuml_state *drcuml, const opcode_desc *desclist)
+{
+	drcuml->log_printf("\nDescriptor list @ %08X\n", desclist->pc);
+
+	/* output each descriptor */
+	for ( ; desclist != nullptr; desclist = desclist->next())
+	{
+		char buffer[100];
+
+		/* disassemle the current instruction and output it to the log */
+		if (desclist->flags & OPFLAG_VIRTUAL_NOOP)
+			strcpy(buffer, "<virtual nop>");
+		else
+			i386_dasm_one(buffer, desclist->pc, desclist->opptr.b, 32);
+		drcuml->log_printf("%08X [%08X] t:%08X f:%08X u:%X: %s\n", desclist->pc, desclist->physpc, desclist->targetpc, desclist->flags, desclist->userflags, buffer);
+
+		/* at the end of a sequence add a dividing line */
+		if (desclist->flags & OPFLAG_END_SEQUENCE)
+			drcuml->log_printf("-----\n");
+	}
+}
+
+/*-------------------------------------------------
+    generate_set_pc - generate code to store a
+    linear PC and the matching EIP; param must
+    not be I0
+-------------------------------------------------*/
+
+void i386_device::generate_set_pc(drcuml_block *block, uml::parameter param)
+{
+	UML_STORE(block, &m_pc, 0, param, SIZE_DWORD, SCALE_x1);                    // store   [pc],param
+	UML_LOAD(block, I0, &m_sreg[CS].base, 0, SIZE_DWORD, SCALE_x1);             // load    i0,[cs.base]
+	UML_SUB(block, I0, param, I0);                                              // sub     i0,param,i0
+	UML_STORE(block, &m_eip, 0, I0, SIZE_DWORD, SCALE_x1);                      // store   [eip],i0
+}
+
+/*-------------------------------------------------
+    generate_update_cycles - generate code to
+    subtract cycles from the icount and generate
+    an exception if out
+-------------------------------------------------*/
+
+void i386_device::generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception)
+{
+	/* account for cycles */
+	if (compiler->cycles > 0)
+	{
+		UML_LOAD(block, I0, &m_cycles, 0, SIZE_DWORD, SCALE_x1);                // load    i0,[cycles]
+		UML_SUB(block, I0, I0, compiler->cycles);                               // sub     i0,i0,cycles
+		UML_STORE(block, &m_cycles, 0, I0, SIZE_DWORD, SCALE_x1);               // store   [cycles],i0
+	}
+	compiler->cycles = 0;
+
+	if (allow_exception)
+	{
+		code_label skip = compiler->labelnum++;
+
+		/* pending interrupts and SMIs are taken by the dispatcher, as in the interpreter loop */
+		LOAD_FLAG(block, I0, m_irq_state);                                      // load    i0,[irq_state]
+		UML_CMP(block, I0, 0);                                                  // cmp     i0,0
+		UML_SETc(block, COND_NE, I0);                                           // setne   i0
+		LOAD_FLAG(block, I1, m_IF);                                             // load    i1,[if]
+		UML_AND(block, I0, I0, I1);                                             // and     i0,i0,i1
+		UML_LOAD(block, I1, &m_smi, 0, SIZE_BYTE, SCALE_x1);                    // load    i1,[smi]
+		UML_LOAD(block, I2, &m_smm, 0, SIZE_BYTE, SCALE_x1);                    // load    i2,[smm]
+		UML_XOR(block, I2, I2, 1);                                              // xor     i2,i2,1
+		UML_AND(block, I1, I1, I2);                                             // and     i1,i1,i2
+		UML_OR(block, I0, I0, I1);                                              // or      i0,i0,i1
+		UML_CMP(block, I0, 0);                                                  // cmp     i0,0
+		UML_JMPc(block, COND_Z, skip);                                          // jz      skip
+		generate_set_pc(block, param);
+		UML_EXIT(block, EXECUTE_DISPATCH);                                      // exit    EXECUTE_DISPATCH
+		UML_LABEL(block, skip);                                                 // skip:
+
+		UML_LOAD(block, I0, &m_cycles, 0, SIZE_DWORD, SCALE_x1);                // load    i0,[cycles]
+		UML_CMP(block, I0, 0);                                                  // cmp     i0,0
+		UML_EXHc(block, COND_LE, *m_out_of_cycles, param);                      // exh     out_of_cycles,param
+	}
+}
+
+/*-------------------------------------------------
+    generate_checksum_block - generate code to
+    validate a sequence of opcodes
+-------------------------------------------------*/
+
+void i386_device::generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	const opcode_desc *curdesc;
+	if (m_drcuml->logging())
+		block->append_comment("[Validation for %08X]", seqhead->pc);            // comment
+
+	/* loose verify or single instruction: just compare the first instruction and fail */
+	if (!(m_drcoptions & I386DRC_STRICT_VERIFY) || seqhead->next() == nullptr)
+	{
+		/* bytes past the end of the page live somewhere else physically */
+		int count = std::min<int>(seqhead->length, 0x1000 - (seqhead->physpc & 0xfff));
+		for (int index = 0; index < count; index++)
+		{
+			void *base = m_direct->read_ptr(seqhead->physpc + index);
+			if (base != nullptr)
+			{
+				UML_LOAD(block, I0, base, 0, SIZE_BYTE, SCALE_x1);              // load    i0,base,byte
+				UML_CMP(block, I0, seqhead->opptr.b[index]);                    // cmp     i0,*opptr
+				UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);               // exne    nocode,seqhead->pc
+			}
+		}
+	}
+
+	/* full verification; sum up everything */
+	else
+	{
+		UINT32 sum = 0;
+		UML_MOV(block, I0, 0);                                                  // mov     i0,0
+		for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+			if (!(curdesc->flags & OPFLAG_VIRTUAL_NOOP))
+			{
+				int count = std::min<int>(curdesc->length, 0x1000 - (curdesc->physpc & 0xfff));
+				for (int index = 0; index < count; index++)
+				{
+					void *base = m_direct->read_ptr(curdesc->physpc + index);
+					if (base == nullptr)
+						continue;
+					UML_LOAD(block, I1, base, 0, SIZE_BYTE, SCALE_x1);          // load    i1,base,byte
+					UML_ADD(block, I0, I0, I1);                                 // add     i0,i0,i1
+					sum += curdesc->opptr.b[index];
+				}
+			}
+		UML_CMP(block, I0, sum);                                                // cmp     i0,sum
+		UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);                       // exne    nocode,seqhead->pc
+	}
+}
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void i386_device::generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	/* add an entry for the log */
+	if (m_drcuml->logging() && !(desc->flags & OPFLAG_VIRTUAL_NOOP))
+	{
+		char buffer[100];
+		i386_dasm_one(buffer, desc->pc, desc->opptr.b, 32);
+		block->append_comment("%08X: %s", desc->pc, buffer);                    // comment
+	}
+
+	/* if we are debugging, call the debugger */
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		generate_update_cycles(block, compiler, desc->pc, FALSE);
+		generate_set_pc(block, desc->pc);
+		UML_DEBUG(block, desc->pc);                                             // debug   desc->pc
+	}
+
+	/* a page fault at fetch time is raised by letting the interpreter fetch the instruction */
+	if (desc->flags & OPFLAG_COMPILER_PAGE_FAULT)
+	{
+		generate_interpreter_call(block, compiler, desc);
+		return;
+	}
+
+	/* register-only instructions can be checked against the interpreter */
+	bool lockstep = (m_drcoptions & I386DRC_LOCKSTEP) && !(desc->flags & OPFLAG_IS_BRANCH);
+	if (lockstep)
+		UML_CALLC(block, cfunc_lockstep_save, this);                            // callc   cfunc_lockstep_save
+
+	/* compile the instruction, or hand it to the interpreter */
+	if (!generate_opcode(block, compiler, desc))
+		generate_interpreter_call(block, compiler, desc);
+	else if (lockstep)
+	{
+		UML_STORE(block, &m_drc_arg0, 0, desc->pc, SIZE_DWORD, SCALE_x1);      // store   [arg0],desc->pc
+		UML_CALLC(block, cfunc_lockstep_check, this);                           // callc   cfunc_lockstep_check
+	}
+}
+
+/*-------------------------------------------------
+    generate_interpreter_call - run an instruction
+    we don't translate through the interpreter
+-------------------------------------------------*/
+
+void i386_device::generate_interpreter_call(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	code_label next = compiler->labelnum++;
+	code_label branch = compiler->labelnum++;
+
+	/* the interpreter counts its own cycles, so settle ours first */
+	generate_update_cycles(block, compiler, desc->pc, TRUE);                    // <subtract cycles>
+	generate_set_pc(block, desc->pc);
+	UML_STORE(block, &m_drc_arg0, 0, desc->pc + desc->length, SIZE_DWORD, SCALE_x1);   // store   [arg0],nextpc
+	UML_STORE(block, &m_drc_arg1, 0, compiler->mode, SIZE_DWORD, SCALE_x1);    // store   [arg1],mode
+	UML_CALLC(block, cfunc_execute_one, this);                                  // callc   cfunc_execute_one
+
+	/* anything that can change translation throws the cache away */
+	if (desc->userflags & I386UF_FLUSH_CACHE)
+	{
+		UML_EXIT(block, EXECUTE_RESET_CACHE);                                   // exit    EXECUTE_RESET_CACHE
+		return;
+	}
+
+	UML_LOAD(block, I0, &m_drc_result, 0, SIZE_DWORD, SCALE_x1);                // load    i0,[result]
+	UML_CMP(block, I0, DRC_RESULT_NEXT);                                        // cmp     i0,DRC_RESULT_NEXT
+	UML_JMPc(block, COND_E, next);                                              // je      next
+	UML_CMP(block, I0, DRC_RESULT_EXIT);                                        // cmp     i0,DRC_RESULT_EXIT
+	UML_JMPc(block, COND_NE, branch);                                           // jne     branch
+	UML_EXIT(block, EXECUTE_DISPATCH);                                          // exit    EXECUTE_DISPATCH
+
+	/* the instruction branched without leaving the mode; go straight there */
+	UML_LABEL(block, branch);                                                   // branch:
+	UML_LOAD(block, I4, &m_pc, 0, SIZE_DWORD, SCALE_x1);                        // load    i4,[pc]
+	generate_update_cycles(block, compiler, I4, TRUE);                          // <check cycles>
+	UML_HASHJMP(block, compiler->mode, I4, *m_nocode);                          // hashjmp <mode>,i4,nocode
+
+	UML_LABEL(block, next);                                                     // next:
+}
+
+/*-------------------------------------------------
+    generate_flags_szp - set ZF, SF and PF from a
+    32-bit result
+-------------------------------------------------*/
+
+void i386_device::generate_flags_szp(drcuml_block *block, uml::parameter result)
+{
+	UML_CMP(block, result, 0);                                                  // cmp     result,0
+	UML_SETc(block, COND_E, I3);                                                // sete    i3
+	STORE_FLAG(block, m_ZF, I3);                                                // store   [zf],i3
+	UML_SHR(block, I3, result, 31);                                             // shr     i3,result,31
+	STORE_FLAG(block, m_SF, I3);                                                // store   [sf],i3
+	UML_AND(block, I3, result, 0xff);                                           // and     i3,result,0xff
+	UML_LOAD(block, I3, i386_parity_table, I3, SIZE_DWORD, SCALE_x4);           // load    i3,parity_table,i3,dword
+	STORE_FLAG(block, m_PF, I3);                                                // store   [pf],i3
+}
+
+/*-------------------------------------------------
+    generate_alu - compute one of ADD, OR, AND,
+    SUB, XOR or CMP of dst (I0) and src into I2,
+    setting the flags the way the interpreter's
+    helpers do
+-------------------------------------------------*/
+
+void i386_device::generate_alu(drcuml_block *block, int op, uml::parameter dst, uml::parameter src)
+{
+	switch (op)
+	{
+		case 0:     // ADD
+			UML_ADD(block, I2, dst, src);                                       // add     i2,dst,src
+			UML_CMP(block, I2, dst);                                            // cmp     i2,dst
+			UML_SETc(block, COND_B, I3);                                        // setb    i3
+			STORE_FLAG(block, m_CF, I3);                                        // store   [cf],i3
+			UML_XOR(block, I3, I2, src);                                        // xor     i3,i2,src
+			UML_XOR(block, I5, I2, dst);                                        // xor     i5,i2,dst
+			UML_AND(block, I3, I3, I5);                                         // and     i3,i3,i5
+			UML_SHR(block, I3, I3, 31);                                         // shr     i3,i3,31
+			STORE_FLAG(block, m_OF, I3);                                        // store   [of],i3
+			break;
+
+		case 5:     // SUB
+		case 7:     // CMP
+			UML_SUB(block, I2, dst, src);                                       // sub     i2,dst,src
+			UML_CMP(block, dst, src);                                           // cmp     dst,src
+			UML_SETc(block, COND_B, I3);                                        // setb    i3
+			STORE_FLAG(block, m_CF, I3);                                        // store   [cf],i3
+			UML_XOR(block, I3, dst, src);                                       // xor     i3,dst,src
+			UML_XOR(block, I5, dst, I2);                                        // xor     i5,dst,i2
+			UML_AND(block, I3, I3, I5);                                         // and     i3,i3,i5
+			UML_SHR(block, I3, I3, 31);                                         // shr     i3,i3,31
+			STORE_FLAG(block, m_OF, I3);                                        // store   [of],i3
+			break;
+
+		case 1:     // OR
+		case 4:     // AND
+		case 6:     // XOR
+			if (op == 1)
+				UML_OR(block, I2, dst, src);                                    // or      i2,dst,src
+			else if (op == 4)
+				UML_AND(block, I2, dst, src);                                   // and     i2,dst,src
+			else
+				UML_XOR(block, I2, dst, src);                                   // xor     i2,dst,src
+			STORE_FLAG(block, m_CF, 0);                                         // store   [cf],0
+			STORE_FLAG(block, m_OF, 0);                                         // store   [of],0
+			generate_flags_szp(block, I2);
+			return;
+	}
+
+	/* the adjust flag for ADD and SUB */
+	UML_XOR(block, I3, I2, src);                                                // xor     i3,i2,src
+	UML_XOR(block, I3, I3, dst);                                                // xor     i3,i3,dst
+	UML_SHR(block, I3, I3, 4);                                                  // shr     i3,i3,4
+	UML_AND(block, I3, I3, 1);                                                  // and     i3,i3,1
+	STORE_FLAG(block, m_AF, I3);                                                // store   [af],i3
+	generate_flags_szp(block, I2);
+}
+
+/*-------------------------------------------------
+    generate_effective_address - compute a 32-bit
+    ModR/M memory operand address without a
+    segment, as LEA does
+-------------------------------------------------*/
+
+void i386_device::generate_effective_address(drcuml_block *block, uml::parameter dst, const opcode_desc *desc, UINT8 modrm)
+{
+	const UINT8 *bytes = &desc->opptr.b[2];
+	UINT8 mod = modrm >> 6;
+	UINT8 rm = modrm & 7;
+	bool have_base = true;
+	bool disp32 = (mod == 2);
+	INT32 disp = 0;
+
+	UML_MOV(block, dst, 0);                                                     // mov     dst,0
+	if (rm == 4)
+	{
+		UINT8 sib = *bytes++;
+		UINT8 base = sib & 7;
+		UINT8 index = (sib >> 3) & 7;
+
+		if (base == 5 && mod == 0)
+		{
+			have_base = false;
+			disp32 = true;
+		}
+		else
+			UML_LOAD_REG32(block, dst, base);                                   // load    dst,[base]
+		if (index != 4)
+		{
+			UML_LOAD_REG32(block, I1, index);                                   // load    i1,[index]
+			UML_SHL(block, I1, I1, sib >> 6);                                   // shl     i1,i1,scale
+			UML_ADD(block, dst, dst, I1);                                       // add     dst,dst,i1
+		}
+	}
+	else if (rm == 5 && mod == 0)
+	{
+		have_base = false;
+		disp32 = true;
+	}
+	else
+		UML_LOAD_REG32(block, dst, rm);                                         // load    dst,[rm]
+
+	if (mod == 1)
+		disp = (INT8)bytes[0];
+	else if (disp32)
+		disp = (INT32)fetch_imm32(bytes);
+	if (disp != 0 || !have_base)
+		UML_ADD(block, dst, dst, disp);                                         // add     dst,dst,disp
+}
+
+/*-------------------------------------------------
+    generate_jcc - generate a conditional branch
+    on one of the sixteen x86 conditions
+-------------------------------------------------*/
+
+int i386_device::generate_jcc(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT8 cond, int taken_cycles, int nottaken_cycles)
+{
+	code_label skip = compiler->labelnum++;
+	compiler_state compiler_temp;
+
+	if (desc->targetpc == BRANCH_TARGET_DYNAMIC)
+		return FALSE;
+
+	/* evaluate the even-numbered condition into I0 */
+	switch (cond >> 1)
+	{
+		case 0:     // O
+			LOAD_FLAG(block, I0, m_OF);                                         // load    i0,[of]
+			break;
+
+		case 1:     // B
+			LOAD_FLAG(block, I0, m_CF);                                         // load    i0,[cf]
+			break;
+
+		case 2:     // Z
+			LOAD_FLAG(block, I0, m_ZF);                                         // load    i0,[zf]
+			break;
+
+		case 3:     // BE
+			LOAD_FLAG(block, I0, m_CF);                                         // load    i0,[cf]
+			LOAD_FLAG(block, I1, m_ZF);                                         // load    i1,[zf]
+			UML_OR(block, I0, I0, I1);                                          // or      i0,i0,i1
+			break;
+
+		case 4:     // S
+			LOAD_FLAG(block, I0, m_SF);                                         // load    i0,[sf]
+			break;
+
+		case 5:     // P
+			LOAD_FLAG(block, I0, m_PF);                                         // load    i0,[pf]
+			break;
+
+		case 6:     // L
+			LOAD_FLAG(block, I0, m_SF);                                         // load    i0,[sf]
+			LOAD_FLAG(block, I1, m_OF);                                         // load    i1,[of]
+			UML_XOR(block, I0, I0, I1);                                         // xor     i0,i0,i1
+			break;
+
+		case 7:     // LE
+			LOAD_FLAG(block, I0, m_SF);                                         // load    i0,[sf]
+			LOAD_FLAG(block, I1, m_OF);                                         // load    i1,[of]
+			UML_XOR(block, I0, I0, I1);                                         // xor     i0,i0,i1
+			LOAD_FLAG(block, I1, m_ZF);                                         // load    i1,[zf]
+			UML_OR(block, I0, I0, I1);                                          // or      i0,i0,i1
+			break;
+	}
+
+	/* odd conditions are the inverse */
+	UML_CMP(block, I0, 0);                                                      // cmp     i0,0
+	UML_JMPc(block, (cond & 1) ? COND_NZ : COND_Z, skip);                       // jz/jnz  skip
+
+	/* taken path */
+	compiler_temp = *compiler;
+	compiler_temp.cycles += taken_cycles;
+	generate_update_cycles(block, &compiler_temp, desc->targetpc, TRUE);        // <subtract cycles>
+	UML_HASHJMP(block, compiler->mode, desc->targetpc, *m_nocode);              // hashjmp <mode>,targetpc,nocode
+
+	UML_LABEL(block, skip);                                                     // skip:
+	compiler->labelnum = compiler_temp.labelnum;
+	compiler->cycles += nottaken_cycles;
+	return TRUE;
+}
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a specific
+    opcode; only register forms without prefixes
+    are translated, everything else returns FALSE
+    and goes through the interpreter
+-------------------------------------------------*/
+
+int i386_device::generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	const UINT8 *bytes = desc->opptr.b;
+	UINT8 opcode = bytes[0];
+	UINT8 modrm = bytes[1];
+	int op;
+
+	if (desc->userflags & (I386UF_PREFIXED | I386UF_INCOMPLETE))
+		return FALSE;
+
+	switch (opcode)
+	{
+		case 0x01: case 0x09: case 0x21: case 0x29: case 0x31: case 0x39:   // ALU r/m32,r32
+		case 0x03: case 0x0b: case 0x23: case 0x2b: case 0x33: case 0x3b:   // ALU r32,r/m32
+		{
+			if (modrm < 0xc0)
+				return FALSE;
+			int dstreg = (opcode & 2) ? ((modrm >> 3) & 7) : (modrm & 7);
+			int srcreg = (opcode & 2) ? (modrm & 7) : ((modrm >> 3) & 7);
+			op = opcode >> 3;
+			UML_LOAD_REG32(block, I0, dstreg);                                  // load    i0,[dst]
+			UML_LOAD_REG32(block, I1, srcreg);                                  // load    i1,[src]
+			generate_alu(block, op, I0, I1);
+			if (op != 7)
+				UML_STORE_REG32(block, dstreg, I2);                             // store   [dst],i2
+			compiler->cycles += PM_CYCLES((op == 7) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG);
+			return TRUE;
+		}
+
+		case 0x05: case 0x0d: case 0x25: case 0x2d: case 0x35: case 0x3d:   // ALU EAX,imm32
+			op = opcode >> 3;
+			UML_LOAD_REG32(block, I0, EAX);                                     // load    i0,[eax]
+			generate_alu(block, op, I0, fetch_imm32(&bytes[1]));
+			if (op != 7)
+				UML_STORE_REG32(block, EAX, I2);                                // store   [eax],i2
+			compiler->cycles += PM_CYCLES((op == 7) ? CYCLES_CMP_IMM_ACC : CYCLES_ALU_IMM_ACC);
+			return TRUE;
+
+		case 0x81:  // ALU r/m32,imm32
+		case 0x83:  // ALU r/m32,imm8
+		{
+			op = (modrm >> 3) & 7;
+			if (modrm < 0xc0 || op == 2 || op == 3)
+				return FALSE;
+			UINT32 imm = (opcode == 0x81) ? fetch_imm32(&bytes[2]) : (UINT32)(INT8)bytes[2];
+			UML_LOAD_REG32(block, I0, modrm & 7);                               // load    i0,[rm]
+			generate_alu(block, op, I0, imm);
+			if (op != 7)
+				UML_STORE_REG32(block, modrm & 7, I2);                          // store   [rm],i2
+			compiler->cycles += PM_CYCLES((op == 7) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG);
+			return TRUE;
+		}
+
+		case 0x85:  // TEST r/m32,r32
+		case 0xa9:  // TEST EAX,imm32
+			if (opcode == 0x85)
+			{
+				if (modrm < 0xc0)
+					return FALSE;
+				UML_LOAD_REG32(block, I0, modrm & 7);                           // load    i0,[rm]
+				UML_LOAD_REG32(block, I1, (modrm >> 3) & 7);                    // load    i1,[reg]
+				UML_AND(block, I2, I0, I1);                                     // and     i2,i0,i1
+			}
+			else
+			{
+				UML_LOAD_REG32(block, I0, EAX);                                 // load    i0,[eax]
+				UML_AND(block, I2, I0, fetch_imm32(&bytes[1]));                 // and     i2,i0,imm
+			}
+			STORE_FLAG(block, m_CF, 0);                                         // store   [cf],0
+			STORE_FLAG(block, m_OF, 0);                                         // store   [of],0
+			generate_flags_szp(block, I2);
+			compiler->cycles += PM_CYCLES((opcode == 0x85) ? CYCLES_TEST_REG_REG : CYCLES_TEST_IMM_ACC);
+			return TRUE;
+
+		case 0x40: case 0x41: case 0x42: case 0x43: case 0x44: case 0x45: case 0x46: case 0x47:    // INC r32
+		case 0x48: case 0x49: case 0x4a: case 0x4b: case 0x4c: case 0x4d: case 0x4e: case 0x4f:    // DEC r32
+			UML_LOAD_REG32(block, I0, opcode & 7);                              // load    i0,[reg]
+			if (opcode < 0x48)
+			{
+				UML_ADD(block, I2, I0, 1);                                      // add     i2,i0,1
+				UML_XOR(block, I3, I2, 1);                                      // xor     i3,i2,1
+				UML_XOR(block, I5, I2, I0);                                     // xor     i5,i2,i0
+			}
+			else
+			{
+				UML_SUB(block, I2, I0, 1);                                      // sub     i2,i0,1
+				UML_XOR(block, I3, I0, 1);                                      // xor     i3,i0,1
+				UML_XOR(block, I5, I0, I2);                                     // xor     i5,i0,i2
+			}
+			UML_AND(block, I3, I3, I5);                                         // and     i3,i3,i5
+			UML_SHR(block, I3, I3, 31);                                         // shr     i3,i3,31
+			STORE_FLAG(block, m_OF, I3);                                        // store   [of],i3
+			UML_XOR(block, I3, I2, I0);                                         // xor     i3,i2,i0
+			UML_XOR(block, I3, I3, 1);                                          // xor     i3,i3,1
+			UML_SHR(block, I3, I3, 4);                                          // shr     i3,i3,4
+			UML_AND(block, I3, I3, 1);                                          // and     i3,i3,1
+			STORE_FLAG(block, m_AF, I3);                                        // store   [af],i3
+			generate_flags_szp(block, I2);
+			UML_STORE_REG32(block, opcode & 7, I2);                             // store   [reg],i2
+			compiler->cycles += PM_CYCLES((opcode < 0x48) ? CYCLES_INC_REG : CYCLES_DEC_REG);
+			return TRUE;
+
+		case 0x89:  // MOV r/m32,r32
+		case 0x8b:  // MOV r32,r/m32
+			if (modrm < 0xc0)
+				return FALSE;
+			UML_LOAD_REG32(block, I0, (opcode == 0x89) ? ((modrm >> 3) & 7) : (modrm & 7)); // load    i0,[src]
+			UML_STORE_REG32(block, (opcode == 0x89) ? (modrm & 7) : ((modrm >> 3) & 7), I0);    // store   [dst],i0
+			compiler->cycles += PM_CYCLES(CYCLES_MOV_REG_REG);
+			return TRUE;
+
+		case 0xb8: case 0xb9: case 0xba: case 0xbb: case 0xbc: case 0xbd: case 0xbe: case 0xbf:    // MOV r32,imm32
+			UML_STORE_REG32(block, opcode & 7, fetch_imm32(&bytes[1]));         // store   [reg],imm
+			compiler->cycles += PM_CYCLES(CYCLES_MOV_IMM_REG);
+			return TRUE;
+
+		case 0x8d:  // LEA r32,m
+			if (modrm >= 0xc0)
+				return FALSE;
+			generate_effective_address(block, I0, desc, modrm);
+			UML_STORE_REG32(block, (modrm >> 3) & 7, I0);                       // store   [reg],i0
+			compiler->cycles += PM_CYCLES(CYCLES_LEA);
+			return TRUE;
+
+		case 0x90:  // NOP
+			compiler->cycles += PM_CYCLES(CYCLES_NOP);
+			return TRUE;
+
+		case 0xf5:  // CMC
+			LOAD_FLAG(block, I0, m_CF);                                         // load    i0,[cf]
+			UML_XOR(block, I0, I0, 1);                                          // xor     i0,i0,1
+			STORE_FLAG(block, m_CF, I0);                                        // store   [cf],i0
+			compiler->cycles += PM_CYCLES(CYCLES_CMC);
+			return TRUE;
+
+		case 0xf8:  // CLC
+		case 0xf9:  // STC
+			STORE_FLAG(block, m_CF, opcode & 1);                                // store   [cf],opcode & 1
+			compiler->cycles += PM_CYCLES((opcode & 1) ? CYCLES_STC : CYCLES_CLC);
+			return TRUE;
+
+		case 0xfc:  // CLD
+		case 0xfd:  // STD
+			STORE_FLAG(block, m_DF, opcode & 1);                                // store   [df],opcode & 1
+			compiler->cycles += PM_CYCLES((opcode & 1) ? CYCLES_STD : CYCLES_CLD);
+			return TRUE;
+
+		case 0x70: case 0x71: case 0x72: case 0x73: case 0x74: case 0x75: case 0x76: case 0x77:    // Jcc rel8
+		case 0x78: case 0x79: case 0x7a: case 0x7b: case 0x7c: case 0x7d: case 0x7e: case 0x7f:
+			return generate_jcc(block, compiler, desc, opcode & 0x0f, PM_CYCLES(CYCLES_JCC_DISP8), PM_CYCLES(CYCLES_JCC_DISP8_NOBRANCH));
+
+		case 0xeb:  // JMP rel8
+		case 0xe9:  // JMP rel32
+			if (desc->targetpc == BRANCH_TARGET_DYNAMIC)
+				return FALSE;
+			compiler->cycles += PM_CYCLES((opcode == 0xeb) ? CYCLES_JMP_SHORT : CYCLES_JMP);
+			generate_update_cycles(block, compiler, desc->targetpc, TRUE);      // <subtract cycles>
+			UML_HASHJMP(block, compiler->mode, desc->targetpc, *m_nocode);      // hashjmp <mode>,targetpc,nocode
+			return TRUE;
+
+		case 0x0f:
+			opcode = bytes[1];
+			modrm = bytes[2];
+			switch (opcode)
+			{
+				case 0x80: case 0x81: case 0x82: case 0x83: case 0x84: case 0x85: case 0x86: case 0x87:    // Jcc rel32
+				case 0x88: case 0x89: case 0x8a: case 0x8b: case 0x8c: case 0x8d: case 0x8e: case 0x8f:
+					return generate_jcc(block, compiler, desc, opcode & 0x0f, PM_CYCLES(CYCLES_JCC_FULL_DISP), PM_CYCLES(CYCLES_JCC_FULL_DISP_NOBRANCH));
+
+				case 0xb6: case 0xbe:   // MOVZX/MOVSX r32,r/m8
+					if (modrm < 0xc0)
+						return FALSE;
+					UML_LOAD_REG32(block, I0, modrm & 3);                       // load    i0,[rm & 3]
+					if (modrm & 4)
+						UML_SHR(block, I0, I0, 8);                              // shr     i0,i0,8
+					if (opcode == 0xb6)
+						UML_AND(block, I0, I0, 0xff);                           // and     i0,i0,0xff
+					else
+						UML_SEXT(block, I0, I0, SIZE_BYTE);                     // sext    i0,i0,byte
+					UML_STORE_REG32(block, (modrm >> 3) & 7, I0);               // store   [reg],i0
+					compiler->cycles += PM_CYCLES((opcode == 0xb6) ? CYCLES_MOVZX_REG_REG : CYCLES_MOVSX_REG_REG);
+					return TRUE;
+
+				case 0xb7: case 0xbf:   // MOVZX/MOVSX r32,r/m16
+					if (modrm < 0xc0)
+						return FALSE;
+					UML_LOAD_REG32(block, I0, modrm & 7);                       // load    i0,[rm]
+					if (opcode == 0xb7)
+						UML_AND(block, I0, I0, 0xffff);                         // and     i0,i0,0xffff
+					else
+						UML_SEXT(block, I0, I0, SIZE_WORD);                     // sext    i0,i0,word
+					UML_STORE_REG32(block, (modrm >> 3) & 7, I0);               // store   [reg],i0
+					compiler->cycles += PM_CYCLES((opcode == 0xb7) ? CYCLES_MOVZX_REG_REG : CYCLES_MOVSX_REG_REG);
+					return TRUE;
+			}
+			return FALSE;
+	}
+
+	return FALSE;
+}
+
+/***************************************************************************
+    CORE CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    i386drc_set_options - configure DRC options
+-------------------------------------------------*/
+
+void i386_device::i386drc_set_options(UINT32 options)
+{
+	if (!allow_drc()) return;
+	m_drcoptions = options;
+	m_cache_dirty = TRUE;
+}
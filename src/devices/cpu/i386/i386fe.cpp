@@ -0,0 +1,342 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    i386fe.c
+
+    Front end for the i386 recompiler
+
+    x86 instructions are variable length, so the front end is mostly an
+    instruction length decoder.  It never fails to describe an instruction;
+    anything it does not understand is handed to the interpreter, which
+    raises the appropriate fault, and the sequence ends there.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "i386.h"
+#include "cpu/drcfe.h"
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* operand encodings for the length decoder */
+#define OP_NONE         0x00    /* no operands */
+#define OP_MODRM        0x01    /* ModR/M byte, SIB and displacement */
+#define OP_IMM8         0x02    /* 8-bit immediate */
+#define OP_IMM16        0x04    /* 16-bit immediate */
+#define OP_IMMZ         0x08    /* 16 or 32-bit immediate depending on operand size */
+#define OP_MOFFS        0x10    /* 16 or 32-bit offset depending on address size */
+#define OP_FAR          0x20    /* 16-bit selector following the immediate */
+#define OP_GRP3         0x40    /* TEST in group 3 takes an immediate */
+#define OP_PREFIX       0x80    /* prefix byte */
+#define OP_UNKNOWN      0xff    /* not decoded here; let the interpreter sort it out */
+
+#define M   OP_MODRM
+#define I8  OP_IMM8
+#define IZ  OP_IMMZ
+#define P   OP_PREFIX
+#define U   OP_UNKNOWN
+
+static const UINT8 s_onebyte_operands[256] =
+{
+	/* 00 */ M, M, M, M, I8, IZ, 0, 0, M, M, M, M, I8, IZ, 0, 0,
+	/* 10 */ M, M, M, M, I8, IZ, 0, 0, M, M, M, M, I8, IZ, 0, 0,
+	/* 20 */ M, M, M, M, I8, IZ, P, 0, M, M, M, M, I8, IZ, P, 0,
+	/* 30 */ M, M, M, M, I8, IZ, P, 0, M, M, M, M, I8, IZ, P, 0,
+	/* 40 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	/* 50 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	/* 60 */ 0, 0, M, M, P, P, P, P, IZ, M|IZ, I8, M|I8, 0, 0, 0, 0,
+	/* 70 */ I8, I8, I8, I8, I8, I8, I8, I8, I8, I8, I8, I8, I8, I8, I8, I8,
+	/* 80 */ M|I8, M|IZ, M|I8, M|I8, M, M, M, M, M, M, M, M, M, M, M, M,
+	/* 90 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, IZ|OP_FAR, 0, 0, 0, 0, 0,
+	/* a0 */ OP_MOFFS, OP_MOFFS, OP_MOFFS, OP_MOFFS, 0, 0, 0, 0, I8, IZ, 0, 0, 0, 0, 0, 0,
+	/* b0 */ I8, I8, I8, I8, I8, I8, I8, I8, IZ, IZ, IZ, IZ, IZ, IZ, IZ, IZ,
+	/* c0 */ M|I8, M|I8, OP_IMM16, 0, M, M, M|I8, M|IZ, OP_IMM16|I8, 0, OP_IMM16, 0, 0, I8, 0, 0,
+	/* d0 */ M, M, M, M, I8, I8, 0, 0, M, M, M, M, M, M, M, M,
+	/* e0 */ I8, I8, I8, I8, I8, I8, I8, I8, IZ, IZ, IZ|OP_FAR, I8, 0, 0, 0, 0,
+	/* f0 */ P, 0, P, P, 0, 0, M|OP_GRP3, M|OP_GRP3, 0, 0, 0, 0, 0, 0, M, M
+};
+
+static const UINT8 s_twobyte_operands[256] =
+{
+	/* 00 */ M, M, M, M, U, U, 0, U, 0, 0, U, 0, U, M, U, U,
+	/* 10 */ M, M, M, M, M, M, M, M, M, M, M, M, M, M, M, M,
+	/* 20 */ M, M, M, M, M, U, M, U, M, M, M, M, M, M, M, M,
+	/* 30 */ 0, 0, 0, 0, 0, 0, U, U, U, U, U, U, U, U, U, U,
+	/* 40 */ M, M, M, M, M, M, M, M, M, M, M, M, M, M, M, M,
+	/* 50 */ M, M, M, M, M, M, M, M, M, M, M, M, M, M, M, M,
+	/* 60 */ M, M, M, M, M, M, M, M, M, M, M, M, M, M, M, M,
+	/* 70 */ M|I8, M|I8, M|I8, M|I8, M, M, M, 0, M, M, U, U, M, M, M, M,
+	/* 80 */ IZ, IZ, IZ, IZ, IZ, IZ, IZ, IZ, IZ, IZ, IZ, IZ, IZ, IZ, IZ, IZ,
+	/* 90 */ M, M, M, M, M, M, M, M, M, M, M, M, M, M, M, M,
+	/* a0 */ 0, 0, 0, M, M|I8, M, U, U, 0, 0, 0, M, M|I8, M, M, M,
+	/* b0 */ M, M, M, M, M, M, M, M, M, U, M|I8, M, M, M, M, M,
+	/* c0 */ M, M, M|I8, M, M|I8, M|I8, M|I8, M, 0, 0, 0, 0, 0, 0, 0, 0,
+	/* d0 */ M, M, M, M, M, M, M, M, M, M, M, M, M, M, M, M,
+	/* e0 */ M, M, M, M, M, M, M, M, M, M, M, M, M, M, M, M,
+	/* f0 */ M, M, M, M, M, M, M, M, M, M, M, M, M, M, M, M
+};
+
+#undef M
+#undef I8
+#undef IZ
+#undef P
+#undef U
+
+
+/***************************************************************************
+    INSTRUCTION PARSERS
+***************************************************************************/
+
+i386_frontend::i386_frontend(i386_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(*device, window_start, window_end, max_sequence)
+	, m_mode(0)
+	, m_i386(device)
+{
+}
+
+/*-------------------------------------------------
+    fetch_bytes - read up to count opcode bytes
+    from a linear address, translating again at
+    each page boundary; returns the number of
+    bytes that could be fetched and the physical
+    address of the first one
+-------------------------------------------------*/
+
+int i386_frontend::fetch_bytes(offs_t pc, offs_t &physpc, UINT8 *dest, int count)
+{
+	/* the page walk may set accessed bits on pages we never reach, which the architecture permits */
+	int intention = TRANSLATE_FETCH | (m_mode ? TRANSLATE_USER_MASK : 0);
+	offs_t address = 0;
+	int index;
+
+	for (index = 0; index < count; index++)
+	{
+		if (index == 0 || ((pc + index) & 0xfff) == 0)
+		{
+			address = pc + index;
+			if (!m_i386->i386_translate_address(intention, &address, nullptr))
+				break;
+			if (index == 0)
+				physpc = address & m_i386->m_a20_mask;
+		}
+		dest[index] = m_i386->m_direct->read_byte(address & m_i386->m_a20_mask);
+		address++;
+	}
+	return index;
+}
+
+/*-------------------------------------------------
+    modrm_length - return the number of bytes
+    taken by a ModR/M byte along with any SIB
+    byte and displacement
+-------------------------------------------------*/
+
+int i386_frontend::modrm_length(const UINT8 *bytes, int address32)
+{
+	UINT8 modrm = bytes[0];
+	UINT8 mod = modrm >> 6;
+	UINT8 rm = modrm & 7;
+
+	if (mod == 3)
+		return 1;
+
+	if (!address32)
+	{
+		if (mod == 0)
+			return (rm == 6) ? 3 : 1;
+		return (mod == 1) ? 2 : 3;
+	}
+
+	int length = 1;
+	if (rm == 4)
+	{
+		length++;
+		if (mod == 0 && (bytes[1] & 7) == 5)
+			return length + 4;
+	}
+	if (mod == 0)
+		return (rm == 5) ? length + 4 : length;
+	return (mod == 1) ? length + 1 : length + 4;
+}
+
+/*-------------------------------------------------
+    describe - build a description of a single
+    instruction
+-------------------------------------------------*/
+
+bool i386_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	UINT8 bytes[15 + 6];
+	int fetched, length, prefixes;
+	int operand32 = 1, address32 = 1;
+	UINT8 opcode, operands;
+	bool twobyte = false;
+
+	/* blocks are only built for 32-bit code segments; see drc_eligible */
+	memset(bytes, 0, sizeof(bytes));
+	fetched = fetch_bytes(desc.pc, desc.physpc, bytes, 15);
+	if (fetched == 0)
+	{
+		desc.flags |= OPFLAG_VALIDATE_TLB | OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_COMPILER_PAGE_FAULT | OPFLAG_VIRTUAL_NOOP | OPFLAG_END_SEQUENCE;
+		return true;
+	}
+
+	/* skip over any prefixes */
+	for (prefixes = 0; prefixes < 14; prefixes++)
+	{
+		opcode = bytes[prefixes];
+		if (s_onebyte_operands[opcode] != OP_PREFIX)
+			break;
+		if (opcode == 0x66)
+			operand32 = 0;
+		else if (opcode == 0x67)
+			address32 = 0;
+	}
+	length = prefixes + 1;
+	opcode = bytes[prefixes];
+	operands = s_onebyte_operands[opcode];
+	if (prefixes != 0)
+		desc.userflags |= I386UF_PREFIXED;
+
+	/* two and three byte opcodes */
+	if (opcode == 0x0f)
+	{
+		twobyte = true;
+		opcode = bytes[length++];
+		operands = s_twobyte_operands[opcode];
+		if (opcode == 0x38 || opcode == 0x3a)
+		{
+			length++;
+			operands = (opcode == 0x3a) ? (OP_MODRM | OP_IMM8) : OP_MODRM;
+		}
+	}
+
+	/* decode the operand bytes */
+	if (operands == OP_UNKNOWN || operands == OP_PREFIX)
+		operands = OP_NONE;
+	if (operands & OP_MODRM)
+	{
+		UINT8 modrm = bytes[length];
+		length += modrm_length(&bytes[length], address32);
+		if ((operands & OP_GRP3) && ((modrm >> 3) & 6) == 0)
+			operands |= (opcode == 0xf6) ? OP_IMM8 : OP_IMMZ;
+	}
+	if (operands & OP_IMM16)
+		length += 2;
+	if (operands & OP_IMM8)
+		length += 1;
+	if (operands & OP_IMMZ)
+		length += operand32 ? 4 : 2;
+	if (operands & OP_MOFFS)
+		length += address32 ? 4 : 2;
+	if (operands & OP_FAR)
+		length += 2;
+
+	/* an instruction longer than 15 bytes faults; either way the interpreter has to see it */
+	desc.length = std::min(length, 15);
+	memcpy(desc.opptr.b, bytes, std::min<size_t>(desc.length, sizeof(desc.opptr.b)));
+	desc.cycles = 0;
+	if (length > fetched || length > 15)
+	{
+		desc.userflags |= I386UF_INCOMPLETE;
+		desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_END_SEQUENCE;
+		return true;
+	}
+
+	/* most instructions can fault one way or another */
+	desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION;
+
+	if (!twobyte)
+	{
+		switch (opcode)
+		{
+			case 0x70: case 0x71: case 0x72: case 0x73: case 0x74: case 0x75: case 0x76: case 0x77:
+			case 0x78: case 0x79: case 0x7a: case 0x7b: case 0x7c: case 0x7d: case 0x7e: case 0x7f:
+				/* Jcc rel8 */
+				desc.targetpc = desc.pc + desc.length + (INT8)bytes[length - 1];
+				desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+				if (!operand32)
+					desc.targetpc = BRANCH_TARGET_DYNAMIC;
+				break;
+
+			case 0xeb:  /* JMP rel8 */
+			case 0xe9:  /* JMP rel16/32 */
+				if (opcode == 0xeb)
+					desc.targetpc = desc.pc + desc.length + (INT8)bytes[length - 1];
+				else if (operand32)
+					desc.targetpc = desc.pc + desc.length + (INT32)(bytes[length - 4] | (bytes[length - 3] << 8) | (bytes[length - 2] << 16) | (bytes[length - 1] << 24));
+				if (!operand32)
+					desc.targetpc = BRANCH_TARGET_DYNAMIC;
+				desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+				break;
+
+			case 0xc2: case 0xc3:   /* RET near */
+			case 0xe8:              /* CALL near */
+				desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+				break;
+
+			case 0xe0: case 0xe1: case 0xe2: case 0xe3:     /* LOOPcc, JECXZ */
+				desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+				break;
+
+			case 0x9a:  /* CALL far */
+			case 0xea:  /* JMP far */
+			case 0xca: case 0xcb:   /* RETF */
+			case 0xcc: case 0xcd: case 0xce: case 0xcf:     /* INT3, INT, INTO, IRET */
+			case 0xf1:  /* ICEBP */
+			case 0xf4:  /* HLT */
+			case 0x9d:  /* POPF */
+			case 0xfb:  /* STI */
+				desc.flags |= OPFLAG_END_SEQUENCE;
+				break;
+
+			case 0xff:
+				switch ((bytes[prefixes + 1] >> 3) & 7)
+				{
+					case 2: case 4:     /* CALL/JMP near indirect */
+						desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+						break;
+
+					case 3: case 5:     /* CALL/JMP far indirect */
+						desc.flags |= OPFLAG_END_SEQUENCE;
+						break;
+				}
+				break;
+		}
+	}
+	else
+	{
+		if (opcode >= 0x80 && opcode <= 0x8f)
+		{
+			/* Jcc rel16/32 */
+			if (operand32)
+				desc.targetpc = desc.pc + desc.length + (INT32)(bytes[length - 4] | (bytes[length - 3] << 8) | (bytes[length - 2] << 16) | (bytes[length - 1] << 24));
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+		}
+		else switch (opcode)
+		{
+			case 0x01:  /* LGDT, LIDT, LMSW, INVLPG */
+			case 0x22:  /* MOV CRn,r32 */
+			case 0x06:  /* CLTS */
+				desc.userflags |= I386UF_FLUSH_CACHE;
+				desc.flags |= OPFLAG_END_SEQUENCE;
+				break;
+
+			case 0x34: case 0x35:   /* SYSENTER, SYSEXIT */
+			case 0xaa:  /* RSM */
+				desc.flags |= OPFLAG_END_SEQUENCE;
+				break;
+
+			default:
+				if (s_twobyte_operands[opcode] == OP_UNKNOWN)
+					desc.flags |= OPFLAG_END_SEQUENCE;
+				break;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,3061 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    sh4drc.c
+    Universal machine language-based SH-3/SH-4 emulator.
+
+    This file is #included from sh4.cpp so that the recompiler can share
+    the interpreter's inline opcode helpers for the handful of instructions
+    that are not worth translating.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "debugger.h"
+#include "sh4.h"
+#include "sh4comn.h"
+#include "cpu/drcumlsh.h"
+
+extern unsigned DasmSH4(char *buffer, unsigned pc, UINT16 opcode);
+
+using namespace uml;
+
+/***************************************************************************
+    DEBUGGING
+***************************************************************************/
+
+#define SET_EA                      (0) // makes slower but "shows work" in the EA fake register like the interpreter
+
+#define LOCKSTEP_ALWAYS             (0) // check every eligible instruction against the interpreter regardless of options
+
+#if SET_EA
+#define SETEA(x) UML_MOV(block, mem(&m_sh4_state->ea), ireg(x))
+#else
+#define SETEA(x)
+#endif
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* map variables */
+#define MAPVAR_PC                   M0
+#define MAPVAR_CYCLES                   M1
+
+/* exit codes */
+#define EXECUTE_OUT_OF_CYCLES           0
+#define EXECUTE_MISSING_CODE            1
+#define EXECUTE_UNMAPPED_CODE           2
+#define EXECUTE_RESET_CACHE         3
+
+#define PROBE_ADDRESS                   ~0
+
+/* compiler modes; blocks are compiled separately for each FPSCR.PR/SZ combination */
+#define MODE_SZ                     1
+#define MODE_PR                     2
+
+/* ovrpc value for the delay slot of a branch whose target is only known at runtime (in target) */
+#define OVRPC_DYNAMIC               0xfffffffe
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define R32(reg)        m_regmap[reg]
+#define FR32(reg)       mem(&m_sh4_state->fr[reg])
+#define XF32(reg)       mem(&m_sh4_state->xf[reg])
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    epc - compute the exception PC from a
+    descriptor
+-------------------------------------------------*/
+
+UINT32 sh34_base_device::epc(const opcode_desc *desc)
+{
+	return (desc->flags & OPFLAG_IN_DELAY_SLOT) ? (desc->pc - 1) : desc->pc;
+}
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+void sh34_base_device::alloc_handle(drcuml_state *drcuml, code_handle **handleptr, const char *name)
+{
+	if (*handleptr == nullptr)
+		*handleptr = drcuml->handle_alloc(name);
+}
+
+/*-------------------------------------------------
+    load_fast_iregs - load any fast integer
+    registers
+-------------------------------------------------*/
+
+void sh34_base_device::load_fast_iregs(drcuml_block *block)
+{
+	int regnum;
+
+	for (regnum = 0; regnum < ARRAY_LENGTH(m_regmap); regnum++)
+	{
+		if (m_regmap[regnum].is_int_register())
+		{
+			UML_MOV(block, uml::parameter::make_ireg(m_regmap[regnum].ireg()), mem(&m_sh4_state->r[regnum]));
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    save_fast_iregs - save any fast integer
+    registers
+-------------------------------------------------*/
+
+void sh34_base_device::save_fast_iregs(drcuml_block *block)
+{
+	int regnum;
+
+	for (regnum = 0; regnum < ARRAY_LENGTH(m_regmap); regnum++)
+	{
+		if (m_regmap[regnum].is_int_register())
+		{
+			UML_MOV(block, mem(&m_sh4_state->r[regnum]), uml::parameter::make_ireg(m_regmap[regnum].ireg()));
+		}
+	}
+}
+
+/*-------------------------------------------------
+    fmov_regs - pick the FPU registers a memory
+    form of FMOV transfers for a compiler mode;
+    returns the number of 32-bit words moved
+-------------------------------------------------*/
+
+static int fmov_regs(UINT32 *fr, UINT32 *xf, UINT8 mode, UINT32 reg, bool mrfr, UINT32 **first, UINT32 **second)
+{
+	if (mode & MODE_PR)
+	{
+		/* the interpreter always goes through XD here, except for FMOV @Rm,DRn */
+		UINT32 *base = (mrfr && !(reg & 1)) ? fr : xf;
+		*first = &base[(reg & 14) + NATIVE_ENDIAN_VALUE_LE_BE(1, 0)];
+		*second = &base[(reg & 14) + NATIVE_ENDIAN_VALUE_LE_BE(0, 1)];
+		return 2;
+	}
+	else if (mode & MODE_SZ)
+	{
+		UINT32 *base = (reg & 1) ? xf : fr;
+		*first = &base[reg & 14];
+		*second = &base[(reg & 14) + 1];
+		return 2;
+	}
+
+	*first = &fr[reg];
+	*second = nullptr;
+	return 1;
+}
+
+/*-------------------------------------------------
+    cfunc_printf_probe - print the current CPU
+    state and return
+-------------------------------------------------*/
+
+static void cfunc_printf_probe(void *param)
+{
+	((sh34_base_device *)param)->func_printf_probe();
+}
+
+void sh34_base_device::func_printf_probe()
+{
+	UINT32 pc = m_sh4_state->pc;
+
+	printf(" PC=%08X          r0=%08X  r1=%08X  r2=%08X\n",
+		pc,
+		(UINT32)m_sh4_state->r[0],
+		(UINT32)m_sh4_state->r[1],
+		(UINT32)m_sh4_state->r[2]);
+	printf(" r3=%08X  r4=%08X  r5=%08X  r6=%08X\n",
+		(UINT32)m_sh4_state->r[3],
+		(UINT32)m_sh4_state->r[4],
+		(UINT32)m_sh4_state->r[5],
+		(UINT32)m_sh4_state->r[6]);
+	printf(" r7=%08X  r8=%08X  r9=%08X  r10=%08X\n",
+		(UINT32)m_sh4_state->r[7],
+		(UINT32)m_sh4_state->r[8],
+		(UINT32)m_sh4_state->r[9],
+		(UINT32)m_sh4_state->r[10]);
+	printf(" r11=%08X  r12=%08X  r13=%08X  r14=%08X\n",
+		(UINT32)m_sh4_state->r[11],
+		(UINT32)m_sh4_state->r[12],
+		(UINT32)m_sh4_state->r[13],
+		(UINT32)m_sh4_state->r[14]);
+	printf(" r15=%08X  macl=%08X  mach=%08X  gbr=%08X\n",
+		(UINT32)m_sh4_state->r[15],
+		(UINT32)m_sh4_state->macl,
+		(UINT32)m_sh4_state->mach,
+		(UINT32)m_sh4_state->gbr);
+	printf(" sr=%08X  fpscr=%08X  fpul=%08X  pr=%08X\n",
+		(UINT32)m_sh4_state->sr,
+		(UINT32)m_sh4_state->fpscr,
+		(UINT32)m_sh4_state->fpul,
+		(UINT32)m_sh4_state->pr);
+}
+
+/*-------------------------------------------------
+    cfunc_execute_one - run a single instruction
+    through the interpreter
+-------------------------------------------------*/
+
+static void cfunc_execute_one(void *param)
+{
+	((sh34_base_device *)param)->func_execute_one();
+}
+
+void sh34_base_device::func_execute_one()
+{
+	// the opcode is in arg0 and pc already points past it, as the interpreter expects
+	execute_one(m_sh4_state->arg0);
+
+	// delay slots are compiled separately, so never leave the interpreter waiting for one
+	m_delay = 0;
+}
+
+/*-------------------------------------------------
+    cfunc_check_irq - take the highest priority
+    pending exception, if any
+-------------------------------------------------*/
+
+static void cfunc_check_irq(void *param)
+{
+	((sh34_base_device *)param)->func_check_irq();
+}
+
+void sh34_base_device::func_check_irq()
+{
+	UINT32 oldpc = m_sh4_state->pc;
+
+	sh4_check_pending_irq("sh4drc");
+
+	// tell the generated code whether it has to go somewhere else
+	m_sh4_state->arg0 = (m_sh4_state->pc != oldpc);
+}
+
+/*-------------------------------------------------
+    cfunc_prefetch - PREF @Rn into the store
+    queue area
+-------------------------------------------------*/
+
+static void cfunc_prefetch(void *param)
+{
+	((sh34_base_device *)param)->func_prefetch();
+}
+
+void sh34_base_device::func_prefetch()
+{
+	PREFM(m_sh4_state->arg0);
+}
+
+/*-------------------------------------------------
+    cfunc_lockstep_run - run an instruction
+    through the interpreter on a copy of the
+    state, keeping the result for comparison
+-------------------------------------------------*/
+
+static void cfunc_lockstep_run(void *param)
+{
+	((sh34_base_device *)param)->func_lockstep_run();
+}
+
+void sh34_base_device::func_lockstep_run()
+{
+	m_lockstep_input = *m_sh4_state;
+
+	execute_one(m_sh4_state->arg0);
+	m_delay = 0;
+
+	m_lockstep_result = *m_sh4_state;
+	*m_sh4_state = m_lockstep_input;
+}
+
+/*-------------------------------------------------
+    cfunc_lockstep_check - compare the compiled
+    code's result against the interpreter's
+-------------------------------------------------*/
+
+static void cfunc_lockstep_check(void *param)
+{
+	((sh34_base_device *)param)->func_lockstep_check();
+}
+
+void sh34_base_device::func_lockstep_check()
+{
+	internal_sh4_state drc = *m_sh4_state;
+	internal_sh4_state interp = m_lockstep_result;
+
+	// bookkeeping fields legitimately differ between the two
+	interp.ppc = drc.ppc;
+	interp.pc = drc.pc;
+	interp.ea = drc.ea;
+	interp.icount = drc.icount;
+	interp.target = drc.target;
+	interp.arg0 = drc.arg0;
+	interp.arg1 = drc.arg1;
+
+	if (memcmp(&drc, &interp, sizeof(drc)) != 0)
+	{
+		logerror("sh4drc: lockstep mismatch at %08X (opcode %04X)\n", m_lockstep_input.arg1, m_lockstep_input.arg0);
+		m_lockstep_mismatches++;
+
+		// trust the interpreter and carry on
+		*m_sh4_state = interp;
+	}
+}
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void sh34_base_device::code_flush_cache()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+
+	/* empty the transient cache contents */
+	drcuml->reset();
+
+	try
+	{
+		/* generate the entry point and out-of-cycles handlers */
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+		static_generate_entry_point();
+
+		/* add subroutines for memory accesses */
+		static_generate_memory_accessor(1, FALSE, "read8", &m_read8);
+		static_generate_memory_accessor(1, TRUE,  "write8", &m_write8);
+		static_generate_memory_accessor(2, FALSE, "read16", &m_read16);
+		static_generate_memory_accessor(2, TRUE,  "write16", &m_write16);
+		static_generate_memory_accessor(4, FALSE, "read32", &m_read32);
+		static_generate_memory_accessor(4, TRUE,  "write32", &m_write32);
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unable to generate SH4 static code\n");
+	}
+
+	m_cache_dirty = FALSE;
+}
+
+/* Execute cycles - returns number of cycles actually run */
+void sh34_base_device::execute_run_drc()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	int execute_result;
+
+	if (m_cpu_off)
+	{
+		m_sh4_state->icount = 0;
+		return;
+	}
+
+	/* reset the cache if dirty */
+	if (m_cache_dirty)
+		code_flush_cache();
+
+	/* execute */
+	do
+	{
+		/* run as much as we can */
+		execute_result = drcuml->execute(*m_entry);
+
+		/* if we need to recompile, do it */
+		if (execute_result == EXECUTE_MISSING_CODE)
+		{
+			code_compile_block((m_sh4_state->fpu_pr << 1) | m_sh4_state->fpu_sz, m_sh4_state->pc);
+		}
+		else if (execute_result == EXECUTE_UNMAPPED_CODE)
+		{
+			fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_sh4_state->pc);
+		}
+		else if (execute_result == EXECUTE_RESET_CACHE)
+		{
+			code_flush_cache();
+		}
+	} while (execute_result != EXECUTE_OUT_OF_CYCLES);
+}
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of the
+    given mode at the specified pc
+-------------------------------------------------*/
+
+void sh34_base_device::code_compile_block(UINT8 mode, offs_t pc)
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqhead, *seqlast;
+	const opcode_desc *desclist;
+	int override = FALSE;
+	drcuml_block *block;
+
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* get a description of this sequence */
+	desclist = m_drcfe->describe_code(pc);
+	if (drcuml->logging() || drcuml->logging_native())
+		log_opcode_desc(drcuml, desclist, 0);
+
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* start the block */
+			block = drcuml->begin_block(4096);
+
+			/* loop until we get through all instruction sequences */
+			compiler.mode = mode;
+			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				UINT32 nextpc;
+
+				/* add a code log entry */
+				if (drcuml->logging())
+					block->append_comment("-------------------------");                 // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				if (override || !drcuml->hash_exists(mode, seqhead->pc))
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = TRUE;
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);
+																							// hashjmp <mode>,seqhead->pc,nocode
+					continue;
+				}
+
+				/* validate this code block if we're not pointing into ROM */
+				if (m_program->get_write_ptr(seqhead->physpc & AM) != nullptr)
+					generate_checksum_block(block, &compiler, seqhead, seqlast);
+
+				/* label this instruction, if it may be jumped to locally */
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+				}
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					generate_sequence_instruction(block, &compiler, curdesc, 0xffffffff);
+				}
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+				{
+					nextpc = pc;
+				}
+				/* otherwise we just go to the next instruction */
+				else
+				{
+					nextpc = seqlast->pc + (seqlast->skipslots + 1) * 2;
+				}
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, &compiler, nextpc, TRUE);                // <subtract cycles>
+
+				/* if the last instruction can change modes, use the runtime mode */
+				if (seqlast->flags & OPFLAG_CAN_CHANGE_MODES)
+					generate_mode_hashjmp(block, nextpc);                                   // hashjmp <newmode>,nextpc,nocode
+				else if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, mode, nextpc, *m_nocode);                            // hashjmp <mode>,nextpc,nocode
+			}
+
+			/* end the sequence */
+			block->end();
+			g_profiler.stop();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void sh34_base_device::static_generate_entry_point()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	code_label skip = 1;
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(200);
+
+	/* forward references */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+	alloc_handle(drcuml, &m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                         // handle  entry
+
+	/* take any exception that was raised while we were out; this may switch banks */
+	UML_CMP(block, mem(&m_sh4_state->test_irq), 0);      // cmp     test_irq,0
+	UML_JMPc(block, COND_Z, skip);                       // jz      skip
+	UML_CALLC(block, cfunc_check_irq, this);             // callc   cfunc_check_irq
+	UML_LABEL(block, skip);                              // skip:
+
+	/* load fast integer registers */
+	load_fast_iregs(block);
+
+	/* generate a hash jump via the current mode and PC */
+	generate_mode_hashjmp(block, mem(&m_sh4_state->pc)); // hashjmp <mode>,<pc>,nocode
+
+	block->end();
+}
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void sh34_base_device::static_generate_nocode_handler()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                    // handle  nocode
+	UML_GETEXP(block, I0);                                  // getexp  i0
+	UML_MOV(block, mem(&m_sh4_state->pc), I0);                              // mov     [pc],i0
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                          // exit    EXECUTE_MISSING_CODE
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void sh34_base_device::static_generate_out_of_cycles()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(drcuml, &m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                             // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                  // getexp  i0
+	UML_MOV(block, mem(&m_sh4_state->pc), I0);                              // mov     <pc>,i0
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                         // exit    EXECUTE_OUT_OF_CYCLES
+
+	block->end();
+}
+
+/*------------------------------------------------------------------
+    static_generate_memory_accessor
+------------------------------------------------------------------*/
+
+void sh34_base_device::static_generate_memory_accessor(int size, int iswrite, const char *name, code_handle **handleptr)
+{
+	/* on entry, address is in I0; data for writes is in I1 */
+	/* on exit, read result is in I0 */
+	/* routine trashes I0 */
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+	int label = 1;
+	code_label direct = label++;
+
+	/* begin generating */
+	block = drcuml->begin_block(1024);
+
+	/* add a global entry for this */
+	alloc_handle(drcuml, handleptr, name);
+	UML_HANDLE(block, **handleptr);                         // handle  *handleptr
+
+	// P4 (0xe0000000 and up) goes out unmasked, everything else is masked down to the external area
+	UML_CMP(block, I0, 0xe0000000);     // cmp i0, #0xe0000000
+	UML_JMPc(block, COND_AE, direct);           // jae direct
+
+	UML_AND(block, I0, I0, AM);     // and i0, i0, #AM (0x1fffffff)
+
+#if SH4_USE_FASTRAM_OPTIMIZATION
+	for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
+	{
+		if (m_fastram[ramnum].base != nullptr && (!iswrite || !m_fastram[ramnum].readonly))
+		{
+			void *fastbase = (UINT8 *)m_fastram[ramnum].base - m_fastram[ramnum].start;
+			UINT32 skip = label++;
+			if (m_fastram[ramnum].end != 0xffffffff)
+			{
+				UML_CMP(block, I0, m_fastram[ramnum].end);   // cmp     i0,end
+				UML_JMPc(block, COND_A, skip);                                      // ja      skip
+			}
+			if (m_fastram[ramnum].start != 0x00000000)
+			{
+				UML_CMP(block, I0, m_fastram[ramnum].start);// cmp     i0,fastram_start
+				UML_JMPc(block, COND_B, skip);                                      // jb      skip
+			}
+
+			if (!iswrite)
+			{
+				if (size == 1)
+				{
+					UML_XOR(block, I0, I0, m_byte_xor);
+					UML_LOAD(block, I0, fastbase, I0, SIZE_BYTE, SCALE_x1);             // load    i0,fastbase,i0,byte
+				}
+				else if (size == 2)
+				{
+					UML_XOR(block, I0, I0, m_word_xor);
+					UML_LOAD(block, I0, fastbase, I0, SIZE_WORD, SCALE_x1);         // load    i0,fastbase,i0,word_x1
+				}
+				else if (size == 4)
+				{
+					UML_XOR(block, I0, I0, m_dword_xor);
+					UML_LOAD(block, I0, fastbase, I0, SIZE_DWORD, SCALE_x1);            // load    i0,fastbase,i0,dword_x1
+				}
+				UML_RET(block);                                                     // ret
+			}
+			else
+			{
+				if (size == 1)
+				{
+					UML_XOR(block, I0, I0, m_byte_xor);
+					UML_STORE(block, fastbase, I0, I1, SIZE_BYTE, SCALE_x1);// store   fastbase,i0,i1,byte
+				}
+				else if (size == 2)
+				{
+					UML_XOR(block, I0, I0, m_word_xor);
+					UML_STORE(block, fastbase, I0, I1, SIZE_WORD, SCALE_x1);// store   fastbase,i0,i1,word_x1
+				}
+				else if (size == 4)
+				{
+					UML_XOR(block, I0, I0, m_dword_xor);
+					UML_STORE(block, fastbase, I0, I1, SIZE_DWORD, SCALE_x1);       // store   fastbase,i0,i1,dword_x1
+				}
+				UML_RET(block);                                                     // ret
+			}
+
+			UML_LABEL(block, skip);                                             // skip:
+		}
+	}
+#endif
+
+	UML_LABEL(block, direct);               // direct:
+
+	if (iswrite)
+	{
+		switch (size)
+		{
+			case 1:
+				UML_WRITE(block, I0, I1, SIZE_BYTE, SPACE_PROGRAM); // write r0, r1, program_byte
+				break;
+
+			case 2:
+				UML_WRITE(block, I0, I1, SIZE_WORD, SPACE_PROGRAM); // write r0, r1, program_word
+				break;
+
+			case 4:
+				UML_WRITE(block, I0, I1, SIZE_DWORD, SPACE_PROGRAM);    // write r0, r1, program_dword
+				break;
+		}
+	}
+	else
+	{
+		switch (size)
+		{
+			case 1:
+				UML_READ(block, I0, I0, SIZE_BYTE, SPACE_PROGRAM);  // read r0, program_byte
+				break;
+
+			case 2:
+				UML_READ(block, I0, I0, SIZE_WORD, SPACE_PROGRAM);  // read r0, program_word
+				break;
+
+			case 4:
+				UML_READ(block, I0, I0, SIZE_DWORD, SPACE_PROGRAM); // read r0, program_dword
+				break;
+		}
+	}
+
+	UML_RET(block);                         // ret
+
+	block->end();
+}
+
+/*-------------------------------------------------
+    log_desc_flags_to_string - generate a string
+    representing the instruction description
+    flags
+-------------------------------------------------*/
+
+const char *sh34_base_device::log_desc_flags_to_string(UINT32 flags)
+{
+	static char tempbuf[30];
+	char *dest = tempbuf;
+
+	/* branches */
+	if (flags & OPFLAG_IS_UNCONDITIONAL_BRANCH)
+		*dest++ = 'U';
+	else if (flags & OPFLAG_IS_CONDITIONAL_BRANCH)
+		*dest++ = 'C';
+	else
+		*dest++ = '.';
+
+	/* intrablock branches */
+	*dest++ = (flags & OPFLAG_INTRABLOCK_BRANCH) ? 'i' : '.';
+
+	/* branch targets */
+	*dest++ = (flags & OPFLAG_IS_BRANCH_TARGET) ? 'B' : '.';
+
+	/* delay slots */
+	*dest++ = (flags & OPFLAG_IN_DELAY_SLOT) ? 'D' : '.';
+
+	/* exceptions */
+	if (flags & OPFLAG_WILL_CAUSE_EXCEPTION)
+		*dest++ = 'E';
+	else if (flags & OPFLAG_CAN_CAUSE_EXCEPTION)
+		*dest++ = 'e';
+	else
+		*dest++ = '.';
+
+	/* read/write */
+	if (flags & OPFLAG_READS_MEMORY)
+		*dest++ = 'R';
+	else if (flags & OPFLAG_WRITES_MEMORY)
+		*dest++ = 'W';
+	else
+		*dest++ = '.';
+
+	/* mode changes */
+	*dest++ = (flags & OPFLAG_CAN_CHANGE_MODES) ? 'M' : '.';
+
+	/* TLB validation */
+	*dest++ = (flags & OPFLAG_VALIDATE_TLB) ? 'V' : '.';
+
+	/* TLB modification */
+	*dest++ = (flags & OPFLAG_MODIFIES_TRANSLATION) ? 'T' : '.';
+
+	/* redispatch */
+	*dest++ = (flags & OPFLAG_REDISPATCH) ? 'R' : '.';
+	*dest = 0;
+	return tempbuf;
+}
+
+
+/*-------------------------------------------------
+    log_register_list - log a list of GPR registers
+-------------------------------------------------*/
+
+void sh34_base_device::log_register_list(drcuml_state *drcuml, const char *string, const UINT32 *reglist, const UINT32 *regnostarlist)
+{
+	static const struct
+	{
+		UINT32      flag;
+		const char *name;
+	} s_control_regs[] =
+	{
+		{ REGFLAG_PR,    "pr" },
+		{ REGFLAG_SR,    "sr" },
+		{ REGFLAG_MACL,  "macl" },
+		{ REGFLAG_MACH,  "mach" },
+		{ REGFLAG_GBR,   "gbr" },
+		{ REGFLAG_VBR,   "vbr" },
+		{ REGFLAG_SGR,   "sgr" },
+		{ REGFLAG_FPUL,  "fpul" },
+		{ REGFLAG_FPSCR, "fpscr" },
+		{ REGFLAG_DBR,   "dbr" },
+		{ REGFLAG_SSR,   "ssr" },
+		{ REGFLAG_SPC,   "spc" }
+	};
+	int count = 0;
+	int regnum;
+
+	/* skip if nothing */
+	if (reglist[0] == 0 && reglist[1] == 0 && reglist[2] == 0)
+		return;
+
+	drcuml->log_printf("[%s:", string);
+
+	for (regnum = 0; regnum < 16; regnum++)
+	{
+		if (reglist[0] & REGFLAG_R(regnum))
+		{
+			drcuml->log_printf("%sr%d", (count++ == 0) ? "" : ",", regnum);
+			if (regnostarlist != nullptr && !(regnostarlist[0] & REGFLAG_R(regnum)))
+				drcuml->log_printf("*");
+		}
+	}
+
+	for (auto &reg : s_control_regs)
+	{
+		if (reglist[1] & reg.flag)
+		{
+			drcuml->log_printf("%s%s", (count++ == 0) ? "" : ",", reg.name);
+			if (regnostarlist != nullptr && !(regnostarlist[1] & reg.flag))
+				drcuml->log_printf("*");
+		}
+	}
+
+	for (regnum = 0; regnum < 16; regnum++)
+	{
+		if (reglist[2] & REGFLAG_FR(regnum))
+		{
+			drcuml->log_printf("%sfr%d", (count++ == 0) ? "" : ",", regnum);
+			if (regnostarlist != nullptr && !(regnostarlist[2] & REGFLAG_FR(regnum)))
+				drcuml->log_printf("*");
+		}
+	}
+
+	drcuml->log_printf("] ");
+}
+
+/*-------------------------------------------------
+    log_opcode_desc - log a list of descriptions
+-------------------------------------------------*/
+
+void sh34_base_device::log_opcode_desc(drcuml_state *drcuml, const opcode_desc *desclist, int indent)
+{
+	/* open the file, creating it if necessary */
+	if (indent == 0)
+		drcuml->log_printf("\nDescriptor list @ %08X\n", desclist->pc);
+
+	/* output each descriptor */
+	for ( ; desclist != nullptr; desclist = desclist->next())
+	{
+		char buffer[100];
+
+		/* disassemle the current instruction and output it to the log */
+		if (drcuml->logging() || drcuml->logging_native())
+		{
+			if (desclist->flags & OPFLAG_VIRTUAL_NOOP)
+				strcpy(buffer, "<virtual nop>");
+			else
+				DasmSH4(buffer, desclist->pc, desclist->opptr.w[0]);
+		}
+		else
+			strcpy(buffer, "???");
+		drcuml->log_printf("%08X [%08X] t:%08X f:%s: %-30s", desclist->pc, desclist->physpc, desclist->targetpc, log_desc_flags_to_string(desclist->flags), buffer);
+
+		/* output register states */
+		log_register_list(drcuml, "use", desclist->regin, nullptr);
+		log_register_list(drcuml, "mod", desclist->regout, desclist->regreq);
+		drcuml->log_printf("\n");
+
+		/* if we have a delay slot, output it recursively */
+		if (desclist->delay.first() != nullptr)
+			log_opcode_desc(drcuml, desclist->delay.first(), indent + 1);
+
+		/* at the end of a sequence add a dividing line */
+		if (desclist->flags & OPFLAG_END_SEQUENCE)
+			drcuml->log_printf("-----\n");
+	}
+}
+
+/*-------------------------------------------------
+    log_add_disasm_comment - add a comment
+    including disassembly of an SH4 instruction
+-------------------------------------------------*/
+
+void sh34_base_device::log_add_disasm_comment(drcuml_block *block, UINT32 pc, UINT32 op)
+{
+	if (m_drcuml->logging())
+	{
+		char buffer[100];
+		DasmSH4(buffer, pc, op);
+		block->append_comment("%08X: %s", pc, buffer);                  // comment
+	}
+}
+
+/*-------------------------------------------------
+    generate_update_cycles - generate code to
+    subtract cycles from the icount and generate
+    an exception if out
+-------------------------------------------------*/
+
+void sh34_base_device::generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception)
+{
+	/* check for pending exceptions; the interpreter does this after every instruction */
+	if (allow_exception)
+	{
+		code_label skip = compiler->labelnum++;
+
+		UML_CMP(block, mem(&m_sh4_state->test_irq), 0);                 // cmp     test_irq,0
+		UML_JMPc(block, COND_Z, skip);                                  // jz      skip
+
+		UML_MOV(block, mem(&m_sh4_state->pc), param);                   // mov     pc,param
+		save_fast_iregs(block);
+		UML_CALLC(block, cfunc_check_irq, this);                        // callc   cfunc_check_irq
+		load_fast_iregs(block);
+		UML_CMP(block, mem(&m_sh4_state->arg0), 0);                     // cmp     arg0,0
+		UML_JMPc(block, COND_Z, skip);                                  // jz      skip
+
+		/* an exception was taken; pc now points at the handler */
+		if (compiler->cycles > 0)
+		{
+			UML_SUB(block, mem(&m_sh4_state->icount), mem(&m_sh4_state->icount), MAPVAR_CYCLES);  // sub     icount,icount,cycles
+			UML_EXHc(block, COND_S, *m_out_of_cycles, mem(&m_sh4_state->pc));  // exh     out_of_cycles,pc
+		}
+		generate_mode_hashjmp(block, mem(&m_sh4_state->pc));            // hashjmp <mode>,pc,nocode
+
+		UML_LABEL(block, skip);                                         // skip:
+	}
+
+	/* account for cycles */
+	if (compiler->cycles > 0)
+	{
+		UML_SUB(block, mem(&m_sh4_state->icount), mem(&m_sh4_state->icount), MAPVAR_CYCLES);    // sub     icount,icount,cycles
+		UML_MAPVAR(block, MAPVAR_CYCLES, 0);                                        // mapvar  cycles,0
+		if (allow_exception)
+			UML_EXHc(block, COND_S, *m_out_of_cycles, param);
+																					// exh     out_of_cycles,nextpc
+	}
+	compiler->cycles = 0;
+}
+
+/*-------------------------------------------------
+    generate_mode_hashjmp - jump to a PC using the
+    FPU mode currently in FPSCR
+-------------------------------------------------*/
+
+void sh34_base_device::generate_mode_hashjmp(drcuml_block *block, uml::parameter param)
+{
+	UML_SHL(block, I0, mem(&m_sh4_state->fpu_pr), 1);               // shl     i0,fpu_pr,1
+	UML_OR(block, I0, I0, mem(&m_sh4_state->fpu_sz));               // or      i0,i0,fpu_sz
+	UML_HASHJMP(block, I0, param, *m_nocode);                       // hashjmp i0,param,nocode
+}
+
+/*-------------------------------------------------
+    generate_branch_hashjmp - jump to a branch
+    target, rechecking the mode only if the delay
+    slot could have changed it
+-------------------------------------------------*/
+
+void sh34_base_device::generate_branch_hashjmp(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, uml::parameter param)
+{
+	if (desc->delay.first() != nullptr && (desc->delay.first()->flags & OPFLAG_CAN_CHANGE_MODES))
+		generate_mode_hashjmp(block, param);
+	else
+		UML_HASHJMP(block, compiler->mode, param, *m_nocode);       // hashjmp <mode>,param,nocode
+}
+
+/*-------------------------------------------------
+    generate_checksum_block - generate code to
+    validate a sequence of opcodes
+-------------------------------------------------*/
+
+void sh34_base_device::generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	const opcode_desc *curdesc;
+	if (m_drcuml->logging())
+		block->append_comment("[Validation for %08X]", seqhead->pc);                // comment
+
+	/* loose verify or single instruction: just compare and fail */
+	if (!(m_drcoptions & SH4DRC_STRICT_VERIFY) || seqhead->next() == nullptr)
+	{
+		if (!(seqhead->flags & OPFLAG_VIRTUAL_NOOP))
+		{
+			void *base = m_direct->read_ptr(seqhead->physpc & AM, m_opcode_xor);
+			if (base != nullptr)
+			{
+				UML_LOAD(block, I0, base, 0, SIZE_WORD, SCALE_x2);                          // load    i0,base,word
+				UML_CMP(block, I0, seqhead->opptr.w[0]);                        // cmp     i0,*opptr
+				UML_EXHc(block, COND_NE, *m_nocode, epc(seqhead));       // exne    nocode,seqhead->pc
+			}
+		}
+	}
+
+	/* full verification; sum up everything */
+	else
+	{
+		UINT32 sum = 0;
+		void *base = m_direct->read_ptr(seqhead->physpc & AM, m_opcode_xor);
+		if (base == nullptr)
+			return;
+		UML_LOAD(block, I0, base, 0, SIZE_WORD, SCALE_x2);                              // load    i0,base,word
+		sum += seqhead->opptr.w[0];
+		for (curdesc = seqhead->next(); curdesc != seqlast->next(); curdesc = curdesc->next())
+			if (!(curdesc->flags & OPFLAG_VIRTUAL_NOOP))
+			{
+				base = m_direct->read_ptr(curdesc->physpc & AM, m_opcode_xor);
+				if (base == nullptr)
+					continue;
+				UML_LOAD(block, I1, base, 0, SIZE_WORD, SCALE_x2);                      // load    i1,*opptr,word
+				UML_ADD(block, I0, I0, I1);                         // add     i0,i0,i1
+				sum += curdesc->opptr.w[0];
+			}
+		UML_CMP(block, I0, sum);                                            // cmp     i0,sum
+		UML_EXHc(block, COND_NE, *m_nocode, epc(seqhead));           // exne    nocode,seqhead->pc
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void sh34_base_device::generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc)
+{
+	offs_t expc;
+
+	/* add an entry for the log */
+	if (m_drcuml->logging() && !(desc->flags & OPFLAG_VIRTUAL_NOOP))
+		log_add_disasm_comment(block, desc->pc, desc->opptr.w[0]);
+
+	/* set the PC map variable */
+	expc = (desc->flags & OPFLAG_IN_DELAY_SLOT) ? desc->pc - 1 : desc->pc;
+	UML_MAPVAR(block, MAPVAR_PC, expc);                                             // mapvar  PC,expc
+
+	/* accumulate total cycles */
+	compiler->cycles += desc->cycles;
+
+	/* update the icount map variable */
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);                             // mapvar  CYCLES,compiler->cycles
+
+	/* if we want a probe, add it here */
+	if (desc->pc == PROBE_ADDRESS)
+	{
+		UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);                                // mov     [pc],desc->pc
+		save_fast_iregs(block);
+		UML_CALLC(block, cfunc_printf_probe, this);                                  // callc   cfunc_printf_probe,sh4
+	}
+
+	/* if we are debugging, call the debugger */
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);                                // mov     [pc],desc->pc
+		save_fast_iregs(block);
+		UML_DEBUG(block, desc->pc & AM);                                         // debug   desc->pc
+	}
+	else    // not debug, see what other reasons there are for flushing the PC
+	{
+		if (m_drcoptions & SH4DRC_FLUSH_PC)  // always flush?
+		{
+			UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);        // mov m_sh4_state->pc, desc->pc
+		}
+		else    // check for driver-selected flushes
+		{
+			int pcflush;
+
+			for (pcflush = 0; pcflush < m_pcfsel; pcflush++)
+			{
+				if (desc->pc == m_pcflushes[pcflush])
+				{
+					UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);        // mov m_sh4_state->pc, desc->pc
+				}
+			}
+		}
+	}
+
+
+	/* if we hit an unmapped address, fatal error */
+	if (desc->flags & OPFLAG_COMPILER_UNMAPPED)
+	{
+		UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);                                // mov     [pc],desc->pc
+		save_fast_iregs(block);
+		UML_EXIT(block, EXECUTE_UNMAPPED_CODE);                             // exit    EXECUTE_UNMAPPED_CODE
+	}
+
+	/* if this is an invalid opcode, die */
+	if (desc->flags & OPFLAG_INVALID_OPCODE)
+	{
+		fatalerror("SH4DRC: invalid opcode!\n");
+	}
+
+	/* otherwise, unless this is a virtual no-op, it's a regular instruction */
+	else if (!(desc->flags & OPFLAG_VIRTUAL_NOOP))
+	{
+		/* register-only instructions can be checked against the interpreter */
+		bool lockstep = ((m_drcoptions & SH4DRC_LOCKSTEP) || LOCKSTEP_ALWAYS) &&
+			!(desc->flags & (OPFLAG_IN_DELAY_SLOT | OPFLAG_IS_BRANCH | OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY | OPFLAG_END_SEQUENCE | OPFLAG_CAN_CHANGE_MODES));
+
+		if (lockstep)
+		{
+			save_fast_iregs(block);
+			UML_MOV(block, mem(&m_sh4_state->arg0), desc->opptr.w[0]);              // mov     [arg0],opcode
+			UML_MOV(block, mem(&m_sh4_state->arg1), desc->pc);                      // mov     [arg1],desc->pc
+			UML_MOV(block, mem(&m_sh4_state->pc), desc->pc + 2);                    // mov     [pc],desc->pc+2
+			UML_CALLC(block, cfunc_lockstep_run, this);                             // callc   cfunc_lockstep_run
+			load_fast_iregs(block);
+		}
+
+		/* compile the instruction, or hand it to the interpreter */
+		if (!generate_opcode(block, compiler, desc, ovrpc))
+			generate_interpreter_call(block, compiler, desc);
+
+		if (lockstep)
+		{
+			save_fast_iregs(block);
+			UML_CALLC(block, cfunc_lockstep_check, this);                           // callc   cfunc_lockstep_check
+			load_fast_iregs(block);
+		}
+	}
+}
+
+/*------------------------------------------------------------------
+    generate_delay_slot
+------------------------------------------------------------------*/
+
+void sh34_base_device::generate_delay_slot(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc)
+{
+	compiler_state compiler_temp = *compiler;
+
+	/* compile the delay slot using temporary compiler state */
+	assert(desc->delay.first() != nullptr);
+	generate_sequence_instruction(block, &compiler_temp, desc->delay.first(), ovrpc);              // <next instruction>
+
+	/* update the label */
+	compiler->labelnum = compiler_temp.labelnum;
+}
+
+/*-------------------------------------------------
+    generate_interpreter_call - run an instruction
+    we don't translate through the interpreter
+-------------------------------------------------*/
+
+void sh34_base_device::generate_interpreter_call(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	save_fast_iregs(block);
+	UML_MOV(block, mem(&m_sh4_state->pc), desc->pc + 2);                            // mov     [pc],desc->pc+2
+	UML_MOV(block, mem(&m_sh4_state->arg0), desc->opptr.w[0]);                      // mov     [arg0],opcode
+	UML_CALLC(block, cfunc_execute_one, this);                                       // callc   cfunc_execute_one
+	load_fast_iregs(block);
+}
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a specific
+    opcode
+-------------------------------------------------*/
+
+int sh34_base_device::generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc)
+{
+	UINT32 scratch, scratch2;
+	INT32 disp;
+	UINT16 opcode = desc->opptr.w[0];
+	UINT8 opswitch = opcode >> 12;
+	int in_delay_slot = ((desc->flags & OPFLAG_IN_DELAY_SLOT) != 0);
+
+	switch (opswitch)
+	{
+		case  0:
+			return generate_group_0(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+		case  1:    // MOVLS4
+			scratch = (opcode & 0x0f) * 4;
+			UML_ADD(block, I0, R32(Rn), scratch);   // add r0, Rn, scratch
+			UML_MOV(block, I1, R32(Rm));        // mov r1, Rm
+			SETEA(0);                       // set ea for debug
+			UML_CALLH(block, *m_write32);
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+
+		case  2:
+			return generate_group_2(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+		case  3:
+			return generate_group_3(block, compiler, desc, opcode, ovrpc);
+		case  4:
+			return generate_group_4(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+		case  5:    // MOVLL4
+			scratch = (opcode & 0x0f) * 4;
+			UML_ADD(block, I0, R32(Rm), scratch);       // add r0, Rm, scratch
+			SETEA(0);                       // set ea for debug
+			UML_CALLH(block, *m_read32);             // call read32
+			UML_MOV(block, R32(Rn), I0);            // mov Rn, r0
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+
+		case  6:
+			return generate_group_6(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+		case  7:    // ADDI
+			scratch = opcode & 0xff;
+			scratch2 = (UINT32)(INT32)(INT16)(INT8)scratch;
+			UML_ADD(block, R32(Rn), R32(Rn), scratch2); // add Rn, Rn, scratch2
+			return TRUE;
+
+		case  8:
+			return generate_group_8(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+		case  9:    // MOVWI
+			if (ovrpc == OVRPC_DYNAMIC)
+			{
+				// delay slot of a computed branch: pc is the runtime target
+				UML_ADD(block, I0, mem(&m_sh4_state->target), ((opcode & 0xff) * 2) + 2);   // add r0, target, disp
+				SETEA(0);                       // set ea for debug
+				UML_CALLH(block, *m_read16);             // read16(r0, r1)
+				UML_SEXT(block, R32(Rn), I0, SIZE_WORD);            // sext Rn, r0, WORD
+			}
+			else
+			{
+				if (ovrpc == 0xffffffff)
+				{
+					scratch = (desc->pc + 2) + ((opcode & 0xff) * 2) + 2;
+				}
+				else
+				{
+					scratch = (ovrpc + 2) + ((opcode & 0xff) * 2) + 2;
+				}
+
+				if (m_drcoptions & SH4DRC_STRICT_PCREL)
+				{
+					UML_MOV(block, I0, scratch);            // mov r0, scratch
+					SETEA(0);                       // set ea for debug
+					UML_CALLH(block, *m_read16);             // read16(r0, r1)
+					UML_SEXT(block, R32(Rn), I0, SIZE_WORD);            // sext Rn, r0, WORD
+				}
+				else
+				{
+					scratch2 = (UINT32)(INT32)(INT16) RW(scratch);
+					UML_MOV(block, R32(Rn), scratch2);          // mov Rn, scratch2
+				}
+			}
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+
+		case 10:    // BRA
+			disp = ((INT32)opcode << 20) >> 20;
+			scratch = (desc->pc + 2) + disp * 2 + 2;            // scratch = pc+4 + disp*2
+
+			generate_delay_slot(block, compiler, desc, scratch - 2);
+
+			generate_update_cycles(block, compiler, scratch, TRUE);    // <subtract cycles>
+			generate_branch_hashjmp(block, compiler, desc, scratch);   // hashjmp <mode>,scratch
+			return TRUE;
+
+		case 11:    // BSR
+			// the delay slot is allowed to clobber PR, so set it first
+			UML_ADD(block, mem(&m_sh4_state->pr), desc->pc, 4); // add m_pr, desc->pc, #4 (skip the current insn & delay slot)
+
+			disp = ((INT32)opcode << 20) >> 20;
+			scratch = (desc->pc + 2) + disp * 2 + 2;            // scratch = pc+4 + disp*2
+
+			generate_delay_slot(block, compiler, desc, scratch - 2);
+
+			generate_update_cycles(block, compiler, scratch, TRUE);    // <subtract cycles>
+			generate_branch_hashjmp(block, compiler, desc, scratch);   // hashjmp <mode>,scratch
+			return TRUE;
+
+		case 12:
+			return generate_group_12(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+		case 13:    // MOVLI
+			if (ovrpc == OVRPC_DYNAMIC)
+			{
+				// delay slot of a computed branch: pc is the runtime target
+				UML_ADD(block, I0, mem(&m_sh4_state->target), 2);       // add r0, target, #2
+				UML_AND(block, I0, I0, ~3);                             // and r0, r0, #~3
+				UML_ADD(block, I0, I0, (opcode & 0xff) * 4);            // add r0, r0, disp
+				UML_CALLH(block, *m_read32);             // read32(r0, r1)
+				UML_MOV(block, R32(Rn), I0);            // mov Rn, r0
+			}
+			else
+			{
+				if (ovrpc == 0xffffffff)
+				{
+					scratch = ((desc->pc + 4) & ~3) + ((opcode & 0xff) * 4);
+				}
+				else
+				{
+					scratch = ((ovrpc + 4) & ~3) + ((opcode & 0xff) * 4);
+				}
+
+				if (m_drcoptions & SH4DRC_STRICT_PCREL)
+				{
+					UML_MOV(block, I0, scratch);            // mov r0, scratch
+					UML_CALLH(block, *m_read32);             // read32(r0, r1)
+					UML_MOV(block, R32(Rn), I0);            // mov Rn, r0
+				}
+				else
+				{
+					scratch2 = RL(scratch);
+					UML_MOV(block, R32(Rn), scratch2);          // mov Rn, scratch2
+				}
+			}
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+
+		case 14:    // MOVI
+			scratch = opcode & 0xff;
+			scratch2 = (UINT32)(INT32)(INT16)(INT8)scratch;
+			UML_MOV(block, R32(Rn), scratch2);
+			return TRUE;
+
+		case 15:
+			return generate_group_15(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	switch (opcode & 0xF)
+	{
+	case 0x0:
+	case 0x1:
+		return TRUE;    // NOP
+
+	case 0x2:
+		if (opcode & 0x80)
+		{
+			// STCRBANK(Rm, Rn); - the bank that isn't live depends on SR.RB at runtime
+			UML_TEST(block, mem(&m_sh4_state->sr), sRB);                            // test sr, RB
+			UML_MOV(block, I0, mem(&m_sh4_state->rbnk[1][Rm & 7]));                 // mov r0, rbnk[1][m]
+			UML_MOVc(block, COND_NZ, I0, mem(&m_sh4_state->rbnk[0][Rm & 7]));       // movnz r0, rbnk[0][m]
+			UML_MOV(block, R32(Rn), I0);                                            // mov Rn, r0
+			return TRUE;
+		}
+
+		switch (opcode & 0x70)
+		{
+		case 0x00: // STCSR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->sr));     // mov Rn, sr
+			return TRUE;
+
+		case 0x10: // STCGBR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->gbr));    // mov Rn, gbr
+			return TRUE;
+
+		case 0x20: // STCVBR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->vbr));    // mov Rn, vbr
+			return TRUE;
+
+		case 0x30: // STCSSR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->ssr));    // mov Rn, ssr
+			return TRUE;
+
+		case 0x40: // STCSPC(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->spc));    // mov Rn, spc
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0x3:
+		switch (opcode & 0xF0)
+		{
+		case 0x00: // BSRF(Rn);
+			UML_ADD(block, mem(&m_sh4_state->target), R32(Rn), desc->pc + 4);  // add target, Rn, pc+4
+
+			// the delay slot is allowed to clobber PR, so set it first
+			UML_ADD(block, mem(&m_sh4_state->pr), desc->pc, 4); // add m_pr, desc->pc, #4 (skip the current insn & delay slot)
+
+			generate_delay_slot(block, compiler, desc, OVRPC_DYNAMIC);
+
+			generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+			generate_branch_hashjmp(block, compiler, desc, mem(&m_sh4_state->target)); // jmp target
+			return TRUE;
+
+		case 0x20: // BRAF(Rn);
+			UML_ADD(block, mem(&m_sh4_state->target), R32(Rn), desc->pc + 4); // add target, Rn, pc+4
+
+			generate_delay_slot(block, compiler, desc, OVRPC_DYNAMIC);
+
+			generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+			generate_branch_hashjmp(block, compiler, desc, mem(&m_sh4_state->target)); // jmp target
+			return TRUE;
+
+		case 0x80: // PREFM(Rn);
+			// only the store queue area does anything
+			UML_AND(block, I0, R32(Rn), 0xfc000000);        // and r0, Rn, #0xfc000000
+			UML_CMP(block, I0, 0xe0000000);                 // cmp r0, #0xe0000000
+			UML_JMPc(block, COND_NE, compiler->labelnum);   // jne labelnum
+
+			save_fast_iregs(block);
+			UML_MOV(block, mem(&m_sh4_state->arg0), desc->opptr.w[0]);      // mov arg0, opcode
+			UML_CALLC(block, cfunc_prefetch, this);                         // callc cfunc_prefetch
+
+			UML_LABEL(block, compiler->labelnum++);         // labelnum:
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+
+		case 0x90:
+		case 0xa0:
+		case 0xb0:
+			return FALSE;   // TODO
+
+		case 0xc0: // MOVCAL(Rn);
+			UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+			UML_MOV(block, I1, R32(0));         // mov r1, R0
+			SETEA(0);
+			UML_CALLH(block, *m_write32);            // call write32
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0x4: // MOVBS0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rn));        // add r0, R0, Rn
+		UML_AND(block, I1, R32(Rm), 0x000000ff);    // and r1, Rm, 0xff
+		UML_CALLH(block, *m_write8);             // call write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x5: // MOVWS0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rn));        // add r0, R0, Rn
+		UML_AND(block, I1, R32(Rm), 0x0000ffff);    // and r1, Rm, 0xffff
+		UML_CALLH(block, *m_write16);                // call write16
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x6: // MOVLS0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rn));        // add r0, R0, Rn
+		UML_MOV(block, I1, R32(Rm));            // mov r1, Rm
+		UML_CALLH(block, *m_write32);                // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x7: // MULL(Rm, Rn);
+		UML_MULU(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->ea), R32(Rn), R32(Rm));  // mulu macl, ea, Rn, Rm
+		return TRUE;
+
+	case 0x8:
+		switch (opcode & 0x70)
+		{
+		case 0x00: // CLRT();
+			UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T (clear the T bit)
+			return TRUE;
+
+		case 0x10: // SETT();
+			UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+			return TRUE;
+
+		case 0x20: // CLRMAC();
+			UML_MOV(block, mem(&m_sh4_state->macl), 0);     // mov macl, #0
+			UML_MOV(block, mem(&m_sh4_state->mach), 0);     // mov mach, #0
+			return TRUE;
+
+		case 0x30:
+			return FALSE;   // TODO
+
+		case 0x40: // CLRS();
+			UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~S);   // and sr, sr, ~S
+			return TRUE;
+
+		case 0x50: // SETS();
+			UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), S); // or sr, sr, S
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0x9:
+		switch (opcode & 0x30)
+		{
+		case 0x10: // DIV0U();
+			UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~(M|Q|T)); // and sr, sr, ~(M|Q|T)
+			return TRUE;
+
+		case 0x20: // MOVT(Rn);
+			UML_AND(block, R32(Rn), mem(&m_sh4_state->sr), T);      // and Rn, sr, T
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0xa:
+		switch (opcode & 0x70)
+		{
+		case 0x00: // STSMACH(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->mach));       // mov Rn, mach
+			return TRUE;
+
+		case 0x10: // STSMACL(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->macl));       // mov Rn, macl
+			return TRUE;
+
+		case 0x20: // STSPR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->pr));         // mov Rn, pr
+			return TRUE;
+
+		case 0x30: // STCSGR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->sgr));        // mov Rn, sgr
+			return TRUE;
+
+		case 0x50: // STSFPUL(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->fpul));       // mov Rn, fpul
+			return TRUE;
+
+		case 0x60: // STSFPSCR(Rn);
+			UML_AND(block, R32(Rn), mem(&m_sh4_state->fpscr), 0x003FFFFF);  // and Rn, fpscr, #0x003fffff
+			return TRUE;
+
+		case 0x70: // STCDBR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->dbr));        // mov Rn, dbr
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0xb:
+		switch (opcode & 0x30)
+		{
+		case 0x00: // RTS();
+			UML_MOV(block, mem(&m_sh4_state->target), mem(&m_sh4_state->pr));   // mov target, pr (in case of d-slot shenanigans)
+
+			generate_delay_slot(block, compiler, desc, OVRPC_DYNAMIC);
+
+			generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+			generate_branch_hashjmp(block, compiler, desc, mem(&m_sh4_state->target));
+			return TRUE;
+
+		case 0x10: // SLEEP();
+			// the interpreter works out whether we stay put or move on
+			generate_interpreter_call(block, compiler, desc);
+
+			generate_update_cycles(block, compiler, mem(&m_sh4_state->pc), TRUE);  // <subtract cycles>
+			UML_HASHJMP(block, compiler->mode, mem(&m_sh4_state->pc), *m_nocode);   // hashjmp <mode>,pc
+			return TRUE;
+
+		case 0x20: // RTE();
+			// bank switching and SR/exception bookkeeping stay in the interpreter
+			generate_interpreter_call(block, compiler, desc);
+			UML_MOV(block, mem(&m_sh4_state->target), mem(&m_sh4_state->pc));   // mov target, pc
+
+			generate_delay_slot(block, compiler, desc, OVRPC_DYNAMIC);
+
+			generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+			generate_branch_hashjmp(block, compiler, desc, mem(&m_sh4_state->target)); // and jump to the "resume PC"
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0xc: // MOVBL0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rm));        // add r0, R0, Rm
+		UML_CALLH(block, *m_read8);              // call read8
+		UML_SEXT(block, R32(Rn), I0, SIZE_BYTE);        // sext Rn, r0, BYTE
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0xd: // MOVWL0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rm));        // add r0, R0, Rm
+		UML_CALLH(block, *m_read16);             // call read16
+		UML_SEXT(block, R32(Rn), I0, SIZE_WORD);        // sext Rn, r0, WORD
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0xe: // MOVLL0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rm));        // add r0, R0, Rm
+		UML_CALLH(block, *m_read32);             // call read32
+		UML_MOV(block, R32(Rn), I0);            // mov Rn, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0xf: // MAC_L(Rm, Rn);
+		return FALSE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_2(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	switch (opcode & 15)
+	{
+	case  0: // MOVBS(Rm, Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_AND(block, I1, R32(Rm), 0xff);  // and r1, Rm, 0xff
+		UML_CALLH(block, *m_write8);
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  1: // MOVWS(Rm, Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_AND(block, I1, R32(Rm), 0xffff);    // and r1, Rm, 0xffff
+		UML_CALLH(block, *m_write16);
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  2: // MOVLS(Rm, Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_MOV(block, I1, R32(Rm));        // mov r1, Rm
+		UML_CALLH(block, *m_write32);
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  3:
+		return TRUE;    // NOP
+
+	case  4: // MOVBM(Rm, Rn);
+		UML_MOV(block, I1, R32(Rm));        // mov r1, Rm
+		UML_SUB(block, R32(Rn), R32(Rn), 1);    // sub Rn, Rn, 1
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_CALLH(block, *m_write8);         // call write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  5: // MOVWM(Rm, Rn);
+		UML_MOV(block, I1, R32(Rm));        // mov r1, Rm
+		UML_SUB(block, R32(Rn), R32(Rn), 2);    // sub Rn, Rn, 2
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_CALLH(block, *m_write16);            // call write16
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  6: // MOVLM(Rm, Rn);
+		UML_MOV(block, I1, R32(Rm));        // mov r1, Rm
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, 4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 13: // XTRCT(Rm, Rn);
+		UML_SHL(block, I0, R32(Rm), 16);        // shl r0, Rm, #16
+		UML_AND(block, I0, I0, 0xffff0000); // and r0, r0, #0xffff0000
+
+		UML_SHR(block, I1, R32(Rn), 16);        // shr, r1, Rn, #16
+		UML_AND(block, I1, I1, 0xffff);     // and r1, r1, #0x0000ffff
+
+		UML_OR(block, R32(Rn), I0, I1);     // or Rn, r0, r1
+		return TRUE;
+
+	case  7: // DIV0S(Rm, Rn);
+		UML_MOV(block, I0, mem(&m_sh4_state->sr));              // move r0, sr
+		UML_AND(block, I0, I0, ~(Q|M|T));       // and r0, r0, ~(Q|M|T) (clear the Q,M, and T bits)
+
+		UML_TEST(block, R32(Rn), 0x80000000);           // test Rn, #0x80000000
+		UML_JMPc(block, COND_Z, compiler->labelnum);            // jz labelnum
+
+		UML_OR(block, I0, I0, Q);               // or r0, r0, Q
+		UML_LABEL(block, compiler->labelnum++);             // labelnum:
+
+		UML_TEST(block, R32(Rm), 0x80000000);           // test Rm, #0x80000000
+		UML_JMPc(block, COND_Z, compiler->labelnum);            // jz labelnum
+
+		UML_OR(block, I0, I0, M);               // or r0, r0, M
+		UML_LABEL(block, compiler->labelnum++);             // labelnum:
+
+		UML_XOR(block, I1, R32(Rn), R32(Rm));           // xor r1, Rn, Rm
+		UML_TEST(block, I1, 0x80000000);            // test r1, #0x80000000
+		UML_JMPc(block, COND_Z, compiler->labelnum);            // jz labelnum
+
+		UML_OR(block, I0, I0, T);               // or r0, r0, T
+		UML_LABEL(block, compiler->labelnum++);             // labelnum:
+		UML_MOV(block, mem(&m_sh4_state->sr), I0);              // mov sr, r0
+		return TRUE;
+
+	case  8: // TST(Rm, Rn);
+		UML_AND(block, I0, mem(&m_sh4_state->sr), ~T);  // and r0, sr, ~T (clear the T bit)
+		UML_TEST(block, R32(Rm), R32(Rn));      // test Rm, Rn
+		UML_JMPc(block, COND_NZ, compiler->labelnum);   // jnz compiler->labelnum
+
+		UML_OR(block, I0, I0, T);   // or r0, r0, T
+		UML_LABEL(block, compiler->labelnum++);         // desc->pc:
+
+		UML_MOV(block, mem(&m_sh4_state->sr), I0);      // mov m_sh4_state->sr, r0
+		return TRUE;
+
+	case 12: // CMPSTR(Rm, Rn);
+		UML_XOR(block, I0, R32(Rn), R32(Rm));   // xor r0, Rn, Rm       (temp)
+
+		UML_SHR(block, I1, I0, 24); // shr r1, r0, #24  (HH)
+		UML_AND(block, I1, I1, 0xff);   // and r1, r1, #0xff
+
+		UML_SHR(block, I2, I0, 16); // shr r2, r0, #16  (HL)
+		UML_AND(block, I2, I2, 0xff);   // and r2, r2, #0xff
+
+		UML_SHR(block, I3, I0, 8);  // shr r3, r0, #8   (LH)
+		UML_AND(block, I3, I3, 0xff);   // and r3, r3, #0xff
+
+		UML_AND(block, I7, I0, 0xff);   // and r7, r0, #0xff    (LL)
+
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T (clear the T bit)
+
+		UML_CMP(block, I1, 0);      // cmp r1, #0
+		UML_JMPc(block, COND_Z, compiler->labelnum);    // jnz labelnum
+		UML_CMP(block, I2, 0);      // cmp r2, #0
+		UML_JMPc(block, COND_Z, compiler->labelnum);    // jnz labelnum
+		UML_CMP(block, I3, 0);      // cmp r3, #0
+		UML_JMPc(block, COND_Z, compiler->labelnum);    // jnz labelnum
+		UML_CMP(block, I7, 0);      // cmp r7, #0
+		UML_JMPc(block, COND_NZ, compiler->labelnum+1); // jnz labelnum
+
+		UML_LABEL(block, compiler->labelnum++);     // labelnum:
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+
+		UML_LABEL(block, compiler->labelnum++);     // labelnum+1:
+		return TRUE;
+
+	case  9: // AND(Rm, Rn);
+		UML_AND(block, R32(Rn), R32(Rn), R32(Rm));  // and Rn, Rn, Rm
+		return TRUE;
+
+	case 10: // XOR(Rm, Rn);
+		UML_XOR(block, R32(Rn), R32(Rn), R32(Rm));  // xor Rn, Rn, Rm
+		return TRUE;
+
+	case 11: // OR(Rm, Rn);
+		UML_OR(block, R32(Rn), R32(Rn), R32(Rm));   // or Rn, Rn, Rm
+		return TRUE;
+
+	case 14: // MULU(Rm, Rn);
+		UML_AND(block, I0, R32(Rm), 0xffff);                // and r0, Rm, 0xffff
+		UML_AND(block, I1, R32(Rn), 0xffff);                // and r1, Rn, 0xffff
+		UML_MULU(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->ea), I0, I1);    // mulu macl, ea, r0, r1
+		return TRUE;
+
+	case 15: // MULS(Rm, Rn);
+		UML_SEXT(block, I0, R32(Rm), SIZE_WORD);                // sext r0, Rm
+		UML_SEXT(block, I1, R32(Rn), SIZE_WORD);                // sext r1, Rn
+		UML_MULS(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->ea), I0, I1);    // muls macl, ea, r0, r1
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_3(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, UINT32 ovrpc)
+{
+	switch (opcode & 15)
+	{
+	case  0: // CMPEQ(Rm, Rn); (equality)
+		UML_CMP(block, R32(Rn), R32(Rm));       // cmp Rn, Rm
+		UML_SETc(block, COND_E, I0);            // set E, r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, 1); // rolins sr, r0, 0, 1
+		return TRUE;
+
+	case  2: // CMPHS(Rm, Rn); (unsigned greater than or equal)
+		UML_CMP(block, R32(Rn), R32(Rm));       // cmp Rn, Rm
+		UML_SETc(block, COND_AE, I0);       // set AE, r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, 1); // rolins sr, r0, 0, 1
+		return TRUE;
+
+	case  3: // CMPGE(Rm, Rn); (signed greater than or equal)
+		UML_CMP(block, R32(Rn), R32(Rm));       // cmp Rn, Rm
+		UML_SETc(block, COND_GE, I0);       // set GE, r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, 1); // rolins sr, r0, 0, 1
+		return TRUE;
+
+	case  6: // CMPHI(Rm, Rn); (unsigned greater than)
+		UML_CMP(block, R32(Rn), R32(Rm));       // cmp Rn, Rm
+		UML_SETc(block, COND_A, I0);            // set A, r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, 1); // rolins sr, r0, 0, 1
+		return TRUE;
+
+	case  7: // CMPGT(Rm, Rn); (signed greater than)
+		UML_CMP(block, R32(Rn), R32(Rm));       // cmp Rn, Rm
+		UML_SETc(block, COND_G, I0);            // set G, r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, 1); // rolins sr, r0, 0, 1
+		return TRUE;
+
+	case  1:
+	case  9:
+		return TRUE;    // NOP
+
+	case  4: // DIV1(Rm, Rn);
+		return FALSE;
+
+	case  5: // DMULU(Rm, Rn);
+		UML_MULU(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->mach), R32(Rn), R32(Rm));
+		return TRUE;
+
+	case 13: // DMULS(Rm, Rn);
+		UML_MULS(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->mach), R32(Rn), R32(Rm));
+		return TRUE;
+
+	case  8: // SUB(Rm, Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), R32(Rm));  // sub Rn, Rn, Rm
+		return TRUE;
+
+	case 12: // ADD(Rm, Rn);
+		UML_ADD(block, R32(Rn), R32(Rn), R32(Rm));  // add Rn, Rn, Rm
+		return TRUE;
+
+	case 10: // SUBC(Rm, Rn);
+		UML_CARRY(block, mem(&m_sh4_state->sr), 0); // carry = T (T is bit 0 of SR)
+		UML_SUBB(block, R32(Rn), R32(Rn), R32(Rm)); // addc Rn, Rn, Rm
+		UML_SETc(block, COND_C, I0);                // setc    i0, C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins sr,i0,0,T
+		return TRUE;
+
+	case 11: // SUBV(Rm, Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), R32(Rm));      // sub Rn, Rn, Rm
+		UML_SETc(block, COND_V, I0);                    // setc    i0, V
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins [sr],i0,0,T
+		return TRUE;
+
+	case 14: // ADDC(Rm, Rn);
+		UML_CARRY(block, mem(&m_sh4_state->sr), 0); // carry = T (T is bit 0 of SR)
+		UML_ADDC(block, R32(Rn), R32(Rn), R32(Rm)); // addc Rn, Rn, Rm
+		UML_SETc(block, COND_C, I0);                // setc    i0, C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins sr,i0,0,T
+		return TRUE;
+
+	case 15: // ADDV(Rm, Rn);
+		UML_ADD(block, R32(Rn), R32(Rn), R32(Rm));      // add Rn, Rn, Rm
+		UML_SETc(block, COND_V, I0);                    // setc    i0, V
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins [sr],i0,0,T
+		return TRUE;
+	}
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_4(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	uml::parameter src, dst;
+
+	switch (opcode & 0xF)
+	{
+	case 0x0:
+		switch (opcode & 0x30)
+		{
+		case 0x00: // SHLL(Rn);
+			UML_SHL(block, R32(Rn), R32(Rn), 1);        // shl Rn, Rn, 1
+			UML_SETc(block, COND_C, I0);                    // set i0,C
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins [sr],i0,0,T
+			return TRUE;
+
+		case 0x10: // DT(Rn);
+			UML_AND(block, I0, mem(&m_sh4_state->sr), ~T);  // and r0, sr, ~T (clear the T bit)
+			UML_SUB(block, R32(Rn), R32(Rn), 1);    // sub Rn, Rn, 1
+			UML_JMPc(block, COND_NZ, compiler->labelnum);   // jz compiler->labelnum
+
+			UML_OR(block, I0, I0, T);   // or r0, r0, T
+			UML_LABEL(block, compiler->labelnum++);         // desc->pc:
+
+			UML_MOV(block, mem(&m_sh4_state->sr), I0);      // mov m_sh4_state->sr, r0
+			return TRUE;
+
+		case 0x20: // SHAL(Rn);
+			UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T
+			UML_SHR(block, I0, R32(Rn), 31);        // shr r0, Rn, 31
+			UML_AND(block, I0, I0, T);      // and r0, r0, T
+			UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), I0);    // or sr, sr, r0
+			UML_SHL(block, R32(Rn), R32(Rn), 1);        // shl Rn, Rn, 1
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0x1:
+		switch (opcode & 0x30)
+		{
+		case 0x00: // SHLR(Rn);
+			UML_SHR(block, R32(Rn), R32(Rn), 1);        // shr Rn, Rn, 1
+			UML_SETc(block, COND_C, I0);                    // set i0,C
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins [sr],i0,0,T
+			return TRUE;
+
+		case 0x10: // CMPPZ(Rn);
+			UML_AND(block, I0, mem(&m_sh4_state->sr), ~T);  // and r0, sr, ~T (clear the T bit)
+
+			UML_CMP(block, R32(Rn), 0);     // cmp Rn, 0
+			UML_JMPc(block, COND_S, compiler->labelnum);    // js compiler->labelnum    (if negative)
+
+			UML_OR(block, I0, I0, T);   // or r0, r0, T
+			UML_LABEL(block, compiler->labelnum++);         // desc->pc:
+
+			UML_MOV(block, mem(&m_sh4_state->sr), I0);      // mov m_sh4_state->sr, r0
+			return TRUE;
+
+		case 0x20: // SHAR(Rn);
+			UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T
+			UML_AND(block, I0, R32(Rn), T);     // and r0, Rn, T
+			UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), I0);    // or sr, sr, r0
+			UML_SAR(block, R32(Rn), R32(Rn), 1);        // sar Rn, Rn, 1
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0x2: // STS.L / STC.L ...,@-Rn
+		switch (opcode & 0xF0)
+		{
+		case 0x00: src = mem(&m_sh4_state->mach); break;   // STSMMACH(Rn);
+		case 0x10: src = mem(&m_sh4_state->macl); break;   // STSMMACL(Rn);
+		case 0x20: src = mem(&m_sh4_state->pr); break;     // STSMPR(Rn);
+		case 0x30: src = mem(&m_sh4_state->sgr); break;    // STCMSGR(Rn);
+		case 0x50: src = mem(&m_sh4_state->fpul); break;   // STSMFPUL(Rn);
+		case 0x60: src = mem(&m_sh4_state->fpscr); break;  // STSMFPSCR(Rn);
+		case 0xF0: src = mem(&m_sh4_state->dbr); break;    // STCMDBR(Rn);
+		default:
+			return TRUE;    // NOP
+		}
+
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, #4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		if ((opcode & 0xF0) == 0x60)
+			UML_AND(block, I1, src, 0x003FFFFF);    // and r1, fpscr, #0x003fffff
+		else
+			UML_MOV(block, I1, src);    // mov r1, src
+		SETEA(0);                   // set ea for debug
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x3: // STC.L ...,@-Rn
+		if (opcode & 0x80)
+		{
+			// STCMRBANK(Rm, Rn);
+			UML_TEST(block, mem(&m_sh4_state->sr), sRB);                            // test sr, RB
+			UML_MOV(block, I1, mem(&m_sh4_state->rbnk[1][Rm & 7]));                 // mov r1, rbnk[1][m]
+			UML_MOVc(block, COND_NZ, I1, mem(&m_sh4_state->rbnk[0][Rm & 7]));       // movnz r1, rbnk[0][m]
+		}
+		else
+		{
+			switch (opcode & 0x70)
+			{
+			case 0x00: src = mem(&m_sh4_state->sr); break;     // STCMSR(Rn);
+			case 0x10: src = mem(&m_sh4_state->gbr); break;    // STCMGBR(Rn);
+			case 0x20: src = mem(&m_sh4_state->vbr); break;    // STCMVBR(Rn);
+			case 0x30: src = mem(&m_sh4_state->ssr); break;    // STCMSSR(Rn);
+			case 0x40: src = mem(&m_sh4_state->spc); break;    // STCMSPC(Rn);
+			default:
+				return TRUE;    // NOP
+			}
+			UML_MOV(block, I1, src);    // mov r1, src
+		}
+
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, #4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		SETEA(0);                   // set ea for debug
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x4:
+		switch (opcode & 0x30)
+		{
+		case 0x00: // ROTL(Rn);
+			UML_ROL(block, R32(Rn), R32(Rn), 1);        // rol Rn, Rn, 1
+			UML_SETc(block, COND_C, I0);                    // set i0,C
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins [sr],i0,0,T
+			return TRUE;
+
+		case 0x20: // ROTCL(Rn);
+			UML_CARRY(block, mem(&m_sh4_state->sr), 0);         // carry sr,0
+			UML_ROLC(block, R32(Rn), R32(Rn), 1);           // rolc  Rn,Rn,1
+			UML_SETc(block, COND_C, I0);                        // set   i0,C
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins sr,i0,0,T
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0x5:
+		switch (opcode & 0x30)
+		{
+		case 0x00: // ROTR(Rn);
+			UML_ROR(block, R32(Rn), R32(Rn), 1);        // ror Rn, Rn, 1
+			UML_SETc(block, COND_C, I0);                    // set i0,C
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins [sr],i0,0,T
+			return TRUE;
+
+		case 0x10: // CMPPL(Rn);
+			UML_AND(block, I0, mem(&m_sh4_state->sr), ~T);  // and r0, sr, ~T (clear the T bit)
+
+			UML_CMP(block, R32(Rn), 0);     // cmp Rn, 0
+
+			UML_JMPc(block, COND_S, compiler->labelnum);    // js compiler->labelnum    (if negative)
+			UML_JMPc(block, COND_Z, compiler->labelnum);    // jz compiler->labelnum    (if zero)
+
+			UML_OR(block, I0, I0, T);   // or r0, r0, T
+
+			UML_LABEL(block, compiler->labelnum++);         // desc->pc:
+			UML_MOV(block, mem(&m_sh4_state->sr), I0);      // mov m_sh4_state->sr, r0
+			return TRUE;
+
+		case 0x20: // ROTCR(Rn);
+			UML_CARRY(block, mem(&m_sh4_state->sr), 0);         // carry sr,0
+			UML_RORC(block, R32(Rn), R32(Rn), 1);           // rorc  Rn,Rn,1
+			UML_SETc(block, COND_C, I0);                        // set   i0,C
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins sr,i0,0,T
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0x6: // LDS.L @Rn+,...
+		switch (opcode & 0xF0)
+		{
+		case 0x00: dst = mem(&m_sh4_state->mach); break;   // LDSMMACH(Rn);
+		case 0x10: dst = mem(&m_sh4_state->macl); break;   // LDSMMACL(Rn);
+		case 0x20: dst = mem(&m_sh4_state->pr); break;     // LDSMPR(Rn);
+		case 0x50: dst = mem(&m_sh4_state->fpul); break;   // LDSMFPUL(Rn);
+		case 0xF0: dst = mem(&m_sh4_state->dbr); break;    // LDCMDBR(Rn);
+		case 0x60: // LDSMFPSCR(Rn);
+			return FALSE;
+		default:
+			return TRUE;    // NOP
+		}
+
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		SETEA(0);
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_ADD(block, R32(Rn), R32(Rn), 4);    // add Rn, #4
+		UML_MOV(block, dst, I0);    // mov dst, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x7: // LDC.L @Rn+,...
+		if (opcode & 0x80)
+		{
+			// LDCMRBANK(Rm, Rn);
+			UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+			SETEA(0);
+			UML_CALLH(block, *m_read32);         // call read32
+			UML_ADD(block, R32(Rn), R32(Rn), 4);    // add Rn, #4
+
+			UML_TEST(block, mem(&m_sh4_state->sr), sRB);                    // test sr, RB
+			UML_JMPc(block, COND_Z, compiler->labelnum);                    // jz labelnum
+			UML_MOV(block, mem(&m_sh4_state->rbnk[0][Rm & 7]), I0);         // mov rbnk[0][m], r0
+			UML_JMP(block, compiler->labelnum + 1);                         // jmp labelnum+1
+			UML_LABEL(block, compiler->labelnum++);                         // labelnum:
+			UML_MOV(block, mem(&m_sh4_state->rbnk[1][Rm & 7]), I0);         // mov rbnk[1][m], r0
+			UML_LABEL(block, compiler->labelnum++);                         // labelnum+1:
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+		}
+
+		switch (opcode & 0x70)
+		{
+		case 0x10: dst = mem(&m_sh4_state->gbr); break;    // LDCMGBR(Rn);
+		case 0x20: dst = mem(&m_sh4_state->vbr); break;    // LDCMVBR(Rn);
+		case 0x30: dst = mem(&m_sh4_state->ssr); break;    // LDCMSSR(Rn);
+		case 0x40: dst = mem(&m_sh4_state->spc); break;    // LDCMSPC(Rn);
+		case 0x00: // LDCMSR(Rn);
+			return FALSE;
+		default:
+			return TRUE;    // NOP
+		}
+
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		SETEA(0);
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_ADD(block, R32(Rn), R32(Rn), 4);    // add Rn, #4
+		UML_MOV(block, dst, I0);    // mov dst, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x8:
+		switch (opcode & 0x30)
+		{
+		case 0x00: // SHLL2(Rn);
+			UML_SHL(block, R32(Rn), R32(Rn), 2);
+			return TRUE;
+
+		case 0x10: // SHLL8(Rn);
+			UML_SHL(block, R32(Rn), R32(Rn), 8);
+			return TRUE;
+
+		case 0x20: // SHLL16(Rn);
+			UML_SHL(block, R32(Rn), R32(Rn), 16);
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0x9:
+		switch (opcode & 0x30)
+		{
+		case 0x00: // SHLR2(Rn);
+			UML_SHR(block, R32(Rn), R32(Rn), 2);
+			return TRUE;
+
+		case 0x10: // SHLR8(Rn);
+			UML_SHR(block, R32(Rn), R32(Rn), 8);
+			return TRUE;
+
+		case 0x20: // SHLR16(Rn);
+			UML_SHR(block, R32(Rn), R32(Rn), 16);
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0xa: // LDS Rn,...
+		switch (opcode & 0xF0)
+		{
+		case 0x00: dst = mem(&m_sh4_state->mach); break;   // LDSMACH(Rn);
+		case 0x10: dst = mem(&m_sh4_state->macl); break;   // LDSMACL(Rn);
+		case 0x20: dst = mem(&m_sh4_state->pr); break;     // LDSPR(Rn);
+		case 0x50: dst = mem(&m_sh4_state->fpul); break;   // LDSFPUL(Rn);
+		case 0xF0: dst = mem(&m_sh4_state->dbr); break;    // LDCDBR(Rn);
+		case 0x60: // LDSFPSCR(Rn);
+			return FALSE;
+		default:
+			return TRUE;    // NOP
+		}
+
+		UML_MOV(block, dst, R32(Rn));   // mov dst, Rn
+		return TRUE;
+
+	case 0xb:
+		switch (opcode & 0x30)
+		{
+		case 0x00: // JSR(Rn);
+			UML_MOV(block, mem(&m_sh4_state->target), R32(Rn));     // mov target, Rn
+
+			UML_ADD(block, mem(&m_sh4_state->pr), desc->pc, 4); // add m_pr, desc->pc, #4 (skip the current insn & delay slot)
+
+			generate_delay_slot(block, compiler, desc, OVRPC_DYNAMIC);
+
+			generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+			generate_branch_hashjmp(block, compiler, desc, mem(&m_sh4_state->target)); // and do the jump
+			return TRUE;
+
+		case 0x10: // TAS(Rn);
+			UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+			SETEA(0);
+			UML_CALLH(block, *m_read8);          // call read8
+
+			UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T
+
+			UML_CMP(block, I0, 0);      // cmp r0, #0
+			UML_JMPc(block, COND_NZ, compiler->labelnum);   // jnz labelnum
+
+			UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+
+			UML_LABEL(block, compiler->labelnum++);     // labelnum:
+
+			UML_OR(block, I1, I0, 0x80);    // or r1, r0, #0x80
+
+			UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+			UML_CALLH(block, *m_write8);         // write the value back
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+
+		case 0x20: // JMP(Rn);
+			UML_MOV(block, mem(&m_sh4_state->target), R32(Rn));     // mov target, Rn
+
+			generate_delay_slot(block, compiler, desc, OVRPC_DYNAMIC);
+
+			generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+			generate_branch_hashjmp(block, compiler, desc, mem(&m_sh4_state->target)); // jmp (target)
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0xc: // SHAD(Rm, Rn);
+	case 0xd: // SHLD(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));                        // mov r0, Rm
+		UML_TEST(block, I0, 0x80000000);                    // test r0, #0x80000000
+		UML_JMPc(block, COND_NZ, compiler->labelnum);       // jnz labelnum
+
+		UML_AND(block, I0, I0, 0x1f);                       // and r0, r0, #0x1f
+		UML_SHL(block, R32(Rn), R32(Rn), I0);               // shl Rn, Rn, r0
+		UML_JMP(block, compiler->labelnum + 1);             // jmp labelnum+1
+
+		// right shifts go by ((~Rm & 0x1f) + 1), which is 32 for a count of zero: split it so that
+		// the host never sees a shift by 32 and both the sign fill and the zero fall out naturally
+		UML_LABEL(block, compiler->labelnum++);             // labelnum:
+		UML_XOR(block, I0, I0, 0xffffffff);                 // xor r0, r0, #0xffffffff
+		UML_AND(block, I0, I0, 0x1f);                       // and r0, r0, #0x1f
+		if ((opcode & 0xf) == 0xc)
+		{
+			UML_SAR(block, R32(Rn), R32(Rn), I0);           // sar Rn, Rn, r0
+			UML_SAR(block, R32(Rn), R32(Rn), 1);            // sar Rn, Rn, #1
+		}
+		else
+		{
+			UML_SHR(block, R32(Rn), R32(Rn), I0);           // shr Rn, Rn, r0
+			UML_SHR(block, R32(Rn), R32(Rn), 1);            // shr Rn, Rn, #1
+		}
+
+		UML_LABEL(block, compiler->labelnum++);             // labelnum+1:
+		return TRUE;
+
+	case 0xe: // LDC Rn,...
+		if (opcode & 0x80)
+		{
+			// LDCRBANK(Rm, Rn);
+			UML_TEST(block, mem(&m_sh4_state->sr), sRB);                    // test sr, RB
+			UML_JMPc(block, COND_Z, compiler->labelnum);                    // jz labelnum
+			UML_MOV(block, mem(&m_sh4_state->rbnk[0][Rm & 7]), R32(Rn));    // mov rbnk[0][m], Rn
+			UML_JMP(block, compiler->labelnum + 1);                         // jmp labelnum+1
+			UML_LABEL(block, compiler->labelnum++);                         // labelnum:
+			UML_MOV(block, mem(&m_sh4_state->rbnk[1][Rm & 7]), R32(Rn));    // mov rbnk[1][m], Rn
+			UML_LABEL(block, compiler->labelnum++);                         // labelnum+1:
+			return TRUE;
+		}
+
+		switch (opcode & 0x70)
+		{
+		case 0x10: dst = mem(&m_sh4_state->gbr); break;    // LDCGBR(Rn);
+		case 0x20: dst = mem(&m_sh4_state->vbr); break;    // LDCVBR(Rn);
+		case 0x30: dst = mem(&m_sh4_state->ssr); break;    // LDCSSR(Rn);
+		case 0x40: dst = mem(&m_sh4_state->spc); break;    // LDCSPC(Rn);
+		case 0x00: // LDCSR(Rn);
+			return FALSE;
+		default:
+			return TRUE;    // NOP
+		}
+
+		UML_MOV(block, dst, R32(Rn));   // mov dst, Rn
+		return TRUE;
+
+	case 0xf: // MAC_W(Rm, Rn);
+		return FALSE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_6(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	switch (opcode & 15)
+	{
+	case  0: // MOVBL(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		SETEA(0);                   // debug: ea = r0
+		UML_CALLH(block, *m_read8);          // call read8
+		UML_SEXT(block, R32(Rn), I0, SIZE_BYTE);    // sext Rn, r0, BYTE
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  1: // MOVWL(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		SETEA(0);                   // debug: ea = r0
+		UML_CALLH(block, *m_read16);         // call read16
+		UML_SEXT(block, R32(Rn), I0, SIZE_WORD);    // sext Rn, r0, WORD
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  2: // MOVLL(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		SETEA(0);                   // debug: ea = r0
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_MOV(block, R32(Rn), I0);        // mov Rn, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  3: // MOV(Rm, Rn);
+		UML_MOV(block, R32(Rn), R32(Rm));       // mov Rn, Rm
+		return TRUE;
+
+	case  7: // NOT(Rm, Rn);
+		UML_XOR(block, R32(Rn), R32(Rm), 0xffffffff);   // xor Rn, Rm, 0xffffffff
+		return TRUE;
+
+	case  9: // SWAPW(Rm, Rn);
+		UML_ROL(block, R32(Rn), R32(Rm), 16);   // rol Rn, Rm, 16
+		return TRUE;
+
+	case 11: // NEG(Rm, Rn);
+		UML_SUB(block, R32(Rn), 0, R32(Rm));    // sub Rn, 0, Rm
+		return TRUE;
+
+	case 12: // EXTUB(Rm, Rn);
+		UML_AND(block, R32(Rn), R32(Rm), 0x000000ff);   // and Rn, Rm, 0xff
+		return TRUE;
+
+	case 13: // EXTUW(Rm, Rn);
+		UML_AND(block, R32(Rn), R32(Rm), 0x0000ffff);   // and Rn, Rm, 0xffff
+		return TRUE;
+
+	case 14: // EXTSB(Rm, Rn);
+		UML_SEXT(block, R32(Rn), R32(Rm), SIZE_BYTE);       // sext Rn, Rm, BYTE
+		return TRUE;
+
+	case 15: // EXTSW(Rm, Rn);
+		UML_SEXT(block, R32(Rn), R32(Rm), SIZE_WORD);       // sext Rn, Rm, WORD
+		return TRUE;
+
+	case  4: // MOVBP(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		UML_CALLH(block, *m_read8);          // call read8
+		UML_SEXT(block, R32(Rn), I0, SIZE_BYTE);        // sext Rn, r0, BYTE
+
+		if (Rm != Rn)
+			UML_ADD(block, R32(Rm), R32(Rm), 1);    // add Rm, Rm, #1
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  5: // MOVWP(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		UML_CALLH(block, *m_read16);         // call read16
+		UML_SEXT(block, R32(Rn), I0, SIZE_WORD);        // sext Rn, r0, WORD
+
+		if (Rm != Rn)
+			UML_ADD(block, R32(Rm), R32(Rm), 2);    // add Rm, Rm, #2
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  6: // MOVLP(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_MOV(block, R32(Rn), I0);        // mov Rn, r0
+
+		if (Rm != Rn)
+			UML_ADD(block, R32(Rm), R32(Rm), 4);    // add Rm, Rm, #4
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  8: // SWAPB(Rm, Rn);
+		UML_AND(block, I0, R32(Rm), 0xffff0000);    // and r0, Rm, #0xffff0000
+		UML_AND(block, I1, R32(Rm), 0x000000ff);    // and r0, Rm, #0x000000ff
+		UML_AND(block, I2, R32(Rm), 0x0000ff00);    // and r0, Rm, #0x0000ff00
+		UML_SHL(block, I1, I1, 8);      // shl r1, r1, #8
+		UML_SHR(block, I2, I2, 8);      // shr r2, r2, #8
+		UML_OR(block, I0, I0, I1);      // or r0, r0, r1
+		UML_OR(block, R32(Rn), I0, I2);     // or Rn, r0, r2
+		return TRUE;
+
+	case 10: // NEGC(Rm, Rn);
+		UML_MOV(block, I0, mem(&m_sh4_state->sr));      // mov r0, sr (save SR)
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T (clear the T bit)
+		UML_CARRY(block, I0, 0);    // carry = T (T is bit 0 of SR)
+		UML_SUBB(block, R32(Rn), 0, R32(Rm));   // subb Rn, #0, Rm
+
+		UML_JMPc(block, COND_NC, compiler->labelnum);   // jnc labelnum
+
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+
+		UML_LABEL(block, compiler->labelnum++);     // labelnum:
+
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_8(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	INT32 disp;
+	UINT32 udisp, scratch;
+	code_label templabel;
+
+	switch ( opcode  & (15<<8) )
+	{
+	case  0 << 8: // MOVBS4(opcode & 0x0f, Rm);
+		udisp = (opcode & 0x0f);
+		UML_ADD(block, I0, R32(Rm), udisp);     // add r0, Rm, udisp
+		UML_MOV(block, I1, R32(0));         // mov r1, R0
+		UML_CALLH(block, *m_write8);             // call write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  1 << 8: // MOVWS4(opcode & 0x0f, Rm);
+		udisp = (opcode & 0x0f) * 2;
+		UML_ADD(block, I0, R32(Rm), udisp);     // add r0, Rm, udisp
+		UML_MOV(block, I1, R32(0));         // mov r1, R0
+		UML_CALLH(block, *m_write16);                // call write16
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  2<< 8:
+	case  3<< 8:
+	case  6<< 8:
+	case  7<< 8:
+	case 10<< 8:
+	case 12<< 8:
+	case 14<< 8:
+		return TRUE;    // NOP, as in the interpreter
+
+	case  4<< 8: // MOVBL4(Rm, opcode & 0x0f);
+		udisp = opcode & 0x0f;
+		UML_ADD(block, I0, R32(Rm), udisp);     // add r0, Rm, udisp
+		SETEA(0);
+		UML_CALLH(block, *m_read8);              // call read8
+		UML_SEXT(block, R32(0), I0, SIZE_BYTE);         // sext R0, r0, BYTE
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  5<< 8: // MOVWL4(Rm, opcode & 0x0f);
+		udisp = (opcode & 0x0f)*2;
+		UML_ADD(block, I0, R32(Rm), udisp);     // add r0, Rm, udisp
+		SETEA(0);
+		UML_CALLH(block, *m_read16);             // call read16
+		UML_SEXT(block, R32(0), I0, SIZE_WORD);         // sext R0, r0, WORD
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  8<< 8: // CMPIM(opcode & 0xff);
+		UML_AND(block, I0, mem(&m_sh4_state->sr), ~T);  // and r0, sr, ~T (clear the T bit)
+
+		UML_SEXT(block, I1, opcode&0xff, SIZE_BYTE);    // sext r1, opcode&0xff, BYTE
+		UML_CMP(block, I1, R32(0));         // cmp r1, R0
+		UML_JMPc(block, COND_NZ, compiler->labelnum);   // jnz compiler->labelnum   (if negative)
+
+		UML_OR(block, I0, I0, T);   // or r0, r0, T
+
+		UML_LABEL(block, compiler->labelnum++);         // labelnum:
+		UML_MOV(block, mem(&m_sh4_state->sr), I0);      // mov sr, r0
+		return TRUE;
+
+	case  9<< 8: // BT(opcode & 0xff);
+		UML_TEST(block, mem(&m_sh4_state->sr), T);      // test sr, T
+		UML_JMPc(block, COND_Z, compiler->labelnum);    // jz compiler->labelnum
+
+		disp = ((INT32)opcode << 24) >> 24;
+		scratch = (desc->pc + 2) + disp * 2 + 2;        // scratch = destination
+
+		generate_update_cycles(block, compiler, scratch, TRUE);    // <subtract cycles>
+		UML_HASHJMP(block, compiler->mode, scratch, *m_nocode);    // hashjmp <mode>,scratch
+
+		UML_LABEL(block, compiler->labelnum++);         // labelnum:
+		return TRUE;
+
+	case 11<< 8: // BF(opcode & 0xff);
+		UML_TEST(block, mem(&m_sh4_state->sr), T);      // test sr, T
+		UML_JMPc(block, COND_NZ, compiler->labelnum);   // jnz compiler->labelnum
+
+		disp = ((INT32)opcode << 24) >> 24;
+		scratch = (desc->pc + 2) + disp * 2 + 2;        // scratch = destination
+
+		generate_update_cycles(block, compiler, scratch, TRUE);    // <subtract cycles>
+		UML_HASHJMP(block, compiler->mode, scratch, *m_nocode);    // hashjmp <mode>,scratch
+
+		UML_LABEL(block, compiler->labelnum++);         // labelnum:
+		return TRUE;
+
+	case 13<< 8: // BTS(opcode & 0xff);
+		UML_TEST(block, mem(&m_sh4_state->sr), T);      // test sr, T
+		UML_JMPc(block, COND_Z, compiler->labelnum);    // jz compiler->labelnum
+
+		disp = ((INT32)opcode << 24) >> 24;
+		scratch = (desc->pc + 2) + disp * 2 + 2;        // scratch = destination
+
+		templabel = compiler->labelnum;         // save our label
+		compiler->labelnum++;               // make sure the delay slot doesn't use it
+		generate_delay_slot(block, compiler, desc, scratch - 2);
+
+		generate_update_cycles(block, compiler, scratch, TRUE);    // <subtract cycles>
+		generate_branch_hashjmp(block, compiler, desc, scratch);   // hashjmp <mode>,scratch
+
+		UML_LABEL(block, templabel);            // labelnum:
+		return TRUE;
+
+	case 15<< 8: // BFS(opcode & 0xff);
+		UML_TEST(block, mem(&m_sh4_state->sr), T);      // test sr, T
+		UML_JMPc(block, COND_NZ, compiler->labelnum);   // jnz compiler->labelnum
+
+		disp = ((INT32)opcode << 24) >> 24;
+		scratch = (desc->pc + 2) + disp * 2 + 2;        // scratch = destination
+
+		templabel = compiler->labelnum;         // save our label
+		compiler->labelnum++;               // make sure the delay slot doesn't use it
+		generate_delay_slot(block, compiler, desc, scratch - 2); // delay slot only if the branch is taken
+
+		generate_update_cycles(block, compiler, scratch, TRUE);    // <subtract cycles>
+		generate_branch_hashjmp(block, compiler, desc, scratch);   // hashjmp <mode>,scratch
+
+		UML_LABEL(block, templabel);            // labelnum:
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_12(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	UINT32 scratch;
+
+	switch (opcode & (15<<8))
+	{
+	case  0<<8: // MOVBSG(opcode & 0xff);
+		scratch = (opcode & 0xff);
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_AND(block, I1, R32(0), 0xff);       // and r1, R0, 0xff
+		UML_CALLH(block, *m_write8);             // call write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  1<<8: // MOVWSG(opcode & 0xff);
+		scratch = (opcode & 0xff) * 2;
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_AND(block, I1, R32(0), 0xffff);     // and r1, R0, 0xffff
+		UML_CALLH(block, *m_write16);                // call write16
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  2<<8: // MOVLSG(opcode & 0xff);
+		scratch = (opcode & 0xff) * 4;
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_MOV(block, I1, R32(0));         // mov r1, R0
+		UML_CALLH(block, *m_write32);                // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  3<<8: // TRAPA(opcode & 0xff);
+		// the exception state lives in the on-chip registers, so let the interpreter raise it
+		generate_interpreter_call(block, compiler, desc);
+		generate_update_cycles(block, compiler, mem(&m_sh4_state->pc), TRUE);  // <subtract cycles>
+		UML_HASHJMP(block, compiler->mode, mem(&m_sh4_state->pc), *m_nocode);  // hashjmp <mode>,pc
+		return TRUE;
+
+	case  4<<8: // MOVBLG(opcode & 0xff);
+		scratch = (opcode & 0xff);
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_CALLH(block, *m_read8);              // call read8
+		UML_SEXT(block, R32(0), I0, SIZE_BYTE);         // sext R0, r0, BYTE
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  5<<8: // MOVWLG(opcode & 0xff);
+		scratch = (opcode & 0xff) * 2;
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_CALLH(block, *m_read16);             // call read16
+		UML_SEXT(block, R32(0), I0, SIZE_WORD);         // sext R0, r0, WORD
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  6<<8: // MOVLLG(opcode & 0xff);
+		scratch = (opcode & 0xff) * 4;
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_CALLH(block, *m_read32);             // call read32
+		UML_MOV(block, R32(0), I0);         // mov R0, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  7<<8: // MOVA(opcode & 0xff);
+		if (ovrpc == OVRPC_DYNAMIC)
+		{
+			// delay slot of a computed branch: pc is the runtime target
+			UML_ADD(block, I0, mem(&m_sh4_state->target), 2);       // add r0, target, #2
+			UML_AND(block, I0, I0, ~3);                             // and r0, r0, #~3
+			UML_ADD(block, R32(0), I0, (opcode & 0xff) * 4);        // add R0, r0, disp
+			return TRUE;
+		}
+
+		scratch = (opcode & 0xff) * 4;
+		if (ovrpc == 0xffffffff)
+			scratch += ((desc->pc + 4) & ~3);
+		else
+			scratch += ((ovrpc + 4) & ~3);
+
+		UML_MOV(block, R32(0), scratch);            // mov R0, scratch
+		return TRUE;
+
+	case  8<<8: // TSTI(opcode & 0xff);
+		scratch = opcode & 0xff;
+
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T (clear the T bit)
+		UML_AND(block, I0, R32(0), scratch);        // and r0, R0, scratch
+		UML_CMP(block, I0, 0);          // cmp r0, #0
+		UML_JMPc(block, COND_NZ, compiler->labelnum);       // jnz labelnum
+
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+
+		UML_LABEL(block, compiler->labelnum++);         // labelnum:
+		return TRUE;
+
+	case  9<<8: // ANDI(opcode & 0xff);
+		UML_AND(block, R32(0), R32(0), opcode & 0xff);  // and r0, r0, opcode & 0xff
+		return TRUE;
+
+	case 10<<8: // XORI(opcode & 0xff);
+		UML_XOR(block, R32(0), R32(0), opcode & 0xff);  // xor r0, r0, opcode & 0xff
+		return TRUE;
+
+	case 11<<8: // ORI(opcode & 0xff);
+		UML_OR(block, R32(0), R32(0), opcode & 0xff);   // or r0, r0, opcode & 0xff
+		return TRUE;
+
+	case 12<<8: // TSTM(opcode & 0xff);
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T (clear the T bit)
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		UML_CALLH(block, *m_read8);              // read8
+
+		UML_AND(block, I0, I0, opcode & 0xff);
+		UML_CMP(block, I0, 0);          // cmp r0, #0
+		UML_JMPc(block, COND_NZ, compiler->labelnum);       // jnz labelnum
+
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+
+		UML_LABEL(block, compiler->labelnum++);         // labelnum:
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 13<<8: // ANDM(opcode & 0xff);
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		UML_CALLH(block, *m_read8);              // read8
+
+		UML_AND(block, I1, I0, opcode&0xff);    // and r1, r0, #opcode&0xff
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		SETEA(0);
+		UML_CALLH(block, *m_write8);             // write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 14<<8: // XORM(opcode & 0xff);
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		UML_CALLH(block, *m_read8);              // read8
+
+		UML_XOR(block, I1, I0, opcode&0xff);    // xor r1, r0, #opcode&0xff
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		SETEA(0);
+		UML_CALLH(block, *m_write8);             // write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 15<<8: // ORM(opcode & 0xff);
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		UML_CALLH(block, *m_read8);              // read8
+
+		UML_OR(block, I1, I0, opcode&0xff); // or r1, r0, #opcode&0xff
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		SETEA(0);
+		UML_CALLH(block, *m_write8);             // write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_15(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	UINT32 m = Rm, n = Rn;
+	UINT32 *first, *second;
+	int words;
+
+	switch (opcode & 15)
+	{
+	case  0: // FADD(Rm, Rn);
+		if (compiler->mode & MODE_PR)
+			UML_FDADD(block, FR32(n & 14), FR32(n & 14), FR32(m & 14));    // fdadd DRn, DRn, DRm
+		else
+			UML_FSADD(block, FR32(n), FR32(n), FR32(m));                   // fsadd FRn, FRn, FRm
+		return TRUE;
+
+	case  1: // FSUB(Rm, Rn);
+		if (compiler->mode & MODE_PR)
+			UML_FDSUB(block, FR32(n & 14), FR32(n & 14), FR32(m & 14));    // fdsub DRn, DRn, DRm
+		else
+			UML_FSSUB(block, FR32(n), FR32(n), FR32(m));                   // fssub FRn, FRn, FRm
+		return TRUE;
+
+	case  2: // FMUL(Rm, Rn);
+		if (compiler->mode & MODE_PR)
+			UML_FDMUL(block, FR32(n & 14), FR32(n & 14), FR32(m & 14));    // fdmul DRn, DRn, DRm
+		else
+			UML_FSMUL(block, FR32(n), FR32(n), FR32(m));                   // fsmul FRn, FRn, FRm
+		return TRUE;
+
+	case  3: // FDIV(Rm, Rn);
+		// the interpreter leaves FRn alone when dividing by +/-0
+		if (compiler->mode & MODE_PR)
+		{
+			UML_DTEST(block, mem(&m_sh4_state->fr[m & 14]), U64(0x7fffffffffffffff));  // dtest DRm, ~sign
+			UML_JMPc(block, COND_Z, compiler->labelnum);                              // jz labelnum
+			UML_FDDIV(block, FR32(n & 14), FR32(n & 14), FR32(m & 14));                // fddiv DRn, DRn, DRm
+		}
+		else
+		{
+			UML_TEST(block, FR32(m), 0x7fffffff);                       // test FRm, ~sign
+			UML_JMPc(block, COND_Z, compiler->labelnum);                // jz labelnum
+			UML_FSDIV(block, FR32(n), FR32(n), FR32(m));                // fsdiv FRn, FRn, FRm
+		}
+		UML_LABEL(block, compiler->labelnum++);                         // labelnum:
+		return TRUE;
+
+	case  4: // FCMP_EQ(Rm, Rn);
+	case  5: // FCMP_GT(Rm, Rn);
+		if (compiler->mode & MODE_PR)
+			UML_FDCMP(block, FR32(n & 14), FR32(m & 14));               // fdcmp DRn, DRm
+		else
+			UML_FSCMP(block, FR32(n), FR32(m));                         // fscmp FRn, FRm
+		UML_SETc(block, ((opcode & 15) == 4) ? COND_E : COND_A, I0);    // set E/A, r0
+		UML_SETc(block, COND_NU, I1);                                   // set NU, r1 (unordered compares are false)
+		UML_AND(block, I0, I0, I1);                                     // and r0, r0, r1
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);             // rolins sr, r0, 0, T
+		return TRUE;
+
+	case  6: // FMOVS0FR(Rm, Rn);
+		words = fmov_regs(m_sh4_state->fr, m_sh4_state->xf, compiler->mode, n, false, &first, &second);
+		UML_ADD(block, I0, R32(0), R32(m));             // add r0, R0, Rm
+		SETEA(0);
+		if (words == 2)
+			UML_MOV(block, mem(&m_sh4_state->ea), I0);  // mov ea, r0
+		UML_CALLH(block, *m_read32);                     // call read32
+		UML_MOV(block, mem(first), I0);                 // mov <first>, r0
+		if (words == 2)
+		{
+			UML_ADD(block, I0, mem(&m_sh4_state->ea), 4);   // add r0, ea, #4
+			UML_CALLH(block, *m_read32);                     // call read32
+			UML_MOV(block, mem(second), I0);                // mov <second>, r0
+		}
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  7: // FMOVFRS0(Rm, Rn);
+		words = fmov_regs(m_sh4_state->fr, m_sh4_state->xf, compiler->mode, m, false, &first, &second);
+		UML_ADD(block, I0, R32(0), R32(n));             // add r0, R0, Rn
+		SETEA(0);
+		if (words == 2)
+			UML_MOV(block, mem(&m_sh4_state->ea), I0);  // mov ea, r0
+		UML_MOV(block, I1, mem(first));                 // mov r1, <first>
+		UML_CALLH(block, *m_write32);                    // call write32
+		if (words == 2)
+		{
+			UML_ADD(block, I0, mem(&m_sh4_state->ea), 4);   // add r0, ea, #4
+			UML_MOV(block, I1, mem(second));                // mov r1, <second>
+			UML_CALLH(block, *m_write32);                    // call write32
+		}
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  8: // FMOVMRFR(Rm, Rn);
+	case  9: // FMOVMRIFR(Rm, Rn);
+		words = fmov_regs(m_sh4_state->fr, m_sh4_state->xf, compiler->mode, n, (opcode & 15) == 8, &first, &second);
+		UML_MOV(block, I0, R32(m));                     // mov r0, Rm
+		SETEA(0);
+		if (words == 2)
+			UML_MOV(block, mem(&m_sh4_state->ea), I0);  // mov ea, r0
+		if ((opcode & 15) == 9)
+			UML_ADD(block, R32(m), R32(m), words * 4);  // add Rm, Rm, #4/#8
+		UML_CALLH(block, *m_read32);                     // call read32
+		UML_MOV(block, mem(first), I0);                 // mov <first>, r0
+		if (words == 2)
+		{
+			UML_ADD(block, I0, mem(&m_sh4_state->ea), 4);   // add r0, ea, #4
+			UML_CALLH(block, *m_read32);                     // call read32
+			UML_MOV(block, mem(second), I0);                // mov <second>, r0
+		}
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 10: // FMOVFRMR(Rm, Rn);
+	case 11: // FMOVFRMDR(Rm, Rn);
+		words = fmov_regs(m_sh4_state->fr, m_sh4_state->xf, compiler->mode, m, false, &first, &second);
+		if ((opcode & 15) == 11)
+			UML_SUB(block, R32(n), R32(n), words * 4);  // sub Rn, Rn, #4/#8
+		UML_MOV(block, I0, R32(n));                     // mov r0, Rn
+		SETEA(0);
+		if (words == 2)
+			UML_MOV(block, mem(&m_sh4_state->ea), I0);  // mov ea, r0
+		UML_MOV(block, I1, mem(first));                 // mov r1, <first>
+		UML_CALLH(block, *m_write32);                    // call write32
+		if (words == 2)
+		{
+			UML_ADD(block, I0, mem(&m_sh4_state->ea), 4);   // add r0, ea, #4
+			UML_MOV(block, I1, mem(second));                // mov r1, <second>
+			UML_CALLH(block, *m_write32);                    // call write32
+		}
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 12: // FMOVFR(Rm, Rn);
+		if (!(compiler->mode & (MODE_SZ | MODE_PR)))
+		{
+			UML_MOV(block, FR32(n), FR32(m));           // mov FRn, FRm
+		}
+		else
+		{
+			UINT32 *src = (m & 1) ? &m_sh4_state->xf[m & 14] : &m_sh4_state->fr[m];
+			UINT32 *dst = (n & 1) ? &m_sh4_state->xf[n & 14] : &m_sh4_state->fr[n];
+			UML_DMOV(block, mem(dst), mem(src));        // dmov <dst pair>, <src pair>
+		}
+		return TRUE;
+
+	case 13: // op1111_0x13(opcode);
+		return generate_group_15_op1111_0x13(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+	case 14: // FMAC(Rm, Rn);
+		if (!(compiler->mode & MODE_PR))
+		{
+			UML_FSMUL(block, F0, FR32(0), FR32(m));     // fsmul f0, FR0, FRm
+			UML_FSADD(block, FR32(n), F0, FR32(n));     // fsadd FRn, f0, FRn
+		}
+		return TRUE;
+
+	case 15: // dbreak(opcode);
+		return FALSE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_15_op1111_0x13(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	UINT32 n = Rn;
+	int i, j;
+
+	switch ((opcode >> 4) & 0x0f)
+	{
+	case 0x00: // FSTS(opcode);
+		UML_MOV(block, FR32(n), mem(&m_sh4_state->fpul));           // mov FRn, fpul
+		return TRUE;
+
+	case 0x01: // FLDS(opcode);
+		UML_MOV(block, mem(&m_sh4_state->fpul), FR32(n));           // mov fpul, FRn
+		return TRUE;
+
+	case 0x02: // FLOAT(opcode);
+		if (compiler->mode & MODE_PR)
+		{
+			if (n & 1)
+				return FALSE;
+			UML_FDFRINT(block, FR32(n), mem(&m_sh4_state->fpul), SIZE_DWORD);   // fdfrint DRn, fpul, dword
+		}
+		else
+			UML_FSFRINT(block, FR32(n), mem(&m_sh4_state->fpul), SIZE_DWORD);   // fsfrint FRn, fpul, dword
+		return TRUE;
+
+	case 0x03: // FTRC(opcode);
+		if (compiler->mode & MODE_PR)
+		{
+			if (n & 1)
+				return FALSE;
+			UML_FDTOINT(block, mem(&m_sh4_state->fpul), FR32(n), SIZE_DWORD, ROUND_TRUNC);  // fdtoint fpul, DRn, dword, trunc
+		}
+		else
+			UML_FSTOINT(block, mem(&m_sh4_state->fpul), FR32(n), SIZE_DWORD, ROUND_TRUNC);  // fstoint fpul, FRn, dword, trunc
+		return TRUE;
+
+	case 0x04: // FNEG(opcode);
+		if (compiler->mode & MODE_PR)
+			UML_FDNEG(block, FR32(n), FR32(n));                     // fdneg DRn, DRn
+		else
+			UML_FSNEG(block, FR32(n), FR32(n));                     // fsneg FRn, FRn
+		return TRUE;
+
+	case 0x05: // FABS(opcode);
+		if (compiler->mode & MODE_PR)
+			n = NATIVE_ENDIAN_VALUE_LE_BE(n | 1, n & 14);           // the word holding the sign
+		UML_AND(block, FR32(n), FR32(n), 0x7fffffff);               // and FRn, FRn, ~sign
+		return TRUE;
+
+	case 0x06: // FSQRT(opcode);
+		// negative inputs leave the register alone, NaNs go through
+		if (compiler->mode & MODE_PR)
+		{
+			n &= 14;
+			UML_FDFRINT(block, F0, 0, SIZE_DWORD);                  // fdfrint f0, 0, dword
+			UML_FDCMP(block, FR32(n), F0);                          // fdcmp DRn, f0
+		}
+		else
+		{
+			UML_FSFRINT(block, F0, 0, SIZE_DWORD);                  // fsfrint f0, 0, dword
+			UML_FSCMP(block, FR32(n), F0);                          // fscmp FRn, f0
+		}
+		UML_JMPc(block, COND_U, compiler->labelnum);                // ju labelnum
+		UML_JMPc(block, COND_B, compiler->labelnum + 1);            // jb labelnum+1
+		UML_LABEL(block, compiler->labelnum++);                     // labelnum:
+		if (compiler->mode & MODE_PR)
+		{
+			// the interpreter goes through sqrtf, so round to single first
+			UML_FSFRFLT(block, F1, FR32(n), SIZE_QWORD);            // fsfrflt f1, DRn, qword
+			UML_FSSQRT(block, F1, F1);                              // fssqrt f1, f1
+			UML_FDFRFLT(block, FR32(n), F1, SIZE_DWORD);            // fdfrflt DRn, f1, dword
+		}
+		else
+			UML_FSSQRT(block, FR32(n), FR32(n));                    // fssqrt FRn, FRn
+		UML_LABEL(block, compiler->labelnum++);                     // labelnum+1:
+		return TRUE;
+
+	case 0x07: // FSRRA(opcode);
+		return FALSE;
+
+	case 0x08: // FLDI0(opcode);
+		UML_MOV(block, FR32(n), 0);                                 // mov FRn, #0
+		return TRUE;
+
+	case 0x09: // FLDI1(opcode);
+		UML_MOV(block, FR32(n), 0x3F800000);                        // mov FRn, #1.0f
+		return TRUE;
+
+	case 0x0a: // FCNVSD(opcode);
+		if (compiler->mode & MODE_PR)
+			UML_FDFRFLT(block, FR32(n & 14), mem(&m_sh4_state->fpul), SIZE_DWORD);  // fdfrflt DRn, fpul, dword
+		return TRUE;
+
+	case 0x0b: // FCNVDS(opcode);
+	case 0x0c: // dbreak(opcode);
+	case 0x0d: // dbreak(opcode);
+		return FALSE;
+
+	case 0x0e: // FIPR(opcode);
+	{
+		UINT32 m = (n & 3) << 2;
+		n &= 12;
+		UML_FSMUL(block, F0, FR32(n), FR32(m));                     // fsmul f0, FRn, FRm
+		for (i = 1; i < 4; i++)
+		{
+			UML_FSMUL(block, F1, FR32(n + i), FR32(m + i));         // fsmul f1, FRn+i, FRm+i
+			UML_FSADD(block, F0, F0, F1);                           // fsadd f0, f0, f1
+		}
+		UML_FSMOV(block, FR32(n + 3), F0);                          // fsmov FRn+3, f0
+		return TRUE;
+	}
+
+	case 0x0f: // op1111_0xf13(opcode);
+		if (!(opcode & 0x100))      // FSSCA(opcode);
+			return FALSE;
+
+		if (!(opcode & 0x200))      // FTRV(opcode);
+		{
+			static const uml::parameter sum[4] = { F0, F1, F2, F3 };
+
+			n &= 12;
+			for (i = 0; i < 4; i++)
+			{
+				UML_FSFRINT(block, sum[i], 0, SIZE_DWORD);          // fsfrint sum[i], 0, dword
+				for (j = 0; j < 4; j++)
+				{
+					UML_FSMUL(block, F4, XF32((j << 2) + i), FR32(n + j));  // fsmul f4, XF(j*4+i), FRn+j
+					UML_FSADD(block, sum[i], sum[i], F4);                   // fsadd sum[i], sum[i], f4
+				}
+			}
+			for (i = 0; i < 4; i++)
+				UML_FSMOV(block, FR32(n + i), sum[i]);              // fsmov FRn+i, sum[i]
+			return TRUE;
+		}
+
+		switch (opcode & 0xc00)
+		{
+		case 0x000: // FSCHG();
+			UML_XOR(block, mem(&m_sh4_state->fpscr), mem(&m_sh4_state->fpscr), SZ);    // xor fpscr, fpscr, SZ
+			UML_MOV(block, mem(&m_sh4_state->fpu_sz), (compiler->mode & MODE_SZ) ? 0 : 1);   // mov fpu_sz, !SZ
+			return TRUE;
+
+		default:    // FRCHG() and dbreak
+			return FALSE;
+		}
+	}
+
+	return FALSE;
+}
+
+/***************************************************************************
+    CORE CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    sh4drc_set_options - configure DRC options
+-------------------------------------------------*/
+
+void sh34_base_device::sh4drc_set_options(UINT32 options)
+{
+	if (!allow_drc()) return;
+	m_drcoptions = options;
+	m_cache_dirty = TRUE;
+}
+
+
+/*-------------------------------------------------
+    sh4drc_add_pcflush - add a new address where
+    the PC must be flushed for speedups to work
+-------------------------------------------------*/
+
+void sh34_base_device::sh4drc_add_pcflush(offs_t address)
+{
+	if (!allow_drc()) return;
+
+	if (m_pcfsel < ARRAY_LENGTH(m_pcflushes))
+		m_pcflushes[m_pcfsel++] = address;
+}
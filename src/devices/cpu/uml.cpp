@@ -472,6 +472,8 @@ void uml::instruction::simplify()
 
 			// ROLAND: convert to MOV if all immediate, or to ROL or AND if one is not needed, or to SHL/SHR if the mask is right
 			case OP_ROLAND:
+				if (m_param[2].is_immediate())
+					m_param[2] = m_param[2].immediate() & (8 * m_size - 1);
 				if (m_param[1].is_immediate() && m_param[2].is_immediate() && m_param[3].is_immediate())
 				{
 					assert(m_size == 4 || m_size == 8);
@@ -670,7 +672,7 @@ void uml::instruction::simplify()
 			// SHL: convert to MOV if immediate or shifting by 0
 			case OP_SHL:
 				if (m_param[1].is_immediate() && m_param[2].is_immediate())
-					convert_to_mov_immediate(m_param[1].immediate() << m_param[2].immediate());
+					convert_to_mov_immediate(m_param[1].immediate() << (m_param[2].immediate() & (8 * m_size - 1)));
 				else if (m_param[2].is_immediate_value(0))
 					convert_to_mov_param(1);
 				break;
@@ -680,9 +682,9 @@ void uml::instruction::simplify()
 				if (m_param[1].is_immediate() && m_param[2].is_immediate())
 				{
 					if (m_size == 4)
-						convert_to_mov_immediate((UINT32)m_param[1].immediate() >> m_param[2].immediate());
+						convert_to_mov_immediate((UINT32)m_param[1].immediate() >> (m_param[2].immediate() & 31));
 					else if (m_size == 8)
-						convert_to_mov_immediate((UINT64)m_param[1].immediate() >> m_param[2].immediate());
+						convert_to_mov_immediate((UINT64)m_param[1].immediate() >> (m_param[2].immediate() & 63));
 				}
 				else if (m_param[2].is_immediate_value(0))
 					convert_to_mov_param(1);
@@ -693,9 +695,9 @@ void uml::instruction::simplify()
 				if (m_param[1].is_immediate() && m_param[2].is_immediate())
 				{
 					if (m_size == 4)
-						convert_to_mov_immediate((INT32)m_param[1].immediate() >> m_param[2].immediate());
+						convert_to_mov_immediate((INT32)m_param[1].immediate() >> (m_param[2].immediate() & 31));
 					else if (m_size == 8)
-						convert_to_mov_immediate((INT64)m_param[1].immediate() >> m_param[2].immediate());
+						convert_to_mov_immediate((INT64)m_param[1].immediate() >> (m_param[2].immediate() & 63));
 				}
 				else if (m_param[2].is_immediate_value(0))
 					convert_to_mov_param(1);
@@ -849,6 +851,64 @@ UINT8 uml::instruction::modified_flags() const
 }
 
 
+//-------------------------------------------------
+//  param_is_input - return true if the given
+//  parameter is read by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::param_is_input(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[paramnum].output & PIO_IN) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_is_output - return true if the given
+//  parameter is written by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::param_is_output(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[paramnum].output & PIO_OUT) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_allows_immediate - return true if the
+//  given parameter may be encoded as an immediate
+//-------------------------------------------------
+
+bool uml::instruction::param_allows_immediate(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[paramnum].typemask & PTYPES_IMM) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_size - return the size in bytes of the
+//  given parameter
+//-------------------------------------------------
+
+int uml::instruction::param_size(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	switch (s_opcode_info_table[m_opcode].param[paramnum].size)
+	{
+		case PSIZE_4:   return 4;
+		case PSIZE_8:   return 8;
+		case PSIZE_P1:  return 1 << m_param[0].size();
+		case PSIZE_P2:  return 1 << m_param[1].size();
+		case PSIZE_P3:  return 1 << m_param[2].size();
+		case PSIZE_P4:  return 1 << m_param[3].size();
+		default:
+		case PSIZE_OP:  return m_size;
+	}
+}
+
+
 //-------------------------------------------------
 //  disasm - disassemble an instruction to the
 //  given buffer
@@ -410,6 +410,7 @@ namespace uml
 		// setters
 		void set_flags(UINT8 flags) { m_flags = flags; }
 		void set_mapvar(int paramnum, UINT32 value) { assert(paramnum < m_numparams); assert(m_param[paramnum].is_mapvar()); m_param[paramnum] = value; }
+		void set_param(int paramnum, const parameter &param) { assert(paramnum < m_numparams); m_param[paramnum] = param; }
 
 		// misc
 		std::string disasm(drcuml_state *drcuml = nullptr) const;
@@ -418,6 +419,12 @@ namespace uml
 		UINT8 modified_flags() const;
 		void simplify();
 
+		// parameter rules
+		bool param_is_input(int paramnum) const;
+		bool param_is_output(int paramnum) const;
+		bool param_allows_immediate(int paramnum) const;
+		int param_size(int paramnum) const;
+
 		// compile-time opcodes
 		void handle(code_handle &hand) { configure(OP_HANDLE, 4, hand); }
 		void hash(UINT32 mode, UINT32 pc) { configure(OP_HASH, 4, mode, pc); }
@@ -486,7 +486,8 @@ netlist_mame_cpu_device_t::netlist_mame_cpu_device_t(const machine_config &mconf
 		device_state_interface(mconfig, *this),
 		device_disasm_interface(mconfig, *this),
 		device_memory_interface(mconfig, *this),
-		m_program_config("program", ENDIANNESS_LITTLE, 8, 12, 0, ADDRESS_MAP_NAME(program_dummy))
+		m_program_config("program", ENDIANNESS_LITTLE, 8, 12, 0, ADDRESS_MAP_NAME(program_dummy)),
+		m_disasm_genPC(-1)
 {
 }
 
@@ -541,10 +542,18 @@ ATTR_COLD offs_t netlist_mame_cpu_device_t::disasm_disassemble(char *buffer, off
 	int relpc = pc - m_genPC;
 	if (relpc >= 0 && relpc < netlist().queue().size())
 	{
-		int dpc = netlist().queue().size() - relpc - 1;
+		// the queue only changes when we step, so keep one snapshot per stop
+		if (m_disasm_genPC != m_genPC || m_disasm_time != netlist().time() || m_disasm_queue.size() != netlist().queue().size())
+		{
+			netlist().queue().snapshot(m_disasm_queue);
+			m_disasm_genPC = m_genPC;
+			m_disasm_time = netlist().time();
+		}
+		int dpc = m_disasm_queue.size() - relpc - 1;
+		const auto &entry = m_disasm_queue[dpc];
 		// FIXME: 50 below fixes crash in mame-debugger. It's based on try on error.
-		snprintf(buffer, 50, "%c %s @%10.7f", (relpc == 0) ? '*' : ' ', netlist().queue()[dpc].m_object->name().cstr(),
-				netlist().queue()[dpc].m_exec_time.as_double());
+		snprintf(buffer, 50, "%c %s @%10.7f", (relpc == 0) ? '*' : ' ', entry.m_object->name().cstr(),
+				entry.m_exec_time.as_double());
 	}
 	else
 		sprintf(buffer, "%s", "");
@@ -243,6 +243,10 @@ private:
 
 	int m_genPC;
 
+	// the queue as of the last disassembly, so a listing sorts it only once
+	std::vector<netlist::detail::queue_t::entry_t> m_disasm_queue;
+	int m_disasm_genPC;
+	netlist::netlist_time m_disasm_time;
 };
 
 class nld_sound_out;
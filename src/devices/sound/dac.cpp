@@ -30,6 +30,8 @@ dac_device::dac_device(const machine_config &mconfig, const char *tag, device_t
 		m_stream(nullptr),
 		m_output(0)
 {
+	// the update only reads the latched output
+	m_self_contained_update = true;
 }
 
 
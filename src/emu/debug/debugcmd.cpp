@@ -196,6 +196,8 @@ debugger_commands::debugger_commands(running_machine& machine, debugger_cpu& cpu
 	m_console.register_command("ss",        CMDFLAG_NONE, 0, 1, 1, std::bind(&debugger_commands::execute_statesave, this, _1, _2, _3));
 	m_console.register_command("stateload", CMDFLAG_NONE, 0, 1, 1, std::bind(&debugger_commands::execute_stateload, this, _1, _2, _3));
 	m_console.register_command("sl",        CMDFLAG_NONE, 0, 1, 1, std::bind(&debugger_commands::execute_stateload, this, _1, _2, _3));
+	m_console.register_command("rewind",    CMDFLAG_NONE, 0, 0, 1, std::bind(&debugger_commands::execute_rewind, this, _1, _2, _3));
+	m_console.register_command("rw",        CMDFLAG_NONE, 0, 0, 1, std::bind(&debugger_commands::execute_rewind, this, _1, _2, _3));
 
 	m_console.register_command("save",      CMDFLAG_NONE, AS_PROGRAM, 3, 4, std::bind(&debugger_commands::execute_save, this, _1, _2, _3));
 	m_console.register_command("saved",     CMDFLAG_NONE, AS_DATA, 3, 4, std::bind(&debugger_commands::execute_save, this, _1, _2, _3));
@@ -255,6 +257,9 @@ debugger_commands::debugger_commands(running_machine& machine, debugger_cpu& cpu
 	m_console.register_command("mapd",      CMDFLAG_NONE, AS_DATA, 1, 1, std::bind(&debugger_commands::execute_map, this, _1, _2, _3));
 	m_console.register_command("mapi",      CMDFLAG_NONE, AS_IO, 1, 1, std::bind(&debugger_commands::execute_map, this, _1, _2, _3));
 	m_console.register_command("memdump",   CMDFLAG_NONE, 0, 0, 1, std::bind(&debugger_commands::execute_memdump, this, _1, _2, _3));
+	m_console.register_command("memcount",  CMDFLAG_NONE, AS_PROGRAM, 0, 3, std::bind(&debugger_commands::execute_memcount, this, _1, _2, _3));
+	m_console.register_command("memcountd", CMDFLAG_NONE, AS_DATA, 0, 3, std::bind(&debugger_commands::execute_memcount, this, _1, _2, _3));
+	m_console.register_command("memcounti", CMDFLAG_NONE, AS_IO, 0, 3, std::bind(&debugger_commands::execute_memcount, this, _1, _2, _3));
 
 	m_console.register_command("symlist",   CMDFLAG_NONE, 0, 0, 1, std::bind(&debugger_commands::execute_symlist, this, _1, _2, _3));
 
@@ -1592,6 +1597,42 @@ void debugger_commands::execute_stateload(int ref, int params, const char *param
 }
 
 
+/*-------------------------------------------------
+    execute_rewind - execute the rewind command
+-------------------------------------------------*/
+
+void debugger_commands::execute_rewind(int ref, int params, const char *param[])
+{
+	state_rewinder *rewinder = m_machine.save().rewinder();
+	if (rewinder == nullptr)
+	{
+		m_console.printf("Rewind is not enabled (use -rewind).\n");
+		return;
+	}
+
+	// default to the start of the previous frame
+	UINT64 count = 2;
+	if (params > 0 && !validate_number_parameter(param[0], &count))
+		return;
+	if (count < 1 || count > rewinder->count())
+	{
+		m_console.printf("Only %d snapshots available (%s to %s)\n", rewinder->count(),
+				rewinder->snapshot_time(rewinder->count()).as_string(3), rewinder->snapshot_time(1).as_string(3));
+		return;
+	}
+
+	m_machine.immediate_rewind(int(count));
+
+	// Clear all PC & memory tracks
+	for (device_t &device : device_iterator(m_machine.root_device()))
+	{
+		device.debug()->track_pc_data_clear();
+		device.debug()->track_mem_data_clear();
+	}
+	m_console.printf("Rewind attempted.  Please refer to window message popup for results.\n");
+}
+
+
 /*-------------------------------------------------
     execute_save - execute the save command
 -------------------------------------------------*/
@@ -2831,6 +2872,45 @@ void debugger_commands::execute_memdump(int ref, int params, const char **param)
 }
 
 
+/*-------------------------------------------------
+    execute_memcount - execute the memcount command
+-------------------------------------------------*/
+
+void debugger_commands::execute_memcount(int ref, int params, const char **param)
+{
+	// get the address space for the given cpu
+	address_space *space;
+	if (!validate_cpu_space_parameter((params > 1) ? param[1] : nullptr, ref, space))
+		return;
+
+	// with no arguments, just report what has been counted so far
+	if (params == 0)
+	{
+		if (!space->access_counters_enabled())
+		{
+			m_console.printf("Access counters are not enabled for '%s' %s space\n", space->device().tag(), space->name());
+			return;
+		}
+		std::ostringstream report;
+		space->dump_access_counts(report);
+		m_console.printf("%s", report.str().c_str());
+		return;
+	}
+
+	// gather the on/off switch and whether to clear
+	UINT64 enable, clear = false;
+	if (!validate_number_parameter(param[0], &enable))
+		return;
+	if (!validate_number_parameter((params > 2) ? param[2] : nullptr, &clear))
+		return;
+
+	space->enable_access_counters(enable != 0);
+	if (clear)
+		space->clear_access_counters();
+	m_console.printf("Access counters %s for '%s' %s space\n", enable ? "enabled" : "disabled", space->device().tag(), space->name());
+}
+
+
 /*-------------------------------------------------
     execute_symlist - execute the symlist command
 -------------------------------------------------*/
@@ -131,6 +131,7 @@ private:
 	void execute_hotspot(int ref, int params, const char **param);
 	void execute_statesave(int ref, int params, const char **param);
 	void execute_stateload(int ref, int params, const char **param);
+	void execute_rewind(int ref, int params, const char **param);
 	void execute_save(int ref, int params, const char **param);
 	void execute_load(int ref, int params, const char **param);
 	void execute_dump(int ref, int params, const char **param);
@@ -151,6 +152,7 @@ private:
 	void execute_source(int ref, int params, const char **param);
 	void execute_map(int ref, int params, const char **param);
 	void execute_memdump(int ref, int params, const char **param);
+	void execute_memcount(int ref, int params, const char **param);
 	void execute_symlist(int ref, int params, const char **param);
 	void execute_softreset(int ref, int params, const char **param);
 	void execute_hardreset(int ref, int params, const char **param);
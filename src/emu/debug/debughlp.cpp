@@ -95,6 +95,7 @@ static const help_item static_help_list[] =
 		"                                (Note: you can also query this info by right clicking in a memory window\n"
 		"  statesave[ss] <filename> -- save a state file for the current driver\n"
 		"  stateload[sl] <filename> -- load a state file for the current driver\n"
+		"  rewind[rw] [<count>] -- step back to an in-memory snapshot taken <count> frames ago\n"
 		"  snap [<filename>] -- save a screen snapshot.\n"
 		"  source <filename> -- reads commands from <filename> and executes them one by one\n"
 		"  quit -- exits MAME and the debugger\n"
@@ -122,6 +123,7 @@ static const help_item static_help_list[] =
 		"  mapd <address> -- map logical data address to physical address and bank\n"
 		"  mapi <address> -- map logical I/O address to physical address and bank\n"
 		"  memdump [<filename>] -- dump the current memory map to <filename>\n"
+		"  memcount[d/i] [<bool>[,<cpu>[,<bool>]]] -- count accesses per handler [turn on and off, for the given cpu, clear]\n"
 	},
 	{
 		"execution",
@@ -467,6 +469,25 @@ static const help_item static_help_list[] =
 		"stateload foo\n"
 		"  Reads file 'foo.sta' from the default state save directory.\n"
 	},
+	{
+		"rewind[rw]",
+		"\n"
+		"  rewind[rw] [<count>]\n"
+		"\n"
+		"The rewind command restores one of the in-memory snapshots that are taken at the end of "
+		"every frame when the -rewind option is enabled. A <count> of 1 returns to the start of the "
+		"current frame, 2 to the frame before, and so on; snapshots newer than the one restored are "
+		"discarded. If <count> is omitted, it defaults to 2. How far back you can go is limited by "
+		"-rewind_capacity. Previous memory and PC tracking statistics are cleared.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"rewind\n"
+		"  Steps back to the previous frame.\n"
+		"\n"
+		"rewind 300\n"
+		"  Steps back 299 frames from the start of the current frame.\n"
+	},
 	{
 		"snap",
 		"\n"
@@ -1235,6 +1256,32 @@ static const help_item static_help_list[] =
 		"memdump\n"
 		"  Dumps memory to memdump.log.\n"
 	},
+	{
+		"memcount",
+		"\n"
+		"  memcount[d/i] [<bool>[,<cpu>[,<bool>]]]\n"
+		"\n"
+		"The memcount command counts the reads and writes made to each handler, bank and RAM range "
+		"of an address space.  'memcount' works on program space, 'memcountd' on data space and "
+		"'memcounti' on I/O space.  The first boolean argument turns counting on and off; counting "
+		"costs nothing while it is off.  The second argument is a cpu selector; if no cpu is "
+		"specified, the current cpu is automatically selected.  The third argument is a boolean "
+		"denoting if the existing counts should be cleared.  With no arguments, the counts gathered "
+		"so far are listed, busiest first.  Counts for every space with counting enabled are also "
+		"written to memcount.log on exit.  Opcode fetches and other accesses made directly through "
+		"RAM pointers are not counted.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"memcount 1\n"
+		"  Start counting program space accesses on the current CPU.\n"
+		"\n"
+		"memcounti 1,1,1\n"
+		"  Count I/O space accesses on CPU #1, clearing any existing counts.\n"
+		"\n"
+		"memcount\n"
+		"  List the program space counts for the current CPU.\n"
+	},
 	{
 		"comlist",
 		"\n"
@@ -23,7 +23,8 @@
 device_sound_interface::device_sound_interface(const machine_config &mconfig, device_t &device)
 	: device_interface(device, "sound"),
 		m_outputs(0),
-		m_auto_allocated_inputs(0)
+		m_auto_allocated_inputs(0),
+		m_self_contained_update(false)
 {
 }
 
@@ -71,6 +72,24 @@ void device_sound_interface::static_reset_routes(device_t &device)
 }
 
 
+//-------------------------------------------------
+//  static_set_self_contained_update -
+//  configuration helper to declare whether the
+//  device's stream update is safe to run
+//  alongside other streams
+//-------------------------------------------------
+
+void device_sound_interface::static_set_self_contained_update(device_t &device, bool self_contained)
+{
+	// find our sound interface
+	device_sound_interface *sound;
+	if (!device.interface(sound))
+		throw emu_fatalerror("MCFG_SOUND_SELF_CONTAINED_UPDATE called on device '%s' with no sound interface", device.tag());
+
+	sound->m_self_contained_update = self_contained;
+}
+
+
 //-------------------------------------------------
 //  stream_alloc - allocate a stream implicitly
 //  associated with this device
@@ -381,6 +400,8 @@ device_mixer_interface::device_mixer_interface(const machine_config &mconfig, de
 		m_outputs(outputs),
 		m_mixer_stream(nullptr)
 {
+	// mixing only reads our own inputs
+	m_self_contained_update = true;
 }
 
 
@@ -49,6 +49,11 @@ const int AUTO_ALLOC_INPUT  = 65535;
 #define MCFG_SOUND_ROUTES_RESET() \
 	device_sound_interface::static_reset_routes(*device);
 
+// declare that the device's stream update reads nothing outside the device and its stream inputs,
+// so it may run on a worker thread when -parallel_sound is enabled
+#define MCFG_SOUND_SELF_CONTAINED_UPDATE(_self_contained) \
+	device_sound_interface::static_set_self_contained_update(*device, _self_contained);
+
 #define MCFG_MIXER_ROUTE(_output, _target, _gain, _mixoutput) \
 	device_sound_interface::static_add_route(*device, _output, _target, _gain, AUTO_ALLOC_INPUT, _mixoutput);
 
@@ -83,10 +88,12 @@ public:
 
 	// configuration access
 	const std::vector<std::unique_ptr<sound_route>> &routes() const { return m_route_list; }
+	bool self_contained_update() const { return m_self_contained_update; }
 
 	// static inline configuration helpers
 	static void static_add_route(device_t &device, UINT32 output, const char *target, double gain, UINT32 input = AUTO_ALLOC_INPUT, UINT32 mixoutput = 0);
 	static void static_reset_routes(device_t &device);
+	static void static_set_self_contained_update(device_t &device, bool self_contained = true);
 
 	// sound stream update overrides
 	virtual void sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples) = 0;
@@ -114,6 +121,7 @@ protected:
 	std::vector<std::unique_ptr<sound_route>> m_route_list;      // list of sound routes
 	int             m_outputs;                  // number of outputs from this instance
 	int             m_auto_allocated_inputs;    // number of auto-allocated inputs targeting us
+	bool            m_self_contained_update;    // true if sound_stream_update may run on another thread
 };
 
 // iterator
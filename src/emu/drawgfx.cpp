@@ -408,7 +408,7 @@ void gfx_element::transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 	// render
 	color = colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_ROW_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY, ROW_OP_REBASE_TRANSPEN16);
 }
 
 void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -436,7 +436,7 @@ void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_ROW_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY, ROW_OP_REMAP_TRANSPEN32);
 }
 
 
@@ -595,7 +595,7 @@ void gfx_element::alpha(bitmap_rgb32 &dest, const rectangle &cliprect,
 	// get final code and color, and grab lookup tables
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32, NO_PRIORITY);
+	DRAWGFX_ROW_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32, NO_PRIORITY, ROW_OP_REMAP_TRANSPEN_ALPHA32);
 }
 
 
@@ -968,7 +968,7 @@ void gfx_element::prio_transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8);
+	DRAWGFX_ROW_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8, ROW_OP_REBASE_TRANSPEN16_PRIORITY);
 }
 
 void gfx_element::prio_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -998,7 +998,7 @@ void gfx_element::prio_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, UINT8);
+	DRAWGFX_ROW_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, UINT8, ROW_OP_REMAP_TRANSPEN32_PRIORITY);
 }
 
 
@@ -1173,7 +1173,7 @@ void gfx_element::prio_alpha(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32_PRIORITY, UINT8);
+	DRAWGFX_ROW_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32_PRIORITY, UINT8, ROW_OP_REMAP_TRANSPEN_ALPHA32_PRIORITY);
 }
 
 
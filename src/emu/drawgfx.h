@@ -119,6 +119,8 @@
 #ifndef __DRAWGFX_H__
 #define __DRAWGFX_H__
 
+#include "drawkern.h"
+
 
 /***************************************************************************
     CONSTANTS
@@ -410,37 +412,6 @@ void copyrozbitmap_trans(bitmap_rgb32 &dest, const rectangle &cliprect, const bi
 
 
 
-/***************************************************************************
-    INLINE FUNCTIONS
-***************************************************************************/
-
-//-------------------------------------------------
-//  alpha_blend_r16 - alpha blend two 16-bit
-//  5-5-5 RGB pixels
-//-------------------------------------------------
-
-inline UINT32 alpha_blend_r16(UINT32 d, UINT32 s, UINT8 level)
-{
-	int alphad = 256 - level;
-	return ((((s & 0x001f) * level + (d & 0x001f) * alphad) >> 8)) |
-			((((s & 0x03e0) * level + (d & 0x03e0) * alphad) >> 8) & 0x03e0) |
-			((((s & 0x7c00) * level + (d & 0x7c00) * alphad) >> 8) & 0x7c00);
-}
-
-
-//-------------------------------------------------
-//  alpha_blend_r16 - alpha blend two 32-bit
-//  8-8-8 RGB pixels
-//-------------------------------------------------
-
-inline UINT32 alpha_blend_r32(UINT32 d, UINT32 s, UINT8 level)
-{
-	int alphad = 256 - level;
-	return ((((s & 0x0000ff) * level + (d & 0x0000ff) * alphad) >> 8)) |
-			((((s & 0x00ff00) * level + (d & 0x00ff00) * alphad) >> 8) & 0x00ff00) |
-			((((s & 0xff0000) * level + (d & 0xff0000) * alphad) >> 8) & 0xff0000);
-}
-
 //**************************************************************************
 //  TYPE DEFINITIONS
 //**************************************************************************
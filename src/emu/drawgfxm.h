@@ -22,6 +22,10 @@
     and a priority bitmap pixel type (UINT8, UINT16, UINT32, or the
     special type NO_PRIORITY).
 
+    DRAWGFX_ROW_CORE additionally takes one of the ROW_OP* macros,
+    which can draw a whole unflipped row at once using the kernels in
+    drawkern.h; DRAWGFX_CORE is the same thing with ROW_OP_NONE.
+
     Although the code may look inefficient at first, the compiler is
     able to easily optimize out unused cases due to the way the
     macros are written, leaving behind just the cases we are
@@ -363,6 +367,51 @@ do
 while (0)
 
 
+/***************************************************************************
+    ROW OPERATIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    ROW_OP_NONE - don't draw rows as a whole;
+    fall back to PIXEL_OP for every pixel
+-------------------------------------------------*/
+
+#define ROW_OP_NONE(DEST, PRIORITY, SOURCE, COUNT) false
+
+/*-------------------------------------------------
+    ROW_OP_REBASE_TRANSPEN - equivalent to
+    PIXEL_OP_REBASE_TRANSPEN over a row of
+    16bpp pixels
+-------------------------------------------------*/
+
+#define ROW_OP_REBASE_TRANSPEN16(DEST, PRIORITY, SOURCE, COUNT)                     \
+	(drawkern_gfx_transpen_ind16(DEST, SOURCE, COUNT, color, trans_pen), true)
+#define ROW_OP_REBASE_TRANSPEN16_PRIORITY(DEST, PRIORITY, SOURCE, COUNT)            \
+	(drawkern_gfx_prio_transpen_ind16(DEST, PRIORITY, SOURCE, COUNT, color, pmask, trans_pen), true)
+
+/*-------------------------------------------------
+    ROW_OP_REMAP_TRANSPEN - equivalent to
+    PIXEL_OP_REMAP_TRANSPEN over a row of 32bpp
+    pixels
+-------------------------------------------------*/
+
+#define ROW_OP_REMAP_TRANSPEN32(DEST, PRIORITY, SOURCE, COUNT)                      \
+	(drawkern_gfx_transpen_rgb32(DEST, SOURCE, COUNT, paldata, trans_pen), true)
+#define ROW_OP_REMAP_TRANSPEN32_PRIORITY(DEST, PRIORITY, SOURCE, COUNT)             \
+	(drawkern_gfx_prio_transpen_rgb32(DEST, PRIORITY, SOURCE, COUNT, paldata, pmask, trans_pen), true)
+
+/*-------------------------------------------------
+    ROW_OP_REMAP_TRANSPEN_ALPHA - equivalent to
+    PIXEL_OP_REMAP_TRANSPEN_ALPHA32 over a row of
+    32bpp pixels
+-------------------------------------------------*/
+
+#define ROW_OP_REMAP_TRANSPEN_ALPHA32(DEST, PRIORITY, SOURCE, COUNT)                \
+	(drawkern_gfx_alpha_rgb32(DEST, SOURCE, COUNT, paldata, trans_pen, alpha_val), true)
+#define ROW_OP_REMAP_TRANSPEN_ALPHA32_PRIORITY(DEST, PRIORITY, SOURCE, COUNT)       \
+	(drawkern_gfx_prio_alpha_rgb32(DEST, PRIORITY, SOURCE, COUNT, paldata, pmask, trans_pen, alpha_val), true)
+
+
 /***************************************************************************
     BASIC DRAWGFX CORE
 ***************************************************************************/
@@ -384,6 +433,9 @@ while (0)
 
 
 #define DRAWGFX_CORE(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE)                               \
+	DRAWGFX_ROW_CORE(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE, ROW_OP_NONE)
+
+#define DRAWGFX_ROW_CORE(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE, ROW_OP)                   \
 do {                                                                                    \
 	g_profiler.start(PROFILER_DRAWGFX);                                                 \
 	do {                                                                                \
@@ -469,6 +521,10 @@ do {
 				const UINT8 *srcptr = srcdata;                                      \
 				srcdata += dy;                                                      \
 																					\
+				/* let the row operation draw the whole row if it can */            \
+				if (ROW_OP(destptr, priptr, srcptr, destendx + 1 - destx))          \
+					continue;                                                       \
+																					\
 				/* iterate over unrolled blocks of 4 */                             \
 				for (curx = 0; curx < numblocks; curx++)                            \
 				{                                                                   \
@@ -0,0 +1,911 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drawkern.h
+
+    Inner loops for drawing tilemap scanlines and rows of gfx elements,
+    along with the pixel blending helpers they share with drawgfx.
+
+    Each kernel has a _generic form written the obvious way, which is
+    the reference for what it draws, and an optimized form that must
+    draw exactly the same pixels and priorities. The optimized forms use
+    SSE2 where it can be assumed; since SSE2 has no gather, palette
+    lookups stay scalar and the vector code handles the mask tests,
+    blending and priority updates around them.
+
+    These only depend on osdcomm.h and palette.h so that they can be
+    benchmarked and tested outside of the emulator.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __DRAWKERN_H__
+#define __DRAWKERN_H__
+
+#include "osdcomm.h"
+#include "palette.h"
+
+#include <string.h>
+
+// use SSE on 64-bit implementations, where it can be assumed
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define DRAWKERN_SSE2       1
+#include <emmintrin.h>
+#else
+#define DRAWKERN_SSE2       0
+#endif
+
+
+
+//**************************************************************************
+//  PIXEL BLENDING
+//**************************************************************************
+
+//-------------------------------------------------
+//  alpha_blend_r16 - alpha blend two 16-bit
+//  5-5-5 RGB pixels
+//-------------------------------------------------
+
+inline UINT32 alpha_blend_r16(UINT32 d, UINT32 s, UINT8 level)
+{
+	int alphad = 256 - level;
+	return ((((s & 0x001f) * level + (d & 0x001f) * alphad) >> 8)) |
+			((((s & 0x03e0) * level + (d & 0x03e0) * alphad) >> 8) & 0x03e0) |
+			((((s & 0x7c00) * level + (d & 0x7c00) * alphad) >> 8) & 0x7c00);
+}
+
+
+//-------------------------------------------------
+//  alpha_blend_r16 - alpha blend two 32-bit
+//  8-8-8 RGB pixels
+//-------------------------------------------------
+
+inline UINT32 alpha_blend_r32(UINT32 d, UINT32 s, UINT8 level)
+{
+	int alphad = 256 - level;
+	return ((((s & 0x0000ff) * level + (d & 0x0000ff) * alphad) >> 8)) |
+			((((s & 0x00ff00) * level + (d & 0x00ff00) * alphad) >> 8) & 0x00ff00) |
+			((((s & 0xff0000) * level + (d & 0xff0000) * alphad) >> 8) & 0xff0000);
+}
+
+
+#if DRAWKERN_SSE2
+
+//-------------------------------------------------
+//  drawkern_alpha_blend_r32x4 - alpha_blend_r32
+//  on four pixels at once; level and alphad hold
+//  the two weights in each 16-bit lane
+//-------------------------------------------------
+
+inline __m128i drawkern_alpha_blend_r32x4(__m128i d, __m128i s, __m128i level, __m128i alphad)
+{
+	// each weighted sum is at most 255 * 256, so it fits an unsigned 16-bit lane
+	const __m128i zero = _mm_setzero_si128();
+	__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), level), _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), alphad));
+	__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), level), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), alphad));
+	__m128i result = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+
+	// the scalar form drops the top byte
+	return _mm_and_si128(result, _mm_set1_epi32(0x00ffffff));
+}
+
+
+//-------------------------------------------------
+//  drawkern_match_bits - return a bit for each of
+//  16 mask bytes that matches value under mask
+//-------------------------------------------------
+
+inline int drawkern_match_bits(const UINT8 *maskptr, __m128i maskvec, __m128i valuevec)
+{
+	__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(maskptr));
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(bytes, maskvec), valuevec));
+}
+
+
+//-------------------------------------------------
+//  drawkern_opaque_bits - return a bit for each of
+//  16 source pens that isn't the transparent pen
+//-------------------------------------------------
+
+inline int drawkern_opaque_bits(const UINT8 *source, __m128i transvec)
+{
+	__m128i pens = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+	return ~_mm_movemask_epi8(_mm_cmpeq_epi8(pens, transvec)) & 0xffff;
+}
+
+#endif
+
+
+
+//**************************************************************************
+//  TILEMAP SCANLINE RASTERIZERS
+//**************************************************************************
+
+// the priority code passed to these packs the priority value in bits 0-7, the
+// priority mask in bits 8-15 and the palette offset above that; a code of
+// 0xff00 leaves the priority bitmap alone
+
+//-------------------------------------------------
+//  drawkern_scanline_opaque_null_generic - draw to a
+//  nullptr bitmap, setting priority only
+//-------------------------------------------------
+
+inline void drawkern_scanline_opaque_null_generic(int count, UINT8 *pri, UINT32 pcode)
+{
+	// skip entirely if not changing priority
+	if (pcode == 0xff00)
+		return;
+
+	// update priority across the scanline
+	for (int i = 0; i < count; i++)
+		pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+}
+
+
+//-------------------------------------------------
+//  drawkern_scanline_opaque_null - optimized form
+//  of the above
+//-------------------------------------------------
+
+inline void drawkern_scanline_opaque_null(int count, UINT8 *pri, UINT32 pcode)
+{
+	// skip entirely if not changing priority
+	if (pcode == 0xff00)
+		return;
+
+	int i = 0;
+#if DRAWKERN_SSE2
+	const __m128i primask = _mm_set1_epi8(INT8(pcode >> 8));
+	const __m128i pricode = _mm_set1_epi8(INT8(pcode));
+	for ( ; i + 16 <= count; i += 16)
+	{
+		__m128i *priptr = reinterpret_cast<__m128i *>(&pri[i]);
+		_mm_storeu_si128(priptr, _mm_or_si128(_mm_and_si128(_mm_loadu_si128(priptr), primask), pricode));
+	}
+#endif
+	drawkern_scanline_opaque_null_generic(count - i, &pri[i], pcode);
+}
+
+
+//-------------------------------------------------
+//  drawkern_scanline_masked_null_generic - draw to a
+//  nullptr bitmap using a mask, setting priority
+//  only
+//-------------------------------------------------
+
+inline void drawkern_scanline_masked_null_generic(const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
+{
+	// skip entirely if not changing priority
+	if (pcode == 0xff00)
+		return;
+
+	// update priority across the scanline, checking the mask
+	for (int i = 0; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+}
+
+
+//-------------------------------------------------
+//  drawkern_scanline_masked_null - optimized form
+//  of the above
+//-------------------------------------------------
+
+inline void drawkern_scanline_masked_null(const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
+{
+	// skip entirely if not changing priority
+	if (pcode == 0xff00)
+		return;
+
+	int i = 0;
+#if DRAWKERN_SSE2
+	// a value outside a byte never matches, which the byte compares can't express
+	if ((value & ~0xff) == 0)
+	{
+		const __m128i maskvec = _mm_set1_epi8(INT8(mask));
+		const __m128i valuevec = _mm_set1_epi8(INT8(value));
+		const __m128i primask = _mm_set1_epi8(INT8(pcode >> 8));
+		const __m128i pricode = _mm_set1_epi8(INT8(pcode));
+		for ( ; i + 16 <= count; i += 16)
+		{
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&maskptr[i]));
+			__m128i match = _mm_cmpeq_epi8(_mm_and_si128(bytes, maskvec), valuevec);
+			__m128i *priptr = reinterpret_cast<__m128i *>(&pri[i]);
+			__m128i oldpri = _mm_loadu_si128(priptr);
+			__m128i newpri = _mm_or_si128(_mm_and_si128(oldpri, primask), pricode);
+			_mm_storeu_si128(priptr, _mm_or_si128(_mm_and_si128(match, newpri), _mm_andnot_si128(match, oldpri)));
+		}
+	}
+#endif
+	drawkern_scanline_masked_null_generic(&maskptr[i], mask, value, count - i, &pri[i], pcode);
+}
+
+
+//-------------------------------------------------
+//  drawkern_scanline_opaque_ind16_generic - draw to a
+//  16bpp indexed bitmap
+//-------------------------------------------------
+
+inline void drawkern_scanline_opaque_ind16_generic(UINT16 *dest, const UINT16 *source, int count, UINT8 *pri, UINT32 pcode)
+{
+	// special case for no palette offset
+	int pal = pcode >> 16;
+	if (pal == 0)
+	{
+		// use memcpy which should be well-optimized for the platform
+		memcpy(dest, source, count * 2);
+
+		// skip the rest if not changing priority
+		if (pcode == 0xff00)
+			return;
+
+		// update priority across the scanline
+		for (int i = 0; i < count; i++)
+			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+	}
+
+	// priority case
+	else if ((pcode & 0xffff) != 0xff00)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			dest[i] = source[i] + pal;
+			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+		}
+	}
+
+	// no priority case
+	else
+	{
+		for (int i = 0; i < count; i++)
+			dest[i] = source[i] + pal;
+	}
+}
+
+
+//-------------------------------------------------
+//  drawkern_scanline_opaque_ind16 - optimized
+//  form of the above; the pixels and priorities
+//  are independent, so they're done in two passes
+//-------------------------------------------------
+
+inline void drawkern_scanline_opaque_ind16(UINT16 *dest, const UINT16 *source, int count, UINT8 *pri, UINT32 pcode)
+{
+	int pal = pcode >> 16;
+	if (pal == 0)
+		memcpy(dest, source, count * 2);
+	else
+	{
+		int i = 0;
+#if DRAWKERN_SSE2
+		const __m128i palvec = _mm_set1_epi16(INT16(pal));
+		for ( ; i + 8 <= count; i += 8)
+		{
+			__m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[i]));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[i]), _mm_add_epi16(pixels, palvec));
+		}
+#endif
+		for ( ; i < count; i++)
+			dest[i] = source[i] + pal;
+	}
+	drawkern_scanline_opaque_null(count, pri, pcode & 0xffff);
+}
+
+
+//-------------------------------------------------
+//  drawkern_scanline_masked_ind16_generic - draw to a
+//  16bpp indexed bitmap using a mask
+//-------------------------------------------------
+
+inline void drawkern_scanline_masked_ind16_generic(UINT16 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
+{
+	int pal = pcode >> 16;
+
+	// priority case
+	if ((pcode & 0xffff) != 0xff00)
+	{
+		for (int i = 0; i < count; i++)
+			if ((maskptr[i] & mask) == value)
+			{
+				dest[i] = source[i] + pal;
+				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+			}
+	}
+
+	// no priority case
+	else
+	{
+		for (int i = 0; i < count; i++)
+			if ((maskptr[i] & mask) == value)
+				dest[i] = source[i] + pal;
+	}
+}
+
+
+//-------------------------------------------------
+//  drawkern_scanline_masked_ind16 - optimized
+//  form of the above
+//-------------------------------------------------
+
+inline void drawkern_scanline_masked_ind16(UINT16 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
+{
+	int pal = pcode >> 16;
+	int i = 0;
+#if DRAWKERN_SSE2
+	if ((value & ~0xff) == 0)
+	{
+		const __m128i maskvec = _mm_set1_epi8(INT8(mask));
+		const __m128i valuevec = _mm_set1_epi8(INT8(value));
+		const __m128i palvec = _mm_set1_epi16(INT16(pal));
+		for ( ; i + 8 <= count; i += 8)
+		{
+			// widen the byte matches to cover each 16-bit pixel
+			__m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(&maskptr[i]));
+			__m128i match = _mm_cmpeq_epi8(_mm_and_si128(bytes, maskvec), valuevec);
+			match = _mm_unpacklo_epi8(match, match);
+
+			__m128i *destptr = reinterpret_cast<__m128i *>(&dest[i]);
+			__m128i pixels = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[i])), palvec);
+			_mm_storeu_si128(destptr, _mm_or_si128(_mm_and_si128(match, pixels), _mm_andnot_si128(match, _mm_loadu_si128(destptr))));
+		}
+	}
+#endif
+	for ( ; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+			dest[i] = source[i] + pal;
+	drawkern_scanline_masked_null(maskptr, mask, value, count, pri, pcode & 0xffff);
+}
+
+
+//-------------------------------------------------
+//  drawkern_scanline_opaque_rgb32_generic - draw to a
+//  32bpp RGB bitmap
+//-------------------------------------------------
+
+inline void drawkern_scanline_opaque_rgb32_generic(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode)
+{
+	const rgb_t *clut = &pens[pcode >> 16];
+
+	// priority case
+	if ((pcode & 0xffff) != 0xff00)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			dest[i] = clut[source[i]];
+			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+		}
+	}
+
+	// no priority case
+	else
+	{
+		for (int i = 0; i < count; i++)
+			dest[i] = clut[source[i]];
+	}
+}
+
+
+//-------------------------------------------------
+//  drawkern_scanline_opaque_rgb32 - optimized
+//  form of the above; the palette lookups stay
+//  scalar, but the priorities are done in a
+//  separate vector pass
+//-------------------------------------------------
+
+inline void drawkern_scanline_opaque_rgb32(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode)
+{
+	const rgb_t *clut = &pens[pcode >> 16];
+	for (int i = 0; i < count; i++)
+		dest[i] = clut[source[i]];
+	drawkern_scanline_opaque_null(count, pri, pcode & 0xffff);
+}
+
+
+//-------------------------------------------------
+//  drawkern_scanline_masked_rgb32_generic - draw to a
+//  32bpp RGB bitmap using a mask
+//-------------------------------------------------
+
+inline void drawkern_scanline_masked_rgb32_generic(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode)
+{
+	const rgb_t *clut = &pens[pcode >> 16];
+
+	// priority case
+	if ((pcode & 0xffff) != 0xff00)
+	{
+		for (int i = 0; i < count; i++)
+			if ((maskptr[i] & mask) == value)
+			{
+				dest[i] = clut[source[i]];
+				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+			}
+	}
+
+	// no priority case
+	else
+	{
+		for (int i = 0; i < count; i++)
+			if ((maskptr[i] & mask) == value)
+				dest[i] = clut[source[i]];
+	}
+}
+
+
+//-------------------------------------------------
+//  drawkern_scanline_masked_rgb32 - optimized
+//  form of the above; runs of 16 pixels that are
+//  entirely in or out are handled without testing
+//  each pixel
+//-------------------------------------------------
+
+inline void drawkern_scanline_masked_rgb32(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode)
+{
+	const rgb_t *clut = &pens[pcode >> 16];
+	int i = 0;
+#if DRAWKERN_SSE2
+	if ((value & ~0xff) == 0)
+	{
+		const __m128i maskvec = _mm_set1_epi8(INT8(mask));
+		const __m128i valuevec = _mm_set1_epi8(INT8(value));
+		for ( ; i + 16 <= count; i += 16)
+		{
+			int bits = drawkern_match_bits(&maskptr[i], maskvec, valuevec);
+			if (bits == 0xffff)
+			{
+				for (int j = i; j < i + 16; j++)
+					dest[j] = clut[source[j]];
+			}
+			else
+			{
+				for (int j = i; bits != 0; j++, bits >>= 1)
+					if (bits & 1)
+						dest[j] = clut[source[j]];
+			}
+		}
+	}
+#endif
+	for ( ; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+			dest[i] = clut[source[i]];
+	drawkern_scanline_masked_null(maskptr, mask, value, count, pri, pcode & 0xffff);
+}
+
+
+//-------------------------------------------------
+//  drawkern_scanline_opaque_rgb32_alpha_generic - draw to
+//  a 32bpp RGB bitmap with alpha blending
+//-------------------------------------------------
+
+inline void drawkern_scanline_opaque_rgb32_alpha_generic(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
+{
+	const rgb_t *clut = &pens[pcode >> 16];
+
+	// priority case
+	if ((pcode & 0xffff) != 0xff00)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+		}
+	}
+
+	// no priority case
+	else
+	{
+		for (int i = 0; i < count; i++)
+			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+	}
+}
+
+
+//-------------------------------------------------
+//  drawkern_scanline_opaque_rgb32_alpha -
+//  optimized form of the above
+//-------------------------------------------------
+
+inline void drawkern_scanline_opaque_rgb32_alpha(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
+{
+	const rgb_t *clut = &pens[pcode >> 16];
+	int i = 0;
+#if DRAWKERN_SSE2
+	const __m128i level = _mm_set1_epi16(alpha);
+	const __m128i alphad = _mm_set1_epi16(256 - alpha);
+	for ( ; i + 4 <= count; i += 4)
+	{
+		__m128i *destptr = reinterpret_cast<__m128i *>(&dest[i]);
+		__m128i pixels = _mm_setr_epi32(clut[source[i]], clut[source[i + 1]], clut[source[i + 2]], clut[source[i + 3]]);
+		_mm_storeu_si128(destptr, drawkern_alpha_blend_r32x4(_mm_loadu_si128(destptr), pixels, level, alphad));
+	}
+#endif
+	for ( ; i < count; i++)
+		dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+	drawkern_scanline_opaque_null(count, pri, pcode & 0xffff);
+}
+
+
+//-------------------------------------------------
+//  drawkern_scanline_masked_rgb32_alpha_generic - draw to
+//  a 32bpp RGB bitmap using a mask and alpha
+//  blending
+//-------------------------------------------------
+
+inline void drawkern_scanline_masked_rgb32_alpha_generic(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
+{
+	const rgb_t *clut = &pens[pcode >> 16];
+
+	// priority case
+	if ((pcode & 0xffff) != 0xff00)
+	{
+		for (int i = 0; i < count; i++)
+			if ((maskptr[i] & mask) == value)
+			{
+				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+			}
+	}
+
+	// no priority case
+	else
+	{
+		for (int i = 0; i < count; i++)
+			if ((maskptr[i] & mask) == value)
+				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+	}
+}
+
+
+//-------------------------------------------------
+//  drawkern_scanline_masked_rgb32_alpha -
+//  optimized form of the above
+//-------------------------------------------------
+
+inline void drawkern_scanline_masked_rgb32_alpha(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
+{
+	const rgb_t *clut = &pens[pcode >> 16];
+	int i = 0;
+#if DRAWKERN_SSE2
+	if ((value & ~0xff) == 0)
+	{
+		const __m128i maskvec = _mm_set1_epi8(INT8(mask));
+		const __m128i valuevec = _mm_set1_epi8(INT8(value));
+		const __m128i level = _mm_set1_epi16(alpha);
+		const __m128i alphad = _mm_set1_epi16(256 - alpha);
+		for ( ; i + 16 <= count; i += 16)
+		{
+			// blend groups of 4 that are entirely in, and test the rest a pixel at a time
+			int bits = drawkern_match_bits(&maskptr[i], maskvec, valuevec);
+			for (int j = i; bits != 0; j += 4, bits >>= 4)
+				if ((bits & 0xf) == 0xf)
+				{
+					__m128i *destptr = reinterpret_cast<__m128i *>(&dest[j]);
+					__m128i pixels = _mm_setr_epi32(clut[source[j]], clut[source[j + 1]], clut[source[j + 2]], clut[source[j + 3]]);
+					_mm_storeu_si128(destptr, drawkern_alpha_blend_r32x4(_mm_loadu_si128(destptr), pixels, level, alphad));
+				}
+				else
+				{
+					for (int k = 0; k < 4; k++)
+						if (bits & (1 << k))
+							dest[j + k] = alpha_blend_r32(dest[j + k], clut[source[j + k]], alpha);
+				}
+		}
+	}
+#endif
+	for ( ; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+	drawkern_scanline_masked_null(maskptr, mask, value, count, pri, pcode & 0xffff);
+}
+
+
+//**************************************************************************
+//  GFX ELEMENT ROW RASTERIZERS
+//**************************************************************************
+
+// these draw one unflipped row of an 8bpp gfx element, matching the
+// PIXEL_OP_*_TRANSPEN* operations in drawgfxm.h; the priority forms
+// draw where the priority bit for the existing pixel is clear in pmask,
+// and mark every pixel they cover as 31
+
+//-------------------------------------------------
+//  drawkern_gfx_transpen_ind16_generic - draw to
+//  a 16bpp indexed bitmap, adding color to each
+//  pen other than trans_pen
+//-------------------------------------------------
+
+inline void drawkern_gfx_transpen_ind16_generic(UINT16 *dest, const UINT8 *source, int count, UINT32 color, UINT32 trans_pen)
+{
+	for (int i = 0; i < count; i++)
+	{
+		UINT32 srcdata = source[i];
+		if (srcdata != trans_pen)
+			dest[i] = color + srcdata;
+	}
+}
+
+
+//-------------------------------------------------
+//  drawkern_gfx_transpen_ind16 - optimized form
+//  of the above
+//-------------------------------------------------
+
+inline void drawkern_gfx_transpen_ind16(UINT16 *dest, const UINT8 *source, int count, UINT32 color, UINT32 trans_pen)
+{
+	int i = 0;
+#if DRAWKERN_SSE2
+	// a pen outside a byte never matches, which the byte compares can't express
+	if (trans_pen <= 0xff)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i transvec = _mm_set1_epi8(INT8(trans_pen));
+		const __m128i colorvec = _mm_set1_epi16(INT16(color));
+		for ( ; i + 8 <= count; i += 8)
+		{
+			// widen the pens and their transparency to 16 bits
+			__m128i pens = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(&source[i]));
+			__m128i trans = _mm_cmpeq_epi8(pens, transvec);
+			trans = _mm_unpacklo_epi8(trans, trans);
+			__m128i pixels = _mm_add_epi16(_mm_unpacklo_epi8(pens, zero), colorvec);
+
+			__m128i *destptr = reinterpret_cast<__m128i *>(&dest[i]);
+			_mm_storeu_si128(destptr, _mm_or_si128(_mm_andnot_si128(trans, pixels), _mm_and_si128(trans, _mm_loadu_si128(destptr))));
+		}
+	}
+#endif
+	drawkern_gfx_transpen_ind16_generic(&dest[i], &source[i], count - i, color, trans_pen);
+}
+
+
+//-------------------------------------------------
+//  drawkern_gfx_transpen_rgb32_generic - draw to
+//  a 32bpp RGB bitmap, mapping each pen other
+//  than trans_pen through paldata
+//-------------------------------------------------
+
+inline void drawkern_gfx_transpen_rgb32_generic(UINT32 *dest, const UINT8 *source, int count, const UINT32 *paldata, UINT32 trans_pen)
+{
+	for (int i = 0; i < count; i++)
+	{
+		UINT32 srcdata = source[i];
+		if (srcdata != trans_pen)
+			dest[i] = paldata[srcdata];
+	}
+}
+
+
+//-------------------------------------------------
+//  drawkern_gfx_transpen_rgb32 - optimized form
+//  of the above; runs of 16 pixels that are
+//  entirely opaque or transparent are handled
+//  without testing each pixel
+//-------------------------------------------------
+
+inline void drawkern_gfx_transpen_rgb32(UINT32 *dest, const UINT8 *source, int count, const UINT32 *paldata, UINT32 trans_pen)
+{
+	int i = 0;
+#if DRAWKERN_SSE2
+	if (trans_pen <= 0xff)
+	{
+		const __m128i transvec = _mm_set1_epi8(INT8(trans_pen));
+		for ( ; i + 16 <= count; i += 16)
+		{
+			int bits = drawkern_opaque_bits(&source[i], transvec);
+			if (bits == 0xffff)
+			{
+				for (int j = i; j < i + 16; j++)
+					dest[j] = paldata[source[j]];
+			}
+			else
+			{
+				for (int j = i; bits != 0; j++, bits >>= 1)
+					if (bits & 1)
+						dest[j] = paldata[source[j]];
+			}
+		}
+	}
+#endif
+	drawkern_gfx_transpen_rgb32_generic(&dest[i], &source[i], count - i, paldata, trans_pen);
+}
+
+
+//-------------------------------------------------
+//  drawkern_gfx_alpha_rgb32_generic - draw to a
+//  32bpp RGB bitmap, alpha blending each pen
+//  other than trans_pen mapped through paldata
+//-------------------------------------------------
+
+inline void drawkern_gfx_alpha_rgb32_generic(UINT32 *dest, const UINT8 *source, int count, const UINT32 *paldata, UINT32 trans_pen, UINT8 alpha)
+{
+	for (int i = 0; i < count; i++)
+	{
+		UINT32 srcdata = source[i];
+		if (srcdata != trans_pen)
+			dest[i] = alpha_blend_r32(dest[i], paldata[srcdata], alpha);
+	}
+}
+
+
+//-------------------------------------------------
+//  drawkern_gfx_alpha_rgb32 - optimized form of
+//  the above
+//-------------------------------------------------
+
+inline void drawkern_gfx_alpha_rgb32(UINT32 *dest, const UINT8 *source, int count, const UINT32 *paldata, UINT32 trans_pen, UINT8 alpha)
+{
+	int i = 0;
+#if DRAWKERN_SSE2
+	if (trans_pen <= 0xff)
+	{
+		const __m128i transvec = _mm_set1_epi8(INT8(trans_pen));
+		const __m128i level = _mm_set1_epi16(alpha);
+		const __m128i alphad = _mm_set1_epi16(256 - alpha);
+		for ( ; i + 16 <= count; i += 16)
+		{
+			// blend groups of 4 that are entirely opaque, and test the rest a pixel at a time
+			int bits = drawkern_opaque_bits(&source[i], transvec);
+			for (int j = i; bits != 0; j += 4, bits >>= 4)
+				if ((bits & 0xf) == 0xf)
+				{
+					__m128i *destptr = reinterpret_cast<__m128i *>(&dest[j]);
+					__m128i pixels = _mm_setr_epi32(paldata[source[j]], paldata[source[j + 1]], paldata[source[j + 2]], paldata[source[j + 3]]);
+					_mm_storeu_si128(destptr, drawkern_alpha_blend_r32x4(_mm_loadu_si128(destptr), pixels, level, alphad));
+				}
+				else
+				{
+					for (int k = 0; k < 4; k++)
+						if (bits & (1 << k))
+							dest[j + k] = alpha_blend_r32(dest[j + k], paldata[source[j + k]], alpha);
+				}
+		}
+	}
+#endif
+	drawkern_gfx_alpha_rgb32_generic(&dest[i], &source[i], count - i, paldata, trans_pen, alpha);
+}
+
+
+//-------------------------------------------------
+//  drawkern_gfx_prio_transpen_ind16_generic -
+//  drawkern_gfx_transpen_ind16_generic, checking
+//  against the priority bitmap
+//-------------------------------------------------
+
+inline void drawkern_gfx_prio_transpen_ind16_generic(UINT16 *dest, UINT8 *pri, const UINT8 *source, int count, UINT32 color, UINT32 pmask, UINT32 trans_pen)
+{
+	for (int i = 0; i < count; i++)
+	{
+		UINT32 srcdata = source[i];
+		if (srcdata != trans_pen)
+		{
+			if (((1U << (pri[i] & 0x1f)) & pmask) == 0)
+				dest[i] = color + srcdata;
+			pri[i] = 31;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  drawkern_gfx_prio_transpen_ind16 - optimized
+//  form of the above; SSE2 has no per-lane
+//  shifts for the priority test, so this only
+//  skips transparent runs of 16 pixels
+//-------------------------------------------------
+
+inline void drawkern_gfx_prio_transpen_ind16(UINT16 *dest, UINT8 *pri, const UINT8 *source, int count, UINT32 color, UINT32 pmask, UINT32 trans_pen)
+{
+	int i = 0;
+#if DRAWKERN_SSE2
+	if (trans_pen <= 0xff)
+	{
+		const __m128i transvec = _mm_set1_epi8(INT8(trans_pen));
+		for ( ; i + 16 <= count; i += 16)
+			for (int j = i, bits = drawkern_opaque_bits(&source[i], transvec); bits != 0; j++, bits >>= 1)
+				if (bits & 1)
+				{
+					if (((1U << (pri[j] & 0x1f)) & pmask) == 0)
+						dest[j] = color + source[j];
+					pri[j] = 31;
+				}
+	}
+#endif
+	drawkern_gfx_prio_transpen_ind16_generic(&dest[i], &pri[i], &source[i], count - i, color, pmask, trans_pen);
+}
+
+
+//-------------------------------------------------
+//  drawkern_gfx_prio_transpen_rgb32_generic -
+//  drawkern_gfx_transpen_rgb32_generic, checking
+//  against the priority bitmap
+//-------------------------------------------------
+
+inline void drawkern_gfx_prio_transpen_rgb32_generic(UINT32 *dest, UINT8 *pri, const UINT8 *source, int count, const UINT32 *paldata, UINT32 pmask, UINT32 trans_pen)
+{
+	for (int i = 0; i < count; i++)
+	{
+		UINT32 srcdata = source[i];
+		if (srcdata != trans_pen)
+		{
+			if (((1U << (pri[i] & 0x1f)) & pmask) == 0)
+				dest[i] = paldata[srcdata];
+			pri[i] = 31;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  drawkern_gfx_prio_transpen_rgb32 - optimized
+//  form of the above
+//-------------------------------------------------
+
+inline void drawkern_gfx_prio_transpen_rgb32(UINT32 *dest, UINT8 *pri, const UINT8 *source, int count, const UINT32 *paldata, UINT32 pmask, UINT32 trans_pen)
+{
+	int i = 0;
+#if DRAWKERN_SSE2
+	if (trans_pen <= 0xff)
+	{
+		const __m128i transvec = _mm_set1_epi8(INT8(trans_pen));
+		for ( ; i + 16 <= count; i += 16)
+			for (int j = i, bits = drawkern_opaque_bits(&source[i], transvec); bits != 0; j++, bits >>= 1)
+				if (bits & 1)
+				{
+					if (((1U << (pri[j] & 0x1f)) & pmask) == 0)
+						dest[j] = paldata[source[j]];
+					pri[j] = 31;
+				}
+	}
+#endif
+	drawkern_gfx_prio_transpen_rgb32_generic(&dest[i], &pri[i], &source[i], count - i, paldata, pmask, trans_pen);
+}
+
+
+//-------------------------------------------------
+//  drawkern_gfx_prio_alpha_rgb32_generic -
+//  drawkern_gfx_alpha_rgb32_generic, checking
+//  against the priority bitmap
+//-------------------------------------------------
+
+inline void drawkern_gfx_prio_alpha_rgb32_generic(UINT32 *dest, UINT8 *pri, const UINT8 *source, int count, const UINT32 *paldata, UINT32 pmask, UINT32 trans_pen, UINT8 alpha)
+{
+	for (int i = 0; i < count; i++)
+	{
+		UINT32 srcdata = source[i];
+		if (srcdata != trans_pen)
+		{
+			if (((1U << (pri[i] & 0x1f)) & pmask) == 0)
+				dest[i] = alpha_blend_r32(dest[i], paldata[srcdata], alpha);
+			pri[i] = 31;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  drawkern_gfx_prio_alpha_rgb32 - optimized form
+//  of the above
+//-------------------------------------------------
+
+inline void drawkern_gfx_prio_alpha_rgb32(UINT32 *dest, UINT8 *pri, const UINT8 *source, int count, const UINT32 *paldata, UINT32 pmask, UINT32 trans_pen, UINT8 alpha)
+{
+	int i = 0;
+#if DRAWKERN_SSE2
+	if (trans_pen <= 0xff)
+	{
+		const __m128i transvec = _mm_set1_epi8(INT8(trans_pen));
+		for ( ; i + 16 <= count; i += 16)
+			for (int j = i, bits = drawkern_opaque_bits(&source[i], transvec); bits != 0; j++, bits >>= 1)
+				if (bits & 1)
+				{
+					if (((1U << (pri[j] & 0x1f)) & pmask) == 0)
+						dest[j] = alpha_blend_r32(dest[j], paldata[source[j]], alpha);
+					pri[j] = 31;
+				}
+	}
+#endif
+	drawkern_gfx_prio_alpha_rgb32_generic(&dest[i], &pri[i], &source[i], count - i, paldata, pmask, trans_pen, alpha);
+}
+
+
+#endif  /* __DRAWKERN_H__ */
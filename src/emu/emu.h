@@ -18,6 +18,7 @@
 #ifndef __EMU_H__
 #define __EMU_H__
 
+#include <deque>
 #include <list>
 #include <vector>
 #include <memory>
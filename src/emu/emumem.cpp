@@ -176,6 +176,8 @@
 
 ***************************************************************************/
 
+#include <algorithm>
+#include <fstream>
 #include <list>
 #include <map>
 
@@ -244,6 +246,7 @@ enum
 	STATIC_NOP,                                         // NOP - reads = unmapped value; writes = no-op
 	STATIC_UNMAP,                                       // unmapped - same as NOP except we log errors
 	STATIC_WATCHPOINT,                                  // watchpoint - used internally
+	STATIC_COUNTER,                                     // access counter - used internally
 	STATIC_COUNT                                        // total number of static handlers
 };
 
@@ -566,6 +569,8 @@ public:
 	// getters
 	virtual handler_entry &handler(UINT32 index) const = 0;
 	bool watchpoints_enabled() const { return (m_live_lookup == s_watchpoint_table); }
+	bool counters_enabled() const { return (m_base_lookup == s_counter_table); }
+	UINT64 access_count(UINT16 entry) const { return m_access_count.empty() ? 0 : m_access_count[entry]; }
 
 	// address lookups
 	UINT32 lookup_live(offs_t byteaddress) const { return m_large ? lookup_live_large(byteaddress) : lookup_live_small(byteaddress); }
@@ -599,7 +604,11 @@ public:
 	}
 
 	// enable watchpoints by swapping in the watchpoint table
-	void enable_watchpoints(bool enable = true) { m_live_lookup = enable ? s_watchpoint_table : &m_table[0]; }
+	void enable_watchpoints(bool enable = true) { m_live_lookup = enable ? s_watchpoint_table : m_base_lookup; }
+
+	// enable access counters by swapping in the counter table underneath any watchpoints
+	void enable_counters(bool enable = true);
+	void clear_counters() { std::fill(m_access_count.begin(), m_access_count.end(), 0); }
 
 	// table mapping helpers
 	void map_range(offs_t bytestart, offs_t byteend, offs_t bytemask, offs_t bytemirror, UINT16 staticentry);
@@ -633,6 +642,8 @@ protected:
 	// internal state
 	std::vector<UINT16>   m_table;                    // pointer to base of table
 	UINT16 *                m_live_lookup;              // current lookup
+	UINT16 *                m_base_lookup;              // lookup to use when watchpoints are disabled
+	std::vector<UINT64>     m_access_count;             // per-entry access counts
 	address_space &         m_space;                    // pointer back to the space
 	bool                    m_large;                    // large memory model?
 
@@ -652,8 +663,9 @@ protected:
 	std::vector<subtable_data>   m_subtable;            // info about each subtable
 	UINT16                  m_subtable_alloc;           // number of subtables allocated
 
-	// static global read-only watchpoint table
+	// static global read-only watchpoint and counter tables
 	static UINT16           s_watchpoint_table[1 << LEVEL1_BITS];
+	static UINT16           s_counter_table[1 << LEVEL1_BITS];
 
 private:
 	int handler_refcount[SUBTABLE_BASE-STATIC_COUNT];
@@ -678,6 +690,8 @@ private:
 			if (! --handler_refcount[entry - STATIC_COUNT])
 			{
 				handler(entry).deconfigure();
+				if (!m_access_count.empty())
+					m_access_count[entry] = 0;
 				handler_next_free[entry - STATIC_COUNT] = handler_free;
 				handler_free = entry;
 			}
@@ -740,6 +754,23 @@ private:
 	{
 		m_space.device().debug()->memory_read_hook(m_space, offset * sizeof(_UintType), mask);
 
+		UINT16 *oldtable = m_live_lookup;
+		m_live_lookup = m_base_lookup;
+		_UintType result;
+		if (sizeof(_UintType) == 1) result = m_space.read_byte(offset);
+		if (sizeof(_UintType) == 2) result = m_space.read_word(offset << 1, mask);
+		if (sizeof(_UintType) == 4) result = m_space.read_dword(offset << 2, mask);
+		if (sizeof(_UintType) == 8) result = m_space.read_qword(offset << 3, mask);
+		m_live_lookup = oldtable;
+		return result;
+	}
+
+	// internal access counter handler
+	template<typename _UintType>
+	_UintType counter_r(address_space &space, offs_t offset, _UintType mask)
+	{
+		m_access_count[lookup_live_nowp(offset * sizeof(_UintType))]++;
+
 		UINT16 *oldtable = m_live_lookup;
 		m_live_lookup = &m_table[0];
 		_UintType result;
@@ -808,6 +839,20 @@ private:
 	{
 		m_space.device().debug()->memory_write_hook(m_space, offset * sizeof(_UintType), data, mask);
 
+		UINT16 *oldtable = m_live_lookup;
+		m_live_lookup = m_base_lookup;
+		if (sizeof(_UintType) == 1) m_space.write_byte(offset, data);
+		if (sizeof(_UintType) == 2) m_space.write_word(offset << 1, data, mask);
+		if (sizeof(_UintType) == 4) m_space.write_dword(offset << 2, data, mask);
+		if (sizeof(_UintType) == 8) m_space.write_qword(offset << 3, data, mask);
+		m_live_lookup = oldtable;
+	}
+
+	template<typename _UintType>
+	void counter_w(address_space &space, offs_t offset, _UintType data, _UintType mask)
+	{
+		m_access_count[lookup_live_nowp(offset * sizeof(_UintType))]++;
+
 		UINT16 *oldtable = m_live_lookup;
 		m_live_lookup = &m_table[0];
 		if (sizeof(_UintType) == 1) m_space.write_byte(offset, data);
@@ -1044,6 +1089,9 @@ public:
 	virtual void enable_read_watchpoints(bool enable = true) override { m_read.enable_watchpoints(enable); }
 	virtual void enable_write_watchpoints(bool enable = true) override { m_write.enable_watchpoints(enable); }
 
+	// access counter control
+	virtual void enable_access_counters(bool enable = true) override { m_read.enable_counters(enable); m_write.enable_counters(enable); }
+
 	// generate accessor table
 	virtual void accessors(data_accessors &accessors) const override
 	{
@@ -1095,6 +1143,7 @@ public:
 	_NativeType read_native(offs_t offset, _NativeType mask)
 	{
 		g_profiler.start(PROFILER_MEMREAD);
+		g_profiler.count(PROFILER_COUNT_MEMORY_READ);
 
 		if (TEST_HANDLER) printf("[r%X,%s]", offset, core_i64_hex_format(mask, sizeof(_NativeType) * 2));
 
@@ -1120,6 +1169,7 @@ public:
 	_NativeType read_native(offs_t offset)
 	{
 		g_profiler.start(PROFILER_MEMREAD);
+		g_profiler.count(PROFILER_COUNT_MEMORY_READ);
 
 		if (TEST_HANDLER) printf("[r%X]", offset);
 
@@ -1145,6 +1195,7 @@ public:
 	void write_native(offs_t offset, _NativeType data, _NativeType mask)
 	{
 		g_profiler.start(PROFILER_MEMWRITE);
+		g_profiler.count(PROFILER_COUNT_MEMORY_WRITE);
 
 		// look up the handler
 		offs_t byteaddress = offset & m_bytemask;
@@ -1170,6 +1221,7 @@ public:
 	void write_native(offs_t offset, _NativeType data)
 	{
 		g_profiler.start(PROFILER_MEMWRITE);
+		g_profiler.count(PROFILER_COUNT_MEMORY_WRITE);
 
 		// look up the handler
 		offs_t byteaddress = offset & m_bytemask;
@@ -1523,8 +1575,9 @@ typedef address_space_specific<UINT64, ENDIANNESS_BIG,    true> address_space_64
 //  GLOBAL VARIABLES
 //**************************************************************************
 
-// global watchpoint table
+// global watchpoint and counter tables
 UINT16 address_table::s_watchpoint_table[1 << LEVEL1_BITS];
+UINT16 address_table::s_counter_table[1 << LEVEL1_BITS];
 
 
 
@@ -1594,6 +1647,12 @@ void memory_manager::initialize()
 			space->set_log_unmap(false);
 	}
 
+	// count accesses from the start if requested, and report them on the way out
+	if (machine().options().memcount())
+		for (auto &space : m_spacelist)
+			space->enable_access_counters(true);
+	machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(memory_manager::access_counts_exit), this));
+
 	// register a callback to reset banks when reloading state
 	machine().save().register_postload(save_prepost_delegate(FUNC(memory_manager::bank_reattach), this));
 
@@ -1634,6 +1693,38 @@ void memory_manager::dump(FILE *file)
 }
 
 
+//-------------------------------------------------
+//  dump_access_counts - report the access counts
+//  of every space that has counting enabled
+//-------------------------------------------------
+
+void memory_manager::dump_access_counts(std::ostream &stream)
+{
+	for (auto &space : m_spacelist)
+		if (space->access_counters_enabled())
+			space->dump_access_counts(stream);
+}
+
+
+//-------------------------------------------------
+//  access_counts_exit - write the access counts
+//  to memcount.log if anything was counted
+//-------------------------------------------------
+
+void memory_manager::access_counts_exit()
+{
+	bool counting = false;
+	for (auto &space : m_spacelist)
+		counting = counting || space->access_counters_enabled();
+	if (!counting)
+		return;
+
+	std::ofstream file("memcount.log");
+	if (file)
+		dump_access_counts(file);
+}
+
+
 //-------------------------------------------------
 //  region_alloc - allocates memory for a region
 //-------------------------------------------------
@@ -2387,6 +2478,65 @@ void address_space::dump_map(FILE *file, read_or_write readorwrite)
 }
 
 
+//-------------------------------------------------
+//  access_counters_enabled - return true if
+//  accesses to this space are being counted
+//-------------------------------------------------
+
+bool address_space::access_counters_enabled()
+{
+	return read().counters_enabled() || write().counters_enabled();
+}
+
+
+//-------------------------------------------------
+//  clear_access_counters - reset all read and
+//  write access counts to zero
+//-------------------------------------------------
+
+void address_space::clear_access_counters()
+{
+	read().clear_counters();
+	write().clear_counters();
+}
+
+
+//-------------------------------------------------
+//  dump_access_counts - report how often each
+//  handler, bank and RAM range was accessed
+//-------------------------------------------------
+
+void address_space::dump_access_counts(std::ostream &stream)
+{
+	for (int pass = 0; pass < 2; pass++)
+	{
+		const address_table &table = (pass == 0) ? static_cast<address_table &>(read()) : static_cast<address_table &>(write());
+
+		// gather the entries that were hit, busiest first
+		std::vector<std::pair<UINT64, UINT16>> hits;
+		UINT64 total = 0;
+		for (UINT16 entry = 0; entry < TOTAL_MEMORY_BANKS; entry++)
+		{
+			UINT64 count = table.access_count(entry);
+			if (count != 0)
+				hits.emplace_back(count, entry);
+			total += count;
+		}
+		std::sort(hits.begin(), hits.end(), [](const std::pair<UINT64, UINT16> &a, const std::pair<UINT64, UINT16> &b) { return a.first > b.first; });
+
+		util::stream_format(stream, "'%s' %s %s: %u accesses\n", m_device.tag(), m_name, (pass == 0) ? "reads" : "writes", total);
+		for (auto &hit : hits)
+		{
+			const handler_entry &handler = table.handler(hit.second);
+			util::stream_format(stream, "  %12u %5.1f%%  %02X: %0*X-%0*X  %s\n",
+					hit.first, 100.0 * double(hit.first) / double(total), hit.second,
+					m_addrchars, byte_to_address(handler.bytestart()), m_addrchars, byte_to_address_end(handler.byteend()),
+					table.handler_name(hit.second));
+		}
+	}
+}
+
+
 //**************************************************************************
 //  DYNAMIC ADDRESS SPACE MAPPING
 //**************************************************************************
@@ -2924,12 +3074,15 @@ address_table::address_table(address_space &space, bool large)
 		m_subtable(SUBTABLE_COUNT),
 		m_subtable_alloc(0)
 {
-	m_live_lookup = &m_table[0];
+	m_live_lookup = m_base_lookup = &m_table[0];
 
-	// make our static table all watchpoints
+	// make our static tables all watchpoints and counters
 	if (s_watchpoint_table[0] != STATIC_WATCHPOINT)
 		for (unsigned int i=0; i != ARRAY_LENGTH(s_watchpoint_table); i++)
 			s_watchpoint_table[i] = STATIC_WATCHPOINT;
+	if (s_counter_table[0] != STATIC_COUNTER)
+		for (unsigned int i=0; i != ARRAY_LENGTH(s_counter_table); i++)
+			s_counter_table[i] = STATIC_COUNTER;
 
 	// initialize everything to unmapped
 	for (unsigned int i=0; i != 1 << LEVEL1_BITS; i++)
@@ -2955,6 +3108,25 @@ address_table::~address_table()
 }
 
 
+//-------------------------------------------------
+//  enable_counters - route all accesses through
+//  the counting handler; counts are kept when
+//  disabled so they can still be reported
+//-------------------------------------------------
+
+void address_table::enable_counters(bool enable)
+{
+	if (enable && m_access_count.empty())
+		m_access_count.resize(TOTAL_MEMORY_BANKS, 0);
+
+	// if watchpoints are live, they will pick up the new base on their way through
+	bool watching = watchpoints_enabled();
+	m_base_lookup = enable ? s_counter_table : &m_table[0];
+	if (!watching)
+		m_live_lookup = m_base_lookup;
+}
+
+
 //-------------------------------------------------
 //  map_range - map a specific entry in the address
 //  map
@@ -3515,11 +3687,14 @@ UINT16 address_table::subtable_alloc()
 					UINT32 newsize = (1 << LEVEL1_BITS) + (m_subtable_alloc << level2_bits());
 
 					bool was_live = (m_live_lookup == &m_table[0]);
+					bool was_base = (m_base_lookup == &m_table[0]);
 					int oldsize = m_table.size();
 					m_table.resize(newsize);
 					memset(&m_table[oldsize], 0, (newsize-oldsize)*sizeof(m_table[0]));
 					if (was_live)
 						m_live_lookup = &m_table[0];
+					if (was_base)
+						m_base_lookup = &m_table[0];
 				}
 				// bump the usecount and return
 				m_subtable[subindex].m_usecount++;
@@ -3718,6 +3893,7 @@ const char *address_table::handler_name(UINT16 entry) const
 	if (entry == STATIC_NOP) return "nop";
 	if (entry == STATIC_UNMAP) return "unmapped";
 	if (entry == STATIC_WATCHPOINT) return "watchpoint";
+	if (entry == STATIC_COUNTER) return "counter";
 
 	static char desc[4096];
 	handler(entry).description(desc);
@@ -3749,6 +3925,7 @@ address_table_read::address_table_read(address_space &space, bool large)
 			m_handlers[STATIC_UNMAP]->set_delegate(read8_delegate(FUNC(address_table_read::unmap_r<UINT8>), this));
 			m_handlers[STATIC_NOP]->set_delegate(read8_delegate(FUNC(address_table_read::nop_r<UINT8>), this));
 			m_handlers[STATIC_WATCHPOINT]->set_delegate(read8_delegate(FUNC(address_table_read::watchpoint_r<UINT8>), this));
+			m_handlers[STATIC_COUNTER]->set_delegate(read8_delegate(FUNC(address_table_read::counter_r<UINT8>), this));
 			break;
 
 		// 16-bit case
@@ -3756,6 +3933,7 @@ address_table_read::address_table_read(address_space &space, bool large)
 			m_handlers[STATIC_UNMAP]->set_delegate(read16_delegate(FUNC(address_table_read::unmap_r<UINT16>), this));
 			m_handlers[STATIC_NOP]->set_delegate(read16_delegate(FUNC(address_table_read::nop_r<UINT16>), this));
 			m_handlers[STATIC_WATCHPOINT]->set_delegate(read16_delegate(FUNC(address_table_read::watchpoint_r<UINT16>), this));
+			m_handlers[STATIC_COUNTER]->set_delegate(read16_delegate(FUNC(address_table_read::counter_r<UINT16>), this));
 			break;
 
 		// 32-bit case
@@ -3763,6 +3941,7 @@ address_table_read::address_table_read(address_space &space, bool large)
 			m_handlers[STATIC_UNMAP]->set_delegate(read32_delegate(FUNC(address_table_read::unmap_r<UINT32>), this));
 			m_handlers[STATIC_NOP]->set_delegate(read32_delegate(FUNC(address_table_read::nop_r<UINT32>), this));
 			m_handlers[STATIC_WATCHPOINT]->set_delegate(read32_delegate(FUNC(address_table_read::watchpoint_r<UINT32>), this));
+			m_handlers[STATIC_COUNTER]->set_delegate(read32_delegate(FUNC(address_table_read::counter_r<UINT32>), this));
 			break;
 
 		// 64-bit case
@@ -3770,6 +3949,7 @@ address_table_read::address_table_read(address_space &space, bool large)
 			m_handlers[STATIC_UNMAP]->set_delegate(read64_delegate(FUNC(address_table_read::unmap_r<UINT64>), this));
 			m_handlers[STATIC_NOP]->set_delegate(read64_delegate(FUNC(address_table_read::nop_r<UINT64>), this));
 			m_handlers[STATIC_WATCHPOINT]->set_delegate(read64_delegate(FUNC(address_table_read::watchpoint_r<UINT64>), this));
+			m_handlers[STATIC_COUNTER]->set_delegate(read64_delegate(FUNC(address_table_read::counter_r<UINT64>), this));
 			break;
 	}
 
@@ -3777,6 +3957,7 @@ address_table_read::address_table_read(address_space &space, bool large)
 	m_handlers[STATIC_UNMAP]->configure(0, space.bytemask(), ~0);
 	m_handlers[STATIC_NOP]->configure(0, space.bytemask(), ~0);
 	m_handlers[STATIC_WATCHPOINT]->configure(0, space.bytemask(), ~0);
+	m_handlers[STATIC_COUNTER]->configure(0, space.bytemask(), ~0);
 }
 
 
@@ -3823,6 +4004,7 @@ address_table_write::address_table_write(address_space &space, bool large)
 			m_handlers[STATIC_UNMAP]->set_delegate(write8_delegate(FUNC(address_table_write::unmap_w<UINT8>), this));
 			m_handlers[STATIC_NOP]->set_delegate(write8_delegate(FUNC(address_table_write::nop_w<UINT8>), this));
 			m_handlers[STATIC_WATCHPOINT]->set_delegate(write8_delegate(FUNC(address_table_write::watchpoint_w<UINT8>), this));
+			m_handlers[STATIC_COUNTER]->set_delegate(write8_delegate(FUNC(address_table_write::counter_w<UINT8>), this));
 			break;
 
 		// 16-bit case
@@ -3830,6 +4012,7 @@ address_table_write::address_table_write(address_space &space, bool large)
 			m_handlers[STATIC_UNMAP]->set_delegate(write16_delegate(FUNC(address_table_write::unmap_w<UINT16>), this));
 			m_handlers[STATIC_NOP]->set_delegate(write16_delegate(FUNC(address_table_write::nop_w<UINT16>), this));
 			m_handlers[STATIC_WATCHPOINT]->set_delegate(write16_delegate(FUNC(address_table_write::watchpoint_w<UINT16>), this));
+			m_handlers[STATIC_COUNTER]->set_delegate(write16_delegate(FUNC(address_table_write::counter_w<UINT16>), this));
 			break;
 
 		// 32-bit case
@@ -3837,6 +4020,7 @@ address_table_write::address_table_write(address_space &space, bool large)
 			m_handlers[STATIC_UNMAP]->set_delegate(write32_delegate(FUNC(address_table_write::unmap_w<UINT32>), this));
 			m_handlers[STATIC_NOP]->set_delegate(write32_delegate(FUNC(address_table_write::nop_w<UINT32>), this));
 			m_handlers[STATIC_WATCHPOINT]->set_delegate(write32_delegate(FUNC(address_table_write::watchpoint_w<UINT32>), this));
+			m_handlers[STATIC_COUNTER]->set_delegate(write32_delegate(FUNC(address_table_write::counter_w<UINT32>), this));
 			break;
 
 		// 64-bit case
@@ -3844,6 +4028,7 @@ address_table_write::address_table_write(address_space &space, bool large)
 			m_handlers[STATIC_UNMAP]->set_delegate(write64_delegate(FUNC(address_table_write::unmap_w<UINT64>), this));
 			m_handlers[STATIC_NOP]->set_delegate(write64_delegate(FUNC(address_table_write::nop_w<UINT64>), this));
 			m_handlers[STATIC_WATCHPOINT]->set_delegate(write64_delegate(FUNC(address_table_write::watchpoint_w<UINT64>), this));
+			m_handlers[STATIC_COUNTER]->set_delegate(write64_delegate(FUNC(address_table_write::counter_w<UINT64>), this));
 			break;
 	}
 
@@ -3851,6 +4036,7 @@ address_table_write::address_table_write(address_space &space, bool large)
 	m_handlers[STATIC_UNMAP]->configure(0, space.bytemask(), ~0);
 	m_handlers[STATIC_NOP]->configure(0, space.bytemask(), ~0);
 	m_handlers[STATIC_WATCHPOINT]->configure(0, space.bytemask(), ~0);
+	m_handlers[STATIC_COUNTER]->configure(0, space.bytemask(), ~0);
 }
 
 
@@ -300,6 +300,12 @@ public:
 	virtual void enable_read_watchpoints(bool enable = true) = 0;
 	virtual void enable_write_watchpoints(bool enable = true) = 0;
 
+	// access counters
+	virtual void enable_access_counters(bool enable = true) = 0;
+	bool access_counters_enabled();
+	void clear_access_counters();
+	void dump_access_counts(std::ostream &stream);
+
 	// general accessors
 	virtual void accessors(data_accessors &accessors) const = 0;
 	virtual void *get_read_ptr(offs_t byteaddress) = 0;
@@ -723,6 +729,9 @@ public:
 	// dump the internal memory tables to the given file
 	void dump(FILE *file);
 
+	// report access counts for every space that is counting them
+	void dump_access_counts(std::ostream &stream);
+
 	// pointers to a bank pointer (internal usage only)
 	UINT8 **bank_pointer_addr(UINT8 index) { return &m_bank_ptr[index]; }
 
@@ -734,6 +743,7 @@ public:
 private:
 	// internal helpers
 	void bank_reattach();
+	void access_counts_exit();
 
 	// internal state
 	running_machine &           m_machine;              // reference to the machine
@@ -54,6 +54,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE STATE/PLAYBACK OPTIONS" },
 	{ OPTION_STATE,                                      nullptr,        OPTION_STRING,     "saved state to load" },
 	{ OPTION_AUTOSAVE,                                   "0",         OPTION_BOOLEAN,    "enable automatic restore at startup, and automatic save at exit time" },
+	{ OPTION_REWIND,                                     "0",         OPTION_BOOLEAN,    "keep an in-memory snapshot of every frame so that emulation can be stepped back" },
+	{ OPTION_REWIND_CAPACITY "(1-2048)",                 "100",       OPTION_INTEGER,    "memory budget in megabytes for rewind snapshots" },
 	{ OPTION_PLAYBACK ";pb",                             nullptr,        OPTION_STRING,     "playback an input file" },
 	{ OPTION_RECORD ";rec",                              nullptr,        OPTION_STRING,     "record an input file" },
 	{ OPTION_RECORD_TIMECODE,                            "0",            OPTION_BOOLEAN,    "record an input timecode file (requires -record option)" },
@@ -81,6 +83,10 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SLEEP,                                      "1",         OPTION_BOOLEAN,    "enable sleeping, which gives time back to other applications when idle" },
 	{ OPTION_SPEED "(0.01-100)",                         "1.0",       OPTION_FLOAT,      "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
 	{ OPTION_REFRESHSPEED ";rs",                         "0",         OPTION_BOOLEAN,    "automatically adjusts the speed of gameplay to keep the refresh rate lower than the screen" },
+	{ OPTION_BENCH_REPORT,                               nullptr,     OPTION_STRING,     "append a line of JSON with speed, profiler and memory statistics to this file when each system exits" },
+	{ OPTION_BENCH_SYSTEMS,                              nullptr,     OPTION_STRING,     "comma-separated list of further systems to run in turn after the first" },
+	{ OPTION_SWRENDER_BANDS "(0-32)",                    "0",         OPTION_INTEGER,    "number of horizontal bands software rendering draws in parallel; 0 or 1 draws on a single thread" },
+	{ OPTION_TILEMAP_BANDS "(0-32)",                     "0",         OPTION_INTEGER,    "number of horizontal bands tall tilemap draws are split into and drawn in parallel; 0 or 1 draws on a single thread" },
 
 	// render options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE RENDER OPTIONS" },
@@ -130,6 +136,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SAMPLERATE ";sr(1000-1000000)",             "48000",     OPTION_INTEGER,    "set sound output sample rate" },
 	{ OPTION_SAMPLES,                                    "1",         OPTION_BOOLEAN,    "enable the use of external samples if available" },
 	{ OPTION_VOLUME ";vol",                              "0",         OPTION_INTEGER,    "sound volume in decibels (-32 min, 0 max)" },
+	{ OPTION_PARALLEL_SOUND,                             "0",         OPTION_BOOLEAN,    "update self-contained sound streams on multiple threads" },
 
 	// input options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE INPUT OPTIONS" },
@@ -169,6 +176,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DEBUG ";d",                                 "0",         OPTION_BOOLEAN,    "enable/disable debugger" },
 	{ OPTION_UPDATEINPAUSE,                              "0",         OPTION_BOOLEAN,    "keep calling video updates while in pause" },
 	{ OPTION_DEBUGSCRIPT,                                nullptr,        OPTION_STRING,     "script for debugger" },
+	{ OPTION_MEMCOUNT,                                   "0",         OPTION_BOOLEAN,    "count memory accesses per handler and write them to memcount.log on exit" },
 
 	// comm options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE COMM OPTIONS" },
@@ -181,11 +189,13 @@ const options_entry emu_options::s_option_entries[] =
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE MISC OPTIONS" },
 	{ OPTION_DRC,                                        "1",         OPTION_BOOLEAN,    "enable DRC cpu core if available" },
 	{ OPTION_DRC_USE_C,                                  "0",         OPTION_BOOLEAN,    "force DRC use C backend" },
+	{ OPTION_DRC_C_THREADED,                             "1",         OPTION_BOOLEAN,    "use threaded code in the DRC C backend where supported" },
 	{ OPTION_DRC_LOG_UML,                                "0",         OPTION_BOOLEAN,    "write DRC UML disassembly log" },
 	{ OPTION_DRC_LOG_NATIVE,                             "0",         OPTION_BOOLEAN,    "write DRC native disassembly log" },
 	{ OPTION_BIOS,                                       nullptr,        OPTION_STRING,     "select the system BIOS to use" },
 	{ OPTION_CHEAT ";c",                                 "0",         OPTION_BOOLEAN,    "enable cheat subsystem" },
 	{ OPTION_SKIP_GAMEINFO,                              "0",         OPTION_BOOLEAN,    "skip displaying the information screen at startup" },
+	{ OPTION_HASH_CACHE,                                 nullptr,     OPTION_STRING,     "file used to remember media file hashes between runs" },
 	{ OPTION_UI_FONT,                                    "default",   OPTION_STRING,     "specify a font to use" },
 	{ OPTION_UI,                                         "cabinet",   OPTION_STRING,     "type of UI (simple|cabinet)" },
 	{ OPTION_RAMSIZE ";ram",                             nullptr,        OPTION_STRING,     "size of RAM (if supported by driver)" },
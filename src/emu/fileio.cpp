@@ -11,6 +11,7 @@
 #include "emu.h"
 #include "unzip.h"
 #include "fileio.h"
+#include "hashcache.h"
 
 
 const UINT32 OPEN_FLAG_HAS_CRC  = 0x10000;
@@ -243,6 +244,12 @@ util::hash_collection &emu_file::hashes(const char *types)
 	if (needed.empty())
 		return m_hashes;
 
+	// see if the persistent hash cache knows this file, before touching the data
+	hash_cache *const cache = ((m_openflags & (OPEN_FLAG_READ | OPEN_FLAG_WRITE)) == OPEN_FLAG_READ) ? hash_cache::active() : nullptr;
+	std::string const &cachepath = m_archive_path.empty() ? m_fullpath : m_archive_path;
+	if (cache && !cachepath.empty() && cache->find(cachepath, m_archive_member, types, m_hashes))
+		return m_hashes;
+
 	// load the ZIP file if needed
 	if (compressed_file_ready())
 		return m_hashes;
@@ -253,16 +260,21 @@ util::hash_collection &emu_file::hashes(const char *types)
 	if (!m_zipdata.empty())
 	{
 		m_hashes.compute(&m_zipdata[0], m_zipdata.size(), needed.c_str());
-		return m_hashes;
 	}
+	else
+	{
+		// read the data if we can
+		const UINT8 *filedata = (const UINT8 *)m_file->buffer();
+		if (filedata == nullptr)
+			return m_hashes;
 
-	// read the data if we can
-	const UINT8 *filedata = (const UINT8 *)m_file->buffer();
-	if (filedata == nullptr)
-		return m_hashes;
+		// compute the hash
+		m_hashes.compute(filedata, m_file->size(), needed.c_str());
+	}
 
-	// compute the hash
-	m_hashes.compute(filedata, m_file->size(), needed.c_str());
+	// remember it for next time
+	if (cache && !cachepath.empty())
+		cache->add(cachepath, m_archive_member, m_hashes);
 	return m_hashes;
 }
 
@@ -400,6 +412,8 @@ void emu_file::close()
 	// reset our hashes and path as well
 	m_hashes.reset();
 	m_fullpath.clear();
+	m_archive_path.clear();
+	m_archive_member.clear();
 }
 
 
@@ -703,6 +717,8 @@ osd_file::error emu_file::attempt_zipped()
 			// if we got it, read the data
 			if (header >= 0)
 			{
+				m_archive_path = m_fullpath + suffixes[i];
+				m_archive_member = zip->current_name();
 				m_zipfile = std::move(zip);
 				m_ziplength = m_zipfile->current_uncompressed_length();
 
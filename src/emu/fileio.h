@@ -167,6 +167,8 @@ private:
 	std::unique_ptr<util::archive_file> m_zipfile;  // ZIP file pointer
 	dynamic_buffer  m_zipdata;                      // ZIP file data
 	UINT64          m_ziplength;                    // ZIP file length
+	std::string     m_archive_path;                 // archive the file was found in
+	std::string     m_archive_member;               // name of the file within the archive
 
 	bool            m_remove_on_close;              // flag: remove the file when closing
 	bool            m_restrict_to_mediapath;        // flag: restrict to paths inside the media-path
@@ -0,0 +1,257 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    hashcache.cpp
+
+    Persistent cache of media file hashes.
+
+    The cache is a text file with one line per container followed by one
+    line per cached member:
+
+        C <size> <modified> <path>
+        M <hashes> <member>
+
+***************************************************************************/
+
+#include "emu.h"
+#include "hashcache.h"
+
+#include <cstdlib>
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+namespace {
+
+char const CACHE_HEADER[] = "# hash cache v1";
+
+} // anonymous namespace
+
+
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+hash_cache *hash_cache::s_active = nullptr;
+
+
+
+//**************************************************************************
+//  HASH CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  hash_cache - constructor; loads the cache and
+//  makes it the active one
+//-------------------------------------------------
+
+hash_cache::hash_cache(std::string const &filename)
+	: m_filename(filename)
+	, m_dirty(false)
+	, m_previous(s_active)
+{
+	load();
+	s_active = this;
+}
+
+
+//-------------------------------------------------
+//  ~hash_cache - destructor; writes back any
+//  changes
+//-------------------------------------------------
+
+hash_cache::~hash_cache()
+{
+	if (s_active == this)
+		s_active = m_previous;
+	if (m_dirty)
+		save();
+}
+
+
+//-------------------------------------------------
+//  validate - return the entry for a container if
+//  it still matches the file on disk
+//-------------------------------------------------
+
+hash_cache::container *hash_cache::validate(const std::string &path)
+{
+	auto const found = m_containers.find(path);
+	if (found == m_containers.end())
+		return nullptr;
+
+	// only hit the file system once per container and session
+	container &entry = found->second;
+	if (!entry.checked)
+	{
+		std::unique_ptr<osd::directory::entry> const stat = osd_stat(path);
+		if (!stat || (stat->type != osd::directory::entry::entry_type::FILE) ||
+				(stat->size != entry.size) ||
+				(stat->last_modified.time_since_epoch().count() != entry.modified))
+		{
+			m_containers.erase(found);
+			m_dirty = true;
+			return nullptr;
+		}
+		entry.checked = true;
+	}
+	return &entry;
+}
+
+
+//-------------------------------------------------
+//  find - retrieve cached hashes if all requested
+//  types are available
+//-------------------------------------------------
+
+bool hash_cache::find(const std::string &path, const std::string &member, const char *types, util::hash_collection &hashes)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	container *const entry = validate(path);
+	if (!entry)
+		return false;
+
+	auto const found = entry->members.find(member);
+	if (found == entry->members.end())
+		return false;
+
+	// make sure everything asked for is there
+	std::string const have = found->second.hash_types();
+	for (const char *scan = types; *scan != 0; scan++)
+		if (have.find_first_of(*scan) == std::string::npos)
+			return false;
+
+	hashes = found->second;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  add - remember the hashes of a container or a
+//  member of it
+//-------------------------------------------------
+
+void hash_cache::add(const std::string &path, const std::string &member, const util::hash_collection &hashes)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	container *entry = validate(path);
+	if (!entry)
+	{
+		std::unique_ptr<osd::directory::entry> const stat = osd_stat(path);
+		if (!stat || (stat->type != osd::directory::entry::entry_type::FILE))
+			return;
+
+		entry = &m_containers[path];
+		entry->size = stat->size;
+		entry->modified = stat->last_modified.time_since_epoch().count();
+		entry->checked = true;
+	}
+
+	entry->members[member] = hashes;
+	m_dirty = true;
+}
+
+
+//-------------------------------------------------
+//  clear - forget everything
+//-------------------------------------------------
+
+void hash_cache::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_dirty = m_dirty || !m_containers.empty();
+	m_containers.clear();
+}
+
+
+//-------------------------------------------------
+//  load - read the cache file; a missing or
+//  unrecognised file simply starts empty
+//-------------------------------------------------
+
+bool hash_cache::load()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_containers.clear();
+	m_dirty = false;
+
+	util::core_file::ptr file;
+	if (util::core_file::open(m_filename, OPEN_FLAG_READ, file) != osd_file::error::NONE)
+		return false;
+
+	char buffer[4096];
+	if (!file->gets(buffer, ARRAY_LENGTH(buffer)) || strncmp(buffer, CACHE_HEADER, ARRAY_LENGTH(CACHE_HEADER) - 1))
+		return false;
+
+	container *current = nullptr;
+	while (file->gets(buffer, ARRAY_LENGTH(buffer)))
+	{
+		// strip the line ending
+		std::string line(buffer);
+		while (!line.empty() && ((line.back() == '\n') || (line.back() == '\r')))
+			line.pop_back();
+
+		if ((line.length() > 2) && (line[0] == 'C') && (line[1] == ' '))
+		{
+			// container: size, modification time, path
+			char *end;
+			UINT64 const size = strtoull(&line[2], &end, 10);
+			INT64 const modified = strtoll(end, &end, 10);
+			if (*end != ' ')
+			{
+				current = nullptr;
+				continue;
+			}
+			current = &m_containers[end + 1];
+			current->size = size;
+			current->modified = modified;
+		}
+		else if (current && (line.length() > 2) && (line[0] == 'M') && (line[1] == ' '))
+		{
+			// member: hashes, name (empty for loose files)
+			auto const space = line.find(' ', 2);
+			std::string const hashes(line.substr(2, space - 2));
+			std::string const member((space != std::string::npos) ? line.substr(space + 1) : std::string());
+			if (!current->members[member].from_internal_string(hashes.c_str()))
+				current->members.erase(member);
+		}
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  save - write the cache file
+//-------------------------------------------------
+
+bool hash_cache::save()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	util::core_file::ptr file;
+	if (util::core_file::open(m_filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file) != osd_file::error::NONE)
+	{
+		osd_printf_warning("Unable to write hash cache %s\n", m_filename.c_str());
+		return false;
+	}
+
+	file->printf("%s\n", CACHE_HEADER);
+	for (auto const &entry : m_containers)
+	{
+		file->printf("C %u %d %s\n", entry.second.size, entry.second.modified, entry.first);
+		for (auto const &member : entry.second.members)
+		{
+			if (member.first.empty())
+				file->printf("M %s\n", member.second.internal_string());
+			else
+				file->printf("M %s %s\n", member.second.internal_string(), member.first);
+		}
+	}
+	m_dirty = false;
+	return true;
+}
@@ -0,0 +1,79 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    hashcache.h
+
+    Persistent cache of media file hashes.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef MAME_EMU_HASHCACHE_H
+#define MAME_EMU_HASHCACHE_H
+
+#include "hash.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> hash_cache
+
+// remembers the hashes of loose files and archive members between runs;
+// entries are keyed by container path and dropped as soon as the size or
+// modification time of the container no longer matches
+class hash_cache
+{
+public:
+	// construction/destruction
+	hash_cache(std::string const &filename);
+	~hash_cache();
+
+	// the cache consulted by emu_file, if any
+	static hash_cache *active() { return s_active; }
+
+	// getters
+	const std::string &filename() const { return m_filename; }
+	std::size_t containers() const { return m_containers.size(); }
+
+	// lookup/store; member is empty for loose files
+	bool find(const std::string &path, const std::string &member, const char *types, util::hash_collection &hashes);
+	void add(const std::string &path, const std::string &member, const util::hash_collection &hashes);
+
+	// persistence
+	void clear();
+	bool load();
+	bool save();
+
+private:
+	struct container
+	{
+		UINT64                                          size = 0;
+		INT64                                           modified = 0;
+		bool                                            checked = false;    // stamp compared against the file this session
+		std::map<std::string, util::hash_collection>    members;
+	};
+
+	// internal helpers
+	container *validate(const std::string &path);
+
+	// internal state
+	std::string                                     m_filename;
+	std::mutex                                      m_mutex;
+	std::unordered_map<std::string, container>      m_containers;
+	bool                                            m_dirty;
+	hash_cache *                                    m_previous;
+
+	static hash_cache *                             s_active;
+};
+
+
+#endif  // MAME_EMU_HASHCACHE_H
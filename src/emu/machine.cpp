@@ -124,6 +124,10 @@ running_machine::running_machine(const machine_config &_config, machine_manager
 		m_saveload_schedule(SLS_NONE),
 		m_saveload_schedule_time(attotime::zero),
 		m_saveload_searchpath(nullptr),
+		m_rewind_pending(0),
+		m_rewind_schedule_time(attotime::zero),
+		m_rewind_capture_pending(false),
+		m_bench_start_time(0),
 
 		m_save(*this),
 		m_memory(*this),
@@ -308,6 +312,10 @@ int running_machine::run(bool quiet)
 		// devices with timers.
 		m_save.allow_registration(false);
 
+		// keep in-memory snapshots for rewinding if requested
+		if (options().rewind())
+			m_save.enable_rewind(size_t(options().rewind_capacity()) << 20);
+
 		nvram_load();
 		sound().ui_mute(false);
 		if (!quiet)
@@ -324,6 +332,13 @@ int running_machine::run(bool quiet)
 		if (m_saveload_schedule != SLS_NONE)
 			handle_saveload();
 
+		// start gathering statistics for the benchmark report
+		if (*options().bench_report() != 0)
+		{
+			m_bench_start_time = osd_ticks();
+			g_profiler.enable(true);
+		}
+
 		// run the CPUs until a reset or exit
 		m_hard_reset_pending = false;
 		while ((!m_hard_reset_pending && !m_exit_pending) || m_saveload_schedule != SLS_NONE)
@@ -349,6 +364,10 @@ int running_machine::run(bool quiet)
 			if (m_saveload_schedule != SLS_NONE)
 				handle_saveload();
 
+			// handle rewind snapshots
+			if (m_rewind_pending != 0 || m_rewind_capture_pending)
+				handle_rewind();
+
 			g_profiler.stop();
 		}
 
@@ -397,6 +416,13 @@ int running_machine::run(bool quiet)
 	// in case we got here via exception
 	m_current_phase = MACHINE_PHASE_EXIT;
 
+	// report the results if we were benchmarking
+	if (*options().bench_report() != 0)
+	{
+		write_bench_report(error);
+		g_profiler.enable(false);
+	}
+
 	// call all exit callbacks registered
 	call_notifiers(MACHINE_NOTIFY_EXIT);
 	util::archive_file::cache_clear();
@@ -668,6 +694,37 @@ void running_machine::immediate_load(const char *filename)
 }
 
 
+//-------------------------------------------------
+//  schedule_rewind - schedule stepping back to
+//  an earlier in-memory snapshot; 1 is the most
+//  recent one
+//-------------------------------------------------
+
+void running_machine::schedule_rewind(int count)
+{
+	m_rewind_pending = count;
+	m_rewind_schedule_time = this->time();
+
+	// we can't be paused since we need to clear out anonymous timers
+	resume();
+}
+
+
+//-------------------------------------------------
+//  immediate_rewind - step back to an earlier
+//  in-memory snapshot right away
+//-------------------------------------------------
+
+void running_machine::immediate_rewind(int count)
+{
+	m_rewind_pending = count;
+	m_rewind_schedule_time = this->time();
+
+	// jump right into the rewind, anonymous timers can't hurt us
+	handle_rewind();
+}
+
+
 //-------------------------------------------------
 //  pause - pause the system
 //-------------------------------------------------
@@ -904,6 +961,51 @@ void running_machine::handle_saveload()
 }
 
 
+//-------------------------------------------------
+//  handle_rewind - take or restore an in-memory
+//  snapshot once it is safe to do so
+//-------------------------------------------------
+
+void running_machine::handle_rewind()
+{
+	state_rewinder *const rewinder = m_save.rewinder();
+	if (rewinder == nullptr)
+	{
+		if (m_rewind_pending != 0)
+			popmessage("Error: Rewind is not enabled.");
+		m_rewind_pending = 0;
+		m_rewind_capture_pending = false;
+		return;
+	}
+
+	// like save states, snapshots can't be taken or restored with anonymous timers outstanding
+	if (!m_scheduler.can_save())
+	{
+		if (m_rewind_pending == 0 || (this->time() - m_rewind_schedule_time) <= attotime::from_seconds(1))
+			return; // try again after the next timeslice
+		popmessage("Unable to rewind due to pending anonymous timers. See error.log for details.");
+	}
+
+	// restoring takes precedence over capturing the current frame
+	else if (m_rewind_pending != 0)
+	{
+		int const available = rewinder->count();
+		if (rewinder->restore(m_rewind_pending) == STATERR_NONE)
+			popmessage("Rewound to %s (%d of %d snapshots).", rewinder->snapshot_time(1).as_string(3), m_rewind_pending, available);
+		else
+			popmessage("Error: Unable to rewind %d snapshots; only %d available.", m_rewind_pending, available);
+	}
+	else if (rewinder->capture(this->time()) != STATERR_NONE)
+	{
+		popmessage("Error: Unable to capture rewind snapshot. See error.log for details.");
+		m_save.enable_rewind(0);
+	}
+
+	m_rewind_pending = 0;
+	m_rewind_capture_pending = false;
+}
+
+
 //-------------------------------------------------
 //  soft_reset - actually perform a soft-reset
 //  of the system
@@ -1117,6 +1219,101 @@ void running_machine::nvram_save()
 }
 
 
+/*-------------------------------------------------
+    json_string - quote a string for the
+    benchmark report
+-------------------------------------------------*/
+
+static std::string json_string(const char *string)
+{
+	std::string result("\"");
+	for ( ; *string != 0; string++)
+	{
+		if (*string == '"' || *string == '\\')
+			result.append(1, '\\').append(1, *string);
+		else if (UINT8(*string) < 0x20)
+			result.append(string_format("\\u%04x", UINT8(*string)));
+		else
+			result.append(1, *string);
+	}
+	return result.append("\"");
+}
+
+
+/*-------------------------------------------------
+    write_bench_report - append a line of JSON
+    describing this run to the benchmark report
+-------------------------------------------------*/
+
+void running_machine::write_bench_report(int error)
+{
+	// prefer the speed measured by the video system, which skips the first few
+	// periods; fall back to the raw times for very short runs
+	double emutime = 0, realtime = 0;
+	if (m_video != nullptr && m_video->overall_emutime() != attotime::zero)
+	{
+		emutime = m_video->overall_emutime().as_double();
+		realtime = m_video->overall_realtime();
+	}
+	else if (m_bench_start_time != 0)
+	{
+		emutime = time().as_double();
+		realtime = double(osd_ticks() - m_bench_start_time) / double(osd_ticks_per_second());
+	}
+
+	std::ostringstream report;
+	util::stream_format(report, "{\"system\":%s,\"source\":%s,\"error\":%d",
+			json_string(system().name), json_string(core_filename_extract_base(system().source_file).c_str()), error);
+	util::stream_format(report, ",\"emulated_seconds\":%.6f,\"real_seconds\":%.6f,\"speed_ratio\":%.6f",
+			emutime, realtime, (realtime > 0) ? emutime / realtime : 0.0);
+
+	// the profiler only gathers timing and event counts when it is compiled in; its
+	// ticks run at an arbitrary rate, so scale each device's share by the wall time
+	bool profiled = g_profiler.enabled();
+	UINT64 totalticks = 0;
+	for (profile_type type = PROFILER_DEVICE_FIRST; type < PROFILER_TOTAL; ++type)
+		totalticks += g_profiler.ticks(type);
+	double wallclock = (m_bench_start_time != 0) ? double(osd_ticks() - m_bench_start_time) / double(osd_ticks_per_second()) : 0;
+	util::stream_format(report, ",\"profiler\":%s,\"devices\":[", profiled ? "true" : "false");
+
+	// devices are only worth reporting if we made it as far as running them
+	device_iterator iter(root_device());
+	bool first = true;
+	if (m_bench_start_time != 0)
+	{
+		for (device_execute_interface &exec : execute_interface_iterator(root_device()))
+		{
+			util::stream_format(report, "%s{\"tag\":%s,\"type\":%s,\"cycles\":%d", first ? "" : ",",
+					json_string(exec.device().tag()), json_string(exec.device().shortname()), exec.total_cycles());
+			int index = iter.indexof(exec.device());
+			if (profiled && totalticks != 0 && index >= 0 && index < PROFILER_DEVICE_MAX - PROFILER_DEVICE_FIRST)
+			{
+				double share = double(g_profiler.ticks(profile_type(PROFILER_DEVICE_FIRST + index))) / double(totalticks);
+				util::stream_format(report, ",\"execute_share\":%.6f,\"execute_seconds\":%.6f", share, share * wallclock);
+			}
+			report << '}';
+			first = false;
+		}
+	}
+	report << ']';
+
+	if (profiled)
+		util::stream_format(report, ",\"memory_reads\":%d,\"memory_writes\":%d,\"timer_callbacks\":%d",
+				g_profiler.counter(PROFILER_COUNT_MEMORY_READ), g_profiler.counter(PROFILER_COUNT_MEMORY_WRITE), g_profiler.counter(PROFILER_COUNT_TIMER_CALLBACK));
+	util::stream_format(report, ",\"peak_rss\":%d}\n", osd_get_peak_memory());
+
+	// one line per system, so that a whole batch can be appended to the same file
+	FILE *file = fopen(options().bench_report(), "a");
+	if (file == nullptr)
+	{
+		osd_printf_error("Unable to open benchmark report '%s'\n", options().bench_report());
+		return;
+	}
+	fputs(report.str().c_str(), file);
+	fclose(file);
+}
+
+
 //**************************************************************************
 //  OUTPUT
 //**************************************************************************
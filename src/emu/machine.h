@@ -215,6 +215,7 @@ public:
 	// TODO: Do saves and loads still require scheduling?
 	void immediate_save(const char *filename);
 	void immediate_load(const char *filename);
+	void immediate_rewind(int count);
 
 	// scheduled operations
 	void schedule_exit();
@@ -222,6 +223,8 @@ public:
 	void schedule_soft_reset();
 	void schedule_save(const char *filename);
 	void schedule_load(const char *filename);
+	void schedule_rewind(int count);
+	void schedule_rewind_capture() { m_rewind_capture_pending = true; }
 
 	// date & time
 	void base_datetime(system_time &systime);
@@ -255,10 +258,12 @@ private:
 	void set_saveload_filename(const char *filename);
 	std::string get_statename(const char *statename_opt) const;
 	void handle_saveload();
+	void handle_rewind();
 	void soft_reset(void *ptr = nullptr, INT32 param = 0);
 	std::string nvram_filename(device_t &device) const;
 	void nvram_load();
 	void nvram_save();
+	void write_bench_report(int error);
 	void popup_clear() const;
 	void popup_message(util::format_argument_pack<std::ostream> const &args) const;
 
@@ -322,6 +327,14 @@ private:
 	std::string             m_saveload_pending_file;
 	const char *            m_saveload_searchpath;
 
+	// rewind management
+	int                     m_rewind_pending;       // number of snapshots to step back, or 0
+	attotime                m_rewind_schedule_time;
+	bool                    m_rewind_capture_pending; // take a snapshot at the end of this timeslice
+
+	// benchmark reporting
+	osd_ticks_t             m_bench_start_time;     // real time when benchmarking started
+
 	// notifier callbacks
 	struct notifier_callback_item
 	{
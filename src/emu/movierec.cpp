@@ -0,0 +1,151 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    movierec.cpp
+
+    Asynchronous movie frame encoding and writing.
+
+***************************************************************************/
+
+#include "emu.h"
+
+
+//**************************************************************************
+//  MOVIE RECORDER
+//**************************************************************************
+
+//-------------------------------------------------
+//  movie_recorder - constructor
+//-------------------------------------------------
+
+movie_recorder::movie_recorder(encode_func &&encode, write_func &&write, int depth)
+	: m_encode(std::move(encode))
+	, m_write(std::move(write))
+	, m_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI))
+	, m_slots(depth)
+	, m_captured(0)
+	, m_written(0)
+	, m_failed(false)
+{
+	for (frame_slot &slot : m_slots)
+	{
+		slot.owner = this;
+		slot.frame = 0;
+		slot.encoded = false;
+		slot.ready = false;
+		slot.item = nullptr;
+	}
+}
+
+
+//-------------------------------------------------
+//  ~movie_recorder - destructor; finishes writing
+//  everything that was captured
+//-------------------------------------------------
+
+movie_recorder::~movie_recorder()
+{
+	flush();
+	if (m_queue != nullptr)
+		osd_work_queue_free(m_queue);
+}
+
+
+//-------------------------------------------------
+//  add_frame - capture a frame; returns false once
+//  encoding or writing has failed
+//-------------------------------------------------
+
+bool movie_recorder::add_frame(const bitmap_rgb32 &bitmap)
+{
+	if (m_failed)
+		return false;
+
+	// reuse the oldest slot; everything before it has been waited for already,
+	// so once its own work is done the frame is guaranteed to be on disk
+	frame_slot &slot = m_slots[m_captured % m_slots.size()];
+	wait_slot(slot);
+	if (m_failed)
+		return false;
+
+	// copy the frame so the caller can carry on drawing into its bitmap
+	if (slot.bitmap.width() != bitmap.width() || slot.bitmap.height() != bitmap.height())
+		slot.bitmap.allocate(bitmap.width(), bitmap.height());
+	for (int y = 0; y < bitmap.height(); y++)
+		memcpy(&slot.bitmap.pix32(y), &bitmap.pix32(y), bitmap.width() * sizeof(UINT32));
+
+	{
+		// writers may be looking at this slot to see whether it is next in line
+		std::lock_guard<std::mutex> lock(m_write_lock);
+		slot.frame = m_captured++;
+		slot.encoded = false;
+		slot.ready = false;
+	}
+	slot.item = (m_queue != nullptr) ? osd_work_item_queue(m_queue, process_frame, &slot, 0) : nullptr;
+	if (slot.item == nullptr)
+		process_frame(&slot, 0);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  flush - wait until every captured frame has
+//  been written
+//-------------------------------------------------
+
+void movie_recorder::flush()
+{
+	// oldest first, so each wait also covers the writes of the frames before it
+	for (UINT32 index = 0; index < m_slots.size(); index++)
+		wait_slot(m_slots[(m_captured + index) % m_slots.size()]);
+}
+
+
+//-------------------------------------------------
+//  wait_slot - wait for the work on a slot to
+//  finish and release it
+//-------------------------------------------------
+
+void movie_recorder::wait_slot(frame_slot &slot)
+{
+	if (slot.item == nullptr)
+		return;
+
+	while (!osd_work_item_wait(slot.item, osd_ticks_per_second()))
+	{
+	}
+	osd_work_item_release(slot.item);
+	slot.item = nullptr;
+}
+
+
+//-------------------------------------------------
+//  process_frame - encode a frame, then write
+//  every frame that is next in line
+//-------------------------------------------------
+
+void *movie_recorder::process_frame(void *param, int threadid)
+{
+	frame_slot &slot = *reinterpret_cast<frame_slot *>(param);
+	movie_recorder &owner = *slot.owner;
+
+	if (!owner.m_failed)
+		slot.encoded = !owner.m_encode || owner.m_encode(slot.bitmap, slot.data);
+
+	// whoever completes the run of frames up to the next one to write does the writing
+	std::lock_guard<std::mutex> lock(owner.m_write_lock);
+	slot.ready = true;
+	for (;;)
+	{
+		frame_slot &next = owner.m_slots[owner.m_written % owner.m_slots.size()];
+		if (!next.ready || next.frame != owner.m_written)
+			break;
+
+		if (!owner.m_failed && (!next.encoded || !owner.m_write(next.bitmap, next.data, next.frame)))
+			owner.m_failed = true;
+		next.ready = false;
+		owner.m_written++;
+	}
+	return nullptr;
+}
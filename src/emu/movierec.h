@@ -0,0 +1,87 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    movierec.h
+
+    Asynchronous movie frame encoding and writing.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __EMU_H__
+#error Dont include this file directly; include emu.h instead.
+#endif
+
+#ifndef MAME_EMU_MOVIEREC_H
+#define MAME_EMU_MOVIEREC_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> movie_recorder
+
+// takes captured frames off the emulation thread: each frame is copied into
+// one of a fixed number of slots, encoded on the work queue and written in
+// capture order; capturing only blocks once every slot is still in flight
+class movie_recorder
+{
+public:
+	// encoders may run concurrently; writers run one frame at a time, in order
+	typedef std::function<bool (const bitmap_rgb32 &bitmap, std::vector<UINT8> &data)> encode_func;
+	typedef std::function<bool (bitmap_rgb32 &bitmap, const std::vector<UINT8> &data, UINT32 frame)> write_func;
+
+	static constexpr int DEFAULT_DEPTH = 8;
+
+	// construction/destruction
+	movie_recorder(encode_func &&encode, write_func &&write, int depth = DEFAULT_DEPTH);
+	~movie_recorder();
+
+	// getters
+	bool failed() const { return m_failed; }
+	UINT32 frames() const { return m_captured; }
+
+	// held while writing frames; take it to write anything else to the same file
+	std::mutex &write_lock() { return m_write_lock; }
+
+	// operations
+	bool add_frame(const bitmap_rgb32 &bitmap);
+	void flush();
+
+private:
+	struct frame_slot
+	{
+		movie_recorder *    owner;
+		UINT32              frame;
+		bitmap_rgb32        bitmap;
+		std::vector<UINT8>  data;
+		bool                encoded;
+		bool                ready;
+		osd_work_item *     item;
+	};
+
+	// internal helpers
+	static void *process_frame(void *param, int threadid);
+	static void wait_slot(frame_slot &slot);
+
+	// internal state
+	encode_func                 m_encode;
+	write_func                  m_write;
+	osd_work_queue *            m_queue;
+	std::vector<frame_slot>     m_slots;
+	UINT32                      m_captured;         // frames handed to us (emulation thread only)
+	UINT32                      m_written;          // frames written (under the write lock)
+	std::mutex                  m_write_lock;
+	std::atomic<bool>           m_failed;
+};
+
+
+#endif  // MAME_EMU_MOVIEREC_H
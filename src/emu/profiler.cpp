@@ -80,6 +80,7 @@ real_profiler_state::real_profiler_state()
 {
 	memset(m_filo, 0, sizeof(m_filo));
 	memset(m_data, 0, sizeof(m_data));
+	memset(m_counts, 0, sizeof(m_counts));
 	reset(false);
 }
 
@@ -95,8 +96,10 @@ void real_profiler_state::reset(bool enabled)
 
 	if (enabled)
 	{
-		// we're enabled now
+		// we're enabled now; discard anything left over from the last time
 		m_filoptr = m_filo;
+		memset(m_data, 0, sizeof(m_data));
+		memset(m_counts, 0, sizeof(m_counts));
 
 		// set up dummy entry
 		m_filoptr->start = 0;
@@ -171,6 +174,14 @@ void real_profiler_state::update_text(running_machine &machine)
 		{ PROFILER_PROFILER,         "Profiler" },
 		{ PROFILER_IDLE,             "Idle" }
 	};
+	static const profile_string count_names[] =
+	{
+		{ PROFILER_COUNT_TIMER_INSERT, "Timer Queue Inserts" },
+		{ PROFILER_COUNT_TIMER_REMOVE, "Timer Queue Removes" },
+		{ PROFILER_COUNT_TIMER_CALLBACK, "Timer Callbacks" },
+		{ PROFILER_COUNT_MEMORY_READ, "Memory Reads" },
+		{ PROFILER_COUNT_MEMORY_WRITE, "Memory Writes" }
+	};
 
 	// compute the total time for all bits, not including profiler or idle
 	UINT64 computed = 0;
@@ -224,6 +235,12 @@ void real_profiler_state::update_text(running_machine &machine)
 		}
 	}
 
+	// followed by any event counts for the same period
+	for (auto & name : count_names)
+		if (m_counts[name.type] != 0)
+			m_text.append(string_format("%d %s\n", m_counts[name.type], name.string));
+
 	// reset data set to 0
 	memset(m_data, 0, sizeof(m_data));
+	memset(m_counts, 0, sizeof(m_counts));
 }
@@ -74,6 +74,19 @@ enum profile_type
 DECLARE_ENUM_OPERATORS(profile_type)
 
 
+// event counters, reported alongside the timing data
+enum profile_count
+{
+	PROFILER_COUNT_TIMER_INSERT,    // timer queue insertions
+	PROFILER_COUNT_TIMER_REMOVE,    // timer queue removals
+	PROFILER_COUNT_TIMER_CALLBACK,  // timer callbacks fired
+	PROFILER_COUNT_MEMORY_READ,     // native-width memory reads
+	PROFILER_COUNT_MEMORY_WRITE,    // native-width memory writes
+	PROFILER_COUNT_TOTAL
+};
+DECLARE_ENUM_OPERATORS(profile_count)
+
+
 
 //**************************************************************************
 //  TYPE DEFINITIONS
@@ -94,6 +107,8 @@ public:
 		return m_filoptr != nullptr;
 	}
 	const char *text(running_machine &machine);
+	osd_ticks_t ticks(profile_type type) const { return m_data[type]; }
+	UINT64 counter(profile_count type) const { return m_counts[type]; }
 
 	// enable/disable
 	void enable(bool state = true)
@@ -108,6 +123,9 @@ public:
 	void start(profile_type type) { if (enabled()) real_start(type); }
 	void stop() { if (enabled()) real_stop(); }
 
+	// event counting
+	void count(profile_count type, UINT64 delta = 1) { if (enabled()) m_counts[type] += delta; }
+
 private:
 	void reset(bool enabled);
 	void update_text(running_machine &machine);
@@ -171,6 +189,7 @@ private:
 	attotime            m_text_time;                // profiler text last update
 	filo_entry          m_filo[32];                 // array of FILO entries
 	osd_ticks_t         m_data[PROFILER_TOTAL + 1]; // array of data
+	UINT64              m_counts[PROFILER_COUNT_TOTAL]; // array of event counts
 };
 
 
@@ -185,6 +204,8 @@ public:
 	// getters
 	bool enabled() const { return false; }
 	const char *text(running_machine &machine) { return ""; }
+	osd_ticks_t ticks(profile_type type) const { return 0; }
+	UINT64 counter(profile_count type) const { return 0; }
 
 	// enable/disable
 	void enable(bool state = true) { }
@@ -192,6 +213,9 @@ public:
 	// start/stop
 	void start(profile_type type) { }
 	void stop() { }
+
+	// event counting
+	void count(profile_count type, UINT64 delta = 1) { }
 };
 
 
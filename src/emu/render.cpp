@@ -219,6 +219,8 @@ void render_primitive::reset()
 //-------------------------------------------------
 
 render_primitive_list::render_primitive_list()
+	: m_serial(0),
+		m_fulldamage(true)
 {
 }
 
@@ -288,6 +290,10 @@ void render_primitive_list::release_all()
 	// release all the live items while under the lock
 	m_primitive_allocator.reclaim_all(m_primlist);
 	m_reference_allocator.reclaim_all(m_reflist);
+
+	// whatever was there before is no longer described by our damage
+	m_fulldamage = true;
+	m_damage.clear();
 }
 
 
@@ -323,9 +329,12 @@ render_texture::render_texture()
 		m_osddata(~0L),
 		m_scaler(nullptr),
 		m_param(nullptr),
-		m_curseq(0)
+		m_curseq(0),
+		m_contentid(0),
+		m_damagebase(0)
 {
 	m_sbounds.set(0, -1, 0, -1);
+	m_damage.set(0, -1, 0, -1);
 	memset(m_scaled, 0, sizeof(m_scaled));
 }
 
@@ -355,6 +364,8 @@ void render_texture::reset(render_manager &manager, texture_scaler_func scaler,
 		m_param = param;
 	}
 	m_osddata = ~0L;
+	m_contentid = manager.next_content_id();
+	m_damagebase = 0;
 }
 
 
@@ -379,6 +390,8 @@ void render_texture::release()
 	m_sbounds.set(0, -1, 0, -1);
 	m_format = TEXFORMAT_ARGB32;
 	m_curseq = 0;
+	m_contentid = 0;
+	m_damagebase = 0;
 }
 
 
@@ -403,6 +416,10 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 	m_sbounds = sbounds;
 	m_format = format;
 
+	// as far as anyone knows, everything has changed
+	m_contentid = m_manager->next_content_id();
+	m_damagebase = 0;
+
 	// invalidate all scaled versions
 	for (auto & elem : m_scaled)
 	{
@@ -417,6 +434,57 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 }
 
 
+//-------------------------------------------------
+//  set_damage - declare that our contents only
+//  differ from the current contents of another
+//  texture within the given area; call after
+//  set_bitmap
+//-------------------------------------------------
+
+void render_texture::set_damage(const render_texture &previous, const rectangle &damage)
+{
+	// this only means something if both cover the same area in the same format
+	if (previous.m_contentid == 0 || previous.m_sbounds != m_sbounds || previous.m_format != m_format || m_scaler != nullptr)
+	{
+		m_damagebase = 0;
+		return;
+	}
+
+	m_damagebase = previous.m_contentid;
+	m_damage = damage;
+	m_damage &= m_sbounds;
+}
+
+
+//-------------------------------------------------
+//  get_damage - if our contents are known to
+//  differ from the given contents only within an
+//  area, return it in texture coordinates
+//-------------------------------------------------
+
+bool render_texture::get_damage(UINT32 contentid, render_bounds &bounds) const
+{
+	if (m_damagebase == 0 || contentid != m_damagebase)
+		return false;
+
+	// nothing at all changed
+	if (m_damage.empty())
+	{
+		bounds.x0 = bounds.y0 = bounds.x1 = bounds.y1 = 0.0f;
+		return true;
+	}
+
+	// widen by a texel on each side to allow for filtering
+	float width = float(m_sbounds.width());
+	float height = float(m_sbounds.height());
+	bounds.x0 = std::max(0.0f, float(m_damage.min_x - m_sbounds.min_x - 1) / width);
+	bounds.y0 = std::max(0.0f, float(m_damage.min_y - m_sbounds.min_y - 1) / height);
+	bounds.x1 = std::min(1.0f, float(m_damage.max_x - m_sbounds.min_x + 2) / width);
+	bounds.y1 = std::min(1.0f, float(m_damage.max_y - m_sbounds.min_y + 2) / height);
+	return true;
+}
+
+
 //-------------------------------------------------
 //  hq_scale - generic high quality resampling
 //  scaler
@@ -459,6 +527,7 @@ void render_texture::get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &t
 		texinfo.height = sheight;
 		// palette will be set later
 		texinfo.seqid = ++m_curseq;
+		texinfo.source = this;
 	}
 	else
 	{
@@ -513,6 +582,7 @@ void render_texture::get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &t
 		texinfo.height = dheight;
 		// palette will be set later
 		texinfo.seqid = scaled->seqid;
+		texinfo.source = this;
 	}
 }
 
@@ -566,7 +636,8 @@ render_container::render_container(render_manager &manager, screen_device *scree
 		m_manager(manager),
 		m_screen(screen),
 		m_overlaybitmap(nullptr),
-		m_overlaytexture(nullptr)
+		m_overlaytexture(nullptr),
+		m_lookupserial(0)
 {
 	// make sure it is empty
 	empty();
@@ -797,6 +868,9 @@ render_container::item &render_container::add_generic(UINT8 type, float x0, floa
 
 void render_container::recompute_lookups()
 {
+	// anything drawn through the old tables needs redrawing
+	m_lookupserial++;
+
 	// recompute the 256 entry lookup table
 	for (int i = 0; i < 0x100; i++)
 	{
@@ -849,6 +923,7 @@ void render_container::update_palette()
 	// iterate over dirty items and update them
 	if (dirty != nullptr)
 	{
+		m_lookupserial++;
 		palette_t &palette = m_palclient->palette();
 		const rgb_t *adjusted_palette = palette.entry_list_adjusted();
 
@@ -920,6 +995,10 @@ render_target::render_target(render_manager &manager, const internal_layout *lay
 		m_base_orientation(ROT0),
 		m_maxtexwidth(65536),
 		m_maxtexheight(65536),
+		m_damage_serial(0),
+		m_damage_width(0),
+		m_damage_height(0),
+		m_track_damage(false),
 		m_transform_container(true)
 {
 	// determine the base layer configuration based on options
@@ -1438,6 +1517,9 @@ render_primitive_list &render_target::get_primitives()
 
 	// optimize the list before handing it off
 	add_clear_and_optimize_primitive_list(list);
+
+	// work out what changed since the last list
+	compute_damage(list);
 	list.release_lock();
 	return list;
 }
@@ -1483,7 +1565,12 @@ void render_target::invalidate_all(void *refptr)
 		// if we have a reference to this object, release our list
 		list.acquire_lock();
 		if (list.has_reference(refptr))
+		{
 			list.release_all();
+
+			// the next list can't be described relative to one that was never drawn
+			m_damage_width = 0;
+		}
 		list.release_lock();
 	}
 }
@@ -2578,6 +2665,199 @@ done:
 }
 
 
+//-------------------------------------------------
+//  compute_damage - compare a freshly built list
+//  against the previous one and record where
+//  they differ
+//-------------------------------------------------
+
+void render_target::compute_damage(render_primitive_list &list)
+{
+	list.m_serial = ++m_damage_serial;
+	list.m_damage.clear();
+
+	// nobody draws partial updates from this target, so don't bother comparing
+	if (!m_track_damage)
+	{
+		list.m_fulldamage = true;
+		m_damage_width = 0;
+		m_damage_states.clear();
+		return;
+	}
+
+	// a new size or a list that was thrown away means starting over
+	list.m_fulldamage = (m_width != m_damage_width || m_height != m_damage_height);
+	m_damage_width = m_width;
+	m_damage_height = m_height;
+
+	// walk the new primitives alongside the old ones
+	size_t index = 0;
+	for (const render_primitive &prim : list)
+	{
+		primitive_state state;
+		state.type = prim.type;
+		state.bounds = prim.bounds;
+		state.color = prim.color;
+		state.flags = prim.flags;
+		state.width = prim.width;
+		state.texcoords = prim.texcoords;
+		state.texwidth = prim.texture.width;
+		state.texheight = prim.texture.height;
+		state.palette = prim.texture.palette;
+		state.contentid = (prim.texture.source != nullptr) ? prim.texture.source->content_id() : 0;
+		state.lookupserial = (prim.texture.palette != nullptr && prim.container != nullptr) ? prim.container->lookup_serial() : 0;
+
+		if (!list.m_fulldamage)
+		{
+			if (index >= m_damage_states.size())
+				add_primitive_damage(list, state);
+			else
+			{
+				const primitive_state &last = m_damage_states[index];
+				render_bounds texdamage;
+
+				// anything that moved or changed appearance damages both its old and new areas
+				if (state.type != last.type || state.flags != last.flags || state.width != last.width ||
+					memcmp(&state.bounds, &last.bounds, sizeof(state.bounds)) != 0 ||
+					memcmp(&state.color, &last.color, sizeof(state.color)) != 0 ||
+					memcmp(&state.texcoords, &last.texcoords, sizeof(state.texcoords)) != 0 ||
+					state.texwidth != last.texwidth || state.texheight != last.texheight ||
+					state.palette != last.palette || state.lookupserial != last.lookupserial)
+				{
+					add_primitive_damage(list, last);
+					add_primitive_damage(list, state);
+				}
+
+				// vector buffers and textures we can't identify are redrawn every time
+				else if (PRIMFLAG_GET_VECTORBUF(state.flags) || (prim.texture.base != nullptr && state.contentid == 0))
+					add_primitive_damage(list, state);
+
+				// new texture contents damage whatever part of them changed, if we know
+				else if (state.contentid != last.contentid)
+				{
+					if (!prim.texture.source->get_damage(last.contentid, texdamage))
+						add_primitive_damage(list, state);
+					else if (texdamage.x0 < texdamage.x1 && texdamage.y0 < texdamage.y1)
+					{
+						// map the damaged texture area back through the texture coordinates
+						const render_quad_texuv &uv = state.texcoords;
+						float dus = uv.tr.u - uv.tl.u, dut = uv.bl.u - uv.tl.u;
+						float dvs = uv.tr.v - uv.tl.v, dvt = uv.bl.v - uv.tl.v;
+						float det = dus * dvt - dut * dvs;
+						if (fabsf(det) < 1e-6f)
+							add_primitive_damage(list, state);
+						else
+						{
+							float smin = 1.0f, smax = 0.0f, tmin = 1.0f, tmax = 0.0f;
+							for (int corner = 0; corner < 4; corner++)
+							{
+								float du = ((corner & 1) ? texdamage.x1 : texdamage.x0) - uv.tl.u;
+								float dv = ((corner & 2) ? texdamage.y1 : texdamage.y0) - uv.tl.v;
+								float s = (du * dvt - dut * dv) / det;
+								float t = (dus * dv - du * dvs) / det;
+								smin = std::min(smin, s);
+								smax = std::max(smax, s);
+								tmin = std::min(tmin, t);
+								tmax = std::max(tmax, t);
+							}
+							smin = std::max(smin, 0.0f);
+							tmin = std::max(tmin, 0.0f);
+							smax = std::min(smax, 1.0f);
+							tmax = std::min(tmax, 1.0f);
+							float width = state.bounds.x1 - state.bounds.x0;
+							float height = state.bounds.y1 - state.bounds.y0;
+							if (smin <= smax && tmin <= tmax)
+								add_damage(list, state.bounds.x0 + smin * width, state.bounds.y0 + tmin * height, state.bounds.x0 + smax * width, state.bounds.y0 + tmax * height);
+						}
+					}
+				}
+			}
+		}
+
+		// remember this one for next time
+		if (index < m_damage_states.size())
+			m_damage_states[index] = state;
+		else
+			m_damage_states.push_back(state);
+		index++;
+	}
+
+	// anything that went away damages where it used to be
+	if (!list.m_fulldamage)
+		for (size_t old = index; old < m_damage_states.size(); old++)
+			add_primitive_damage(list, m_damage_states[old]);
+	m_damage_states.resize(index);
+}
+
+
+//-------------------------------------------------
+//  add_primitive_damage - damage everything a
+//  primitive could have touched
+//-------------------------------------------------
+
+void render_target::add_primitive_damage(render_primitive_list &list, const primitive_state &state)
+{
+	float x0 = std::min(state.bounds.x0, state.bounds.x1);
+	float y0 = std::min(state.bounds.y0, state.bounds.y1);
+	float x1 = std::max(state.bounds.x0, state.bounds.x1);
+	float y1 = std::max(state.bounds.y0, state.bounds.y1);
+
+	// lines can be antialiased and have a width
+	if (state.type == render_primitive::LINE)
+	{
+		float margin = 2.0f * std::max(state.width, 1.0f) + 2.0f;
+		x0 -= margin;
+		y0 -= margin;
+		x1 += margin;
+		y1 += margin;
+	}
+	add_damage(list, x0, y0, x1, y1);
+}
+
+
+//-------------------------------------------------
+//  add_damage - add an area to a list's damage,
+//  merging it with anything it touches
+//-------------------------------------------------
+
+void render_target::add_damage(render_primitive_list &list, float x0, float y0, float x1, float y1)
+{
+	// round outwards by a pixel and clip to the target
+	x0 = std::max(x0 - 1.0f, 0.0f);
+	y0 = std::max(y0 - 1.0f, 0.0f);
+	x1 = std::min(x1 + 1.0f, float(m_width - 1));
+	y1 = std::min(y1 + 1.0f, float(m_height - 1));
+	if (!(x0 <= x1 && y0 <= y1))
+		return;
+	rectangle rect(INT32(floorf(x0)), INT32(ceilf(x1)), INT32(floorf(y0)), INT32(ceilf(y1)));
+
+	// fold in every existing rectangle that overlaps or touches this one
+	std::vector<rectangle> &damage = list.m_damage;
+	for (size_t index = 0; index < damage.size(); )
+	{
+		const rectangle &other = damage[index];
+		if (other.min_x <= rect.max_x + 1 && other.max_x + 1 >= rect.min_x && other.min_y <= rect.max_y + 1 && other.max_y + 1 >= rect.min_y)
+		{
+			rect |= other;
+			damage.erase(damage.begin() + index);
+			index = 0;
+		}
+		else
+			index++;
+	}
+	damage.push_back(rect);
+
+	// too many pieces; settle for their bounding box
+	if (damage.size() > MAX_DAMAGE_RECTS)
+	{
+		for (const rectangle &other : damage)
+			rect |= other;
+		damage.clear();
+		damage.push_back(rect);
+	}
+}
+
+
 
 //**************************************************************************
 //  CORE IMPLEMENTATION
@@ -2591,6 +2871,7 @@ render_manager::render_manager(running_machine &machine)
 	: m_machine(machine),
 		m_ui_target(nullptr),
 		m_live_textures(0),
+		m_last_contentid(0),
 		m_ui_container(global_alloc(render_container(*this)))
 {
 	// register callbacks
@@ -2631,6 +2912,21 @@ bool render_manager::is_live(screen_device &screen) const
 }
 
 
+//-------------------------------------------------
+//  tracks_damage - return true if any target's
+//  renderer uses damage, so producers should
+//  work out what changed
+//-------------------------------------------------
+
+bool render_manager::tracks_damage() const
+{
+	for (render_target &target : m_targetlist)
+		if (target.track_damage())
+			return true;
+	return false;
+}
+
+
 //-------------------------------------------------
 //  max_update_rate - return the smallest maximum
 //  update rate across all targets
@@ -226,6 +226,7 @@ struct render_texinfo
 	UINT32              seqid;              // sequence ID
 	UINT64              osddata;            // aux data to pass to osd
 	const rgb_t *       palette;            // palette for PALETTE16 textures, bcg lookup table for RGB32/YUY16
+	render_texture *    source;             // texture the data came from (for damage tracking)
 };
 
 
@@ -393,6 +394,13 @@ public:
 	void add_reference(void *refptr);
 	bool has_reference(void *refptr) const;
 
+	// damage tracking; rectangles are in target pixels and cover everything that
+	// differs from the previous list built for the same target
+	UINT32 serial() const { return m_serial; }
+	bool fully_damaged() const { return m_fulldamage; }
+	const std::vector<rectangle> &damage() const { return m_damage; }
+	bool damage_valid_since(UINT32 serial) const { return !m_fulldamage && serial + 1 == m_serial; }
+
 private:
 	// helpers for our friends to manipulate the list
 	render_primitive *alloc(render_primitive::primitive_type type);
@@ -416,6 +424,10 @@ private:
 	fixed_allocator<render_primitive> m_primitive_allocator;// allocator for primitives
 	fixed_allocator<reference> m_reference_allocator;       // allocator for references
 
+	UINT32                   m_serial;                           // serial number within the target
+	bool                     m_fulldamage;                       // true if everything must be redrawn
+	std::vector<rectangle>   m_damage;                           // damaged areas otherwise
+
 	std::recursive_mutex     m_lock;                             // lock to protect list accesses
 };
 
@@ -452,6 +464,9 @@ public:
 	// set any necessary aux data
 	void set_osd_data(UINT64 data) { m_osddata = data; }
 
+	// declare that the current contents only differ from those of another texture within an area
+	void set_damage(const render_texture &previous, const rectangle &damage);
+
 	// generic high-quality bitmap scaler
 	static void hq_scale(bitmap_argb32 &dest, bitmap_argb32 &source, const rectangle &sbounds, void *param);
 
@@ -459,6 +474,8 @@ private:
 	// internal helpers
 	void get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &texinfo, render_primitive_list &primlist, UINT32 flags = 0);
 	const rgb_t *get_adjusted_palette(render_container &container);
+	UINT32 content_id() const { return m_contentid; }
+	bool get_damage(UINT32 contentid, render_bounds &bounds) const;
 
 	static const int MAX_TEXTURE_SCALES = 16;
 
@@ -482,6 +499,11 @@ private:
 	void *              m_param;                    // scaling callback parameter
 	UINT32              m_curseq;                   // current sequence number
 	scaled_texture      m_scaled[MAX_TEXTURE_SCALES];// array of scaled variants of this texture
+
+	// damage tracking
+	UINT32              m_contentid;                // identifies the current contents
+	UINT32              m_damagebase;               // contents we only differ from within m_damage, or 0
+	rectangle           m_damage;                   // damaged area within the source bitmap
 };
 
 
@@ -549,6 +571,7 @@ public:
 	UINT8 apply_brightness_contrast_gamma(UINT8 value);
 	float apply_brightness_contrast_gamma_fp(float value);
 	const rgb_t *bcg_lookup_table(int texformat, palette_t *palette = nullptr);
+	UINT32 lookup_serial() const { return m_lookupserial; }
 
 private:
 	// an item describes a high level primitive that is added to a container
@@ -603,6 +626,7 @@ private:
 	std::unique_ptr<palette_client> m_palclient;       // client to the screen palette
 	std::vector<rgb_t>           m_bcglookup;            // copy of screen palette with bcg adjustment
 	rgb_t                   m_bcglookup256[0x400];  // lookup table for brightness/contrast/gamma
+	UINT32                  m_lookupserial;         // bumped whenever the lookup tables change
 };
 
 
@@ -1087,6 +1111,7 @@ public:
 	UINT32 height() const { return m_height; }
 	float pixel_aspect() const { return m_pixel_aspect; }
 	int scale_mode() const { return m_scale_mode; }
+	bool track_damage() const { return m_track_damage; }
 	float max_update_rate() const { return m_max_refresh; }
 	int orientation() const { return m_orientation; }
 	render_layer_config layer_config() const { return m_layerconfig; }
@@ -1105,6 +1130,7 @@ public:
 	void set_transform_container(bool transform_container) { m_transform_container = transform_container; }
 	void set_keepaspect(bool keepaspect) { m_keepaspect = keepaspect; }
 	void set_scale_mode(bool scale_mode) { m_scale_mode = scale_mode; }
+	void set_track_damage(bool track_damage) { m_track_damage = track_damage; }
 
 	// layer config getters
 	bool backdrops_enabled() const { return m_layerconfig.backdrops_enabled(); }
@@ -1177,9 +1203,29 @@ private:
 	void add_clear_extents(render_primitive_list &list);
 	void add_clear_and_optimize_primitive_list(render_primitive_list &list);
 
+	// damage tracking
+	struct primitive_state
+	{
+		render_primitive::primitive_type type;      // type of primitive
+		render_bounds       bounds;                 // bounds or positions
+		render_color        color;                  // RGBA values
+		UINT32              flags;                  // flags
+		float               width;                  // width (for line primitives)
+		render_quad_texuv   texcoords;              // texture coordinates (for quad primitives)
+		UINT32              texwidth;               // width of the texture data
+		UINT32              texheight;              // height of the texture data
+		const rgb_t *       palette;                // palette or lookup table
+		UINT32              contentid;              // contents of the source texture, or 0
+		UINT32              lookupserial;           // serial number of the container lookups
+	};
+	void compute_damage(render_primitive_list &list);
+	void add_primitive_damage(render_primitive_list &list, const primitive_state &state);
+	void add_damage(render_primitive_list &list, float x0, float y0, float x1, float y1);
+
 	// constants
 	static const int NUM_PRIMLISTS = 3;
 	static const int MAX_CLEAR_EXTENTS = 1000;
+	static const int MAX_DAMAGE_RECTS = 16;
 
 	// internal state
 	render_target *         m_next;                     // link to next target
@@ -1209,6 +1255,11 @@ private:
 	simple_list<render_container> m_debug_containers;   // list of debug containers
 	INT32                   m_clear_extent_count;       // number of clear extents
 	INT32                   m_clear_extents[MAX_CLEAR_EXTENTS]; // array of clear extents
+	std::vector<primitive_state> m_damage_states;       // state of the primitives in the last list
+	UINT32                  m_damage_serial;            // serial number of the last list
+	INT32                   m_damage_width;             // width of the last list, or 0 if unusable
+	INT32                   m_damage_height;            // height of the last list
+	bool                    m_track_damage;             // true if the OSD renderer draws only damaged areas
 	bool                    m_transform_container;      // determines whether the screen container is transformed by the core renderer,
 														// otherwise the respective render API will handle the transformation (scale, offset)
 
@@ -1222,6 +1273,7 @@ private:
 class render_manager
 {
 	friend class render_target;
+	friend class render_texture;
 
 public:
 	// construction/destruction
@@ -1233,6 +1285,7 @@ public:
 
 	// global queries
 	bool is_live(screen_device &screen) const;
+	bool tracks_damage() const;
 	float max_update_rate() const;
 
 	// targets
@@ -1269,6 +1322,9 @@ private:
 	render_container *container_alloc(screen_device *screen = nullptr);
 	void container_free(render_container *container);
 
+	// texture contents; 0 is never handed out
+	UINT32 next_content_id() { if (++m_last_contentid == 0) ++m_last_contentid; return m_last_contentid; }
+
 	// config callbacks
 	void config_load(config_type cfg_type, xml_data_node *parentnode);
 	void config_save(config_type cfg_type, xml_data_node *parentnode);
@@ -1283,6 +1339,7 @@ private:
 	// texture lists
 	UINT32                          m_live_textures;    // number of live textures
 	fixed_allocator<render_texture> m_texture_allocator;// texture allocator
+	UINT32                          m_last_contentid;   // last texture content ID handed out
 
 	// containers for the UI and for screens
 	render_container *              m_ui_container;     // UI container
@@ -14,6 +14,16 @@
 #include "video/rgbutil.h"
 #include "render.h"
 
+#include <algorithm>
+
+// use SSE on 64-bit implementations, where it can be assumed
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define RENDERSW_SSE2       1
+#include <emmintrin.h>
+#else
+#define RENDERSW_SSE2       0
+#endif
+
 
 template<typename _PixelType, int _SrcShiftR, int _SrcShiftG, int _SrcShiftB, int _DstShiftR, int _DstShiftG, int _DstShiftB, bool _NoDestRead = false, bool _BilinearFilter = false>
 class software_renderer
@@ -28,6 +38,9 @@ private:
 		INT32           endx, endy;
 	};
 
+	// texels fetched at a time for span operations
+	static constexpr int SPAN_PIXELS = 256;
+
 	// internal helpers
 	static inline bool is_opaque(float alpha) { return (alpha >= (_NoDestRead ? 0.5f : 1.0f)); }
 	static inline bool is_transparent(float alpha) { return (alpha < (_NoDestRead ? 0.5f : 0.0001f)); }
@@ -315,6 +328,246 @@ private:
 	}
 
 
+	//-------------------------------------------------
+	//  is_standard_rgb32 - true if the destination
+	//  is 32bpp xRGB, which source texels already
+	//  match channel for channel
+	//-------------------------------------------------
+
+	static constexpr bool is_standard_rgb32()
+	{
+		return sizeof(_PixelType) == 4 && _SrcShiftR == 0 && _SrcShiftG == 0 && _SrcShiftB == 0 && _DstShiftR == 16 && _DstShiftG == 8 && _DstShiftB == 0;
+	}
+
+
+	//-------------------------------------------------
+	//  repeats_previous_row - true if row y samples
+	//  exactly the same texels as the row above it,
+	//  so a row that doesn't read the destination
+	//  can be copied rather than drawn again
+	//-------------------------------------------------
+
+	static inline bool repeats_previous_row(const quad_setup_data &setup, INT32 y)
+	{
+		if (_BilinearFilter || y == setup.starty || setup.dvdx != 0 || setup.dudy != 0)
+			return false;
+		INT32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
+		return (curv >> 16) == ((curv - setup.dvdy) >> 16);
+	}
+
+	static inline void copy_previous_row(_PixelType *dest, UINT32 pitch, INT32 count)
+	{
+		if (count > 0)
+			memcpy(dest, dest - pitch, count * sizeof(_PixelType));
+	}
+
+
+	//-------------------------------------------------
+	//  modulate_row - scale a row of xRGB pixels by
+	//  per-channel factors of at most 0x100
+	//-------------------------------------------------
+
+	static void modulate_row(UINT32 *dest, const UINT32 *src, INT32 count, UINT32 sr, UINT32 sg, UINT32 sb)
+	{
+		INT32 x = 0;
+#if RENDERSW_SSE2
+		// four pixels at a time as 16-bit channels; 0xff * 0x100 still fits
+		__m128i const zero = _mm_setzero_si128();
+		__m128i const scale = _mm_set_epi16(0, sr, sg, sb, 0, sr, sg, sb);
+		for ( ; x + 4 <= count; x += 4)
+		{
+			__m128i const pix = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+			__m128i const lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(pix, zero), scale), 8);
+			__m128i const hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(pix, zero), scale), 8);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + x), _mm_packus_epi16(lo, hi));
+		}
+#endif
+		for ( ; x < count; x++)
+		{
+			UINT32 const pix = src[x];
+			UINT32 const r = (((pix >> 16) & 0xff) * sr) >> 8;
+			UINT32 const g = (((pix >> 8) & 0xff) * sg) >> 8;
+			UINT32 const b = ((pix & 0xff) * sb) >> 8;
+			dest[x] = (r << 16) | (g << 8) | b;
+		}
+	}
+
+
+	//-------------------------------------------------
+	//  blend_row - scale a row of xRGB pixels by
+	//  per-channel factors and add the destination
+	//  scaled by an inverse alpha; each factor plus
+	//  the inverse alpha must be at most 0x100
+	//-------------------------------------------------
+
+	static void blend_row(UINT32 *dest, const UINT32 *src, INT32 count, UINT32 sr, UINT32 sg, UINT32 sb, UINT32 invsa)
+	{
+		INT32 x = 0;
+#if RENDERSW_SSE2
+		// four pixels at a time as 16-bit channels; the sum is at most 0xff * 0x100
+		__m128i const zero = _mm_setzero_si128();
+		__m128i const scale = _mm_set_epi16(0, sr, sg, sb, 0, sr, sg, sb);
+		__m128i const invscale = _mm_set_epi16(0, invsa, invsa, invsa, 0, invsa, invsa, invsa);
+		for ( ; x + 4 <= count; x += 4)
+		{
+			__m128i const pix = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+			__m128i const dpix = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest + x));
+			__m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(pix, zero), scale);
+			__m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(pix, zero), scale);
+			lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_mullo_epi16(_mm_unpacklo_epi8(dpix, zero), invscale)), 8);
+			hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_mullo_epi16(_mm_unpackhi_epi8(dpix, zero), invscale)), 8);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + x), _mm_packus_epi16(lo, hi));
+		}
+#endif
+		for ( ; x < count; x++)
+		{
+			UINT32 const pix = src[x];
+			UINT32 const dpix = dest[x];
+			UINT32 const r = (((pix >> 16) & 0xff) * sr + ((dpix >> 16) & 0xff) * invsa) >> 8;
+			UINT32 const g = (((pix >> 8) & 0xff) * sg + ((dpix >> 8) & 0xff) * invsa) >> 8;
+			UINT32 const b = ((pix & 0xff) * sb + (dpix & 0xff) * invsa) >> 8;
+			dest[x] = (r << 16) | (g << 8) | b;
+		}
+	}
+
+
+	//-------------------------------------------------
+	//  get_texel - return a texel from a PALETTE16
+	//  or RGB32 source
+	//-------------------------------------------------
+
+	template<int _TexFormat>
+	static inline UINT32 get_texel(const render_texinfo &texture, INT32 curu, INT32 curv)
+	{
+		return (_TexFormat == TEXFORMAT_PALETTE16) ? get_texel_palette16(texture, curu, curv) : get_texel_rgb32(texture, curu, curv);
+	}
+
+
+#if RENDERSW_SSE2
+	//-------------------------------------------------
+	//  bilinear_row - filter a row of texels when V
+	//  doesn't change along it; this is the same
+	//  arithmetic as bilinear_filter in rgbsse.h,
+	//  but with the vertical clamp and weights set
+	//  up once per row and each horizontal pair of
+	//  texels fetched with a single load
+	//-------------------------------------------------
+
+	template<int _TexFormat>
+	static void bilinear_row(const render_texinfo &texture, UINT32 *dest, INT32 count, INT32 curu, INT32 curv, INT32 dudx)
+	{
+		// the rows being sampled are the same for every texel
+		INT32 v0 = curv >> 16;
+		INT32 v1 = texture.rowpixels;
+		if (v0 < 0) v0 = v1 = 0;
+		else if (v0 + 1 >= texture.height) v0 = texture.height - 1, v1 = 0;
+		UINT32 const v = UINT8(curv >> 8);
+
+		// the vertical pass weights the bottom pair by V and the top pair by 256-V
+		__m128i const zero = _mm_setzero_si128();
+		__m128i const vscale = _mm_set1_epi32(((256 - v) << 16) | v);
+
+		// keep the texture parameters in locals; stores to dest could alias them
+		INT32 const width = texture.width;
+		const rgb_t *const palbase = texture.palette;
+		const UINT16 *const rowbase16 = reinterpret_cast<const UINT16 *>(texture.base) + v0 * texture.rowpixels;
+		const UINT32 *const rowbase32 = reinterpret_cast<const UINT32 *>(texture.base) + v0 * texture.rowpixels;
+
+		for (INT32 x = 0; x < count; x++)
+		{
+			INT32 u0 = curu >> 16;
+			INT32 u1 = 1;
+			if (u0 < 0) u0 = u1 = 0;
+			else if (u0 + 1 >= width) u0 = width - 1, u1 = 0;
+
+			// fetch the left and right texels of both rows as pairs
+			__m128i top, bottom;
+			if (_TexFormat == TEXFORMAT_PALETTE16)
+			{
+				const UINT16 *texbase = rowbase16 + u0;
+				top = _mm_unpacklo_epi32(_mm_cvtsi32_si128(palbase[texbase[0]]), _mm_cvtsi32_si128(palbase[texbase[u1]]));
+				bottom = _mm_unpacklo_epi32(_mm_cvtsi32_si128(palbase[texbase[v1]]), _mm_cvtsi32_si128(palbase[texbase[u1 + v1]]));
+			}
+			else
+			{
+				const UINT32 *texbase = rowbase32 + u0;
+				if (u1 != 0)
+				{
+					top = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(texbase));
+					bottom = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(texbase + v1));
+				}
+				else
+				{
+					top = _mm_set1_epi32(texbase[0]);
+					bottom = _mm_set1_epi32(texbase[v1]);
+				}
+			}
+
+			// interleave left and right channel by channel and blend by U
+			UINT32 const u = UINT8(curu >> 8);
+			__m128i const uscale = _mm_set1_epi32((u << 16) | (256 - u));
+			top = _mm_madd_epi16(_mm_unpacklo_epi8(_mm_unpacklo_epi8(top, _mm_srli_si128(top, 4)), zero), uscale);
+			bottom = _mm_madd_epi16(_mm_unpacklo_epi8(_mm_unpacklo_epi8(bottom, _mm_srli_si128(bottom, 4)), zero), uscale);
+
+			// pack the halved results into one register and blend by V
+			top = _mm_max_epi16(_mm_slli_epi32(top, 15), _mm_srli_epi32(bottom, 1));
+			top = _mm_srli_epi32(_mm_madd_epi16(top, vscale), 15);
+			top = _mm_packs_epi32(top, zero);
+			dest[x] = _mm_cvtsi128_si32(_mm_packus_epi16(top, zero));
+			curu += dudx;
+		}
+	}
+#endif
+
+
+	//-------------------------------------------------
+	//  fetch_texels - fetch a row of PALETTE16 or
+	//  RGB32 texels as xRGB
+	//-------------------------------------------------
+
+	template<int _TexFormat>
+	static void fetch_texels(const render_texinfo &texture, UINT32 *dest, INT32 count, INT32 curu, INT32 curv, INT32 dudx, INT32 dvdx)
+	{
+#if RENDERSW_SSE2
+		if (_BilinearFilter && dvdx == 0)
+			return bilinear_row<_TexFormat>(texture, dest, count, curu, curv, dudx);
+#endif
+		for (INT32 x = 0; x < count; x++)
+		{
+			dest[x] = get_texel<_TexFormat>(texture, curu, curv);
+			curu += dudx;
+			curv += dvdx;
+		}
+	}
+
+
+	//-------------------------------------------------
+	//  modulate_span - fetch a row of texels a chunk
+	//  at a time and scale or blend them into an
+	//  xRGB destination
+	//-------------------------------------------------
+
+	template<int _TexFormat>
+	static void modulate_span(const render_texinfo &texture, _PixelType *dstdata, INT32 count, INT32 curu, INT32 curv, INT32 dudx, INT32 dvdx, UINT32 sr, UINT32 sg, UINT32 sb, UINT32 invsa)
+	{
+		UINT32 *dest = reinterpret_cast<UINT32 *>(dstdata);
+		UINT32 texels[SPAN_PIXELS];
+		while (count > 0)
+		{
+			INT32 const chunk = std::min<INT32>(count, SPAN_PIXELS);
+			fetch_texels<_TexFormat>(texture, texels, chunk, curu, curv, dudx, dvdx);
+			if (_NoDestRead || invsa == 0)
+				modulate_row(dest, texels, chunk, sr, sg, sb);
+			else
+				blend_row(dest, texels, chunk, sr, sg, sb, invsa);
+			curu += chunk * dudx;
+			curv += chunk * dvdx;
+			dest += chunk;
+			count -= chunk;
+		}
+	}
+
+
 	//-------------------------------------------------
 	//  draw_aa_pixel - draw an antialiased pixel
 	//-------------------------------------------------
@@ -337,10 +590,18 @@ private:
 	//  draw_line - draw a line or point
 	//-------------------------------------------------
 
-	static void draw_line(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 height, UINT32 pitch)
+	static void draw_line(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 top, INT32 bottom, UINT32 pitch)
 	{
-		// internal tables
-		static UINT32 s_cosine_table[2049];
+		// internal tables; built on first use, which may happen on several bands at once
+		struct cosine_table
+		{
+			cosine_table()
+			{
+				for (int entry = 0; entry <= 2048; entry++)
+					entries[entry] = int(double(1.0 / cos(atan(double(entry) / 2048.0))) * 0x10000000 + 0.5);
+			}
+			UINT32 entries[2049];
+		};
 
 		// compute the start/end coordinates
 		int x1 = int(prim.bounds.x0 * 65536.0f);
@@ -353,10 +614,7 @@ private:
 
 		if (PRIMFLAG_GET_ANTIALIAS(prim.flags))
 		{
-			// build up the cosine table if we haven't yet
-			if (s_cosine_table[0] == 0)
-				for (int entry = 0; entry <= 2048; entry++)
-					s_cosine_table[entry] = int(double(1.0 / cos(atan(double(entry) / 2048.0))) * 0x10000000 + 0.5);
+			static const cosine_table s_cosine_table;
 
 			int beam = prim.width * 65536.0f;
 			if (beam < 0x00010000)
@@ -374,7 +632,7 @@ private:
 					dy--;
 				x1 >>= 16;
 				int xx = x2 >> 16;
-				int bwidth = mul_32x32_hi(beam << 4, s_cosine_table[abs(sy) >> 5]);
+				int bwidth = mul_32x32_hi(beam << 4, s_cosine_table.entries[abs(sy) >> 5]);
 				y1 -= bwidth >> 1; // start back half the diameter
 				for (;;)
 				{
@@ -382,7 +640,7 @@ private:
 					{
 						dx = bwidth;    // init diameter of beam
 						dy = y1 >> 16;
-						if (dy >= 0 && dy < height)
+						if (dy >= top && dy < bottom)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(0xff & (~y1 >> 8), col));
 						dy++;
 						dx -= 0x10000 - (0xffff & y1); // take off amount plotted
@@ -390,11 +648,11 @@ private:
 						dx >>= 16;                   // adjust to pixel (solid) count
 						while (dx--)                 // plot rest of pixels
 						{
-							if (dy >= 0 && dy < height)
+							if (dy >= top && dy < bottom)
 								draw_aa_pixel(dstdata, pitch, x1, dy, col);
 							dy++;
 						}
-						if (dy >= 0 && dy < height)
+						if (dy >= top && dy < bottom)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(a1,col));
 					}
 					if (x1 == xx) break;
@@ -410,11 +668,11 @@ private:
 					dx--;
 				y1 >>= 16;
 				int yy = y2 >> 16;
-				int bwidth = mul_32x32_hi(beam << 4,s_cosine_table[abs(sx) >> 5]);
+				int bwidth = mul_32x32_hi(beam << 4,s_cosine_table.entries[abs(sx) >> 5]);
 				x1 -= bwidth >> 1; // start back half the width
 				for (;;)
 				{
-					if (y1 >= 0 && y1 < height)
+					if (y1 >= top && y1 < bottom)
 					{
 						dy = bwidth;    // calc diameter of beam
 						dx = x1 >> 16;
@@ -457,7 +715,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= top && y1 < bottom)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (x1 == x2) break;
 					x1 += sx;
@@ -473,7 +731,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= top && y1 < bottom)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (y1 == y2) break;
 					y1 += sy;
@@ -498,7 +756,7 @@ private:
 	//  draw_rect - draw a solid rectangle
 	//-------------------------------------------------
 
-	static void draw_rect(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 height, UINT32 pitch)
+	static void draw_rect(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 top, INT32 bottom, UINT32 pitch)
 	{
 		render_bounds fpos = prim.bounds;
 		assert(fpos.x0 <= fpos.x1);
@@ -515,10 +773,10 @@ private:
 		if (startx >= width) startx = width;
 		if (endx < 0) endx = 0;
 		if (endx >= width) endx = width;
-		if (starty < 0) starty = 0;
-		if (starty >= height) starty = height;
-		if (endy < 0) endy = 0;
-		if (endy >= height) endy = height;
+		if (starty < top) starty = top;
+		if (starty >= bottom) starty = bottom;
+		if (endy < top) endy = top;
+		if (endy >= bottom) endy = bottom;
 
 		// bail if nothing left
 		if (fpos.x0 > fpos.x1 || fpos.y0 > fpos.y1)
@@ -622,6 +880,20 @@ private:
 				INT32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				INT32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
+				// rows that sample the same texels as the one above are copied
+				if (repeats_previous_row(setup, y))
+				{
+					copy_previous_row(dest, pitch, endx - setup.startx);
+					continue;
+				}
+
+				// standard destinations take the texels as they are
+				if (is_standard_rgb32())
+				{
+					fetch_texels<TEXFORMAT_PALETTE16>(prim.texture, reinterpret_cast<UINT32 *>(dest), endx - setup.startx, curu, curv, dudx, dvdx);
+					continue;
+				}
+
 				// loop over cols
 				for (INT32 x = setup.startx; x < endx; x++)
 				{
@@ -652,6 +924,20 @@ private:
 				INT32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				INT32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
+				// rows that sample the same texels as the one above are copied
+				if (repeats_previous_row(setup, y))
+				{
+					copy_previous_row(dest, pitch, endx - setup.startx);
+					continue;
+				}
+
+				// standard destinations scale whole spans with packed arithmetic
+				if (is_standard_rgb32())
+				{
+					modulate_span<TEXFORMAT_PALETTE16>(prim.texture, dest, endx - setup.startx, curu, curv, dudx, dvdx, sr, sg, sb, 0);
+					continue;
+				}
+
 				// loop over cols
 				for (INT32 x = setup.startx; x < endx; x++)
 				{
@@ -681,6 +967,9 @@ private:
 			if (sb > 0x100) { if (INT32(sb) < 0) sb = 0; else sb = 0x100; }
 			if (invsa > 0x100) { if (INT32(invsa) < 0) invsa = 0; else invsa = 0x100; }
 
+			// packed blending needs every channel's factors to sum to at most 0x100
+			bool const packed = is_standard_rgb32() && std::max(sr, std::max(sg, sb)) + invsa <= 0x100;
+
 			// loop over rows
 			for (INT32 y = setup.starty; y < setup.endy; y++)
 			{
@@ -688,6 +977,13 @@ private:
 				INT32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				INT32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
+				// standard destinations scale whole spans with packed arithmetic
+				if (packed)
+				{
+					modulate_span<TEXFORMAT_PALETTE16>(prim.texture, dest, endx - setup.startx, curu, curv, dudx, dvdx, sr, sg, sb, invsa);
+					continue;
+				}
+
 				// loop over cols
 				for (INT32 x = setup.startx; x < endx; x++)
 				{
@@ -1111,8 +1407,17 @@ private:
 				INT32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				INT32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
-				// no lookup case
-				if (palbase == nullptr)
+				// rows that sample the same texels as the one above are copied
+				if (repeats_previous_row(setup, y))
+				{
+					copy_previous_row(dest, pitch, endx - setup.startx);
+					continue;
+				}
+
+				// no lookup case; standard destinations take the texels as they are
+				if (palbase == nullptr && is_standard_rgb32())
+					fetch_texels<TEXFORMAT_RGB32>(prim.texture, reinterpret_cast<UINT32 *>(dest), endx - setup.startx, curu, curv, dudx, dvdx);
+				else if (palbase == nullptr)
 				{
 					// loop over cols
 					for (INT32 x = setup.startx; x < endx; x++)
@@ -1162,6 +1467,20 @@ private:
 				INT32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				INT32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
+				// rows that sample the same texels as the one above are copied
+				if (repeats_previous_row(setup, y))
+				{
+					copy_previous_row(dest, pitch, endx - setup.startx);
+					continue;
+				}
+
+				// standard destinations scale whole spans with packed arithmetic
+				if (is_standard_rgb32() && palbase == nullptr)
+				{
+					modulate_span<TEXFORMAT_RGB32>(prim.texture, dest, endx - setup.startx, curu, curv, dudx, dvdx, sr, sg, sb, 0);
+					continue;
+				}
+
 				// no lookup case
 				if (palbase == nullptr)
 				{
@@ -1212,6 +1531,9 @@ private:
 			if (sb > 0x100) { if (INT32(sb) < 0) sb = 0; else sb = 0x100; }
 			if (invsa > 0x100) { if (INT32(invsa) < 0) invsa = 0; else invsa = 0x100; }
 
+			// packed blending needs every channel's factors to sum to at most 0x100
+			bool const packed = is_standard_rgb32() && std::max(sr, std::max(sg, sb)) + invsa <= 0x100;
+
 			// loop over rows
 			for (INT32 y = setup.starty; y < setup.endy; y++)
 			{
@@ -1219,6 +1541,13 @@ private:
 				INT32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				INT32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
+				// standard destinations scale whole spans with packed arithmetic
+				if (packed && palbase == nullptr)
+				{
+					modulate_span<TEXFORMAT_RGB32>(prim.texture, dest, endx - setup.startx, curu, curv, dudx, dvdx, sr, sg, sb, invsa);
+					continue;
+				}
+
 				// no lookup case
 				if (palbase == nullptr)
 				{
@@ -1825,7 +2154,7 @@ private:
 	//  drawing routine
 	//-------------------------------------------------
 
-	static void setup_and_draw_textured_quad(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 height, UINT32 pitch)
+	static void setup_and_draw_textured_quad(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 height, INT32 top, INT32 bottom, UINT32 pitch)
 	{
 		assert(prim.bounds.x0 <= prim.bounds.x1);
 		assert(prim.bounds.y0 <= prim.bounds.y1);
@@ -1872,6 +2201,18 @@ private:
 			setup.startv -= 0x8000;
 		}
 
+		// clip to the band being drawn, stepping U/V down to its first row
+		if (setup.starty < top)
+		{
+			setup.startu += (top - setup.starty) * setup.dudy;
+			setup.startv += (top - setup.starty) * setup.dvdy;
+			setup.starty = top;
+		}
+		if (setup.endy > bottom)
+			setup.endy = bottom;
+		if (setup.starty >= setup.endy)
+			return;
+
 		// render based on the texture coordinates
 		switch (prim.flags & (PRIMFLAG_TEXFORMAT_MASK | PRIMFLAG_BLENDMODE_MASK))
 		{
@@ -1926,35 +2267,155 @@ private:
 	}
 
 
-	//**************************************************************************
-	//  PRIMARY ENTRY POINT
-	//**************************************************************************
-
 	//-------------------------------------------------
-	//  draw_primitives - draw a series of primitives
-	//  using a software rasterizer
+	//  draw_band - draw every primitive that touches
+	//  rows top to bottom-1 of the destination
 	//-------------------------------------------------
 
-public:
-	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, UINT32 width, UINT32 height, UINT32 pitch)
+	static void draw_band(const render_primitive_list &primlist, _PixelType *dstdata, INT32 width, INT32 height, INT32 top, INT32 bottom, UINT32 pitch)
 	{
 		// loop over the list and render each element
 		for (const render_primitive *prim = primlist.first(); prim != nullptr; prim = prim->next())
 			switch (prim->type)
 			{
 				case render_primitive::LINE:
-					draw_line(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+				{
+					// skip lines that can't reach this band, allowing for the beam width
+					float const margin = 2.0f * std::max(prim->width, 1.0f) + 2.0f;
+					if (std::max(prim->bounds.y0, prim->bounds.y1) + margin < top || std::min(prim->bounds.y0, prim->bounds.y1) - margin >= bottom)
+						break;
+					draw_line(*prim, dstdata, width, top, bottom, pitch);
 					break;
+				}
 
 				case render_primitive::QUAD:
+					// skip quads that don't reach this band
+					if (round_nearest(prim->bounds.y1) <= top || round_nearest(prim->bounds.y0) >= bottom)
+						break;
 					if (!prim->texture.base)
-						draw_rect(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+						draw_rect(*prim, dstdata, width, top, bottom, pitch);
 					else
-						setup_and_draw_textured_quad(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+						setup_and_draw_textured_quad(*prim, dstdata, width, height, top, bottom, pitch);
 					break;
 
 				default:
 					throw emu_fatalerror("Unexpected render_primitive type");
 			}
 	}
+
+
+	//-------------------------------------------------
+	//  draw_band_callback - work queue callback
+	//  that draws a single band
+	//-------------------------------------------------
+
+	struct band_params
+	{
+		const render_primitive_list *primlist;
+		_PixelType *    dstdata;
+		INT32           width, height;
+		INT32           top, bottom;
+		UINT32          pitch;
+	};
+
+	static void *draw_band_callback(void *param, int threadid)
+	{
+		const band_params &band = *reinterpret_cast<const band_params *>(param);
+		draw_band(*band.primlist, band.dstdata, band.width, band.height, band.top, band.bottom, band.pitch);
+		return nullptr;
+	}
+
+
+	//**************************************************************************
+	//  PRIMARY ENTRY POINT
+	//**************************************************************************
+
+	//-------------------------------------------------
+	//  draw_primitives - draw a series of primitives
+	//  using a software rasterizer
+	//-------------------------------------------------
+
+public:
+	static constexpr int MAX_BANDS = 32;
+	static constexpr int MIN_BAND_HEIGHT = 16;
+
+	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, UINT32 width, UINT32 height, UINT32 pitch)
+	{
+		draw_band(primlist, reinterpret_cast<_PixelType *>(dstdata), width, height, 0, height, pitch);
+	}
+
+	//-------------------------------------------------
+	//  draw_primitives - draw a series of primitives,
+	//  splitting the destination into horizontal
+	//  bands drawn in parallel on a work queue; each
+	//  pixel belongs to exactly one band, so the
+	//  result is identical to drawing on one thread
+	//-------------------------------------------------
+
+	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, UINT32 width, UINT32 height, UINT32 pitch, osd_work_queue *queue, int bands)
+	{
+		draw_rows(primlist, dstdata, width, height, pitch, 0, height, queue, bands);
+	}
+
+	//-------------------------------------------------
+	//  draw_rows - draw the primitives that touch a
+	//  range of rows, leaving the rest of the
+	//  destination alone
+	//-------------------------------------------------
+
+	static void draw_rows(const render_primitive_list &primlist, void *dstdata, UINT32 width, UINT32 height, UINT32 pitch, INT32 top, INT32 bottom, osd_work_queue *queue = nullptr, int bands = 0)
+	{
+		top = std::max<INT32>(top, 0);
+		bottom = std::min<INT32>(bottom, height);
+		if (top >= bottom)
+			return;
+
+		// clamp the band count so each band has some substance
+		bands = std::min<int>(bands, std::min<int>(MAX_BANDS, (bottom - top) / MIN_BAND_HEIGHT));
+		if (queue == nullptr || bands <= 1)
+			return draw_band(primlist, reinterpret_cast<_PixelType *>(dstdata), width, height, top, bottom, pitch);
+
+		band_params params[MAX_BANDS];
+		for (int band = 0; band < bands; band++)
+		{
+			params[band].primlist = &primlist;
+			params[band].dstdata = reinterpret_cast<_PixelType *>(dstdata);
+			params[band].width = width;
+			params[band].height = height;
+			params[band].top = top + (bottom - top) * band / bands;
+			params[band].bottom = top + (bottom - top) * (band + 1) / bands;
+			params[band].pitch = pitch;
+		}
+
+		// hand all but the first band to the queue and draw that one ourselves; the
+		// parameters live on our stack, so we can't leave before every band is done
+		osd_work_item_queue_multiple(queue, draw_band_callback, bands - 1, &params[1], sizeof(params[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		draw_band_callback(&params[0], 0);
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+	}
+
+	//-------------------------------------------------
+	//  draw_damage - redraw only the rows covered by
+	//  a list's damage; the destination must hold
+	//  what the previous list from the same target
+	//  drew (see damage_valid_since)
+	//-------------------------------------------------
+
+	static void draw_damage(const render_primitive_list &primlist, void *dstdata, UINT32 width, UINT32 height, UINT32 pitch, osd_work_queue *queue = nullptr, int bands = 0)
+	{
+		// gather the damaged row ranges in order
+		std::vector<std::pair<INT32, INT32>> rows;
+		for (const rectangle &rect : primlist.damage())
+			rows.emplace_back(rect.min_y, rect.max_y + 1);
+		std::sort(rows.begin(), rows.end());
+
+		// merge any that overlap or touch, and draw each result once
+		for (size_t index = 0; index < rows.size(); )
+		{
+			INT32 top = rows[index].first, bottom = rows[index].second;
+			for (index++; index < rows.size() && rows[index].first <= bottom; index++)
+				bottom = std::max(bottom, rows[index].second);
+			draw_rows(primlist, dstdata, width, height, pitch, top, bottom, queue, bands);
+		}
+	}
 };
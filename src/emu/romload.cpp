@@ -24,6 +24,10 @@
 
 #define TEMPBUFFER_MAX_SIZE     (1024 * 1024 * 1024)
 
+/* look-ahead window for opening and hashing ROM files on worker threads */
+#define ROM_PREFETCH_MAX_FILES  16
+#define ROM_PREFETCH_MAX_BYTES  (256 * 1024 * 1024)
+
 /***************************************************************************
     HELPERS (also used by diimage.cpp)
  ***************************************************************************/
@@ -541,35 +545,32 @@ void rom_load_manager::region_post_process(const char *rgntag, bool invert)
 
 
 /*-------------------------------------------------
-    open_rom_file - open a ROM file, searching
-    up the parent and loading by checksum
+    find_rom_file - locate and open a ROM file,
+    searching up the parent and loading by
+    checksum; safe to call from worker threads
 -------------------------------------------------*/
 
-int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list)
+std::unique_ptr<emu_file> rom_load_manager::find_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names) const
 {
 	osd_file::error filerr = osd_file::error::NOT_FOUND;
-	UINT32 romsize = rom_file_size(romp);
+	std::unique_ptr<emu_file> file;
 	tried_file_names = "";
 
-	/* update status display */
-	display_loading_rom_message(ROM_GETNAME(romp), from_list);
-
 	/* extract CRC to use for searching */
 	UINT32 crc = 0;
 	bool has_crc = util::hash_collection(ROM_GETHASHDATA(romp)).crc(crc);
 
 	/* attempt reading up the chain through the parents. It automatically also
 	 attempts any kind of load by checksum supported by the archives. */
-	m_file = nullptr;
-	for (int drv = driver_list::find(machine().system()); m_file == nullptr && drv != -1; drv = driver_list::clone(drv)) {
+	for (int drv = driver_list::find(machine().system()); file == nullptr && drv != -1; drv = driver_list::clone(drv)) {
 		if (tried_file_names.length() != 0)
 			tried_file_names += " ";
 		tried_file_names += driver_list::driver(drv).name;
-		m_file = common_process_file(machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, filerr);
+		file = common_process_file(machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, filerr);
 	}
 
 	/* if the region is load by name, load the ROM from there */
-	if (m_file == nullptr && regiontag != nullptr)
+	if (file == nullptr && regiontag != nullptr)
 	{
 		// check if we are dealing with softwarelists. if so, locationtag
 		// is actually a concatenation of: listname + setname + parentname
@@ -618,43 +619,181 @@ int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp
 		if (!is_list)
 		{
 			tried_file_names += " " + tag1;
-			m_file = common_process_file(machine().options(), tag1.c_str(), has_crc, crc, romp, filerr);
+			file = common_process_file(machine().options(), tag1.c_str(), has_crc, crc, romp, filerr);
 		}
 		else
 		{
 			// try to load from list/setname
-			if ((m_file == nullptr) && (tag2.c_str() != nullptr))
+			if ((file == nullptr) && (tag2.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag2;
-				m_file = common_process_file(machine().options(), tag2.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag2.c_str(), has_crc, crc, romp, filerr);
 			}
 			// try to load from list/parentname
-			if ((m_file == nullptr) && has_parent && (tag3.c_str() != nullptr))
+			if ((file == nullptr) && has_parent && (tag3.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag3;
-				m_file = common_process_file(machine().options(), tag3.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag3.c_str(), has_crc, crc, romp, filerr);
 			}
 			// try to load from setname
-			if ((m_file == nullptr) && (tag4.c_str() != nullptr))
+			if ((file == nullptr) && (tag4.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag4;
-				m_file = common_process_file(machine().options(), tag4.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag4.c_str(), has_crc, crc, romp, filerr);
 			}
 			// try to load from parentname
-			if ((m_file == nullptr) && has_parent && (tag5.c_str() != nullptr))
+			if ((file == nullptr) && has_parent && (tag5.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag5;
-				m_file = common_process_file(machine().options(), tag5.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag5.c_str(), has_crc, crc, romp, filerr);
 			}
 		}
 	}
 
+	/* return the result */
+	return file;
+}
+
+
+/*-------------------------------------------------
+    open_rom_file - open a ROM file, picking it
+    up from the prefetch queue when possible
+-------------------------------------------------*/
+
+int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list)
+{
+	UINT32 romsize = rom_file_size(romp);
+
+	/* update status display */
+	display_loading_rom_message(ROM_GETNAME(romp), from_list);
+
+	/* take the file from the prefetcher if it got there first */
+	if (m_prefetch_used < m_prefetch_queued && m_prefetch[m_prefetch_used].romp == romp)
+	{
+		prefetch_file &prefetch = m_prefetch[m_prefetch_used++];
+		osd_work_item_wait(prefetch.item, 100 * osd_ticks_per_second());
+		osd_work_item_release(prefetch.item);
+		prefetch.item = nullptr;
+		m_prefetch_bytes -= rom_file_size(romp);
+
+		m_file = std::move(prefetch.file);
+		tried_file_names = std::move(prefetch.tried_file_names);
+
+		/* keep the queue topped up */
+		prefetch_queue_more();
+	}
+	else
+		m_file = find_rom_file(regiontag, romp, tried_file_names);
+
 	/* update counters */
 	m_romsloaded++;
 	m_romsloadedsize += romsize;
 
 	/* return the result */
-	return (filerr == osd_file::error::NONE);
+	return (m_file != nullptr);
+}
+
+
+/*-------------------------------------------------
+    prefetch_start - begin opening the files of
+    a region ahead of the loader, so archive
+    decompression and hashing overlap the copy
+    into the region
+-------------------------------------------------*/
+
+void rom_load_manager::prefetch_start(const char *regiontag, const rom_entry *romp, device_t *device)
+{
+	prefetch_reset();
+
+	/* catch malformed software list tags here rather than on a worker */
+	if (regiontag != nullptr && std::count(regiontag, regiontag + strlen(regiontag), '%') > 2)
+		fatalerror("We do not support clones of clones!\n");
+
+	/* gather the files we will open, in the order the loader wants them */
+	for ( ; !ROMENTRY_ISREGIONEND(romp); romp++)
+		if (ROMENTRY_ISFILE(romp) && (ROM_GETBIOSFLAGS(romp) == 0 || ROM_GETBIOSFLAGS(romp) == device->system_bios()))
+			m_prefetch.push_back(prefetch_file{ this, regiontag, romp, nullptr, std::string(), nullptr });
+
+	/* a single file gains nothing from a worker */
+	if (m_prefetch.size() < 2)
+	{
+		m_prefetch.clear();
+		return;
+	}
+
+	if (!m_prefetch_queue)
+		m_prefetch_queue.reset(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_IO));
+	prefetch_queue_more();
+}
+
+
+/*-------------------------------------------------
+    prefetch_queue_more - queue prefetches until
+    the look-ahead window is full
+-------------------------------------------------*/
+
+void rom_load_manager::prefetch_queue_more()
+{
+	/* the window is bounded both in files and in bytes held in memory */
+	while (m_prefetch_queued < m_prefetch.size() && m_prefetch_queued - m_prefetch_used < ROM_PREFETCH_MAX_FILES)
+	{
+		prefetch_file &prefetch = m_prefetch[m_prefetch_queued];
+		UINT32 romsize = rom_file_size(prefetch.romp);
+		if (m_prefetch_queued != m_prefetch_used && m_prefetch_bytes + romsize > ROM_PREFETCH_MAX_BYTES)
+			break;
+
+		prefetch.item = osd_work_item_queue(m_prefetch_queue.get(), prefetch_callback, &prefetch, 0);
+		if (prefetch.item == nullptr)
+			break;
+		m_prefetch_bytes += romsize;
+		m_prefetch_queued++;
+	}
+}
+
+
+/*-------------------------------------------------
+    prefetch_reset - wait for any outstanding
+    prefetches and discard them
+-------------------------------------------------*/
+
+void rom_load_manager::prefetch_reset()
+{
+	for (size_t index = m_prefetch_used; index < m_prefetch_queued; index++)
+		osd_work_item_release(m_prefetch[index].item);
+	m_prefetch.clear();
+	m_prefetch_queued = m_prefetch_used = 0;
+	m_prefetch_bytes = 0;
+}
+
+
+/*-------------------------------------------------
+    prefetch_callback - open and hash a single
+    file on a worker thread
+-------------------------------------------------*/
+
+void *rom_load_manager::prefetch_callback(void *param, int threadid)
+{
+	prefetch_file &prefetch = *reinterpret_cast<prefetch_file *>(param);
+
+	prefetch.file = prefetch.manager->find_rom_file(prefetch.regiontag, prefetch.romp, prefetch.tried_file_names);
+
+	/* archived files were decompressed by the open; hashing pulls a plain
+	   file into memory in one read, and the loader then copies from there */
+	if (prefetch.file != nullptr)
+		prefetch.file->hashes(util::hash_collection(ROM_GETHASHDATA(prefetch.romp)).hash_types().c_str());
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    prefetch_queue_deleter - wait for the prefetch
+    queue to drain, then free it
+-------------------------------------------------*/
+
+void rom_load_manager::prefetch_queue_deleter::operator()(osd_work_queue *queue) const
+{
+	osd_work_queue_wait(queue, 100 * osd_ticks_per_second());
+	osd_work_queue_free(queue);
 }
 
 
@@ -866,6 +1005,11 @@ void rom_load_manager::copy_rom_data(const rom_entry *romp)
 void rom_load_manager::process_rom_entries(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, device_t *device, bool from_list)
 {
 	UINT32 lastflags = 0;
+	osd_ticks_t starttime = osd_ticks();
+	int files = 0;
+
+	/* start opening and hashing this region's files in the background */
+	prefetch_start(regiontag, romp, device);
 
 	/* loop until we hit the end of this region */
 	while (!ROMENTRY_ISREGIONEND(romp))
@@ -902,6 +1046,8 @@ void rom_load_manager::process_rom_entries(const char *regiontag, const rom_entr
 			std::string tried_file_names;
 			if (!irrelevantbios && !open_rom_file(regiontag, romp, tried_file_names, from_list))
 				handle_missing_file(romp, tried_file_names, CHDERR_NONE);
+			if (!irrelevantbios)
+				files++;
 
 			/* loop until we run out of reloads */
 			do
@@ -954,6 +1100,12 @@ void rom_load_manager::process_rom_entries(const char *regiontag, const rom_entr
 			romp++; /* something else; skip */
 		}
 	}
+
+	/* everything should have been consumed, but don't leave anything in flight */
+	prefetch_reset();
+
+	osd_printf_verbose("Loaded %d file(s) into region %s in %.2f ms\n", files, ROM_GETNAME(parent_region),
+			double(osd_ticks() - starttime) * 1000.0 / double(osd_ticks_per_second()));
 }
 
 
@@ -1196,6 +1348,9 @@ void rom_load_manager::process_disk_entries(const char *regiontag, const rom_ent
 				m_knownbad++;
 			}
 
+			/* drives tend to stream data in order, so decompress a few hunks ahead */
+			chd->orig_chd().set_readahead(8);
+
 			/* if not read-only, make the diff file */
 			if (!DISK_ISREADONLY(romp))
 			{
@@ -1454,7 +1609,10 @@ void rom_load_manager::process_region_list()
 -------------------------------------------------*/
 
 rom_load_manager::rom_load_manager(running_machine &machine)
-	: m_machine(machine)
+	: m_machine(machine),
+		m_prefetch_queued(0),
+		m_prefetch_used(0),
+		m_prefetch_bytes(0)
 {
 	/* figure out which BIOS we are using */
 
@@ -177,6 +177,23 @@ class rom_load_manager
 		chd_file            m_diffchd;              /* handle to the diff CHD */
 	};
 
+	// a ROM file being located, decompressed and hashed ahead of its use
+	struct prefetch_file
+	{
+		rom_load_manager *          manager;            /* owning manager */
+		const char *                regiontag;          /* location tag to search */
+		const rom_entry *           romp;               /* ROM entry for the file */
+		std::unique_ptr<emu_file>   file;               /* opened file, or nullptr if not found */
+		std::string                 tried_file_names;   /* locations searched */
+		osd_work_item *             item;               /* work item, or nullptr if not yet queued */
+	};
+
+	// waits for and frees the prefetch queue
+	struct prefetch_queue_deleter
+	{
+		void operator()(osd_work_queue *queue) const;
+	};
+
 public:
 	// construction/destruction
 	rom_load_manager(running_machine &machine);
@@ -212,7 +229,12 @@ private:
 	void display_loading_rom_message(const char *name, bool from_list);
 	void display_rom_load_results(bool from_list);
 	void region_post_process(const char *rgntag, bool invert);
+	std::unique_ptr<emu_file> find_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names) const;
 	int open_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list);
+	void prefetch_start(const char *regiontag, const rom_entry *romp, device_t *device);
+	void prefetch_queue_more();
+	void prefetch_reset();
+	static void *prefetch_callback(void *param, int threadid);
 	int rom_fread(UINT8 *buffer, int length, const rom_entry *parent_region);
 	int read_rom_data(const rom_entry *parent_region, const rom_entry *romp);
 	void fill_rom_data(const rom_entry *romp);
@@ -239,6 +261,12 @@ private:
 	std::unique_ptr<emu_file>  m_file;               /* current file */
 	std::vector<std::unique_ptr<open_chd>> m_chd_list;     /* disks */
 
+	std::vector<prefetch_file> m_prefetch;  /* files of the current region, in load order */
+	size_t          m_prefetch_queued;    /* number of prefetches queued so far */
+	size_t          m_prefetch_used;      /* number of prefetches consumed so far */
+	UINT64          m_prefetch_bytes;     /* bytes queued but not yet consumed */
+	std::unique_ptr<osd_work_queue, prefetch_queue_deleter> m_prefetch_queue; /* queue for opening and hashing files */
+
 	memory_region * m_region;             /* info about current region */
 
 	std::string     m_errorstring;        /* error string */
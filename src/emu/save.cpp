@@ -43,6 +43,9 @@
 const int SAVE_VERSION      = 2;
 const int HEADER_SIZE       = 32;
 
+// granularity of change detection for rewind snapshots
+const UINT32 REWIND_BLOCK_SIZE = 1024;
+
 // Available flags
 enum
 {
@@ -67,6 +70,15 @@ save_manager::save_manager(running_machine &machine)
 }
 
 
+//-------------------------------------------------
+//  ~save_manager - destructor
+//-------------------------------------------------
+
+save_manager::~save_manager()
+{
+}
+
+
 //-------------------------------------------------
 //  allow_registration - allow/disallow
 //  registrations to happen
@@ -321,6 +333,21 @@ save_error save_manager::write_file(emu_file &file)
 }
 
 
+//-------------------------------------------------
+//  enable_rewind - start keeping in-memory
+//  snapshots within the given memory budget, or
+//  stop if the budget is zero
+//-------------------------------------------------
+
+void save_manager::enable_rewind(size_t capacity)
+{
+	if (capacity != 0)
+		m_rewinder = std::make_unique<state_rewinder>(*this, capacity);
+	else
+		m_rewinder.reset();
+}
+
+
 //-------------------------------------------------
 //  signature - compute the signature, which
 //  is a CRC over the structure of the data
@@ -465,3 +492,167 @@ void state_entry::flip_data()
 			break;
 	}
 }
+
+
+
+//**************************************************************************
+//  STATE REWINDER
+//**************************************************************************
+
+//-------------------------------------------------
+//  state_rewinder - constructor
+//-------------------------------------------------
+
+state_rewinder::state_rewinder(save_manager &save, size_t capacity)
+	: m_save(save),
+		m_capacity(capacity),
+		m_used(0),
+		m_current_time(attotime::zero)
+{
+}
+
+
+//-------------------------------------------------
+//  snapshot_time - return the emulated time of
+//  a snapshot; 1 is the most recent one
+//-------------------------------------------------
+
+attotime state_rewinder::snapshot_time(int index) const
+{
+	if (index < 1 || index > count())
+		return attotime::never;
+	if (index == 1)
+		return m_current_time;
+	return m_history[m_history.size() + 1 - index].m_time;
+}
+
+
+//-------------------------------------------------
+//  capture - take a snapshot of the current
+//  state, keeping only what changed since the
+//  previous one
+//-------------------------------------------------
+
+save_error state_rewinder::capture(const attotime &time)
+{
+	// if we have illegal registrations, return an error
+	if (m_save.m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// call the pre-save functions
+	m_save.dispatch_presave();
+
+	// the first snapshot lays out the flattened state and copies it in full
+	if (m_current.empty())
+	{
+		UINT32 total = 0;
+		for (auto &entry : m_save.m_entry_list)
+		{
+			entry->m_offset = total;
+			total += entry->m_typesize * entry->m_typecount;
+		}
+		if (total > m_capacity)
+		{
+			m_save.machine().logerror("Rewind: state size %u exceeds capacity of %u bytes\n", total, UINT32(m_capacity));
+			return STATERR_WRITE_ERROR;
+		}
+
+		m_current.resize(total);
+		for (auto &entry : m_save.m_entry_list)
+			memcpy(&m_current[entry->m_offset], entry->m_data, entry->m_typesize * entry->m_typecount);
+		m_current_time = time;
+		m_used = m_current.size();
+		return STATERR_NONE;
+	}
+
+	// compare block by block, saving the old contents of anything that changed
+	snapshot previous;
+	previous.m_time = m_current_time;
+	for (auto &entry : m_save.m_entry_list)
+	{
+		const UINT8 *data = reinterpret_cast<const UINT8 *>(entry->m_data);
+		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
+		for (UINT32 offs = 0; offs < totalsize; offs += REWIND_BLOCK_SIZE)
+		{
+			UINT32 length = std::min(totalsize - offs, REWIND_BLOCK_SIZE);
+			UINT8 *current = &m_current[entry->m_offset + offs];
+			if (memcmp(current, data + offs, length) == 0)
+				continue;
+
+			// extend the previous block if contiguous, otherwise start a new one
+			if (!previous.m_blocks.empty() && previous.m_blocks.back().m_offset + previous.m_blocks.back().m_length == entry->m_offset + offs)
+				previous.m_blocks.back().m_length += length;
+			else
+				previous.m_blocks.push_back({ entry->m_offset + offs, length });
+			previous.m_data.insert(previous.m_data.end(), current, current + length);
+			memcpy(current, data + offs, length);
+		}
+	}
+
+	// the new state becomes the newest snapshot
+	m_current_time = time;
+	m_used += previous.size();
+	m_history.push_back(std::move(previous));
+	trim();
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  restore - step back to a snapshot, discarding
+//  everything newer; 1 is the most recent one
+//-------------------------------------------------
+
+save_error state_rewinder::restore(int index)
+{
+	if (index < 1 || index > count())
+		return STATERR_READ_ERROR;
+
+	// undo the newer snapshots one at a time
+	while (--index > 0)
+	{
+		const snapshot &previous = m_history.back();
+		const UINT8 *data = previous.m_data.data();
+		for (const delta_block &block : previous.m_blocks)
+		{
+			memcpy(&m_current[block.m_offset], data, block.m_length);
+			data += block.m_length;
+		}
+		m_current_time = previous.m_time;
+		m_used -= previous.size();
+		m_history.pop_back();
+	}
+
+	// copy the result out and call the post-load functions
+	for (auto &entry : m_save.m_entry_list)
+		memcpy(entry->m_data, &m_current[entry->m_offset], entry->m_typesize * entry->m_typecount);
+	m_save.dispatch_postload();
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  clear - forget all snapshots
+//-------------------------------------------------
+
+void state_rewinder::clear()
+{
+	m_history.clear();
+	m_current.clear();
+	m_used = 0;
+}
+
+
+//-------------------------------------------------
+//  trim - drop the oldest snapshots until we fit
+//  within the memory budget
+//-------------------------------------------------
+
+void state_rewinder::trim()
+{
+	while (m_used > m_capacity && !m_history.empty())
+	{
+		m_used -= m_history.front().size();
+		m_history.pop_front();
+	}
+}
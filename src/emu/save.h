@@ -79,8 +79,12 @@ public:
 	UINT32              m_offset;               // offset within the final structure
 };
 
+class state_rewinder;
+
 class save_manager
 {
+	friend class state_rewinder;
+
 	// type_checker is a set of templates to identify valid save types
 	template<typename _ItemType> struct type_checker { static const bool is_atom = false; static const bool is_pointer = false; };
 	template<typename _ItemType> struct type_checker<_ItemType*> { static const bool is_atom = false; static const bool is_pointer = true; };
@@ -88,11 +92,13 @@ class save_manager
 public:
 	// construction/destruction
 	save_manager(running_machine &machine);
+	~save_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
 	int registration_count() const { return m_entry_list.size(); }
 	bool registration_allowed() const { return m_reg_allowed; }
+	state_rewinder *rewinder() const { return m_rewinder.get(); }
 
 	// registration control
 	void allow_registration(bool allowed = true);
@@ -153,6 +159,9 @@ public:
 	save_error write_file(emu_file &file);
 	save_error read_file(emu_file &file);
 
+	// in-memory rewind snapshots
+	void enable_rewind(size_t capacity);
+
 private:
 	// internal helpers
 	UINT32 signature() const;
@@ -177,6 +186,59 @@ private:
 	std::vector<std::unique_ptr<state_entry>> m_entry_list;          // list of reigstered entries
 	std::vector<std::unique_ptr<state_callback>> m_presave_list;     // list of pre-save functions
 	std::vector<std::unique_ptr<state_callback>> m_postload_list;    // list of post-load functions
+	std::unique_ptr<state_rewinder> m_rewinder;                      // in-memory rewind snapshots, if enabled
+};
+
+
+// ======================> state_rewinder
+
+// keeps a bounded history of in-memory snapshots; the newest one is held in
+// full, and each older one only as the blocks that differ from its successor
+class state_rewinder
+{
+public:
+	// construction/destruction
+	state_rewinder(save_manager &save, size_t capacity);
+
+	// getters
+	int count() const { return m_current.empty() ? 0 : (m_history.size() + 1); }
+	size_t capacity() const { return m_capacity; }
+	size_t memory_used() const { return m_used; }
+	attotime snapshot_time(int index) const;
+
+	// operations
+	save_error capture(const attotime &time);
+	save_error restore(int index);
+	void clear();
+
+private:
+	// a changed range within the flattened state
+	struct delta_block
+	{
+		UINT32              m_offset;               // offset within the flattened state
+		UINT32              m_length;               // number of bytes
+	};
+
+	// an older snapshot, stored as the contents needed to step back to it
+	struct snapshot
+	{
+		size_t size() const { return sizeof(*this) + m_blocks.size() * sizeof(delta_block) + m_data.size(); }
+
+		attotime            m_time;                 // emulated time of this snapshot
+		std::vector<delta_block> m_blocks;          // ranges that differ from the next snapshot
+		std::vector<UINT8>  m_data;                 // previous contents of those ranges
+	};
+
+	// internal helpers
+	void trim();
+
+	// internal state
+	save_manager &          m_save;                 // reference to the save manager
+	size_t                  m_capacity;             // memory budget in bytes
+	size_t                  m_used;                 // memory currently in use
+	std::vector<UINT8>      m_current;              // full contents of the newest snapshot
+	attotime                m_current_time;         // emulated time of the newest snapshot
+	std::deque<snapshot>    m_history;              // older snapshots, newest at the back
 };
 
 
@@ -48,6 +48,8 @@ emu_timer::emu_timer()
 	: m_machine(nullptr),
 		m_next(nullptr),
 		m_prev(nullptr),
+		m_heap_index(-1),
+		m_sequence(0),
 		m_param(0),
 		m_ptr(nullptr),
 		m_enabled(false),
@@ -81,6 +83,8 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 	m_machine = &machine;
 	m_next = nullptr;
 	m_prev = nullptr;
+	m_heap_index = -1;
+	m_sequence = 0;
 	m_callback = callback;
 	m_param = 0;
 	m_ptr = ptr;
@@ -113,6 +117,8 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 	m_machine = &device.machine();
 	m_next = nullptr;
 	m_prev = nullptr;
+	m_heap_index = -1;
+	m_sequence = 0;
 	m_callback = timer_expired_delegate();
 	m_param = 0;
 	m_ptr = ptr;
@@ -141,8 +147,10 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 
 emu_timer &emu_timer::release()
 {
-	// unhook us from the global list
-	machine().scheduler().timer_list_remove(*this);
+	// unhook us from the expiration queue and the global list
+	device_scheduler &scheduler = machine().scheduler();
+	scheduler.timer_queue_remove(*this);
+	scheduler.timer_list_remove(*this);
 	return *this;
 }
 
@@ -160,9 +168,8 @@ bool emu_timer::enable(bool enable)
 		// set the enable flag
 		m_enabled = enable;
 
-		// remove the timer and insert back into the list
-		machine().scheduler().timer_list_remove(*this);
-		machine().scheduler().timer_list_insert(*this);
+		// requeue the timer (or drop it from the queue if disabled)
+		machine().scheduler().timer_queue_reschedule(*this);
 	}
 	return old;
 }
@@ -194,9 +201,8 @@ void emu_timer::adjust(attotime start_delay, INT32 param, const attotime &period
 	m_expire = m_start + start_delay;
 	m_period = period;
 
-	// remove and re-insert the timer in its new order
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// move the timer to its new position in the queue
+	scheduler.timer_queue_reschedule(*this);
 
 	// if this was inserted as the head, abort the current timeslice and resync
 	if (this == scheduler.first_timer())
@@ -244,7 +250,7 @@ void emu_timer::register_save()
 	if (m_device == nullptr)
 	{
 		name = m_callback.name() ? m_callback.name() : "unnamed";
-		for (emu_timer *curtimer = machine().scheduler().first_timer(); curtimer != nullptr; curtimer = curtimer->next())
+		for (emu_timer *curtimer = machine().scheduler().m_timer_list; curtimer != nullptr; curtimer = curtimer->next())
 			if (!curtimer->m_temporary && curtimer->m_device == nullptr)
 			{
 				if (curtimer->m_callback.name() != nullptr && m_callback.name() != nullptr && strcmp(curtimer->m_callback.name(), m_callback.name()) == 0)
@@ -258,7 +264,7 @@ void emu_timer::register_save()
 	else
 	{
 		name = string_format("%s/%d", m_device->tag(), m_id);
-		for (emu_timer *curtimer = machine().scheduler().first_timer(); curtimer != nullptr; curtimer = curtimer->next())
+		for (emu_timer *curtimer = machine().scheduler().m_timer_list; curtimer != nullptr; curtimer = curtimer->next())
 			if (!curtimer->m_temporary && curtimer->m_device != nullptr && curtimer->m_device == m_device && curtimer->m_id == m_id)
 				index++;
 	}
@@ -283,10 +289,8 @@ inline void emu_timer::schedule_next_period()
 	m_start = m_expire;
 	m_expire += m_period;
 
-	// remove and re-insert us
-	device_scheduler &scheduler = machine().scheduler();
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// move us to our new position in the queue
+	machine().scheduler().timer_queue_reschedule(*this);
 }
 
 
@@ -320,15 +324,15 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_execute_list(nullptr),
 	m_basetime(attotime::zero),
 	m_timer_list(nullptr),
+	m_timer_sequence(0),
 	m_callback_timer(nullptr),
 	m_callback_timer_modified(false),
 	m_callback_timer_expire_time(attotime::zero),
 	m_suspend_changes_pending(true),
 	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000)
 {
-	// append a single never-expiring timer so there is always one in the list
-	m_timer_list = &m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), nullptr, true);
-	m_timer_list->adjust(attotime::never);
+	// append a single never-expiring timer so there is always one in the queue
+	m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), nullptr, true).adjust(attotime::never);
 
 	// register global states
 	machine.save().save_item(NAME(m_basetime));
@@ -428,14 +432,14 @@ void device_scheduler::timeslice()
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (m_basetime < first_timer()->m_expire)
 	{
 		// by default, assume our target is the end of the next quantum
 		attotime target(m_basetime + attotime(0, m_quantum_list.first()->m_actual));
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (first_timer()->m_expire < target)
+			target = first_timer()->m_expire;
 
 		LOG(("------------------\n"));
 		LOG(("cpu_timeslice: target = %s\n", target.as_string(PRECISION)));
@@ -666,25 +670,34 @@ void device_scheduler::presave()
 
 void device_scheduler::postload()
 {
-	// remove all timers and make a private list of permanent ones
-	simple_list<emu_timer> private_list;
-	while (m_timer_list != nullptr)
+	// temporary timers go away entirely (except our special never-expiring one)
+	emu_timer *nexttimer;
+	for (emu_timer *timer = m_timer_list; timer != nullptr; timer = nexttimer)
 	{
-		emu_timer &timer = *m_timer_list;
-
-		// temporary timers go away entirely (except our special never-expiring one)
-		if (timer.m_temporary && !timer.expire().is_never())
-			m_timer_allocator.reclaim(timer.release());
-
-		// permanent ones get added to our private list
-		else
-			private_list.append(timer_list_remove(timer));
+		nexttimer = timer->next();
+		if (timer->m_temporary && !timer->expire().is_never())
+			m_timer_allocator.reclaim(timer->release());
 	}
 
-	// now re-insert them; this effectively re-sorts them by time
-	emu_timer *timer;
-	while ((timer = private_list.detach_head()) != nullptr)
-		timer_list_insert(*timer);
+	// gather the survivors in their previous queue order, followed by the ones that were not
+	// queued; the loaded expiration times make the heap itself meaningless at this point
+	std::vector<emu_timer *> timers;
+	for (emu_timer *timer = m_timer_list; timer != nullptr; timer = timer->next())
+		timers.push_back(timer);
+	std::stable_sort(timers.begin(), timers.end(), [](const emu_timer *a, const emu_timer *b)
+	{
+		if ((a->m_heap_index < 0) != (b->m_heap_index < 0))
+			return b->m_heap_index < 0;
+		return a->m_sequence < b->m_sequence;
+	});
+
+	// now re-queue the enabled ones; this effectively re-sorts them by time
+	for (emu_timer *timer : m_timer_heap)
+		timer->m_heap_index = -1;
+	m_timer_heap.clear();
+	for (emu_timer *timer : timers)
+		if (timer->m_enabled)
+			timer_queue_insert(*timer);
 
 	m_suspend_changes_pending = true;
 	rebuild_execute_list();
@@ -808,51 +821,25 @@ void device_scheduler::rebuild_execute_list()
 
 
 //-------------------------------------------------
-//  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  timer_list_insert - add a newly-initialized
+//  timer to the list of all timers
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
 {
-	// disabled timers sort to the end
-	const attotime &expire = timer.m_enabled ? timer.m_expire : attotime::never;
-
-	// loop over the timer list
-	emu_timer *prevtimer = nullptr;
-	for (emu_timer *curtimer = m_timer_list; curtimer != nullptr; prevtimer = curtimer, curtimer = curtimer->next())
-	{
-		// if the current list entry expires after us, we should be inserted before it
-		if (curtimer->m_expire > expire)
-		{
-			// link the new guy in before the current list entry
-			timer.m_prev = curtimer->m_prev;
-			timer.m_next = curtimer;
-
-			if (curtimer->m_prev != nullptr)
-				curtimer->m_prev->m_next = &timer;
-			else
-				m_timer_list = &timer;
-
-			curtimer->m_prev = &timer;
-			return timer;
-		}
-	}
-
-	// need to insert after the last one
-	if (prevtimer != nullptr)
-		prevtimer->m_next = &timer;
-	else
-		m_timer_list = &timer;
-
-	timer.m_prev = prevtimer;
-	timer.m_next = nullptr;
+	// order doesn't matter here, so just link at the head
+	timer.m_prev = nullptr;
+	timer.m_next = m_timer_list;
+	if (m_timer_list != nullptr)
+		m_timer_list->m_prev = &timer;
+	m_timer_list = &timer;
 	return timer;
 }
 
 
 //-------------------------------------------------
 //  timer_list_remove - remove a timer from the
-//  linked list
+//  list of all timers
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
@@ -866,23 +853,151 @@ emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 	if (timer.m_next != nullptr)
 		timer.m_next->m_prev = timer.m_prev;
 
+	timer.m_next = timer.m_prev = nullptr;
 	return timer;
 }
 
 
+//-------------------------------------------------
+//  timer_queue_insert - insert an enabled timer
+//  into the expiration heap
+//-------------------------------------------------
+
+void device_scheduler::timer_queue_insert(emu_timer &timer)
+{
+	assert(timer.m_enabled);
+	assert(timer.m_heap_index < 0);
+	g_profiler.count(PROFILER_COUNT_TIMER_INSERT);
+
+	timer.m_sequence = m_timer_sequence++;
+	timer.m_heap_index = m_timer_heap.size();
+	m_timer_heap.push_back(&timer);
+	timer_queue_sift_up(timer.m_heap_index);
+}
+
+
+//-------------------------------------------------
+//  timer_queue_remove - remove a timer from the
+//  expiration heap, if it is there
+//-------------------------------------------------
+
+void device_scheduler::timer_queue_remove(emu_timer &timer)
+{
+	if (timer.m_heap_index < 0)
+		return;
+	g_profiler.count(PROFILER_COUNT_TIMER_REMOVE);
+
+	// move the last entry into the hole and restore the heap property around it
+	UINT32 index = timer.m_heap_index;
+	emu_timer *last = m_timer_heap.back();
+	m_timer_heap.pop_back();
+	timer.m_heap_index = -1;
+	if (last != &timer)
+	{
+		m_timer_heap[index] = last;
+		last->m_heap_index = index;
+		timer_queue_sift_up(index);
+		timer_queue_sift_down(last->m_heap_index);
+	}
+}
+
+
+//-------------------------------------------------
+//  timer_queue_reschedule - move a timer to the
+//  right place in the heap after its expiration
+//  time or enabled state changed
+//-------------------------------------------------
+
+void device_scheduler::timer_queue_reschedule(emu_timer &timer)
+{
+	// disabled timers are not queued at all
+	if (!timer.m_enabled)
+		timer_queue_remove(timer);
+
+	// not yet queued: a plain insert
+	else if (timer.m_heap_index < 0)
+		timer_queue_insert(timer);
+
+	// otherwise, requeue behind anything with the same expiration time and re-sift in place
+	else
+	{
+		g_profiler.count(PROFILER_COUNT_TIMER_REMOVE);
+		g_profiler.count(PROFILER_COUNT_TIMER_INSERT);
+		timer.m_sequence = m_timer_sequence++;
+		timer_queue_sift_up(timer.m_heap_index);
+		timer_queue_sift_down(timer.m_heap_index);
+	}
+}
+
+
+//-------------------------------------------------
+//  timer_queue_sift_up - move a heap entry toward
+//  the root until its parent expires before it
+//-------------------------------------------------
+
+void device_scheduler::timer_queue_sift_up(UINT32 index)
+{
+	emu_timer *const timer = m_timer_heap[index];
+	while (index > 0)
+	{
+		UINT32 parent = (index - 1) / 2;
+		emu_timer *const parenttimer = m_timer_heap[parent];
+		if (!timer->expires_before(*parenttimer))
+			break;
+		m_timer_heap[index] = parenttimer;
+		parenttimer->m_heap_index = index;
+		index = parent;
+	}
+	m_timer_heap[index] = timer;
+	timer->m_heap_index = index;
+}
+
+
+//-------------------------------------------------
+//  timer_queue_sift_down - move a heap entry
+//  toward the leaves until both children expire
+//  after it
+//-------------------------------------------------
+
+void device_scheduler::timer_queue_sift_down(UINT32 index)
+{
+	emu_timer *const timer = m_timer_heap[index];
+	const UINT32 count = m_timer_heap.size();
+	while (true)
+	{
+		// pick the child that expires first
+		UINT32 child = index * 2 + 1;
+		if (child >= count)
+			break;
+		if (child + 1 < count && m_timer_heap[child + 1]->expires_before(*m_timer_heap[child]))
+			child++;
+
+		// stop once we expire before it
+		emu_timer *const childtimer = m_timer_heap[child];
+		if (!childtimer->expires_before(*timer))
+			break;
+		m_timer_heap[index] = childtimer;
+		childtimer->m_heap_index = index;
+		index = child;
+	}
+	m_timer_heap[index] = timer;
+	timer->m_heap_index = index;
+}
+
+
 //-------------------------------------------------
 //  execute_timers - execute timers that are due
 //-------------------------------------------------
 
 inline void device_scheduler::execute_timers()
 {
-	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_list->m_expire.as_string(PRECISION)));
+	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), first_timer()->m_expire.as_string(PRECISION)));
 
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (first_timer()->m_expire <= m_basetime)
 	{
 		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = *first_timer();
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period.is_zero() || timer.m_period.is_never())
 			timer.m_enabled = false;
@@ -896,6 +1011,7 @@ inline void device_scheduler::execute_timers()
 		if (was_enabled)
 		{
 			g_profiler.start(PROFILER_TIMER_CALLBACK);
+			g_profiler.count(PROFILER_COUNT_TIMER_CALLBACK);
 
 			if (timer.m_device != nullptr)
 			{
@@ -982,7 +1098,7 @@ void device_scheduler::dump_timers() const
 {
 	machine().logerror("=============================================\n");
 	machine().logerror("Timer Dump: Time = %15s\n", time().as_string(PRECISION));
-	for (emu_timer *timer = first_timer(); timer != nullptr; timer = timer->next())
+	for (emu_timer *timer = m_timer_list; timer != nullptr; timer = timer->next())
 		timer->dump();
 	machine().logerror("=============================================\n");
 }
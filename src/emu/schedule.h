@@ -61,7 +61,7 @@ class emu_timer
 
 public:
 	// getters
-	emu_timer *next() const { return m_next; }
+	emu_timer *next() const { return m_next; }      // next in allocation order, not expiration order
 	running_machine &machine() const { assert(m_machine != nullptr); return *m_machine; }
 	bool enabled() const { return m_enabled; }
 	int param() const { return m_param; }
@@ -88,10 +88,18 @@ private:
 	void schedule_next_period();
 	void dump() const;
 
+	// queue ordering: timers with equal expiration times fire in the order they were queued
+	bool expires_before(const emu_timer &other) const
+	{
+		return (m_expire != other.m_expire) ? (m_expire < other.m_expire) : (m_sequence < other.m_sequence);
+	}
+
 	// internal state
 	running_machine *   m_machine;      // reference to the owning machine
-	emu_timer *         m_next;         // next timer in order in the list
-	emu_timer *         m_prev;         // previous timer in order in the list
+	emu_timer *         m_next;         // next timer in the list of all timers
+	emu_timer *         m_prev;         // previous timer in the list of all timers
+	INT32               m_heap_index;   // index in the scheduler's expiration heap, or -1 if not queued
+	UINT64              m_sequence;     // insertion sequence, used to keep equal expirations in FIFO order
 	timer_expired_delegate m_callback;  // callback function
 	INT32               m_param;        // integer parameter
 	void *              m_ptr;          // pointer parameter
@@ -120,7 +128,7 @@ public:
 	// getters
 	running_machine &machine() const { return m_machine; }
 	attotime time() const;
-	emu_timer *first_timer() const { return m_timer_list; }
+	emu_timer *first_timer() const { return m_timer_heap.front(); }
 	device_execute_interface *currently_executing() const { return m_executing_device; }
 	bool can_save() const;
 
@@ -162,6 +170,11 @@ private:
 	// timer helpers
 	emu_timer &timer_list_insert(emu_timer &timer);
 	emu_timer &timer_list_remove(emu_timer &timer);
+	void timer_queue_insert(emu_timer &timer);
+	void timer_queue_remove(emu_timer &timer);
+	void timer_queue_reschedule(emu_timer &timer);
+	void timer_queue_sift_up(UINT32 index);
+	void timer_queue_sift_down(UINT32 index);
 	void execute_timers();
 
 	// internal state
@@ -170,8 +183,10 @@ private:
 	device_execute_interface *  m_execute_list;             // list of devices to be executed
 	attotime                    m_basetime;                 // global basetime; everything moves forward from here
 
-	// list of active timers
-	emu_timer *                 m_timer_list;               // head of the active list
+	// timers: every allocated timer lives in the list; enabled ones are also queued in a binary heap
+	emu_timer *                 m_timer_list;               // head of the list of all timers
+	std::vector<emu_timer *>    m_timer_heap;               // heap of enabled timers, soonest first
+	UINT64                      m_timer_sequence;           // next insertion sequence number
 	fixed_allocator<emu_timer>  m_timer_allocator;          // allocator for timers
 
 	// other internal states
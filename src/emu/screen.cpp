@@ -1546,6 +1546,11 @@ bool screen_device::update_quads()
 			if (!machine().video().skip_this_frame() && m_changed)
 			{
 				m_texture[m_curbitmap]->set_bitmap(m_bitmap[m_curbitmap], m_visarea, m_bitmap[m_curbitmap].texformat());
+
+				// tell the renderer how much actually differs from the frame being displayed,
+				// if there's a renderer that cares; comparing the frames isn't free
+				if (m_curtexture != m_curbitmap && machine().render().tracks_damage())
+					m_texture[m_curbitmap]->set_damage(*m_texture[m_curtexture], changed_area(m_bitmap[m_curtexture], m_bitmap[m_curbitmap]));
 				m_curtexture = m_curbitmap;
 				m_curbitmap = 1 - m_curbitmap;
 			}
@@ -1566,6 +1571,46 @@ bool screen_device::update_quads()
 }
 
 
+//-------------------------------------------------
+//  changed_area - return the part of the visible
+//  area where two screen bitmaps differ
+//-------------------------------------------------
+
+rectangle screen_device::changed_area(const screen_bitmap &before, const screen_bitmap &after) const
+{
+	// assume the worst if they can't be compared
+	if (!before.valid() || !after.valid() || before.format() != after.format() || !before.cliprect().contains(m_visarea) || !after.cliprect().contains(m_visarea))
+		return m_visarea;
+
+	const int bytes = after.bpp() / 8;
+	const int rowbytes = m_visarea.width() * bytes;
+	rectangle result(0, -1, 0, -1);
+	for (int y = m_visarea.min_y; y <= m_visarea.max_y; y++)
+	{
+		const UINT8 *src0 = reinterpret_cast<const UINT8 *>(before.raw_pixptr(y, m_visarea.min_x));
+		const UINT8 *src1 = reinterpret_cast<const UINT8 *>(after.raw_pixptr(y, m_visarea.min_x));
+		if (memcmp(src0, src1, rowbytes) == 0)
+			continue;
+
+		// find the first and last differing bytes, but only look outside what we already have
+		int left = 0, right = rowbytes - 1;
+		int leftstop = result.empty() ? rowbytes : (result.min_x - m_visarea.min_x) * bytes;
+		int rightstop = result.empty() ? -1 : (result.max_x - m_visarea.min_x) * bytes + bytes - 1;
+		while (left < leftstop && src0[left] == src1[left])
+			left++;
+		while (right > rightstop && src0[right] == src1[right])
+			right--;
+
+		rectangle row(m_visarea.min_x + left / bytes, m_visarea.min_x + right / bytes, y, y);
+		if (result.empty())
+			result = row;
+		else
+			result |= row;
+	}
+	return result;
+}
+
+
 //-------------------------------------------------
 //  update_burnin - update the burnin bitmap
 //-------------------------------------------------
@@ -134,6 +134,7 @@ public:
 	bool valid() const { return live().valid(); }
 	palette_t *palette() const { return live().palette(); }
 	const rectangle &cliprect() const { return live().cliprect(); }
+	const void *raw_pixptr(INT32 y, INT32 x = 0) const { return live().raw_pixptr(y, x); }
 
 	// operations
 	void set_palette(palette_t *palette) { live().set_palette(palette); }
@@ -287,6 +288,7 @@ private:
 	void vblank_end();
 	void finalize_burnin();
 	void load_effect_overlay(const char *filename);
+	rectangle changed_area(const screen_bitmap &before, const screen_bitmap &after) const;
 
 	// inline configuration data
 	screen_type_enum    m_type;                     // type of screen
@@ -65,6 +65,7 @@ private:
 class software_part
 {
 	friend class softlist_parser;
+	friend class softlist_index;
 
 public:
 	// construction/destruction
@@ -103,6 +104,7 @@ private:
 class software_info
 {
 	friend class softlist_parser;
+	friend class softlist_index;
 
 public:
 	// construction/destruction
@@ -84,7 +84,8 @@ software_list_device::software_list_device(const machine_config &mconfig, const
 	m_filter(nullptr),
 	m_parsed(false),
 	m_file(mconfig.options().hash_path(), OPEN_FLAG_READ),
-	m_description("")
+	m_description(""),
+	m_index_checked(false)
 {
 }
 
@@ -142,6 +143,48 @@ void software_list_device::find_approx_matches(const std::string &name, int matc
 		list[matchnum] = nullptr;
 	}
 
+	// insert into the sorted table of matches
+	auto const insert = [&penalty, list, matches] (const software_info &swinfo, int curpenalty)
+	{
+		for (int matchnum = matches - 1; matchnum >= 0; matchnum--)
+		{
+			// stop if we're worse than the current entry
+			if (curpenalty >= penalty[matchnum])
+				break;
+
+			// as long as this isn't the last entry, bump this one down
+			if (matchnum < matches - 1)
+			{
+				penalty[matchnum + 1] = penalty[matchnum];
+				list[matchnum + 1] = list[matchnum];
+			}
+			list[matchnum] = &swinfo;
+			penalty[matchnum] = curpenalty;
+		}
+	};
+
+	// if the list hasn't been parsed yet, rank by the names in the index and only
+	// build the items that would make it into the table
+	if (!m_parsed && open_index())
+	{
+		for (UINT32 index = 0; index < m_index.count(); index++)
+		{
+			if (interface != nullptr && !m_index.matches_interface(index, interface))
+				continue;
+
+			int longpenalty = driver_list::penalty_compare(name.c_str(), m_index.longname(index));
+			int shortpenalty = driver_list::penalty_compare(name.c_str(), m_index.shortname(index));
+			int curpenalty = std::min(longpenalty, shortpenalty);
+			if (curpenalty >= penalty[matches - 1])
+				continue;
+
+			const software_info &swinfo = indexed_info(index);
+			if (is_compatible(swinfo.parts().front()) == SOFTWARE_IS_COMPATIBLE)
+				insert(swinfo, curpenalty);
+		}
+		return;
+	}
+
 	// iterate over our info (will cause a parse if needed)
 	for (const software_info &swinfo : get_info())
 	{
@@ -152,23 +195,7 @@ void software_list_device::find_approx_matches(const std::string &name, int matc
 			int longpenalty = driver_list::penalty_compare(name.c_str(), swinfo.longname().c_str());
 			int shortpenalty = driver_list::penalty_compare(name.c_str(), swinfo.shortname().c_str());
 			int curpenalty = std::min(longpenalty, shortpenalty);
-
-			// insert into the sorted table of matches
-			for (int matchnum = matches - 1; matchnum >= 0; matchnum--)
-			{
-				// stop if we're worse than the current entry
-				if (curpenalty >= penalty[matchnum])
-					break;
-
-				// as long as this isn't the last entry, bump this one down
-				if (matchnum < matches - 1)
-				{
-					penalty[matchnum + 1] = penalty[matchnum];
-					list[matchnum + 1] = list[matchnum];
-				}
-				list[matchnum] = &swinfo;
-				penalty[matchnum] = curpenalty;
-			}
+			insert(swinfo, curpenalty);
 		}
 	}
 }
@@ -185,6 +212,10 @@ void software_list_device::release()
 	m_description.clear();
 	m_errors.clear();
 	m_infolist.clear();
+	m_index_checked = false;
+	m_index.reset();
+	m_indexed_map.clear();
+	m_indexed.clear();
 }
 
 
@@ -260,6 +291,13 @@ const software_info *software_list_device::find(const std::string &look_for)
 
 	const bool iswild = look_for.find_first_of("*?") != std::string::npos;
 
+	// an exact name can be answered from the index without parsing the list
+	if (!iswild && !m_parsed && open_index())
+	{
+		int const index = m_index.find(look_for.c_str());
+		return (index >= 0) ? &indexed_info(index) : nullptr;
+	}
+
 	// find a match (will cause a parse if needed when calling get_info)
 	const auto &info_list = get_info();
 	auto iter = std::find_if(
@@ -291,6 +329,15 @@ void software_list_device::parse()
 	// reset the errors
 	m_errors.clear();
 
+	// a current index saves parsing the XML altogether
+	if (open_index())
+	{
+		m_index.build_all(m_infolist);
+		m_index.reset();
+		m_parsed = true;
+		return;
+	}
+
 	// attempt to open the file
 	osd_file::error filerr = m_file.open(m_list_name.c_str(), ".xml");
 	if (filerr == osd_file::error::NONE)
@@ -298,8 +345,18 @@ void software_list_device::parse()
 		// parse if no error
 		std::ostringstream errs;
 		softlist_parser parser(m_file, m_file.filename(), m_description, m_infolist, errs);
+		std::string const listpath(m_file.fullpath());
 		m_file.close();
 		m_errors = errs.str();
+
+		// write an index for next time if the list is clean and is a plain file
+		std::unique_ptr<osd::directory::entry> const stat = osd_stat(listpath);
+		if (m_errors.empty() && !m_infolist.empty() && stat && (stat->type == osd::directory::entry::entry_type::FILE))
+		{
+			std::string const indexname = softlist_index::index_filename(listpath);
+			if (!softlist_index::save(indexname, stat->size, stat->last_modified.time_since_epoch().count(), m_description, m_infolist))
+				osd_printf_verbose("Unable to write software list index %s\n", indexname.c_str());
+		}
 	}
 	else
 		m_errors = string_format("Error opening file: %s\n", filename());
@@ -309,6 +366,52 @@ void software_list_device::parse()
 }
 
 
+//-------------------------------------------------
+//  open_index - load the binary index of our list
+//  if there is one and it is still current
+//-------------------------------------------------
+
+bool software_list_device::open_index()
+{
+	// only look once until released
+	if (m_index_checked)
+		return m_index.loaded();
+	m_index_checked = true;
+
+	if (m_file.open(m_list_name.c_str(), ".xml") != osd_file::error::NONE)
+		return false;
+	std::string const listpath(m_file.fullpath());
+	m_file.close();
+
+	// lists found inside archives have no stamp to check against
+	std::unique_ptr<osd::directory::entry> const stat = osd_stat(listpath);
+	if (!stat || (stat->type != osd::directory::entry::entry_type::FILE))
+		return false;
+	if (!m_index.load(softlist_index::index_filename(listpath), stat->size, stat->last_modified.time_since_epoch().count()))
+		return false;
+
+	m_description = m_index.description();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  indexed_info - build a single item from the
+//  index, once
+//-------------------------------------------------
+
+const software_info &software_list_device::indexed_info(UINT32 index)
+{
+	auto const found = m_indexed_map.find(index);
+	if (found != m_indexed_map.end())
+		return *found->second;
+
+	const software_info &info = m_index.build(index, m_indexed);
+	m_indexed_map.emplace(index, &info);
+	return info;
+}
+
+
 //-------------------------------------------------
 //  is_compatible - determine if we are compatible
 //  with the given software_list_device
@@ -12,6 +12,7 @@
 #define __SOFTLIST_DEV_H_
 
 #include "softlist.h"
+#include "softlist_index.h"
 
 
 //**************************************************************************
@@ -145,7 +146,7 @@ public:
 	const char *filename() { return m_file.filename(); }
 
 	// getters that may trigger a parse
-	const std::string &description() { if (!m_parsed) parse(); return m_description; }
+	const std::string &description() { if (!m_parsed && !open_index()) parse(); return m_description; }
 	bool valid() { if (!m_parsed) parse(); return !m_infolist.empty(); }
 	const char *errors_string() { if (!m_parsed) parse(); return m_errors.c_str(); }
 	const std::list<software_info> &get_info() { if (!m_parsed) parse(); return m_infolist; }
@@ -169,6 +170,8 @@ protected:
 private:
 	// internal helpers
 	void parse();
+	bool open_index();
+	const software_info &indexed_info(UINT32 index);
 	void internal_validity_check(validity_checker &valid) ATTR_COLD;
 
 	// configuration state
@@ -182,6 +185,12 @@ private:
 	std::string                 m_description;
 	std::string                 m_errors;
 	std::list<software_info>    m_infolist;
+
+	// binary index, used for lookups ahead of a full parse
+	bool                        m_index_checked;
+	softlist_index              m_index;
+	std::list<software_info>    m_indexed;
+	std::unordered_map<UINT32, const software_info *> m_indexed_map;
 };
 
 
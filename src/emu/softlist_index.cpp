@@ -0,0 +1,554 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    softlist_index.cpp
+
+    Precompiled binary index of a software list.
+
+    File layout (native byte order, every section 4-byte aligned):
+
+        header
+        software_record[software_count]    in list order
+        UINT32[software_count]             software indices sorted by name
+        part_record[part_count]
+        feature_record[feature_count]      other info, shared info, features
+        rom_record[rom_count]
+        char[string_size]                  NUL-terminated strings
+
+    Strings are referred to by their offset in the string table; offset 0
+    is always the empty string.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "softlist_index.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+namespace {
+
+// stored in native byte order, so an index written on a host of the other
+// endianness simply fails to load and gets rebuilt
+const UINT32 INDEX_MAGIC    = 0x49574c53;   // 'SLWI'
+const UINT32 INDEX_VERSION  = 1;
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//  FILE FORMAT
+//**************************************************************************
+
+struct softlist_index::header
+{
+	UINT32      magic;
+	UINT32      version;
+	UINT64      list_size;          // stamp of the list file the index was built from
+	INT64       list_modified;
+	UINT32      crc;                // CRC-32 of everything following the header
+	UINT32      description;
+	UINT32      software_count;
+	UINT32      part_count;
+	UINT32      feature_count;
+	UINT32      rom_count;
+	UINT32      string_size;
+	UINT32      reserved;
+};
+
+struct softlist_index::software_record
+{
+	UINT32      shortname;
+	UINT32      longname;
+	UINT32      parentname;
+	UINT32      year;
+	UINT32      publisher;
+	UINT32      supported;
+	UINT32      first_info;
+	UINT32      info_count;
+	UINT32      first_shared;
+	UINT32      shared_count;
+	UINT32      first_part;
+	UINT32      part_count;
+};
+
+struct softlist_index::part_record
+{
+	UINT32      name;
+	UINT32      interface;
+	UINT32      first_feature;
+	UINT32      feature_count;
+	UINT32      first_rom;
+	UINT32      rom_count;
+};
+
+struct softlist_index::feature_record
+{
+	UINT32      name;
+	UINT32      value;
+};
+
+struct softlist_index::rom_record
+{
+	UINT32      name;
+	UINT32      hashdata;
+	UINT32      offset;
+	UINT32      length;
+	UINT32      flags;
+};
+
+
+namespace {
+
+//-------------------------------------------------
+//  section - locate a record array within the
+//  index data
+//-------------------------------------------------
+
+template <typename T>
+inline const T *section(const std::vector<UINT8> &data, std::size_t offset)
+{
+	return reinterpret_cast<const T *>(&data[0] + offset);
+}
+
+
+//-------------------------------------------------
+//  string_table - deduplicating string table
+//  builder; offset 0 is the empty string
+//-------------------------------------------------
+
+class string_table
+{
+public:
+	string_table() : m_data(1, '\0') { }
+
+	UINT32 add(const std::string &str)
+	{
+		if (str.empty())
+			return 0;
+		auto const found = m_offsets.find(str);
+		if (found != m_offsets.end())
+			return found->second;
+		UINT32 const offset = UINT32(m_data.size());
+		m_data.insert(m_data.end(), str.begin(), str.end());
+		m_data.push_back('\0');
+		m_offsets.emplace(str, offset);
+		return offset;
+	}
+
+	std::vector<char> &data()
+	{
+		while (m_data.size() % 4)
+			m_data.push_back('\0');
+		return m_data;
+	}
+
+private:
+	std::vector<char>                           m_data;
+	std::unordered_map<std::string, UINT32>     m_offsets;
+};
+
+
+//-------------------------------------------------
+//  append - append raw records to the output
+//-------------------------------------------------
+
+template <typename T>
+inline void append(std::vector<UINT8> &data, const std::vector<T> &records)
+{
+	if (!records.empty())
+	{
+		const UINT8 *const start = reinterpret_cast<const UINT8 *>(&records[0]);
+		data.insert(data.end(), start, start + (records.size() * sizeof(T)));
+	}
+}
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//  SOFTWARE LIST INDEX
+//**************************************************************************
+
+//-------------------------------------------------
+//  softlist_index - constructor
+//-------------------------------------------------
+
+softlist_index::softlist_index()
+{
+}
+
+
+//-------------------------------------------------
+//  index_filename - name of the index kept beside
+//  a list file
+//-------------------------------------------------
+
+std::string softlist_index::index_filename(const std::string &listpath)
+{
+	std::string result(listpath);
+	if ((result.length() > 4) && !core_stricmp(result.c_str() + result.length() - 4, ".xml"))
+		result.resize(result.length() - 4);
+	return result.append(".idx");
+}
+
+
+//-------------------------------------------------
+//  load - read an index and make sure it is intact
+//  and still matches the list file
+//-------------------------------------------------
+
+bool softlist_index::load(const std::string &filename, UINT64 list_size, INT64 list_modified)
+{
+	reset();
+	if (util::core_file::load(filename, m_data) != osd_file::error::NONE)
+		return false;
+
+	if (!check() || (head().list_size != list_size) || (head().list_modified != list_modified))
+	{
+		reset();
+		return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  save - write an index for a parsed list
+//-------------------------------------------------
+
+bool softlist_index::save(const std::string &filename, UINT64 list_size, INT64 list_modified, const std::string &description, const std::list<software_info> &infolist)
+{
+	string_table strings;
+	std::vector<software_record> softwares;
+	std::vector<part_record> parts;
+	std::vector<feature_record> features;
+	std::vector<rom_record> roms;
+
+	auto const add_features = [&strings, &features] (const std::list<feature_list_item> &list)
+	{
+		for (const feature_list_item &item : list)
+			features.push_back(feature_record{ strings.add(item.name()), strings.add(item.value()) });
+		return UINT32(list.size());
+	};
+
+	// flatten the list
+	UINT32 const descoffset = strings.add(description);
+	softwares.reserve(infolist.size());
+	for (const software_info &swinfo : infolist)
+	{
+		software_record sw;
+		sw.shortname = strings.add(swinfo.shortname());
+		sw.longname = strings.add(swinfo.longname());
+		sw.parentname = strings.add(swinfo.parentname());
+		sw.year = strings.add(swinfo.year());
+		sw.publisher = strings.add(swinfo.publisher());
+		sw.supported = swinfo.supported();
+		sw.first_info = UINT32(features.size());
+		sw.info_count = add_features(swinfo.other_info());
+		sw.first_shared = UINT32(features.size());
+		sw.shared_count = add_features(swinfo.shared_info());
+		sw.first_part = UINT32(parts.size());
+		sw.part_count = UINT32(swinfo.parts().size());
+		for (const software_part &swpart : swinfo.parts())
+		{
+			part_record part;
+			part.name = strings.add(swpart.name());
+			part.interface = strings.add(swpart.interface());
+			part.first_feature = UINT32(features.size());
+			part.feature_count = add_features(swpart.featurelist());
+			part.first_rom = UINT32(roms.size());
+			part.rom_count = UINT32(swpart.romdata().size());
+			for (const rom_entry &rom : swpart.romdata())
+				roms.push_back(rom_record{ strings.add(rom.name()), strings.add(rom.hashdata()), rom.offset(), rom.length(), rom.flags() });
+			parts.push_back(part);
+		}
+		softwares.push_back(sw);
+	}
+
+	// sort the name table; ties keep list order so lookups find the first entry like a linear search would
+	std::vector<char> &stringdata = strings.data();
+	std::vector<UINT32> names(softwares.size());
+	for (UINT32 index = 0; index < names.size(); index++)
+		names[index] = index;
+	std::stable_sort(names.begin(), names.end(), [&stringdata, &softwares] (UINT32 a, UINT32 b)
+	{
+		return core_stricmp(&stringdata[softwares[a].shortname], &stringdata[softwares[b].shortname]) < 0;
+	});
+
+	// assemble the image
+	header head;
+	memset(&head, 0, sizeof(head));
+	head.magic = INDEX_MAGIC;
+	head.version = INDEX_VERSION;
+	head.list_size = list_size;
+	head.list_modified = list_modified;
+	head.description = descoffset;
+	head.software_count = UINT32(softwares.size());
+	head.part_count = UINT32(parts.size());
+	head.feature_count = UINT32(features.size());
+	head.rom_count = UINT32(roms.size());
+	head.string_size = UINT32(stringdata.size());
+
+	std::vector<UINT8> data(sizeof(head));
+	append(data, softwares);
+	append(data, names);
+	append(data, parts);
+	append(data, features);
+	append(data, roms);
+	append(data, stringdata);
+	head.crc = util::crc32_creator::simple(&data[sizeof(head)], UINT32(data.size() - sizeof(head)));
+	memcpy(&data[0], &head, sizeof(head));
+
+	// write it out
+	util::core_file::ptr file;
+	if (util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, file) != osd_file::error::NONE)
+		return false;
+	return file->write(&data[0], data.size()) == data.size();
+}
+
+
+//-------------------------------------------------
+//  reset - drop the loaded index
+//-------------------------------------------------
+
+void softlist_index::reset()
+{
+	m_data.clear();
+	m_data.shrink_to_fit();
+}
+
+
+//-------------------------------------------------
+//  description - the list description
+//-------------------------------------------------
+
+const char *softlist_index::description() const
+{
+	return string(head().description);
+}
+
+
+//-------------------------------------------------
+//  count - number of software items
+//-------------------------------------------------
+
+UINT32 softlist_index::count() const
+{
+	return loaded() ? head().software_count : 0;
+}
+
+
+//-------------------------------------------------
+//  find - binary search for a software item by
+//  short name, ignoring case; returns -1 if not
+//  found
+//-------------------------------------------------
+
+int softlist_index::find(const char *shortname) const
+{
+	if (!loaded())
+		return -1;
+
+	const header &hdr = head();
+	const UINT32 *const names = section<UINT32>(m_data, sizeof(header) + (hdr.software_count * sizeof(software_record)));
+	const UINT32 *const end = names + hdr.software_count;
+	const UINT32 *const found = std::lower_bound(names, end, shortname, [this] (UINT32 index, const char *name)
+	{
+		return core_stricmp(string(software(index).shortname), name) < 0;
+	});
+	if ((found == end) || core_stricmp(string(software(*found).shortname), shortname))
+		return -1;
+	return int(*found);
+}
+
+
+//-------------------------------------------------
+//  shortname/longname - names of a software item
+//-------------------------------------------------
+
+const char *softlist_index::shortname(UINT32 index) const
+{
+	return string(software(index).shortname);
+}
+
+const char *softlist_index::longname(UINT32 index) const
+{
+	return string(software(index).longname);
+}
+
+
+//-------------------------------------------------
+//  matches_interface - determine if the first
+//  part of a software item matches an interface
+//  in the provided list, as software_part does
+//-------------------------------------------------
+
+bool softlist_index::matches_interface(UINT32 index, const char *interface) const
+{
+	const software_record &sw = software(index);
+	if (sw.part_count == 0)
+		return false;
+
+	const header &hdr = head();
+	const part_record *const parts = section<part_record>(m_data, sizeof(header) + (hdr.software_count * (sizeof(software_record) + sizeof(UINT32))));
+	const char *const ours = string(parts[sw.first_part].interface);
+	if (*ours == '\0')
+		return true;
+
+	std::string const interfaces = std::string(interface).append(",");
+	return interfaces.find(std::string(ours).append(",")) != std::string::npos;
+}
+
+
+//-------------------------------------------------
+//  build - append the software_info for a single
+//  item to a list
+//-------------------------------------------------
+
+software_info &softlist_index::build(UINT32 index, std::list<software_info> &infolist) const
+{
+	const header &hdr = head();
+	std::size_t offset = sizeof(header) + (hdr.software_count * (sizeof(software_record) + sizeof(UINT32)));
+	const part_record *const parts = section<part_record>(m_data, offset);
+	offset += hdr.part_count * sizeof(part_record);
+	const feature_record *const features = section<feature_record>(m_data, offset);
+	offset += hdr.feature_count * sizeof(feature_record);
+	const rom_record *const roms = section<rom_record>(m_data, offset);
+
+	const software_record &sw = software(index);
+	infolist.emplace_back(std::string(string(sw.shortname)), std::string(string(sw.parentname)), std::string());
+	software_info &info = infolist.back();
+	info.m_supported = sw.supported;
+	info.m_longname = string(sw.longname);
+	info.m_year = string(sw.year);
+	info.m_publisher = string(sw.publisher);
+	for (UINT32 item = sw.first_info; item < sw.first_info + sw.info_count; item++)
+		info.m_other_info.emplace_back(std::string(string(features[item].name)), std::string(string(features[item].value)));
+	for (UINT32 item = sw.first_shared; item < sw.first_shared + sw.shared_count; item++)
+		info.m_shared_info.emplace_back(std::string(string(features[item].name)), std::string(string(features[item].value)));
+
+	for (const part_record *part = &parts[sw.first_part]; part != &parts[sw.first_part + sw.part_count]; part++)
+	{
+		info.m_partdata.emplace_back(info, std::string(string(part->name)), std::string(string(part->interface)));
+		software_part &swpart = info.m_partdata.back();
+		for (UINT32 item = part->first_feature; item < part->first_feature + part->feature_count; item++)
+			swpart.m_featurelist.emplace_back(std::string(string(features[item].name)), std::string(string(features[item].value)));
+		swpart.m_romdata.reserve(part->rom_count);
+		for (const rom_record *rom = &roms[part->first_rom]; rom != &roms[part->first_rom + part->rom_count]; rom++)
+			swpart.m_romdata.emplace_back(std::string(string(rom->name)), std::string(string(rom->hashdata)), rom->offset, rom->length, rom->flags);
+	}
+	return info;
+}
+
+
+//-------------------------------------------------
+//  build_all - append every item to a list in the
+//  original order
+//-------------------------------------------------
+
+void softlist_index::build_all(std::list<software_info> &infolist) const
+{
+	for (UINT32 index = 0; index < count(); index++)
+		build(index, infolist);
+}
+
+
+//-------------------------------------------------
+//  head/software/string - raw accessors
+//-------------------------------------------------
+
+const softlist_index::header &softlist_index::head() const
+{
+	return *section<header>(m_data, 0);
+}
+
+const softlist_index::software_record &softlist_index::software(UINT32 index) const
+{
+	return section<software_record>(m_data, sizeof(header))[index];
+}
+
+const char *softlist_index::string(UINT32 offset) const
+{
+	const header &hdr = head();
+	return section<char>(m_data, m_data.size() - hdr.string_size) + offset;
+}
+
+
+//-------------------------------------------------
+//  check - validate the structure of the loaded
+//  data so the accessors never leave the buffer
+//-------------------------------------------------
+
+bool softlist_index::check() const
+{
+	if (m_data.size() < sizeof(header))
+		return false;
+
+	const header &hdr = head();
+	if ((hdr.magic != INDEX_MAGIC) || (hdr.version != INDEX_VERSION))
+		return false;
+
+	// the sections have to add up to the file size exactly
+	UINT64 const expected = UINT64(sizeof(header))
+			+ (UINT64(hdr.software_count) * (sizeof(software_record) + sizeof(UINT32)))
+			+ (UINT64(hdr.part_count) * sizeof(part_record))
+			+ (UINT64(hdr.feature_count) * sizeof(feature_record))
+			+ (UINT64(hdr.rom_count) * sizeof(rom_record))
+			+ hdr.string_size;
+	if ((expected != m_data.size()) || (hdr.string_size == 0) || (m_data.back() != '\0'))
+		return false;
+	if (UINT32(util::crc32_creator::simple(&m_data[sizeof(header)], UINT32(m_data.size() - sizeof(header)))) != hdr.crc)
+		return false;
+
+	// then every reference has to stay in range
+	auto const str = [&hdr] (UINT32 offset) { return offset < hdr.string_size; };
+	auto const range = [] (UINT32 first, UINT32 count, UINT32 limit) { return (first <= limit) && (count <= limit - first); };
+	if (!str(hdr.description))
+		return false;
+
+	std::size_t offset = sizeof(header);
+	const software_record *const softwares = section<software_record>(m_data, offset);
+	offset += hdr.software_count * sizeof(software_record);
+	const UINT32 *const names = section<UINT32>(m_data, offset);
+	offset += hdr.software_count * sizeof(UINT32);
+	const part_record *const parts = section<part_record>(m_data, offset);
+	offset += hdr.part_count * sizeof(part_record);
+	const feature_record *const features = section<feature_record>(m_data, offset);
+	offset += hdr.feature_count * sizeof(feature_record);
+	const rom_record *const roms = section<rom_record>(m_data, offset);
+
+	for (UINT32 index = 0; index < hdr.software_count; index++)
+	{
+		const software_record &sw = softwares[index];
+		if (!str(sw.shortname) || !str(sw.longname) || !str(sw.parentname) || !str(sw.year) || !str(sw.publisher) ||
+				!range(sw.first_info, sw.info_count, hdr.feature_count) ||
+				!range(sw.first_shared, sw.shared_count, hdr.feature_count) ||
+				!range(sw.first_part, sw.part_count, hdr.part_count) ||
+				(names[index] >= hdr.software_count))
+			return false;
+	}
+	for (UINT32 index = 0; index < hdr.part_count; index++)
+	{
+		const part_record &part = parts[index];
+		if (!str(part.name) || !str(part.interface) ||
+				!range(part.first_feature, part.feature_count, hdr.feature_count) ||
+				!range(part.first_rom, part.rom_count, hdr.rom_count))
+			return false;
+	}
+	for (UINT32 index = 0; index < hdr.feature_count; index++)
+		if (!str(features[index].name) || !str(features[index].value))
+			return false;
+	for (UINT32 index = 0; index < hdr.rom_count; index++)
+		if (!str(roms[index].name) || !str(roms[index].hashdata))
+			return false;
+	return true;
+}
@@ -0,0 +1,79 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    softlist_index.h
+
+    Precompiled binary index of a software list.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef MAME_EMU_SOFTLIST_INDEX_H
+#define MAME_EMU_SOFTLIST_INDEX_H
+
+#include "softlist.h"
+
+#include <string>
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> softlist_index
+
+// flat, position-independent image of a parsed software list: a header,
+// fixed-size software/part/feature/ROM records referring to each other by
+// index, a name table sorted for binary search and a string table; the
+// whole file is read with a single read and used in place
+class softlist_index
+{
+public:
+	// construction/destruction
+	softlist_index();
+
+	// the index file kept beside a given list file
+	static std::string index_filename(const std::string &listpath);
+
+	// persistence; the stamp is the size and modification time of the list file
+	bool load(const std::string &filename, UINT64 list_size, INT64 list_modified);
+	static bool save(const std::string &filename, UINT64 list_size, INT64 list_modified, const std::string &description, const std::list<software_info> &infolist);
+	void reset();
+
+	// getters
+	bool loaded() const { return !m_data.empty(); }
+	const char *description() const;
+	UINT32 count() const;
+
+	// lookups that do not need the list to be built
+	int find(const char *shortname) const;
+	const char *shortname(UINT32 index) const;
+	const char *longname(UINT32 index) const;
+	bool matches_interface(UINT32 index, const char *interface) const;
+
+	// build software_info objects from the index
+	software_info &build(UINT32 index, std::list<software_info> &infolist) const;
+	void build_all(std::list<software_info> &infolist) const;
+
+private:
+	struct header;
+	struct software_record;
+	struct part_record;
+	struct feature_record;
+	struct rom_record;
+
+	// internal helpers
+	const header &head() const;
+	const software_record &software(UINT32 index) const;
+	const char *string(UINT32 offset) const;
+	bool check() const;
+
+	// internal state
+	std::vector<UINT8>          m_data;
+};
+
+
+#endif  // MAME_EMU_SOFTLIST_INDEX_H
@@ -13,6 +13,7 @@
 #include "osdepend.h"
 #include "config.h"
 #include "wavwrite.h"
+#include "soundkern.h"
 
 
 
@@ -229,6 +230,9 @@ void sound_stream::set_input(int index, sound_stream *input_stream, int output_i
 	VPRINTF(("stream_set_input(%p, '%s', %d, %p, %d, %f)\n", (void *)this, m_device.tag(),
 			index, (void *)input_stream, output_index, (double) gain));
 
+	// the input graph changed
+	m_device.machine().sound().m_stream_graph_dirty = true;
+
 	// make sure it's a valid input
 	if (index >= m_input.size())
 		fatalerror("stream_set_input attempted to configure non-existant input %d (%d max)\n", index, int(m_input.size()));
@@ -262,6 +266,26 @@ void sound_stream::set_input(int index, sound_stream *input_stream, int output_i
 //-------------------------------------------------
 
 void sound_stream::update()
+{
+	// if we're already up to date, there's nothing to do
+	INT32 update_sampindex = update_target();
+	if (update_sampindex == m_output_sampindex)
+		return;
+
+	// generate samples to get us up to the appropriate time
+	g_profiler.start(PROFILER_SOUND);
+	update_to(update_sampindex);
+	g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  update_target - return the output sample
+//  index corresponding to the current emulated
+//  time
+//-------------------------------------------------
+
+INT32 sound_stream::update_target() const
 {
 	// determine the number of samples since the start of this second
 	attotime time = m_device.machine().time();
@@ -281,13 +305,20 @@ void sound_stream::update()
 		assert(time.seconds() == last_update.seconds() - 1);
 		update_sampindex -= m_sample_rate;
 	}
+	return update_sampindex;
+}
 
-	// generate samples to get us up to the appropriate time
-	g_profiler.start(PROFILER_SOUND);
+
+//-------------------------------------------------
+//  update_to - generate samples up to the given
+//  output sample index
+//-------------------------------------------------
+
+void sound_stream::update_to(INT32 update_sampindex)
+{
 	assert(m_output_sampindex - m_output_base_sampindex >= 0);
 	assert(update_sampindex - m_output_base_sampindex <= m_output_bufalloc);
 	generate_samples(update_sampindex - m_output_sampindex);
-	g_profiler.stop();
 
 	// remember this info for next time
 	m_output_sampindex = update_sampindex;
@@ -683,80 +714,20 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 	assert(basefrac < FRAC_ONE);
 
 	// compute the stepping fraction
+	static_assert(FRAC_BITS == SOUNDKERN_FRAC_BITS, "resampling kernels expect the same fixed-point format");
 	UINT32 step = (UINT64(input_stream.m_sample_rate) << FRAC_BITS) / m_sample_rate;
 
 	// if we have equal sample rates, we just need to copy
 	if (step == FRAC_ONE)
-	{
-		while (numsamples--)
-		{
-			// compute the sample
-			INT64 sample = *source++;
-			*dest++ = (sample * gain) >> 8;
-		}
-	}
+		soundkern_copy(dest, source, numsamples, gain);
 
 	// input is undersampled: point sample except where our sample period covers a boundary
 	else if (step < FRAC_ONE)
-	{
-		while (numsamples != 0)
-		{
-			// fill in with point samples until we hit a boundary
-			int nextfrac;
-			while ((nextfrac = basefrac + step) < FRAC_ONE && numsamples--)
-			{
-				*dest++ = (source[0] * gain) >> 8;
-				basefrac = nextfrac;
-			}
-
-			// if we're done, we're done
-			if (INT32(numsamples--) < 0)
-				break;
-
-			// compute starting and ending fractional positions
-			int startfrac = basefrac >> (FRAC_BITS - 12);
-			int endfrac = nextfrac >> (FRAC_BITS - 12);
-
-			// blend between the two samples accordingly
-			INT64 sample = ((INT64) source[0] * (0x1000 - startfrac) + (INT64) source[1] * (endfrac - 0x1000)) / (endfrac - startfrac);
-			*dest++ = (sample * gain) >> 8;
-
-			// advance
-			basefrac = nextfrac & FRAC_MASK;
-			source++;
-		}
-	}
+		soundkern_point(dest, source, numsamples, gain, basefrac, step);
 
 	// input is oversampled: sum the energy
 	else
-	{
-		// use 8 bits to allow some extra headroom
-		int smallstep = step >> (FRAC_BITS - 8);
-		while (numsamples--)
-		{
-			INT64 remainder = smallstep;
-			int tpos = 0;
-
-			// compute the sample
-			INT64 scale = (FRAC_ONE - basefrac) >> (FRAC_BITS - 8);
-			INT64 sample = (INT64) source[tpos++] * scale;
-			remainder -= scale;
-			while (remainder > 0x100)
-			{
-				sample += (INT64) source[tpos++] * (INT64) 0x100;
-				remainder -= 0x100;
-			}
-			sample += (INT64) source[tpos] * remainder;
-			sample /= smallstep;
-
-			*dest++ = (sample * gain) >> 8;
-
-			// advance
-			basefrac += step;
-			source += basefrac >> FRAC_BITS;
-			basefrac &= FRAC_MASK;
-		}
-	}
+		soundkern_average(dest, source, numsamples, gain, basefrac, step);
 
 	return &input.m_resample[0];
 }
@@ -809,6 +780,7 @@ sound_stream::stream_output::stream_output()
 sound_manager::sound_manager(running_machine &machine)
 	: m_machine(machine),
 		m_update_timer(nullptr),
+		m_work_queue(nullptr),
 		m_finalmix_leftover(0),
 		m_finalmix(machine.sample_rate()),
 		m_leftmix(machine.sample_rate()),
@@ -817,6 +789,7 @@ sound_manager::sound_manager(running_machine &machine)
 		m_attenuation(0),
 		m_nosound_mode(machine.osd().no_sound()),
 		m_wavfile(nullptr),
+		m_stream_graph_dirty(true),
 		m_update_attoseconds(STREAMS_UPDATE_ATTOTIME.attoseconds()),
 		m_last_update(attotime::zero)
 {
@@ -850,6 +823,10 @@ sound_manager::sound_manager(running_machine &machine)
 	// start the periodic update flushing timer
 	m_update_timer = machine.scheduler().timer_alloc(timer_expired_delegate(FUNC(sound_manager::update), this));
 	m_update_timer->adjust(STREAMS_UPDATE_ATTOTIME, 0, STREAMS_UPDATE_ATTOTIME);
+
+	// allocate a work queue if independent streams should be updated in parallel
+	if (machine.options().parallel_sound())
+		m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 }
 
 
@@ -859,6 +836,8 @@ sound_manager::sound_manager(running_machine &machine)
 
 sound_manager::~sound_manager()
 {
+	if (m_work_queue != nullptr)
+		osd_work_queue_free(m_work_queue);
 }
 
 
@@ -895,6 +874,7 @@ void sound_manager::stop_recording()
 sound_stream *sound_manager::stream_alloc(device_t &device, int inputs, int outputs, int sample_rate, stream_update_delegate callback)
 {
 	m_stream_list.push_back(std::make_unique<sound_stream>(device, inputs, outputs, sample_rate, callback));
+	m_stream_graph_dirty = true;
 	return m_stream_list.back().get();
 }
 
@@ -1057,6 +1037,10 @@ void sound_manager::update(void *ptr, int param)
 
 	g_profiler.start(PROFILER_SOUND);
 
+	// bring independent streams up to date concurrently if we can
+	if (m_work_queue != nullptr)
+		update_streams_parallel();
+
 	// force all the speaker streams to generate the proper number of samples
 	int samples_this_update = 0;
 	for (speaker_device &speaker : speaker_device_iterator(machine().root_device()))
@@ -1066,28 +1050,37 @@ void sound_manager::update(void *ptr, int param)
 	UINT32 finalmix_step = machine().video().speed_factor();
 	UINT32 finalmix_offset = 0;
 	INT16 *finalmix = &m_finalmix[0];
-	int sample;
-	for (sample = m_finalmix_leftover; sample < samples_this_update * 1000; sample += finalmix_step)
+	if (finalmix_step == 1000 && m_finalmix_leftover < 1000)
 	{
-		int sampindex = sample / 1000;
-
-		// clamp the left side
-		INT32 samp = m_leftmix[sampindex];
-		if (samp < -32768)
-			samp = -32768;
-		else if (samp > 32767)
-			samp = 32767;
-		finalmix[finalmix_offset++] = samp;
-
-		// clamp the right side
-		samp = m_rightmix[sampindex];
-		if (samp < -32768)
-			samp = -32768;
-		else if (samp > 32767)
-			samp = 32767;
-		finalmix[finalmix_offset++] = samp;
+		// at normal speed every sample is taken exactly once, so clamp and interleave in bulk
+		soundkern_clamp_interleave(finalmix, &m_leftmix[0], &m_rightmix[0], samples_this_update);
+		finalmix_offset = samples_this_update * 2;
+	}
+	else
+	{
+		int sample;
+		for (sample = m_finalmix_leftover; sample < samples_this_update * 1000; sample += finalmix_step)
+		{
+			int sampindex = sample / 1000;
+
+			// clamp the left side
+			INT32 samp = m_leftmix[sampindex];
+			if (samp < -32768)
+				samp = -32768;
+			else if (samp > 32767)
+				samp = 32767;
+			finalmix[finalmix_offset++] = samp;
+
+			// clamp the right side
+			samp = m_rightmix[sampindex];
+			if (samp < -32768)
+				samp = -32768;
+			else if (samp > 32767)
+				samp = 32767;
+			finalmix[finalmix_offset++] = samp;
+		}
+		m_finalmix_leftover = sample - samples_this_update * 1000;
 	}
-	m_finalmix_leftover = sample - samples_this_update * 1000;
 
 	// play the result
 	if (finalmix_offset > 0)
@@ -1122,3 +1115,117 @@ void sound_manager::update(void *ptr, int param)
 
 	g_profiler.stop();
 }
+
+
+//-------------------------------------------------
+//  build_stream_graph - group the streams by
+//  their depth in the input graph, so that no
+//  stream depends on another in the same group
+//-------------------------------------------------
+
+void sound_manager::build_stream_graph()
+{
+	// compute each stream's depth: one more than the deepest stream feeding it;
+	// streams being visited are marked with -1 so that a feedback loop is caught
+	// rather than recursed into forever
+	static const int VISITING = -1;
+	std::unordered_map<const sound_stream *, int> depth;
+	std::function<int (const sound_stream &)> compute_depth = [&depth, &compute_depth](const sound_stream &stream) -> int
+	{
+		auto found = depth.find(&stream);
+		if (found != depth.end())
+			return found->second;
+
+		depth.emplace(&stream, VISITING);
+		int result = 0;
+		for (auto &input : stream.m_input)
+			if (input.m_source != nullptr)
+			{
+				int sourcedepth = compute_depth(*input.m_source->m_stream);
+				if (sourcedepth == VISITING)
+					return VISITING;
+				result = std::max(result, sourcedepth + 1);
+			}
+		depth[&stream] = result;
+		return result;
+	};
+
+	// bucket the streams, keeping list order within each level
+	m_stream_levels.clear();
+	m_stream_graph_dirty = false;
+	for (auto &stream : m_stream_list)
+	{
+		int level = compute_depth(*stream);
+
+		// with a cycle there's no safe order, so leave the levels empty; the
+		// speakers then pull every stream up to date serially as before
+		if (level == VISITING)
+		{
+			VPRINTF(("stream graph: cycle found, updating streams serially\n"));
+			m_stream_levels.clear();
+			return;
+		}
+
+		if (level >= m_stream_levels.size())
+			m_stream_levels.resize(level + 1);
+
+		// only devices that vouch for their update get handed to the workers
+		device_sound_interface *sound;
+		if (stream->device().interface(sound) && sound->self_contained_update())
+			m_stream_levels[level].parallel.push_back(stream.get());
+		else
+			m_stream_levels[level].serial.push_back(stream.get());
+	}
+
+	VPRINTF(("stream graph: %d streams in %d levels\n", int(m_stream_list.size()), int(m_stream_levels.size())));
+}
+
+
+//-------------------------------------------------
+//  update_streams_parallel - bring all streams
+//  up to date one level at a time, updating the
+//  self-contained streams within a level
+//  concurrently and the rest serially; each
+//  stream generates exactly the samples it would
+//  have in a serial update, so the output is
+//  identical
+//-------------------------------------------------
+
+void sound_manager::update_streams_parallel()
+{
+	if (m_stream_graph_dirty)
+		build_stream_graph();
+
+	for (auto &level : m_stream_levels)
+	{
+		// streams that may read other devices' state run alone on this thread
+		for (sound_stream *stream : level.serial)
+			stream->update_to(stream->update_target());
+
+		// a lone stream isn't worth the trip through the queue
+		if (level.parallel.size() == 1)
+			level.parallel[0]->update_to(level.parallel[0]->update_target());
+		else if (!level.parallel.empty())
+		{
+			// the workers write into the stream buffers, so we can't move on
+			// until every one of them is done
+			osd_work_item_queue_multiple(m_work_queue, update_stream_callback, level.parallel.size(), &level.parallel[0], sizeof(level.parallel[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+			while (!osd_work_queue_wait(m_work_queue, osd_ticks_per_second() * 10)) { }
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  update_stream_callback - work queue callback
+//  for updating a single stream; all of its
+//  inputs are already current, so it won't
+//  touch any other stream's state
+//-------------------------------------------------
+
+void *sound_manager::update_stream_callback(void *param, int threadid)
+{
+	sound_stream &stream = **reinterpret_cast<sound_stream **>(param);
+	stream.update_to(stream.update_target());
+	return nullptr;
+}
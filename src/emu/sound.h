@@ -129,6 +129,8 @@ private:
 	void apply_sample_rate_changes();
 
 	// internal helpers
+	INT32 update_target() const;
+	void update_to(INT32 update_sampindex);
 	void recompute_sample_rate_data();
 	void allocate_resample_buffers();
 	void allocate_output_buffers();
@@ -227,10 +229,21 @@ private:
 	void config_save(config_type cfg_type, xml_data_node *parentnode);
 
 	void update(void *ptr = nullptr, INT32 param = 0);
+	void build_stream_graph();
+	void update_streams_parallel();
+	static void *update_stream_callback(void *param, int threadid);
+
+	// streams at one depth of the input graph
+	struct stream_level
+	{
+		std::vector<sound_stream *> serial;     // streams updated on the calling thread
+		std::vector<sound_stream *> parallel;   // streams whose devices declared a self-contained update
+	};
 
 	// internal state
 	running_machine &   m_machine;              // reference to our machine
 	emu_timer *         m_update_timer;         // timer to drive periodic updates
+	osd_work_queue *    m_work_queue;           // queue for parallel stream updates, or nullptr
 
 	UINT32              m_finalmix_leftover;
 	std::vector<INT16>       m_finalmix;
@@ -245,6 +258,8 @@ private:
 
 	// streams data
 	std::vector<std::unique_ptr<sound_stream>> m_stream_list;    // list of streams
+	std::vector<stream_level> m_stream_levels;  // streams grouped by depth in the input graph
+	bool                m_stream_graph_dirty;   // true if m_stream_levels needs rebuilding
 	attoseconds_t       m_update_attoseconds;   // attoseconds between global updates
 	attotime            m_last_update;          // last update time
 };
@@ -0,0 +1,378 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    soundkern.h
+
+    Inner loops for sound stream resampling and final mixing. Each
+    kernel has a _generic form that is the straightforward reference
+    implementation, and an optimized form that produces bit-identical
+    results, using SSE2 where it can be assumed.
+
+    These only depend on osdcomm.h so that they can be benchmarked
+    outside of the emulator.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __SOUNDKERN_H__
+#define __SOUNDKERN_H__
+
+#include "osdcomm.h"
+
+#include <algorithm>
+#include <string.h>
+
+// use SSE on 64-bit implementations, where it can be assumed
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define SOUNDKERN_SSE2      1
+#include <emmintrin.h>
+#else
+#define SOUNDKERN_SSE2      0
+#endif
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// fixed-point resampling positions, matching sound_stream
+const UINT32 SOUNDKERN_FRAC_BITS    = 22;
+const UINT32 SOUNDKERN_FRAC_ONE     = 1 << SOUNDKERN_FRAC_BITS;
+const UINT32 SOUNDKERN_FRAC_MASK    = SOUNDKERN_FRAC_ONE - 1;
+
+
+
+//**************************************************************************
+//  RESAMPLING - EQUAL RATES
+//**************************************************************************
+
+//-------------------------------------------------
+//  soundkern_copy_generic - apply a gain to each
+//  sample (8.8 fixed point)
+//-------------------------------------------------
+
+inline void soundkern_copy_generic(INT32 *dest, const INT32 *source, UINT32 numsamples, INT64 gain)
+{
+	while (numsamples--)
+	{
+		INT64 sample = *source++;
+		*dest++ = (sample * gain) >> 8;
+	}
+}
+
+
+//-------------------------------------------------
+//  soundkern_copy - optimized form of the above
+//-------------------------------------------------
+
+inline void soundkern_copy(INT32 *dest, const INT32 *source, UINT32 numsamples, INT64 gain)
+{
+	// unity gain is by far the most common case, and is just a copy
+	if (gain == 0x100)
+	{
+		memcpy(dest, source, numsamples * sizeof(*dest));
+		return;
+	}
+
+#if SOUNDKERN_SSE2
+	// we only keep bits 8-39 of each product, which are the same whether the 64-bit
+	// product is formed signed or unsigned once the upper half is corrected for the
+	// sign of each factor
+	if (gain == INT32(gain))
+	{
+		const __m128i gainvec = _mm_set1_epi32(INT32(gain));
+		const __m128i gainsign = _mm_set1_epi32((gain < 0) ? -1 : 0);
+		const __m128i lowmask = _mm_set_epi32(0, -1, 0, -1);
+		for ( ; numsamples >= 4; numsamples -= 4, source += 4, dest += 4)
+		{
+			__m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+			__m128i even = _mm_srli_epi64(_mm_mul_epu32(samples, gainvec), 8);
+			__m128i odd = _mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(samples, 32), gainvec), 8);
+			__m128i result = _mm_or_si128(_mm_and_si128(even, lowmask), _mm_slli_epi64(odd, 32));
+			__m128i correction = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(samples, 31), gainvec), _mm_and_si128(gainsign, samples));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm_sub_epi32(result, _mm_slli_epi32(correction, 24)));
+		}
+	}
+#endif
+
+	soundkern_copy_generic(dest, source, numsamples, gain);
+}
+
+
+
+//**************************************************************************
+//  RESAMPLING - UNDERSAMPLED INPUT
+//**************************************************************************
+
+//-------------------------------------------------
+//  soundkern_point_generic - point sample except
+//  where our sample period covers a boundary;
+//  note that this may write a few samples past
+//  the end of the destination
+//-------------------------------------------------
+
+inline void soundkern_point_generic(INT32 *dest, const INT32 *source, UINT32 numsamples, INT64 gain, UINT32 basefrac, UINT32 step)
+{
+	while (numsamples != 0)
+	{
+		// fill in with point samples until we hit a boundary
+		int nextfrac;
+		while ((nextfrac = basefrac + step) < SOUNDKERN_FRAC_ONE && numsamples--)
+		{
+			*dest++ = (source[0] * gain) >> 8;
+			basefrac = nextfrac;
+		}
+
+		// if we're done, we're done
+		if (INT32(numsamples--) < 0)
+			break;
+
+		// compute starting and ending fractional positions
+		int startfrac = basefrac >> (SOUNDKERN_FRAC_BITS - 12);
+		int endfrac = nextfrac >> (SOUNDKERN_FRAC_BITS - 12);
+
+		// blend between the two samples accordingly
+		INT64 sample = ((INT64) source[0] * (0x1000 - startfrac) + (INT64) source[1] * (endfrac - 0x1000)) / (endfrac - startfrac);
+		*dest++ = (sample * gain) >> 8;
+
+		// advance
+		basefrac = nextfrac & SOUNDKERN_FRAC_MASK;
+		source++;
+	}
+}
+
+
+//-------------------------------------------------
+//  soundkern_point - optimized form of the above;
+//  each run of point samples is a single value,
+//  so compute it once and fill
+//-------------------------------------------------
+
+inline void soundkern_point(INT32 *dest, const INT32 *source, UINT32 numsamples, INT64 gain, UINT32 basefrac, UINT32 step)
+{
+	while (numsamples != 0)
+	{
+		// count the point samples before the next boundary; runs are short when the
+		// rates are close, so avoid the divide there
+		UINT32 run = 0;
+		if (step < SOUNDKERN_FRAC_ONE / 8)
+			run = (SOUNDKERN_FRAC_ONE - 1 - basefrac) / step;
+		else
+			for (UINT32 frac = basefrac + step; frac < SOUNDKERN_FRAC_ONE; frac += step)
+				run++;
+		if (run >= numsamples)
+		{
+			std::fill_n(dest, numsamples, INT32((source[0] * gain) >> 8));
+			return;
+		}
+		if (run != 0)
+		{
+			dest = std::fill_n(dest, run, INT32((source[0] * gain) >> 8));
+			basefrac += run * step;
+			numsamples -= run;
+		}
+
+		// blend between the two samples that straddle the boundary
+		UINT32 nextfrac = basefrac + step;
+		int startfrac = basefrac >> (SOUNDKERN_FRAC_BITS - 12);
+		int endfrac = nextfrac >> (SOUNDKERN_FRAC_BITS - 12);
+		INT64 sample = ((INT64) source[0] * (0x1000 - startfrac) + (INT64) source[1] * (endfrac - 0x1000)) / (endfrac - startfrac);
+		*dest++ = (sample * gain) >> 8;
+		numsamples--;
+
+		// advance
+		basefrac = nextfrac & SOUNDKERN_FRAC_MASK;
+		source++;
+	}
+}
+
+
+
+//**************************************************************************
+//  RESAMPLING - OVERSAMPLED INPUT
+//**************************************************************************
+
+//-------------------------------------------------
+//  soundkern_average_generic - sum the energy of
+//  all the input samples covered by each output
+//  sample
+//-------------------------------------------------
+
+inline void soundkern_average_generic(INT32 *dest, const INT32 *source, UINT32 numsamples, INT64 gain, UINT32 basefrac, UINT32 step)
+{
+	// use 8 bits to allow some extra headroom
+	int smallstep = step >> (SOUNDKERN_FRAC_BITS - 8);
+	while (numsamples--)
+	{
+		INT64 remainder = smallstep;
+		int tpos = 0;
+
+		// compute the sample
+		INT64 scale = (SOUNDKERN_FRAC_ONE - basefrac) >> (SOUNDKERN_FRAC_BITS - 8);
+		INT64 sample = (INT64) source[tpos++] * scale;
+		remainder -= scale;
+		while (remainder > 0x100)
+		{
+			sample += (INT64) source[tpos++] * (INT64) 0x100;
+			remainder -= 0x100;
+		}
+		sample += (INT64) source[tpos] * remainder;
+		sample /= smallstep;
+
+		*dest++ = (sample * gain) >> 8;
+
+		// advance
+		basefrac += step;
+		source += basefrac >> SOUNDKERN_FRAC_BITS;
+		basefrac &= SOUNDKERN_FRAC_MASK;
+	}
+}
+
+
+//-------------------------------------------------
+//  soundkern_sum - sum a run of samples with
+//  64-bit precision
+//-------------------------------------------------
+
+inline INT64 soundkern_sum(const INT32 *source, int count)
+{
+	INT64 sum = 0;
+#if SOUNDKERN_SSE2
+	if (count >= 4)
+	{
+		__m128i accum = _mm_setzero_si128();
+		for ( ; count >= 4; count -= 4, source += 4)
+		{
+			// sign-extend to 64 bits and accumulate
+			__m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+			__m128i sign = _mm_srai_epi32(samples, 31);
+			accum = _mm_add_epi64(accum, _mm_unpacklo_epi32(samples, sign));
+			accum = _mm_add_epi64(accum, _mm_unpackhi_epi32(samples, sign));
+		}
+		accum = _mm_add_epi64(accum, _mm_unpackhi_epi64(accum, accum));
+#if defined(_MSC_VER) && !defined(__clang__)
+		sum = accum.m128i_i64[0];
+#else
+		sum = _mm_cvtsi128_si64(accum);
+#endif
+	}
+#endif
+	while (count-- > 0)
+		sum += *source++;
+	return sum;
+}
+
+
+//-------------------------------------------------
+//  soundkern_average - optimized form of
+//  soundkern_average_generic; the full-weight
+//  samples in the middle of each output sample
+//  are summed in one go
+//-------------------------------------------------
+
+inline void soundkern_average(INT32 *dest, const INT32 *source, UINT32 numsamples, INT64 gain, UINT32 basefrac, UINT32 step)
+{
+	// use 8 bits to allow some extra headroom
+	int smallstep = step >> (SOUNDKERN_FRAC_BITS - 8);
+	while (numsamples--)
+	{
+		// partial first sample
+		INT64 scale = (SOUNDKERN_FRAC_ONE - basefrac) >> (SOUNDKERN_FRAC_BITS - 8);
+		INT64 remainder = smallstep - scale;
+		INT64 sample = (INT64) source[0] * scale;
+
+		// full-weight samples in the middle, then the partial last one
+		const INT32 *last = source + 1;
+		if (remainder > 0x100)
+		{
+			int middle = (remainder - 1) >> 8;
+			sample += soundkern_sum(last, middle) * 0x100;
+			remainder -= middle * 0x100;
+			last += middle;
+		}
+		sample += (INT64) *last * remainder;
+		sample /= smallstep;
+
+		*dest++ = (sample * gain) >> 8;
+
+		// advance
+		basefrac += step;
+		source += basefrac >> SOUNDKERN_FRAC_BITS;
+		basefrac &= SOUNDKERN_FRAC_MASK;
+	}
+}
+
+
+
+//**************************************************************************
+//  FINAL MIXING
+//**************************************************************************
+
+//-------------------------------------------------
+//  soundkern_mix_generic - accumulate a stream
+//  into a mix buffer
+//-------------------------------------------------
+
+inline void soundkern_mix_generic(INT32 *dest, const INT32 *source, int count)
+{
+	for (int sample = 0; sample < count; sample++)
+		dest[sample] += source[sample];
+}
+
+
+//-------------------------------------------------
+//  soundkern_mix - optimized form of the above
+//-------------------------------------------------
+
+inline void soundkern_mix(INT32 *dest, const INT32 *source, int count)
+{
+#if SOUNDKERN_SSE2
+	for ( ; count >= 4; count -= 4, source += 4, dest += 4)
+	{
+		__m128i sum = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(dest)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(source)));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dest), sum);
+	}
+#endif
+	soundkern_mix_generic(dest, source, count);
+}
+
+
+//-------------------------------------------------
+//  soundkern_clamp_interleave_generic - clamp the
+//  left and right mixes to 16 bits and interleave
+//  them
+//-------------------------------------------------
+
+inline void soundkern_clamp_interleave_generic(INT16 *dest, const INT32 *left, const INT32 *right, int count)
+{
+	for (int sample = 0; sample < count; sample++)
+	{
+		*dest++ = std::max(-32768, std::min(32767, left[sample]));
+		*dest++ = std::max(-32768, std::min(32767, right[sample]));
+	}
+}
+
+
+//-------------------------------------------------
+//  soundkern_clamp_interleave - optimized form of
+//  the above; signed saturation does the clamp
+//-------------------------------------------------
+
+inline void soundkern_clamp_interleave(INT16 *dest, const INT32 *left, const INT32 *right, int count)
+{
+#if SOUNDKERN_SSE2
+	for ( ; count >= 8; count -= 8, left += 8, right += 8, dest += 16)
+	{
+		__m128i l = _mm_packs_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&left[0])), _mm_loadu_si128(reinterpret_cast<const __m128i *>(&left[4])));
+		__m128i r = _mm_packs_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&right[0])), _mm_loadu_si128(reinterpret_cast<const __m128i *>(&right[4])));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[0]), _mm_unpacklo_epi16(l, r));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[8]), _mm_unpackhi_epi16(l, r));
+	}
+#endif
+	soundkern_clamp_interleave_generic(dest, left, right, count);
+}
+
+
+#endif  /* __SOUNDKERN_H__ */
@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "soundkern.h"
 
 
 
@@ -127,21 +128,18 @@ void speaker_device::mix(INT32 *leftmix, INT32 *rightmix, int &samples_this_upda
 	{
 		// if the speaker is centered, send to both left and right
 		if (m_x == 0)
-			for (int sample = 0; sample < samples_this_update; sample++)
-			{
-				leftmix[sample] += stream_buf[sample];
-				rightmix[sample] += stream_buf[sample];
-			}
+		{
+			soundkern_mix(leftmix, stream_buf, samples_this_update);
+			soundkern_mix(rightmix, stream_buf, samples_this_update);
+		}
 
 		// if the speaker is to the left, send only to the left
 		else if (m_x < 0)
-			for (int sample = 0; sample < samples_this_update; sample++)
-				leftmix[sample] += stream_buf[sample];
+			soundkern_mix(leftmix, stream_buf, samples_this_update);
 
 		// if the speaker is to the right, send only to the right
 		else
-			for (int sample = 0; sample < samples_this_update; sample++)
-				rightmix[sample] += stream_buf[sample];
+			soundkern_mix(rightmix, stream_buf, samples_this_update);
 	}
 }
 
@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
 
 
 //**************************************************************************
@@ -95,236 +96,6 @@ inline bool tilemap_t::gfx_elements_changed()
 }
 
 
-//**************************************************************************
-//  SCANLINE RASTERIZERS
-//**************************************************************************
-
-//-------------------------------------------------
-//  scanline_draw_opaque_null - draw to a nullptr
-//  bitmap, setting priority only
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_null(int count, UINT8 *pri, UINT32 pcode)
-{
-	// skip entirely if not changing priority
-	if (pcode == 0xff00)
-		return;
-
-	// update priority across the scanline
-	for (int i = 0; i < count; i++)
-		pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_null - draw to a nullptr
-//  bitmap using a mask, setting priority only
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_null(const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
-{
-	// skip entirely if not changing priority
-	if (pcode == 0xff00)
-		return;
-
-	// update priority across the scanline, checking the mask
-	for (int i = 0; i < count; i++)
-		if ((maskptr[i] & mask) == value)
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-}
-
-
-
-//-------------------------------------------------
-//  scanline_draw_opaque_ind16 - draw to a 16bpp
-//  indexed bitmap
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_ind16(UINT16 *dest, const UINT16 *source, int count, UINT8 *pri, UINT32 pcode)
-{
-	// special case for no palette offset
-	int pal = pcode >> 16;
-	if (pal == 0)
-	{
-		// use memcpy which should be well-optimized for the platform
-		memcpy(dest, source, count * 2);
-
-		// skip the rest if not changing priority
-		if (pcode == 0xff00)
-			return;
-
-		// update priority across the scanline
-		for (int i = 0; i < count; i++)
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-	}
-
-	// priority case
-	else if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = source[i] + pal;
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = source[i] + pal;
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_ind16 - draw to a 16bpp
-//  indexed bitmap using a mask
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_ind16(UINT16 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
-{
-	int pal = pcode >> 16;
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = source[i] + pal;
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = source[i] + pal;
-	}
-}
-
-
-
-//-------------------------------------------------
-//  scanline_draw_opaque_rgb32 - draw to a 32bpp
-//  RGB bitmap
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_rgb32(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode)
-{
-	const rgb_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = clut[source[i]];
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = clut[source[i]];
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_rgb32 - draw to a 32bpp
-//  RGB bitmap using a mask
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_rgb32(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode)
-{
-	const rgb_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = clut[source[i]];
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = clut[source[i]];
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_opaque_rgb32_alpha - draw to a
-//  32bpp RGB bitmap with alpha blending
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_rgb32_alpha(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	const rgb_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_rgb32_alpha - draw to a
-//  32bpp RGB bitmap using a mask and alpha
-//  blending
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_rgb32_alpha(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	const rgb_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-	}
-}
-
-
 //**************************************************************************
 //  TILEMAP CREATION AND CONFIGURATION
 //**************************************************************************
@@ -948,6 +719,9 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 	// flush the dirty state to all tiles as appropriate
 	realize_all_dirty_tiles();
 
+	// gather every instance of the tilemap that needs drawing
+	m_instances.clear();
+
 	// flip the tilemap around the center of the visible area
 	rectangle visarea = screen.visible_area();
 	UINT32 width = visarea.min_x + visarea.max_x + 1;
@@ -961,7 +735,7 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 		int scrolly = effective_colscroll(0, height);
 		for (int ypos = scrolly - m_height; ypos <= blit.cliprect.max_y; ypos += m_height)
 			for (int xpos = scrollx - m_width; xpos <= blit.cliprect.max_x; xpos += m_width)
-				draw_instance(screen, dest, blit, xpos, ypos);
+				m_instances.push_back({ blit.cliprect, xpos, ypos });
 	}
 
 	// scrolling rows + vertical scroll
@@ -998,7 +772,7 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 
 				// iterate over X to handle wraparound
 				for (int xpos = scrollx - m_width; xpos <= original_cliprect.max_x; xpos += m_width)
-					draw_instance(screen, dest, blit, xpos, ypos);
+					m_instances.push_back({ blit.cliprect, xpos, ypos });
 			}
 		}
 	}
@@ -1034,10 +808,14 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 
 				// iterate over Y to handle wraparound
 				for (int ypos = scrolly - m_height; ypos <= original_cliprect.max_y; ypos += m_height)
-					draw_instance(screen, dest, blit, xpos, ypos);
+					m_instances.push_back({ blit.cliprect, xpos, ypos });
 			}
 		}
 	}
+
+	// then draw them
+	draw_instances(screen, dest, blit, cliprect);
+
 g_profiler.stop();
 }
 
@@ -1209,13 +987,13 @@ void tilemap_t::draw_instance(screen_device &screen, _BitmapClass &dest, const b
 					for (int cury = y; cury < nexty; cury++)
 					{
 						if (dest_baseaddr == nullptr)
-							scanline_draw_opaque_null(x_end - x_start, pmap0, blit.tilemap_priority_code);
+							drawkern_scanline_opaque_null(x_end - x_start, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 2)
-							scanline_draw_opaque_ind16(reinterpret_cast<UINT16 *>(dest0), source0, x_end - x_start, pmap0, blit.tilemap_priority_code);
+							drawkern_scanline_opaque_ind16(reinterpret_cast<UINT16 *>(dest0), source0, x_end - x_start, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 4 && blit.alpha >= 0xff)
-							scanline_draw_opaque_rgb32(reinterpret_cast<UINT32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
+							drawkern_scanline_opaque_rgb32(reinterpret_cast<UINT32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 4)
-							scanline_draw_opaque_rgb32_alpha(reinterpret_cast<UINT32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
+							drawkern_scanline_opaque_rgb32_alpha(reinterpret_cast<UINT32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
 
 						dest0 += dest_rowpixels;
 						source0 += m_pixmap.rowpixels();
@@ -1230,13 +1008,13 @@ void tilemap_t::draw_instance(screen_device &screen, _BitmapClass &dest, const b
 					for (int cury = y; cury < nexty; cury++)
 					{
 						if (dest_baseaddr == nullptr)
-							scanline_draw_masked_null(mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
+							drawkern_scanline_masked_null(mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 2)
-							scanline_draw_masked_ind16(reinterpret_cast<UINT16 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
+							drawkern_scanline_masked_ind16(reinterpret_cast<UINT16 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 4 && blit.alpha >= 0xff)
-							scanline_draw_masked_rgb32(reinterpret_cast<UINT32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
+							drawkern_scanline_masked_rgb32(reinterpret_cast<UINT32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 4)
-							scanline_draw_masked_rgb32_alpha(reinterpret_cast<UINT32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
+							drawkern_scanline_masked_rgb32_alpha(reinterpret_cast<UINT32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
 
 						dest0 += dest_rowpixels;
 						source0 += m_pixmap.rowpixels();
@@ -1269,6 +1047,112 @@ void tilemap_t::draw_instance(screen_device &screen, _BitmapClass &dest, const b
 }
 
 
+//-------------------------------------------------
+//  draw_instances - draw the instances gathered
+//  by draw_common, splitting tall draws into
+//  bands drawn in parallel if configured to
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void tilemap_t::draw_instances(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, const rectangle &cliprect)
+{
+	// clamp the band count so each band has some substance
+	osd_work_queue *queue = m_manager->band_queue();
+	int bands = std::min(m_manager->bands(), std::min(MAX_BANDS, cliprect.height() / MIN_BAND_HEIGHT));
+	if (queue == nullptr || bands <= 1)
+	{
+		draw_instance_rows(screen, dest, blit, cliprect.min_y, cliprect.max_y);
+		return;
+	}
+
+	// tiles are otherwise fetched as they are first drawn, which can't happen on
+	// several threads at once
+	for (const instance_params &instance : m_instances)
+		realize_instance_tiles(instance);
+
+	// each band owns its rows of the destination and priority bitmaps, and draws
+	// the instances in the same order, so the result matches drawing serially
+	band_params<_BitmapClass> params[MAX_BANDS];
+	for (int band = 0; band < bands; band++)
+	{
+		params[band].tilemap = this;
+		params[band].screen = &screen;
+		params[band].dest = &dest;
+		params[band].blit = &blit;
+		params[band].top = cliprect.min_y + cliprect.height() * band / bands;
+		params[band].bottom = cliprect.min_y + cliprect.height() * (band + 1) / bands - 1;
+	}
+
+	// hand all but the first band to the queue and draw that one ourselves; the
+	// parameters live on our stack, so we can't leave before every band is done
+	osd_work_item_queue_multiple(queue, draw_band<_BitmapClass>, bands - 1, &params[1], sizeof(params[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	draw_band<_BitmapClass>(&params[0], 0);
+	while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+}
+
+
+//-------------------------------------------------
+//  draw_instance_rows - draw the part of each
+//  gathered instance that falls within a range
+//  of rows
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void tilemap_t::draw_instance_rows(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, int top, int bottom)
+{
+	blit_parameters rowblit = blit;
+	for (const instance_params &instance : m_instances)
+	{
+		rowblit.cliprect = instance.cliprect;
+		rowblit.cliprect.min_y = std::max(rowblit.cliprect.min_y, top);
+		rowblit.cliprect.max_y = std::min(rowblit.cliprect.max_y, bottom);
+		if (!rowblit.cliprect.empty())
+			draw_instance(screen, dest, rowblit, instance.xpos, instance.ypos);
+	}
+}
+
+
+//-------------------------------------------------
+//  draw_band - work queue callback that draws a
+//  single band
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void *tilemap_t::draw_band(void *param, int threadid)
+{
+	const band_params<_BitmapClass> &band = *reinterpret_cast<const band_params<_BitmapClass> *>(param);
+	band.tilemap->draw_instance_rows(*band.screen, *band.dest, *band.blit, band.top, band.bottom);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  realize_instance_tiles - bring every dirty
+//  tile that an instance will draw up to date
+//-------------------------------------------------
+
+void tilemap_t::realize_instance_tiles(const instance_params &instance)
+{
+	// clip to the tilemap the same way draw_instance does
+	int x1 = std::max(instance.xpos, instance.cliprect.min_x) - instance.xpos;
+	int x2 = std::min(instance.xpos + (int)m_width, instance.cliprect.max_x + 1) - instance.xpos;
+	int y1 = std::max(instance.ypos, instance.cliprect.min_y) - instance.ypos;
+	int y2 = std::min(instance.ypos + (int)m_height, instance.cliprect.max_y + 1) - instance.ypos;
+	if (x1 >= x2 || y1 >= y2)
+		return;
+
+	int mincol = x1 / m_tilewidth;
+	int maxcol = (x2 + m_tilewidth - 1) / m_tilewidth;
+	for (int row = y1 / m_tileheight; row <= (y2 - 1) / (int)m_tileheight; row++)
+		for (int column = mincol; column < maxcol; column++)
+		{
+			logical_index logindex = row * m_cols + column;
+			if (m_tileflags[logindex] == TILE_FLAG_DIRTY)
+				tile_update(logindex, column, row);
+		}
+}
+
+
 //-------------------------------------------------
 //  tilemap_draw_roz_core - render the tilemap's
 //  pixmap to the destination with rotation
@@ -1486,8 +1370,13 @@ void tilemap_t::draw_debug(screen_device &screen, bitmap_rgb32 &dest, UINT32 scr
 
 tilemap_manager::tilemap_manager(running_machine &machine)
 	: m_machine(machine),
-		m_instance(0)
+		m_instance(0),
+		m_band_queue(nullptr),
+		m_bands(machine.options().tilemap_bands())
 {
+	// only bother with a queue if draws are going to be split
+	if (m_bands > 1)
+		m_band_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
 }
 
 
@@ -1497,6 +1386,9 @@ tilemap_manager::tilemap_manager(running_machine &machine)
 
 tilemap_manager::~tilemap_manager()
 {
+	if (m_band_queue != nullptr)
+		osd_work_queue_free(m_band_queue);
+
 	// detach all device tilemaps since they will be destroyed
 	// as subdevices elsewhere
 	bool found = true;
@@ -587,21 +587,34 @@ private:
 		UINT8               alpha;
 	};
 
+	// one wrapped copy of the tilemap, clipped to part of the destination
+	struct instance_params
+	{
+		rectangle           cliprect;
+		int                 xpos;
+		int                 ypos;
+	};
+
+	// rows of the destination drawn by one work item
+	template<class _BitmapClass> struct band_params
+	{
+		tilemap_t *         tilemap;
+		screen_device *     screen;
+		_BitmapClass *      dest;
+		const blit_parameters *blit;
+		int                 top;
+		int                 bottom;
+	};
+
+	// band drawing limits
+	static const int MAX_BANDS = 32;
+	static const int MIN_BAND_HEIGHT = 16;
+
 	// inline helpers
 	INT32 effective_rowscroll(int index, UINT32 screen_width);
 	INT32 effective_colscroll(int index, UINT32 screen_height);
 	bool gfx_elements_changed();
 
-	// inline scanline rasterizers
-	void scanline_draw_opaque_null(int count, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_masked_null(const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_opaque_ind16(UINT16 *dest, const UINT16 *source, int count, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_masked_ind16(UINT16 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_opaque_rgb32(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_masked_rgb32(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_opaque_rgb32_alpha(UINT32 *dest, const UINT16 *source, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-	void scanline_draw_masked_rgb32_alpha(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-
 	// internal helpers
 	void postload();
 	void mappings_create();
@@ -617,6 +630,10 @@ private:
 	template<class _BitmapClass> void draw_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask);
 	template<class _BitmapClass> void draw_roz_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, UINT32 startx, UINT32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound, UINT32 flags, UINT8 priority, UINT8 priority_mask);
 	template<class _BitmapClass> void draw_instance(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, int xpos, int ypos);
+	template<class _BitmapClass> void draw_instances(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, const rectangle &cliprect);
+	template<class _BitmapClass> void draw_instance_rows(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, int top, int bottom);
+	template<class _BitmapClass> static void *draw_band(void *param, int threadid);
+	void realize_instance_tiles(const instance_params &instance);
 	template<class _BitmapClass> void draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, const blit_parameters &blit, UINT32 startx, UINT32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound);
 
 	// managers and devices
@@ -673,6 +690,9 @@ private:
 	bitmap_ind8                 m_flagsmap;             // per-pixel flags
 	std::vector<UINT8>               m_tileflags;            // per-tile flags
 	UINT8                       m_pen_to_flags[MAX_PEN_TO_FLAGS * TILEMAP_NUM_GROUPS]; // mapping of pens to flags
+
+	// drawing state
+	std::vector<instance_params>     m_instances;            // instances making up the current draw
 };
 
 
@@ -703,6 +723,10 @@ public:
 	void mark_all_dirty();
 	void set_flip_all(UINT32 attributes);
 
+	// parallel drawing
+	osd_work_queue *band_queue() const { return m_band_queue; }
+	int bands() const { return m_bands; }
+
 private:
 	// allocate an instance index
 	int alloc_instance() { return ++m_instance; }
@@ -711,6 +735,8 @@ private:
 	running_machine &       m_machine;
 	simple_list<tilemap_t>  m_tilemap_list;
 	int                     m_instance;
+	osd_work_queue *        m_band_queue;       // queue for drawing bands in parallel, or nullptr
+	int                     m_bands;            // number of bands to split large draws into
 };
 
 
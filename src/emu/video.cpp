@@ -97,6 +97,8 @@ video_manager::video_manager(running_machine &machine)
 		m_skipping_this_frame(false),
 		m_average_oversleep(0),
 		m_snap_target(nullptr),
+		m_snap_queue(nullptr),
+		m_snap_bands(machine.options().swrender_bands()),
 		m_snap_native(true),
 		m_snap_width(0),
 		m_snap_height(0),
@@ -151,6 +153,10 @@ video_manager::video_manager(running_machine &machine)
 	if (sscanf(machine.options().snap_size(), "%dx%d", &m_snap_width, &m_snap_height) != 2)
 		m_snap_width = m_snap_height = 0;
 
+	// snapshots and movie frames can be drawn in bands on several threads
+	if (m_snap_bands > 1)
+		m_snap_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
 	// start recording movie if specified
 	const char *filename = machine.options().mng_write();
 	if (filename[0] != 0)
@@ -240,6 +246,10 @@ void video_manager::frame_update(bool from_debugger)
 	if (!from_debugger)
 		machine().call_notifiers(MACHINE_NOTIFY_FRAME);
 
+	// snapshot the frame for rewinding once the current timeslice completes
+	if (!from_debugger && phase == MACHINE_PHASE_RUNNING && !machine().paused() && machine().save().rewinder() != nullptr)
+		machine().schedule_rewind_capture();
+
 	// update frameskipping
 	if (!from_debugger)
 		update_frameskip();
@@ -428,7 +438,7 @@ void video_manager::begin_recording(const char *name, movie_format format)
 		// build up information about this new movie
 		screen_device *screen = machine().first_screen();
 		avi_file::movie_info info;
-		info.video_format = 0;
+		info.video_format = FORMAT_HFYU;
 		info.video_timescale = 1000 * ((screen != nullptr) ? ATTOSECONDS_TO_HZ(screen->frame_period().attoseconds()) : screen_device::DEFAULT_FRAME_RATE);
 		info.video_sampletime = 1000;
 		info.video_numsamples = 0;
@@ -471,6 +481,17 @@ void video_manager::begin_recording(const char *name, movie_format format)
 				osd_printf_error("Error creating AVI: %s\n", avi_file::error_string(avierr));
 				return end_recording(format);
 			}
+
+			// compress frames on the work queue and append them in order
+			m_avi_recorder = std::make_unique<movie_recorder>(
+					[this] (const bitmap_rgb32 &bitmap, std::vector<UINT8> &data)
+					{
+						return m_avi_file->compress_video_frame(bitmap, data) == avi_file::error::NONE;
+					},
+					[this] (bitmap_rgb32 &bitmap, const std::vector<UINT8> &data, UINT32 frame)
+					{
+						return m_avi_file->append_compressed_video_frame(&data[0], data.size()) == avi_file::error::NONE;
+					});
 		}
 	}
 
@@ -506,6 +527,27 @@ void video_manager::begin_recording(const char *name, movie_format format)
 
 			// compute the frame time
 			m_mng_frame_period = attotime::from_hz(rate);
+
+			// PNG compression and writing are a single step, so do both off the emulation thread
+			std::string const software = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
+			std::string const system = std::string(machine().system().manufacturer).append(" ").append(machine().system().description);
+			m_mng_recorder = std::make_unique<movie_recorder>(
+					nullptr,
+					[this, software, system] (bitmap_rgb32 &bitmap, const std::vector<UINT8> &data, UINT32 frame)
+					{
+						// set up the text fields in the movie info
+						png_info pnginfo = { nullptr };
+						if (frame == 0)
+						{
+							png_add_text(&pnginfo, "Software", software.c_str());
+							png_add_text(&pnginfo, "System", system.c_str());
+						}
+
+						// snapshot bitmaps are RGB, so there is never a palette to write
+						png_error const error = mng_capture_frame(*m_mng_file, &pnginfo, bitmap, 0, nullptr);
+						png_free(&pnginfo);
+						return error == PNGERR_NONE;
+					});
 		}
 		else
 		{
@@ -527,6 +569,8 @@ void video_manager::end_recording(movie_format format)
 		// close the file if it exists
 		if (m_avi_file)
 		{
+			// finish writing any frames still in flight
+			m_avi_recorder.reset();
 			m_avi_file.reset();
 
 			// reset the state
@@ -538,6 +582,7 @@ void video_manager::end_recording(movie_format format)
 		// close the file if it exists
 		if (m_mng_file != nullptr)
 		{
+			m_mng_recorder.reset();
 			mng_capture_stop(*m_mng_file);
 			m_mng_file.reset();
 
@@ -560,10 +605,14 @@ void video_manager::add_sound_to_recording(const INT16 *sound, int numsamples)
 	{
 		g_profiler.start(PROFILER_MOVIE_REC);
 
-		// write the next frame
-		avi_file::error avierr = m_avi_file->append_sound_samples(0, sound + 0, numsamples, 1);
-		if (avierr == avi_file::error::NONE)
-			avierr = m_avi_file->append_sound_samples(1, sound + 1, numsamples, 1);
+		// write the next frame; video frames may be being appended at the same time
+		avi_file::error avierr;
+		{
+			std::lock_guard<std::mutex> lock(m_avi_recorder->write_lock());
+			avierr = m_avi_file->append_sound_samples(0, sound + 0, numsamples, 1);
+			if (avierr == avi_file::error::NONE)
+				avierr = m_avi_file->append_sound_samples(1, sound + 1, numsamples, 1);
+		}
 		if (avierr != avi_file::error::NONE)
 			end_recording(MF_AVI);
 
@@ -586,12 +635,16 @@ void video_manager::exit()
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
+	if (m_snap_queue != nullptr)
+	{
+		osd_work_queue_free(m_snap_queue);
+		m_snap_queue = nullptr;
+	}
 
 	// print a final result if we have at least 2 seconds' worth of data
 	if (!emulator_info::standalone() && m_overall_emutime.seconds() >= 1)
 	{
-		osd_ticks_t tps = osd_ticks_per_second();
-		double final_real_time = (double)m_overall_real_seconds + (double)m_overall_real_ticks / (double)tps;
+		double final_real_time = overall_realtime();
 		double final_emu_time = m_overall_emutime.as_double();
 		osd_printf_info("Average speed: %.2f%% (%d seconds)\n", 100 * final_emu_time / final_real_time, (m_overall_emutime + attotime(0, ATTOSECONDS_PER_SECOND / 2)).seconds());
 	}
@@ -1096,6 +1149,17 @@ void video_manager::recompute_speed(const attotime &emutime)
 }
 
 
+//-------------------------------------------------
+//  overall_realtime - return the number of real
+//  seconds counted towards the overall speed
+//-------------------------------------------------
+
+double video_manager::overall_realtime() const
+{
+	return (double)m_overall_real_seconds + (double)m_overall_real_ticks / (double)osd_ticks_per_second();
+}
+
+
 //-------------------------------------------------
 //  create_snapshot_bitmap - creates a
 //  bitmap containing the screenshot for the
@@ -1131,9 +1195,9 @@ void video_manager::create_snapshot_bitmap(screen_device *screen)
 	render_primitive_list &primlist = m_snap_target->get_primitives();
 	primlist.acquire_lock();
 	if (machine().options().snap_bilinear())
-		snap_renderer_bilinear::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels());
+		snap_renderer_bilinear::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels(), m_snap_queue, m_snap_bands);
 	else
-		snap_renderer::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels());
+		snap_renderer::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels(), m_snap_queue, m_snap_bands);
 	primlist.release_lock();
 }
 
@@ -1288,9 +1352,8 @@ void video_manager::record_frame()
 		// loop until we hit the right time
 		while (m_avi_next_frame_time <= curtime)
 		{
-			// write the next frame
-			avi_file::error avierr = m_avi_file->append_video_frame(m_snap_bitmap);
-			if (avierr != avi_file::error::NONE)
+			// hand the next frame to the recorder
+			if (!m_avi_recorder->add_frame(m_snap_bitmap))
 			{
 				g_profiler.stop();
 				end_recording(MF_AVI);
@@ -1309,23 +1372,8 @@ void video_manager::record_frame()
 		// loop until we hit the right time
 		while (m_mng_next_frame_time <= curtime)
 		{
-			// set up the text fields in the movie info
-			png_info pnginfo = { nullptr };
-			if (m_mng_frame == 0)
-			{
-				std::string text1 = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
-				std::string text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().description);
-				png_add_text(&pnginfo, "Software", text1.c_str());
-				png_add_text(&pnginfo, "System", text2.c_str());
-			}
-
-			// write the next frame
-			screen_device *screen = machine().first_screen();
-			const rgb_t *palette = (screen != nullptr && screen->has_palette()) ? screen->palette().palette()->entry_list_adjusted() : nullptr;
-			int entries = (screen != nullptr && screen->has_palette()) ? screen->palette().entries() : 0;
-			png_error error = mng_capture_frame(*m_mng_file, &pnginfo, m_snap_bitmap, entries, palette);
-			png_free(&pnginfo);
-			if (error != PNGERR_NONE)
+			// hand the next frame to the recorder
+			if (!m_mng_recorder->add_frame(m_snap_bitmap))
 			{
 				g_profiler.stop();
 				end_recording(MF_MNG);
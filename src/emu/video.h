@@ -18,6 +18,7 @@
 #define MAME_EMU_VIDEO_H
 
 #include "aviio.h"
+#include "movierec.h"
 
 
 //**************************************************************************
@@ -86,6 +87,8 @@ public:
 	// current speed helpers
 	std::string speed_text();
 	double speed_percent() const { return m_speed_percent; }
+	attotime overall_emutime() const { return m_overall_emutime; }
+	double overall_realtime() const;
 
 	// snapshots
 	void save_snapshot(screen_device *screen, emu_file &file);
@@ -175,6 +178,8 @@ private:
 	// snapshot stuff
 	render_target *     m_snap_target;              // screen shapshot target
 	bitmap_rgb32        m_snap_bitmap;              // screen snapshot bitmap
+	osd_work_queue *    m_snap_queue;               // work queue for drawing snapshots in bands
+	int                 m_snap_bands;               // number of bands to draw snapshots in
 	bool                m_snap_native;              // are we using native per-screen layouts?
 	INT32               m_snap_width;               // width of snapshots (0 == auto)
 	INT32               m_snap_height;              // height of snapshots (0 == auto)
@@ -184,12 +189,14 @@ private:
 	attotime            m_mng_frame_period;         // period of a single movie frame
 	attotime            m_mng_next_frame_time;      // time of next frame
 	UINT32              m_mng_frame;                // current movie frame number
+	std::unique_ptr<movie_recorder> m_mng_recorder; // writes captured frames in the background
 
 	// movie recording - AVI
 	avi_file::ptr       m_avi_file;                 // handle to the open movie file
 	attotime            m_avi_frame_period;         // period of a single movie frame
 	attotime            m_avi_next_frame_time;      // time of next frame
 	UINT32              m_avi_frame;                // current movie frame number
+	std::unique_ptr<movie_recorder> m_avi_recorder; // compresses and writes captured frames in the background
 
 	// movie recording - dummy
 	bool                m_dummy_recording;          // indicates if snapshot should be created of every frame
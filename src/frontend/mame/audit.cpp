@@ -16,6 +16,44 @@
 #include "sound/samples.h"
 #include "softlist_dev.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <sstream>
+#include <thread>
+
+
+namespace {
+
+//-------------------------------------------------
+//  locate_file - find a file along the media
+//  path and compute the requested hashes
+//-------------------------------------------------
+
+void locate_file(emu_options &options, const std::string &path, bool has_crc, UINT32 crc, const char *validation, audit_hash_index::entry &result)
+{
+	// find the file and checksum it, getting the file length along the way
+	emu_file file(options.media_path(), OPEN_FLAG_READ | OPEN_FLAG_NO_PRELOAD);
+	file.set_restrict_to_mediapath(true);
+
+	// open the file if we can
+	osd_file::error filerr;
+	if (has_crc)
+		filerr = file.open(path, crc);
+	else
+		filerr = file.open(path);
+
+	// if it worked, get the actual length and hashes
+	if (filerr == osd_file::error::NONE)
+	{
+		result.found = true;
+		result.hashes = file.hashes(validation);
+		result.length = file.size();
+	}
+}
+
+} // anonymous namespace
+
 
 //**************************************************************************
 //  CORE FUNCTIONS
@@ -25,10 +63,11 @@
 //  media_auditor - constructor
 //-------------------------------------------------
 
-media_auditor::media_auditor(const driver_enumerator &enumerator)
+media_auditor::media_auditor(const driver_enumerator &enumerator, audit_hash_index *index)
 	: m_enumerator(enumerator)
 	, m_validation(AUDIT_VALIDATE_FULL)
 	, m_searchpath(nullptr)
+	, m_hash_index(index)
 {
 }
 
@@ -383,24 +422,20 @@ media_auditor::audit_record &media_auditor::audit_one_rom(const rom_entry *rom)
 	UINT32 crc = 0;
 	bool const has_crc = record.expected_hashes().crc(crc);
 
-	// find the file and checksum it, getting the file length along the way
-	emu_file file(m_enumerator.options().media_path(), OPEN_FLAG_READ | OPEN_FLAG_NO_PRELOAD);
-	file.set_restrict_to_mediapath(true);
+	// try each location in turn, sharing lookups with other auditors if possible
 	path_iterator path(m_searchpath);
 	std::string curpath;
 	while (path.next(curpath, record.name()))
 	{
-		// open the file if we can
-		osd_file::error filerr;
-		if (has_crc)
-			filerr = file.open(curpath.c_str(), crc);
-		else
-			filerr = file.open(curpath.c_str());
+		audit_hash_index::entry local;
+		if (!m_hash_index)
+			locate_file(m_enumerator.options(), curpath, has_crc, crc, m_validation, local);
+		audit_hash_index::entry const &result(m_hash_index ? m_hash_index->find(curpath, has_crc, crc, m_validation) : local);
 
 		// if it worked, get the actual length and hashes, then stop
-		if (filerr == osd_file::error::NONE)
+		if (result.found)
 		{
-			record.set_actual(file.hashes(m_validation), file.size());
+			record.set_actual(result.hashes, result.length);
 			break;
 		}
 	}
@@ -559,3 +594,173 @@ media_auditor::audit_record::audit_record(const char *name, media_type type)
 	, m_shared_device(nullptr)
 {
 }
+
+
+
+//**************************************************************************
+//  HASH INDEX
+//**************************************************************************
+
+struct audit_hash_index::slot
+{
+	std::once_flag  once;
+	entry           value;
+};
+
+
+//-------------------------------------------------
+//  audit_hash_index - constructor
+//-------------------------------------------------
+
+audit_hash_index::audit_hash_index(emu_options &options)
+	: m_options(options)
+	, m_lookups(0)
+	, m_misses(0)
+{
+}
+
+
+//-------------------------------------------------
+//  find - look up a file, locating and hashing it
+//  if this is the first request for it
+//-------------------------------------------------
+
+const audit_hash_index::entry &audit_hash_index::find(const std::string &path, bool has_crc, UINT32 crc, const char *validation)
+{
+	// the key covers everything that affects the result
+	std::string key(path);
+	key.push_back('\0');
+	key.append(has_crc ? util::string_format("%08x", crc) : std::string("-"));
+	key.push_back('\0');
+	key.append(validation);
+
+	std::shared_ptr<slot> target;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		++m_lookups;
+		std::shared_ptr<slot> &existing(m_entries[key]);
+		if (!existing)
+		{
+			existing = std::make_shared<slot>();
+			++m_misses;
+		}
+		target = existing;
+	}
+
+	// concurrent requests for the same file wait for the first one
+	std::call_once(target->once, [this, &path, has_crc, crc, validation, &target] () { locate_file(m_options, path, has_crc, crc, validation, target->value); });
+	return target->value;
+}
+
+
+
+//**************************************************************************
+//  PARALLEL AUDITING
+//**************************************************************************
+
+//-------------------------------------------------
+//  parallel_media_auditor - constructor
+//-------------------------------------------------
+
+parallel_media_auditor::parallel_media_auditor(emu_options &options, unsigned threads)
+	: m_options(options)
+	, m_threads(threads ? threads : (std::max)(std::thread::hardware_concurrency(), 1U))
+	, m_index(options)
+{
+}
+
+
+//-------------------------------------------------
+//  audit_drivers - audit the media of a list of
+//  drivers, reporting results in list order
+//-------------------------------------------------
+
+void parallel_media_auditor::audit_drivers(const std::vector<int> &drivers, const char *validation, const result_callback &callback)
+{
+	struct slot
+	{
+		result              value;
+		std::exception_ptr  error;
+		bool                done = false;
+	};
+
+	std::vector<slot> slots(drivers.size());
+	std::atomic<std::size_t> next(0);
+	std::mutex mutex;
+	std::condition_variable ready;
+
+	// each worker claims the next driver from the list until none are left
+	auto const worker = [this, &drivers, validation, &slots, &next, &mutex, &ready] ()
+	{
+		driver_enumerator drivlist(m_options);
+		media_auditor auditor(drivlist, &m_index);
+		std::ostringstream details;
+		for (std::size_t item = next++; item < drivers.size(); item = next++)
+		{
+			result current;
+			std::exception_ptr error;
+			try
+			{
+				drivlist.set_current(drivers[item]);
+				current.driver = drivers[item];
+				current.summary = auditor.audit_media(validation);
+
+				// records point into the machine configuration, so format them now
+				if (current.summary != media_auditor::NOTFOUND)
+				{
+					details.str(std::string());
+					auditor.summarize(drivlist.driver().name, &details);
+					current.details = details.str();
+				}
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+				next = drivers.size();
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				slots[item].value = std::move(current);
+				slots[item].error = error;
+				slots[item].done = true;
+			}
+			ready.notify_all();
+		}
+	};
+
+	std::vector<std::thread> workers;
+	if (m_threads > 1)
+	{
+		for (unsigned i = 0; i < m_threads; i++)
+			workers.emplace_back(worker);
+	}
+	else
+	{
+		worker();
+	}
+
+	// hand results back in order as soon as they are available
+	std::exception_ptr error;
+	for (std::size_t item = 0; (item < drivers.size()) && !error; item++)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			ready.wait(lock, [&slots, item] () { return slots[item].done; });
+		}
+		error = slots[item].error;
+		if (!error)
+		{
+			callback(slots[item].value);
+			slots[item].value.details = std::string();
+		}
+	}
+
+	// stop handing out work if anything went wrong
+	if (error)
+		next = drivers.size();
+	for (std::thread &thread : workers)
+		thread.join();
+	if (error)
+		std::rethrow_exception(error);
+}
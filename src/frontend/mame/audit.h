@@ -15,9 +15,15 @@
 
 #include "hash.h"
 
+#include <functional>
 #include <iosfwd>
 #include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <utility>
+#include <vector>
 
 
 
@@ -38,6 +44,44 @@
 
 // forward declarations
 class driver_enumerator;
+class emu_options;
+
+
+// ======================> audit_hash_index
+
+// thread-safe cache of file lookups shared between auditors, so a file
+// referenced by several sets is only located and hashed once
+class audit_hash_index
+{
+public:
+	// result of locating a file along the media path
+	struct entry
+	{
+		bool                    found = false;
+		util::hash_collection   hashes;
+		UINT64                  length = 0;
+	};
+
+	// construction/destruction
+	audit_hash_index(emu_options &options);
+
+	// look up a file, hashing it on first use
+	const entry &find(const std::string &path, bool has_crc, UINT32 crc, const char *validation);
+
+	// statistics
+	std::size_t lookups() const { return m_lookups; }
+	std::size_t misses() const { return m_misses; }
+
+private:
+	struct slot;
+
+	// internal state
+	emu_options &                                   m_options;
+	std::mutex                                      m_mutex;
+	std::map<std::string, std::shared_ptr<slot>>    m_entries;
+	std::size_t                                     m_lookups;
+	std::size_t                                     m_misses;
+};
 
 
 
@@ -150,7 +194,7 @@ public:
 	using record_list = std::list<audit_record>;
 
 	// construction/destruction
-	media_auditor(const driver_enumerator &enumerator);
+	media_auditor(const driver_enumerator &enumerator, audit_hash_index *index = nullptr);
 
 	// getters
 	const record_list &records() const { return m_record_list; }
@@ -175,6 +219,41 @@ private:
 	const driver_enumerator &   m_enumerator;
 	const char *                m_validation;
 	const char *                m_searchpath;
+	audit_hash_index *          m_hash_index;
+};
+
+
+// ======================> parallel_media_auditor
+
+// audits the media of many drivers on a pool of worker threads, sharing
+// one hash index; results are delivered in the order they were requested
+class parallel_media_auditor
+{
+public:
+	// result of auditing a single driver
+	struct result
+	{
+		int                     driver;     // driver index
+		media_auditor::summary  summary;    // overall status
+		std::string             details;    // output of media_auditor::summarize
+	};
+	using result_callback = std::function<void (const result &)>;
+
+	// construction/destruction
+	parallel_media_auditor(emu_options &options, unsigned threads = 0);
+
+	// audit the given drivers, calling back on this thread in order
+	void audit_drivers(const std::vector<int> &drivers, const char *validation, const result_callback &callback);
+
+	// getters
+	unsigned threads() const { return m_threads; }
+	audit_hash_index &index() { return m_index; }
+
+private:
+	// internal state
+	emu_options &       m_options;
+	unsigned            m_threads;
+	audit_hash_index    m_index;
 };
 
 
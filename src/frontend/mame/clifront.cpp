@@ -15,6 +15,7 @@
 #include "mameopts.h"
 #include "jedparse.h"
 #include "audit.h"
+#include "hashcache.h"
 #include "info.h"
 #include "unzip.h"
 #include "validity.h"
@@ -67,6 +68,7 @@
 #define CLICOMMAND_VERIFYSOFTWARE       "verifysoftware"
 #define CLICOMMAND_GETSOFTLIST          "getsoftlist"
 #define CLICOMMAND_VERIFYSOFTLIST       "verifysoftlist"
+#define CLICOMMAND_REBUILDHASHCACHE     "rebuildhashcache"
 
 
 namespace {
@@ -107,6 +109,7 @@ const options_entry cli_option_entries[] =
 	{ CLICOMMAND_VERIFYSOFTWARE ";vsoft",   "0",       OPTION_COMMAND,    "verify known software for the system" },
 	{ CLICOMMAND_GETSOFTLIST ";glist",      "0",       OPTION_COMMAND,    "retrieve software list by name" },
 	{ CLICOMMAND_VERIFYSOFTLIST ";vlist",   "0",       OPTION_COMMAND,    "verify software list by name" },
+	{ CLICOMMAND_REBUILDHASHCACHE,          "0",       OPTION_COMMAND,    "rebuild the hash cache from the romsets of matching systems" },
 	{ nullptr }
 };
 
@@ -399,10 +402,9 @@ int media_identifier::find_by_hash(const util::hash_collection &hashes, int leng
 
 
 void print_summary(
-		const media_auditor &auditor, media_auditor::summary summary, bool record_none_needed,
-		const char *type, const char *name, const char *parent,
-		unsigned &correct, unsigned &incorrect, unsigned &notfound,
-		util::ovectorstream &buffer)
+		media_auditor::summary summary, bool record_none_needed,
+		const char *type, const char *name, const char *parent, const char *details,
+		unsigned &correct, unsigned &incorrect, unsigned &notfound)
 {
 	if (summary == media_auditor::NOTFOUND)
 	{
@@ -412,11 +414,7 @@ void print_summary(
 	else if (record_none_needed || (summary != media_auditor::NONE_NEEDED))
 	{
 		// output the summary of the audit
-		buffer.clear();
-		buffer.seekp(0);
-		auditor.summarize(name, &buffer);
-		buffer.put('\0');
-		osd_printf_info("%s", &buffer.vec()[0]);
+		osd_printf_info("%s", details);
 
 		// output the name of the driver and its parent
 		osd_printf_info("%sset %s ", type, name);
@@ -451,6 +449,24 @@ void print_summary(
 	}
 }
 
+void print_summary(
+		const media_auditor &auditor, media_auditor::summary summary, bool record_none_needed,
+		const char *type, const char *name, const char *parent,
+		unsigned &correct, unsigned &incorrect, unsigned &notfound,
+		util::ovectorstream &buffer)
+{
+	buffer.clear();
+	buffer.seekp(0);
+	if ((summary != media_auditor::NOTFOUND) && (record_none_needed || (summary != media_auditor::NONE_NEEDED)))
+		auditor.summarize(name, &buffer);
+	buffer.put('\0');
+
+	print_summary(
+			summary, record_none_needed,
+			type, name, parent, &buffer.vec()[0],
+			correct, incorrect, notfound);
+}
+
 } // anonymous namespace
 
 
@@ -594,6 +610,11 @@ int cli_frontend::execute(int argc, char **argv)
 			if (system == nullptr && *(m_options.system_name()) != 0)
 				throw emu_fatalerror(EMU_ERR_NO_SUCH_GAME, "Unknown system '%s'", m_options.system_name());
 
+			// use the hash cache while loading media
+			std::unique_ptr<hash_cache> hashcache;
+			if (*m_options.hash_cache() != 0)
+				hashcache = std::make_unique<hash_cache>(m_options.hash_cache());
+
 			// otherwise just run the game
 			m_result = manager->execute();
 		}
@@ -1134,23 +1155,25 @@ void cli_frontend::verifyroms(const char *gamename)
 	unsigned notfound = 0;
 	unsigned matched = 0;
 
-	// iterate over drivers
-	media_auditor auditor(drivlist);
-	util::ovectorstream summary_string;
+	// gather the matching drivers
+	std::vector<int> drivers;
 	while (drivlist.next())
-	{
-		matched++;
+		drivers.push_back(drivlist.current());
+	matched = drivers.size();
 
-		// audit the ROMs in this set
-		media_auditor::summary summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
-
-		auto const clone_of = drivlist.clone();
+	// audit the ROMs in these sets on all available threads
+	parallel_media_auditor parallel_auditor(m_options);
+	parallel_auditor.audit_drivers(drivers, AUDIT_VALIDATE_FAST, [&] (parallel_media_auditor::result const &result)
+	{
+		auto const clone_of = drivlist.clone(result.driver);
 		print_summary(
-				auditor, summary, true,
-				"rom", drivlist.driver().name, (clone_of >= 0) ? drivlist.driver(clone_of).name : nullptr,
-				correct, incorrect, notfound,
-				summary_string);
-	}
+				result.summary, true,
+				"rom", drivlist.driver(result.driver).name, (clone_of >= 0) ? drivlist.driver(clone_of).name : nullptr, result.details.c_str(),
+				correct, incorrect, notfound);
+	});
+
+	media_auditor auditor(drivlist, &parallel_auditor.index());
+	util::ovectorstream summary_string;
 
 	if (!matched || strchr(gamename, '*') || strchr(gamename, '?'))
 	{
@@ -1270,6 +1293,45 @@ void cli_frontend::verifyroms(const char *gamename)
 }
 
 
+//-------------------------------------------------
+//  rebuildhashcache - discard the hash cache and
+//  fill it again from the ROM sets of one or more
+//  games
+//-------------------------------------------------
+
+void cli_frontend::rebuildhashcache(const char *gamename)
+{
+	hash_cache *const cache = hash_cache::active();
+	if (!cache)
+		throw emu_fatalerror(EMU_ERR_INVALID_CONFIG, "No hash cache file specified, use the -%s option\n", OPTION_HASH_CACHE);
+
+	// determine which drivers to hash
+	driver_enumerator drivlist(m_options, gamename);
+	std::vector<int> drivers;
+	while (drivlist.next())
+		drivers.push_back(drivlist.current());
+	if (drivers.empty())
+		throw emu_fatalerror(EMU_ERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
+
+	// a full audit hashes every file it finds, which fills the cache
+	cache->clear();
+	unsigned found = 0;
+	parallel_media_auditor auditor(m_options);
+	auditor.audit_drivers(drivers, AUDIT_VALIDATE_FULL, [&found] (parallel_media_auditor::result const &result)
+	{
+		if (result.summary != media_auditor::NOTFOUND)
+			++found;
+	});
+
+	// clear out any cached files
+	util::archive_file::cache_clear();
+
+	if (!cache->save())
+		throw emu_fatalerror(EMU_ERR_FATALERROR, "Unable to write hash cache %s\n", cache->filename().c_str());
+	osd_printf_info("%u romsets hashed, %u files in %s\n", found, unsigned(cache->containers()), cache->filename().c_str());
+}
+
+
 //-------------------------------------------------
 //  info_verifysamples - verify the sample sets of
 //  one or more games
@@ -1768,6 +1830,11 @@ void cli_frontend::execute_commands(const char *exename)
 	if (!option_errors.empty())
 		osd_printf_error("%s\n", option_errors.c_str());
 
+	// use the hash cache for the duration of the command
+	std::unique_ptr<hash_cache> hashcache;
+	if (*m_options.hash_cache() != 0)
+		hashcache = std::make_unique<hash_cache>(m_options.hash_cache());
+
 	// createconfig?
 	if (strcmp(m_options.command(), CLICOMMAND_CREATECONFIG) == 0)
 	{
@@ -1837,6 +1904,7 @@ void cli_frontend::execute_commands(const char *exename)
 		{ CLICOMMAND_ROMIDENT,      &cli_frontend::romident },
 		{ CLICOMMAND_GETSOFTLIST,   &cli_frontend::getsoftlist },
 		{ CLICOMMAND_VERIFYSOFTLIST,&cli_frontend::verifysoftlist },
+		{ CLICOMMAND_REBUILDHASHCACHE,&cli_frontend::rebuildhashcache },
 	};
 
 	// find the command
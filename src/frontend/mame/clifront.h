@@ -54,6 +54,7 @@ public:
 	void romident(const char *filename);
 	void getsoftlist(const char *gamename = "*");
 	void verifysoftlist(const char *gamename = "*");
+	void rebuildhashcache(const char *gamename = "*");
 
 private:
 	// internal helpers
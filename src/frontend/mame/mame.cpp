@@ -184,6 +184,23 @@ int mame_machine_manager::execute()
 	if (m_options.console()) {
 		m_lua->start_console();
 	}
+
+	// gather any further systems to benchmark once the first one exits
+	std::vector<std::string> bench_systems;
+	std::istringstream bench_list(m_options.bench_systems());
+	std::string bench_name;
+	while (std::getline(bench_list, bench_name, ','))
+	{
+		strtrimspace(bench_name);
+		if (bench_name.empty())
+			continue;
+		if (driver_list::find(bench_name.c_str()) == -1)
+			throw emu_fatalerror(EMU_ERR_NO_SUCH_GAME, "Unknown system '%s' in %s", bench_name.c_str(), OPTION_BENCH_SYSTEMS);
+		bench_systems.push_back(bench_name);
+	}
+	auto bench_next = bench_systems.begin();
+	int bench_error = EMU_ERR_NONE;
+
 	while (error == EMU_ERR_NONE && !exit_pending)
 	{
 		m_new_driver_pending = nullptr;
@@ -229,7 +246,18 @@ int mame_machine_manager::execute()
 		m_firstrun = false;
 
 		// check the state of the machine
-		if (m_new_driver_pending)
+		if (bench_next != bench_systems.end() && !m_new_driver_pending && (machine.exit_pending() || error != EMU_ERR_NONE))
+		{
+			// move on to the next system in the benchmark list, even if this one failed
+			if (error != EMU_ERR_NONE)
+				bench_error = error;
+			error = EMU_ERR_NONE;
+			mame_options::set_system_name(m_options, (bench_next++)->c_str());
+			m_firstrun = true;
+			set_machine(nullptr);
+			continue;
+		}
+		else if (m_new_driver_pending)
 		{
 			// set up new system name and adjust device options accordingly
 			mame_options::set_system_name(m_options,m_new_driver_pending->name);
@@ -246,8 +274,8 @@ int mame_machine_manager::execute()
 		// machine will go away when we exit scope
 		set_machine(nullptr);
 	}
-	// return an error
-	return error;
+	// return an error, including any from earlier in a benchmark list
+	return (error != EMU_ERR_NONE) ? error : bench_error;
 }
 
 TIMER_CALLBACK_MEMBER(mame_machine_manager::autoboot_callback)
@@ -127,12 +127,14 @@ void detail::queue_t::register_state(plib::state_manager_t &manager, const pstri
 void detail::queue_t::on_pre_save()
 {
 	netlist().log().debug("on_pre_save\n");
-	m_qsize = this->size();
+	std::vector<entry_t> entries;
+	this->snapshot(entries);
+	m_qsize = entries.size();
 	netlist().log().debug("current time {1} qsize {2}\n", netlist().time().as_double(), m_qsize);
 	for (std::size_t i = 0; i < m_qsize; i++ )
 	{
-		m_times[i] =  this->listptr()[i].m_exec_time.as_raw();
-		pstring p = this->listptr()[i].m_object->name();
+		m_times[i] =  entries[i].m_exec_time.as_raw();
+		pstring p = entries[i].m_object->name();
 		std::size_t n = p.len();
 		if (n > 63) n = 63;
 		std::strncpy(m_names[i].m_buf, p.cstr(), n);
@@ -192,6 +194,7 @@ netlist_t::netlist_t(const pstring &aname)
 	: m_state()
 	, m_time(netlist_time::zero())
 	, m_queue(*this)
+	, m_events_processed(0)
 	, m_mainclock(nullptr)
 	, m_solver(nullptr)
 	, m_gnd(nullptr)
@@ -372,6 +375,7 @@ void netlist_t::process_queue(const netlist_time &delta)
 		{
 			e.m_object->update_devs();
 			m_perf_out_processed.inc();
+			m_events_processed++;
 			e = m_queue.pop();
 			m_time = e.m_exec_time;
 		}
@@ -398,6 +402,7 @@ void netlist_t::process_queue(const netlist_time &delta)
 				break;
 			e.m_object->update_devs();
 			m_perf_out_processed.inc();
+			m_events_processed++;
 		}
 		mc_net.set_time(mc_time);
 	}
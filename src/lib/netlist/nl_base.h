@@ -1084,6 +1084,7 @@ namespace netlist
 		const detail::queue_t &queue() const { return m_queue; }
 		detail::queue_t &queue() { return m_queue; }
 		const netlist_time time() const { return m_time; }
+		std::uint_least64_t events_processed() const { return m_events_processed; }
 		devices::NETLIB_NAME(solver) *solver() const { return m_solver; }
 		devices::NETLIB_NAME(gnd) *gnd() const { return m_gnd; }
 		nl_double gmin() const;
@@ -1165,6 +1166,7 @@ namespace netlist
 		/* mostly rw */
 		netlist_time                        m_time;
 		detail::queue_t                     m_queue;
+		std::uint_least64_t                 m_events_processed; /* always counted, unlike the statistics below */
 
 		/* mostly ro */
 
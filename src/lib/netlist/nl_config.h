@@ -141,6 +141,14 @@ using nperfcount_t = plib::chrono::counter<false>;
 #define USE_OPENMP              (0)
 #endif // !defined(USE_OPENMP)
 
+// Use a heap instead of a sorted array for the event queue. This scales
+// better for large netlists with many events pending at the same time.
+// Use "nltool -c bench" to compare both.
+
+#if !defined(NL_USE_HEAP_QUEUE)
+#define NL_USE_HEAP_QUEUE       (0)
+#endif // !defined(NL_USE_HEAP_QUEUE)
+
 // Use nano-second resolution - Sufficient for now
 #define NETLIST_INTERNAL_RES        (UINT64_C(1000000000))
 //#define NETLIST_INTERNAL_RES      (UINT64_C(1000000000000))
@@ -10,7 +10,10 @@
 #ifndef NLLISTS_H_
 #define NLLISTS_H_
 
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
+#include <vector>
 
 #include "nl_config.h"
 #include "plib/plists.h"
@@ -21,12 +24,24 @@
 // timed queue
 // ----------------------------------------------------------------------------------------
 
+/*
+ * Two implementations are available, selected by NL_USE_HEAP_QUEUE:
+ *
+ * timed_queue_linear keeps a sorted array. Pushes are cheap if the new
+ * event is due soon, which is the common case for small netlists.
+ *
+ * timed_queue_heap is a d-ary heap with O(log n) push and pop and scales
+ * better with many pending events.
+ *
+ * Both pop events with equal time in reverse order of their push.
+ */
+
 namespace netlist
 {
 	template <class Element, class Time>
-	class timed_queue
+	class timed_queue_linear
 	{
-		P_PREVENT_COPYING(timed_queue)
+		P_PREVENT_COPYING(timed_queue_linear)
 	public:
 
 		struct entry_t
@@ -35,7 +50,7 @@ namespace netlist
 			Element m_object;
 		};
 
-		timed_queue(unsigned list_size)
+		timed_queue_linear(unsigned list_size)
 		: m_list(list_size)
 		{
 	#if HAS_OPENMP && USE_OPENMP
@@ -120,6 +135,9 @@ namespace netlist
 		std::size_t size() const noexcept { return static_cast<std::size_t>(m_end - &m_list[1]); }
 		const entry_t & operator[](const std::size_t index) const { return m_list[ 1 + index]; }
 
+		/* entries ordered from the last to be popped to the next one */
+		void snapshot(std::vector<entry_t> &list) const { list.assign(listptr(), listptr() + size()); }
+
 	private:
 
 	#if HAS_OPENMP && USE_OPENMP
@@ -134,6 +152,159 @@ namespace netlist
 		nperfcount_t m_prof_call;
 };
 
+	template <class Element, class Time, std::size_t D = 4>
+	class timed_queue_heap
+	{
+		P_PREVENT_COPYING(timed_queue_heap)
+	public:
+
+		struct entry_t
+		{
+			Time m_exec_time;
+			Element m_object;
+		};
+
+		timed_queue_heap(unsigned list_size)
+		: m_seq(0)
+		{
+			m_heap.reserve(list_size);
+		}
+
+		std::size_t capacity() const { return m_heap.capacity(); }
+		bool empty() const { return m_heap.empty(); }
+
+		void push(const Time t, Element o) noexcept
+		{
+			m_heap.push_back({ { t, o }, ++m_seq });
+			sift_up(m_heap.size() - 1);
+			m_prof_call.inc();
+		}
+
+		entry_t pop() noexcept
+		{
+			const entry_t ret = m_heap[0].m_entry;
+			m_heap[0] = m_heap.back();
+			m_heap.pop_back();
+			if (!m_heap.empty())
+				sift_down(0);
+			return ret;
+		}
+
+		const entry_t &top() const noexcept { return m_heap[0].m_entry; }
+
+		void remove(const Element &elem) noexcept
+		{
+			for (std::size_t i = 0; i < m_heap.size(); i++)
+			{
+				if (m_heap[i].m_entry.m_object == elem)
+				{
+					m_heap[i] = m_heap.back();
+					m_heap.pop_back();
+					if (i < m_heap.size())
+					{
+						sift_up(i);
+						sift_down(i);
+					}
+					return;
+				}
+			}
+		}
+
+		void retime(const Time t, const Element &elem) noexcept
+		{
+			remove(elem);
+			push(t, elem);
+		}
+
+		void clear()
+		{
+			m_heap.clear();
+			m_seq = 0;
+		}
+
+		std::size_t size() const noexcept { return m_heap.size(); }
+
+		/* entries ordered from the last to be popped to the next one; this
+		 * sorts a copy of the heap, so take one per save or debugger listing */
+		void snapshot(std::vector<entry_t> &list) const
+		{
+			std::vector<node_t> nodes(m_heap);
+			std::sort(nodes.begin(), nodes.end(), [](const node_t &a, const node_t &b) { return before(b, a); });
+			list.clear();
+			for (auto &n : nodes)
+				list.push_back(n.m_entry);
+		}
+
+	private:
+
+		/* m_seq keeps the order of events with equal time deterministic */
+		struct node_t
+		{
+			entry_t m_entry;
+			std::uint_least64_t m_seq;
+		};
+
+		static bool before(const node_t &a, const node_t &b) noexcept
+		{
+			return (a.m_entry.m_exec_time < b.m_entry.m_exec_time)
+				|| (a.m_entry.m_exec_time == b.m_entry.m_exec_time && a.m_seq > b.m_seq);
+		}
+
+		void sift_up(std::size_t i) noexcept
+		{
+			const node_t n = m_heap[i];
+			while (i > 0)
+			{
+				const std::size_t p = (i - 1) / D;
+				if (!before(n, m_heap[p]))
+					break;
+				m_heap[i] = m_heap[p];
+				i = p;
+				m_prof_sortmove.inc();
+			}
+			m_heap[i] = n;
+		}
+
+		void sift_down(std::size_t i) noexcept
+		{
+			const node_t n = m_heap[i];
+			const std::size_t sz = m_heap.size();
+			for (;;)
+			{
+				const std::size_t c = i * D + 1;
+				if (c >= sz)
+					break;
+				std::size_t best = c;
+				const std::size_t e = std::min(c + D, sz);
+				for (std::size_t k = c + 1; k < e; k++)
+					if (before(m_heap[k], m_heap[best]))
+						best = k;
+				if (!before(m_heap[best], n))
+					break;
+				m_heap[i] = m_heap[best];
+				i = best;
+				m_prof_sortmove.inc();
+			}
+			m_heap[i] = n;
+		}
+
+		std::vector<node_t> m_heap;
+		std::uint_least64_t m_seq;
+
+	public:
+		// profiling
+		nperfcount_t m_prof_sortmove;
+		nperfcount_t m_prof_call;
+	};
+
+#if (NL_USE_HEAP_QUEUE)
+	template <class Element, class Time>
+	using timed_queue = timed_queue_heap<Element, Time>;
+#else
+	template <class Element, class Time>
+	using timed_queue = timed_queue_linear<Element, Time>;
+#endif
+
 }
 
 #endif /* NLLISTS_H_ */
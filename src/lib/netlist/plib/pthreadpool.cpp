@@ -0,0 +1,114 @@
+// license:GPL-2.0+
+// copyright-holders:MAMEdev Team
+/*
+ * pthreadpool.cpp
+ *
+ */
+
+#include "pthreadpool.h"
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+namespace plib {
+
+static inline void spin_pause()
+{
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	__builtin_ia32_pause();
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	_mm_pause();
+#endif
+}
+
+thread_pool::thread_pool(std::size_t threads, unsigned spin_count)
+: m_job(nullptr)
+, m_spin_count(spin_count)
+, m_generation(0)
+, m_pending(0)
+, m_sleeping(0)
+, m_shutdown(false)
+{
+	for (std::size_t i = 1; i < threads; i++)
+		m_threads.emplace_back(&thread_pool::worker, this, i);
+}
+
+thread_pool::~thread_pool()
+{
+	m_shutdown = true;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_wakeup.notify_all();
+	}
+	for (auto &t : m_threads)
+		t.join();
+}
+
+void thread_pool::run(const job_func &job)
+{
+	if (m_threads.empty())
+	{
+		job(0);
+		return;
+	}
+
+	m_job = &job;
+	m_pending = m_threads.size();
+	m_generation++;
+
+	/* sleeping workers register under the lock before re-checking the
+	 * generation, so either they see the new one or we see them here */
+	if (m_sleeping > 0)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_wakeup.notify_all();
+	}
+
+	job(0);
+
+	unsigned spins = 0;
+	while (m_pending.load(std::memory_order_acquire) != 0)
+	{
+		if (spins < m_spin_count)
+		{
+			spins++;
+			spin_pause();
+		}
+		else
+			std::this_thread::yield();
+	}
+	m_job = nullptr;
+}
+
+void thread_pool::worker(std::size_t slot)
+{
+	unsigned seen = 0;
+	for (;;)
+	{
+		unsigned spins = 0;
+		unsigned gen;
+		while ((gen = m_generation) == seen && !m_shutdown)
+		{
+			if (spins < m_spin_count)
+			{
+				spins++;
+				spin_pause();
+			}
+			else
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_sleeping++;
+				m_wakeup.wait(lock, [this, seen] { return m_generation != seen || m_shutdown; });
+				m_sleeping--;
+			}
+		}
+		if (m_shutdown)
+			return;
+		seen = gen;
+		(*m_job)(slot);
+		m_pending.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+} // namespace plib
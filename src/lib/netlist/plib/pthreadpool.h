@@ -0,0 +1,68 @@
+// license:GPL-2.0+
+// copyright-holders:MAMEdev Team
+/*
+ * pthreadpool.h
+ *
+ */
+
+#ifndef PTHREADPOOL_H_
+#define PTHREADPOOL_H_
+
+#include <cstddef>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "pconfig.h"
+
+namespace plib {
+// ----------------------------------------------------------------------------------------
+// thread_pool: persistent fork/join pool for short, frequent parallel sections
+// ----------------------------------------------------------------------------------------
+
+/*
+ * Workers are created once and kept alive. After finishing a job they
+ * spin for spin_count iterations waiting for the next one before falling
+ * back to sleeping on a condition variable. The calling thread always
+ * takes part in a job as slot 0, so a pool of size() == 1 runs everything
+ * inline.
+ */
+class thread_pool
+{
+public:
+	using job_func = std::function<void(std::size_t)>;
+
+	explicit thread_pool(std::size_t threads, unsigned spin_count = 20000);
+	~thread_pool();
+
+	thread_pool(const thread_pool &) = delete;
+	thread_pool &operator=(const thread_pool &) = delete;
+
+	/* total number of slots, including the calling thread */
+	std::size_t size() const { return m_threads.size() + 1; }
+
+	/* call job(slot) once for every slot in [0, size()) and wait for all of them */
+	void run(const job_func &job);
+
+private:
+	void worker(std::size_t slot);
+
+	std::vector<std::thread> m_threads;
+	const job_func *m_job;
+	const unsigned m_spin_count;
+
+	std::atomic<unsigned> m_generation;
+	std::atomic<std::size_t> m_pending;
+	std::atomic<std::size_t> m_sleeping;
+	std::atomic<bool> m_shutdown;
+
+	std::mutex m_mutex;
+	std::condition_variable m_wakeup;
+};
+
+} // namespace plib
+
+#endif /* PTHREADPOOL_H_ */
@@ -27,7 +27,7 @@ public:
 	tool_options_t() :
 		plib::options(),
 		opt_grp1(*this,     "General options",              "The following options apply to all commands."),
-		opt_cmd (*this,     "c", "cmd",         "run",      "run:convert:listdevices:static", "run|convert|listdevices|static"),
+		opt_cmd (*this,     "c", "cmd",         "run",      "run:convert:listdevices:static:bench", "run|convert|listdevices|static|bench"),
 		opt_file(*this,     "f", "file",        "-",        "file to process (default is stdin)"),
 		opt_defines(*this,  "D", "define",                  "predefine value as macro, e.g. -Dname=value. If '=value' is omitted predefine it as 1. This option may be specified repeatedly."),
 		opt_verb(*this,     "v", "verbose",                 "be verbose - this produces lots of output"),
@@ -36,7 +36,7 @@ public:
 		opt_help(*this,     "h", "help",                    "display help and exit"),
 		opt_grp2(*this,     "Options for run and static commands",   "These options apply to run and static commands."),
 		opt_name(*this,     "n", "name",        "",         "the netlist in file specified by ""-f"" option to run; default is first one"),
-		opt_grp3(*this,     "Options for run command",      "These options are only used by the run command."),
+		opt_grp3(*this,     "Options for run and bench commands", "These options are only used by the run and bench commands."),
 		opt_ttr (*this,     "t", "time_to_run", 1.0,        "time to run the emulation (seconds)"),
 		opt_logs(*this,     "l", "log" ,                    "define terminal to log. This option may be specified repeatedly."),
 		opt_inp(*this,      "i", "input",       "",         "input file to process (default is none)"),
@@ -46,7 +46,9 @@ public:
 		opt_ex1(*this,     "nltool -c run -t 3.5 -f nl_examples/cdelay.c -n cap_delay",
 				"Run netlist \"cap_delay\" from file nl_examples/cdelay.c for 3.5 seconds"),
 		opt_ex2(*this,     "nltool --cmd=listdevices",
-				"List all known devices.")
+				"List all known devices."),
+		opt_ex3(*this,     "nltool -c bench -t 10 -f nl_examples/breakout.c",
+				"Run netlist from file nl_examples/breakout.c for 10 seconds and report queue events per second")
 		{}
 
 	plib::option_group  opt_grp1;
@@ -67,6 +69,7 @@ public:
 	plib::option_str_limit opt_type;
 	plib::option_example opt_ex1;
 	plib::option_example opt_ex2;
+	plib::option_example opt_ex3;
 };
 
 static plib::pstdout pout_strm;
@@ -278,6 +281,39 @@ static void run(tool_options_t &opts)
 	pout("{1:f} seconds emulation took {2:f} real time ==> {3:5.2f}%\n", ttr, emutime, ttr/emutime*100.0);
 }
 
+static void bench(tool_options_t &opts)
+{
+	netlist_tool_t nt("netlist");
+
+	nt.init();
+
+	nt.log().verbose.set_enabled(false);
+	nt.log().warning.set_enabled(false);
+
+	nt.read_netlist(opts.opt_file(), opts.opt_name(),
+			opts.opt_logs(),
+			opts.opt_defines());
+
+	const double ttr = opts.opt_ttr();
+	const auto events_start = nt.events_processed();
+
+	plib::chrono::timer<plib::chrono::system_ticks> t;
+	t.start();
+	nt.process_queue(netlist::netlist_time::from_double(ttr));
+	t.stop();
+
+	const auto events = nt.events_processed() - events_start;
+	nt.stop();
+
+	const double emutime = t.as_seconds();
+	pout("queue      : {1}\n", NL_USE_HEAP_QUEUE ? "heap" : "linear");
+	pout("netlist    : {1}\n", opts.opt_file());
+	pout("emulated   : {1:f} seconds\n", ttr);
+	pout("real time  : {1:f} seconds ==> {2:5.2f}%\n", emutime, ttr/emutime*100.0);
+	pout("events     : {1}\n", static_cast<unsigned long long>(events));
+	pout("events/s   : {1:.0f}\n", static_cast<double>(events) / emutime);
+}
+
 static void static_compile(tool_options_t &opts)
 {
 	netlist_tool_t nt("netlist");
@@ -442,6 +478,8 @@ int main(int argc, char *argv[])
 			run(opts);
 		else if (cmd == "static")
 			static_compile(opts);
+		else if (cmd == "bench")
+			bench(opts);
 		else if (cmd == "convert")
 		{
 			pstring contents;
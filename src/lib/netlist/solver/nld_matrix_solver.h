@@ -13,6 +13,7 @@
 //#include "solver/nld_solver.h"
 #include "nl_base.h"
 #include "plib/pstream.h"
+#include "plib/pchrono.h"
 
 namespace netlist
 {
@@ -130,6 +131,7 @@ public:
 	, m_fb_sync(*this, "FB_sync")
 	, m_Q_sync(*this, "Q_sync")
 	, m_sort(sort)
+	, m_inputs_pending(false)
 	{
 		connect_post_start(m_fb_sync, m_Q_sync);
 	}
@@ -142,6 +144,16 @@ public:
 
 	const netlist_time solve();
 
+	/* solve() split in two: solve_isolated() only touches the solver's own
+	 * nets and may run concurrently with other solvers, flush_inputs()
+	 * pushes the results to the queue and must be called serially.
+	 */
+	const netlist_time solve_isolated();
+	void flush_inputs();
+
+	/* accumulated time spent in solve_isolated(), in fast_ticks */
+	plib::chrono::fast_ticks::type solve_ticks() const { return m_stat_solve_time.total(); }
+
 	inline bool has_dynamic_devices() const { return m_dynamic_devices.size() > 0; }
 	inline bool has_timestep_devices() const { return m_step_devices.size() > 0; }
 
@@ -220,6 +232,9 @@ private:
 	void update_inputs();
 
 	const eSortType m_sort;
+
+	bool m_inputs_pending;
+	plib::chrono::timer<plib::chrono::fast_ticks, true> m_stat_solve_time;
 };
 
 template <typename T>
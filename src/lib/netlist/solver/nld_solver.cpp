@@ -31,12 +31,10 @@
 
 #include <iostream>
 #include <algorithm>
+#include <numeric>
+#include <thread>
 #include "nl_lists.h"
 
-#if HAS_OPENMP
-#include "omp.h"
-#endif
-
 #include "plib/putil.h"
 #include "nld_solver.h"
 #include "nld_matrix_solver.h"
@@ -442,6 +440,13 @@ void matrix_solver_t::solve_base()
 }
 
 const netlist_time matrix_solver_t::solve()
+{
+	const netlist_time next_time_step = solve_isolated();
+	flush_inputs();
+	return next_time_step;
+}
+
+const netlist_time matrix_solver_t::solve_isolated()
 {
 	const netlist_time now = netlist().time();
 	const netlist_time delta = now - m_last_step;
@@ -451,17 +456,27 @@ const netlist_time matrix_solver_t::solve()
 	if (delta < netlist_time::quantum())
 		return netlist_time::zero();
 
+	m_stat_solve_time.start();
 	/* update all terminals for new time step */
 	m_last_step = now;
 	step(delta);
 	solve_base();
 	const netlist_time next_time_step = compute_next_timestep(delta.as_double());
+	m_stat_solve_time.stop();
 
-	update_inputs();
-
+	m_inputs_pending = true;
 	return next_time_step;
 }
 
+void matrix_solver_t::flush_inputs()
+{
+	if (m_inputs_pending)
+	{
+		m_inputs_pending = false;
+		update_inputs();
+	}
+}
+
 int matrix_solver_t::get_net_idx(detail::net_t *net)
 {
 	for (std::size_t k = 0; k < m_nets.size(); k++)
@@ -556,6 +571,8 @@ void matrix_solver_t::log_stats()
 				100.0 * static_cast<double>(this->m_iterative_fail())
 					/ static_cast<double>(this->m_stat_calculations()),
 				static_cast<double>(this->m_iterative_total()) / static_cast<double>(this->m_stat_calculations()));
+		log().verbose("       {1:10} ticks per solve  {2:10.6} s total solve time",
+				m_stat_solve_time.average(), m_stat_solve_time.as_seconds());
 	}
 }
 
@@ -586,36 +603,23 @@ NETLIB_UPDATE(solver)
 		return;
 
 
-#if HAS_OPENMP && USE_OPENMP
-	const std::size_t t_cnt = m_mat_solvers.size();
-	if (m_parallel())
+	if (m_thread_pool)
 	{
-		omp_set_num_threads(3);
-		//omp_set_dynamic(0);
-		#pragma omp parallel
-		{
-			#pragma omp for
-			for (int i = 0; i <  t_cnt; i++)
-				if (m_mat_solvers[i]->has_timestep_devices())
-				{
-					// Ignore return value
-					ATTR_UNUSED const netlist_time ts = m_mat_solvers[i]->solve();
-				}
-		}
+		if (m_steps_to_rebalance-- == 0)
+			partition_solvers();
+
+		m_thread_pool->run(m_solve_job);
+
+		/* Queue pushes happen serially and in solver order so the
+		 * result does not depend on thread scheduling.
+		 */
+		for (auto & solver : m_step_solvers)
+			solver->flush_inputs();
 	}
 	else
-		for (int i = 0; i < t_cnt; i++)
-			if (m_mat_solvers[i]->has_timestep_devices())
-			{
-				// Ignore return value
-				ATTR_UNUSED const netlist_time ts = m_mat_solvers[i]->solve();
-			}
-#else
-	for (auto & solver : m_mat_solvers)
-		if (solver->has_timestep_devices())
+		for (auto & solver : m_step_solvers)
 			// Ignore return value
 			ATTR_UNUSED const netlist_time ts = solver->solve();
-#endif
 
 	/* step circuit */
 	if (!m_Q_step.net().is_queued())
@@ -886,6 +890,79 @@ void NETLIB_NAME(solver)::post_start()
 
 		m_mat_solvers.push_back(std::move(ms));
 	}
+
+	setup_parallel();
+}
+
+void NETLIB_NAME(solver)::setup_parallel()
+{
+	m_step_solvers.clear();
+	for (auto & s : m_mat_solvers)
+		if (s->has_timestep_devices())
+			m_step_solvers.push_back(s.get());
+
+	std::size_t threads = 0;
+	if (m_parallel() == 1)
+		threads = std::max(std::thread::hardware_concurrency(), 1u);
+	else if (m_parallel() > 1)
+		threads = static_cast<std::size_t>(m_parallel());
+	threads = std::min(threads, m_step_solvers.size());
+
+	m_thread_pool = nullptr;
+	m_partitions.clear();
+	if (threads < 2)
+		return;
+
+	netlist().log().verbose("Solving {1} time step solvers on {2} threads", m_step_solvers.size(), threads);
+	m_thread_pool = plib::make_unique<plib::thread_pool>(threads);
+	m_partitions.resize(threads);
+	m_solver_cost.assign(m_step_solvers.size(), 0.0);
+	m_solver_ticks.assign(m_step_solvers.size(), 0);
+	m_solve_job = [this](std::size_t slot)
+	{
+		for (auto & solver : m_partitions[slot])
+			// Ignore return value
+			ATTR_UNUSED const netlist_time ts = solver->solve_isolated();
+	};
+
+	/* no measurements yet - start round robin and rebalance early */
+	partition_solvers();
+	m_steps_to_rebalance = 64;
+}
+
+void NETLIB_NAME(solver)::partition_solvers()
+{
+	const std::size_t n = m_step_solvers.size();
+
+	/* exponentially weighted cost, measured since the last partitioning */
+	for (std::size_t i = 0; i < n; i++)
+	{
+		const auto ticks = m_step_solvers[i]->solve_ticks();
+		m_solver_cost[i] = 0.5 * m_solver_cost[i] + 0.5 * static_cast<double>(ticks - m_solver_ticks[i]);
+		m_solver_ticks[i] = ticks;
+	}
+
+	/* longest processing time first, ties resolved by solver order */
+	std::vector<std::size_t> order(n);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(),
+		[this](std::size_t a, std::size_t b) { return m_solver_cost[a] > m_solver_cost[b]; });
+
+	std::vector<double> load(m_partitions.size(), 0.0);
+	std::vector<std::size_t> slot_of(n);
+	for (auto i : order)
+	{
+		const std::size_t slot = static_cast<std::size_t>(std::min_element(load.begin(), load.end()) - load.begin());
+		load[slot] += std::max(m_solver_cost[i], 1.0);
+		slot_of[i] = slot;
+	}
+
+	for (auto & p : m_partitions)
+		p.clear();
+	for (std::size_t i = 0; i < n; i++)
+		m_partitions[slot_of[i]].push_back(m_step_solvers[i]);
+
+	m_steps_to_rebalance = 4096;
 }
 
 void NETLIB_NAME(solver)::create_solver_code(plib::postream &strm)
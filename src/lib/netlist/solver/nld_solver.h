@@ -11,6 +11,7 @@
 #include "nl_setup.h"
 #include "nl_base.h"
 #include "plib/pstream.h"
+#include "plib/pthreadpool.h"
 #include "solver/nld_matrix_solver.h"
 
 //#define ATTR_ALIGNED(N) __attribute__((aligned(N)))
@@ -56,7 +57,7 @@ NETLIB_OBJECT(solver)
 	, m_gmin(*this, "GMIN", NETLIST_GMIN_DEFAULT)
 	, m_pivot(*this, "PIVOT", 0)                    // use pivoting - on supported solvers
 	, m_nr_loops(*this, "NR_LOOPS", 250)            // Newton-Raphson loops
-	, m_parallel(*this, "PARALLEL", 0)
+	, m_parallel(*this, "PARALLEL", 0)            // 0: serial, 1: one thread per core, n: n threads
 
 	/* automatic time step */
 	, m_dynamic(*this, "DYNAMIC_TS", 0)
@@ -64,6 +65,7 @@ NETLIB_OBJECT(solver)
 	, m_min_timestep(*this, "MIN_TIMESTEP", 1e-6)   // nl_double timestep resolution
 
 	, m_log_stats(*this, "LOG_STATS", 1)   // nl_double timestep resolution
+	, m_steps_to_rebalance(0)
 	{
 		// internal staff
 
@@ -110,6 +112,18 @@ private:
 
 	solver_parameters_t m_params;
 
+	/* parallel solving of the time step solvers */
+	void setup_parallel();
+	void partition_solvers();
+
+	std::vector<matrix_solver_t *> m_step_solvers;
+	std::unique_ptr<plib::thread_pool> m_thread_pool;
+	plib::thread_pool::job_func m_solve_job;
+	std::vector<std::vector<matrix_solver_t *>> m_partitions;
+	std::vector<double> m_solver_cost;
+	std::vector<plib::chrono::fast_ticks::type> m_solver_ticks;
+	unsigned m_steps_to_rebalance;
+
 	template <int m_N, int storage_N>
 	std::unique_ptr<matrix_solver_t> create_solver(unsigned size, bool use_specific);
 };
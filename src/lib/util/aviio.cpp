@@ -8,10 +8,12 @@
 
 ***************************************************************************/
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <queue>
 
 #include "aviio.h"
 
@@ -231,6 +233,14 @@
 
 #define HUFFYUV_PREDICT_DECORR   0x40
 
+/**
+ * @def HUFFYUV_PROGRESSIVE
+ *
+ * @brief   Flag marking HuffYUV data as progressive rather than interlaced.
+ */
+
+#define HUFFYUV_PROGRESSIVE      0x20
+
 
 namespace {
 /***************************************************************************
@@ -286,6 +296,7 @@ public:
 		, m_depth(0)
 		, m_interlace(0)
 		, m_huffyuv()
+		, m_huffyuv_encoder()
 		, m_channels(0)
 		, m_samplebits(0)
 		, m_samplerate(0)
@@ -313,6 +324,10 @@ public:
 		m_width = width;
 		m_height = height;
 		m_depth = info.video_depth;
+
+		/* HuffYUV streams carry their code tables in the header */
+		if (m_format == FORMAT_HFYU)
+			huffyuv_build_encoder();
 	}
 
 	void initialize_audio(avi_file::movie_info const &info)
@@ -365,6 +380,9 @@ public:
 
 	// HuffYUV helpers
 	avi_file::error huffyuv_decompress_to_yuy16(const std::uint8_t *data, std::uint32_t numbytes, bitmap_yuy16 &bitmap) const;
+	avi_file::error rgb32_compress_to_huffyuv(const bitmap_rgb32 &bitmap, std::vector<std::uint8_t> &data) const;
+	void huffyuv_append_header(std::vector<std::uint8_t> &data) const;
+	bool huffyuv_can_decompress() const { return bool(m_huffyuv); }
 
 private:
 	struct huffyuv_table
@@ -382,7 +400,14 @@ private:
 		huffyuv_table       table[3];               /* array of tables */
 	};
 
+	struct huffyuv_encoder
+	{
+		std::uint8_t        length[3][256];         /* code lengths */
+		std::uint32_t       code[3][256];           /* right-aligned codes */
+	};
+
 	avi_file::error huffyuv_extract_tables(const std::uint8_t *chunkdata, std::uint32_t size);
+	void huffyuv_build_encoder();
 
 	std::uint32_t       m_type;                 /* subtype of stream */
 	std::uint32_t       m_format;               /* format of stream data */
@@ -398,6 +423,7 @@ private:
 	std::uint32_t       m_depth;                /* depth of video */
 	std::uint8_t        m_interlace;            /* interlace parameters */
 	std::unique_ptr<huffyuv_data const> m_huffyuv; /* huffyuv decompression data */
+	std::unique_ptr<huffyuv_encoder const> m_huffyuv_encoder; /* huffyuv compression tables */
 
 	std::uint16_t       m_channels;             /* audio channels */
 	std::uint16_t       m_samplebits;           /* audio bits per sample */
@@ -465,6 +491,9 @@ public:
 	virtual error append_video_frame(bitmap_rgb32 &bitmap) override;
 	virtual error append_sound_samples(int channel, std::int16_t const *samples, std::uint32_t numsamples, std::uint32_t sampleskip) override;
 
+	virtual error compress_video_frame(bitmap_rgb32 const &bitmap, std::vector<std::uint8_t> &data) const override;
+	virtual error append_compressed_video_frame(std::uint8_t const *data, std::uint32_t length) override;
+
 	error read_movie_data();
 	error write_initial_headers();
 	error soundbuf_initialize();
@@ -492,6 +521,7 @@ private:
 	}
 
 	avi_stream *get_video_stream();
+	avi_stream const *get_video_stream() const;
 	avi_stream *get_audio_stream(int channel, int &offset);
 	std::uint32_t compute_idx1_size() const;
 	std::uint32_t get_chunkid_for_stream(const avi_stream *stream) const;
@@ -785,7 +815,7 @@ inline avi_file::error avi_stream::set_strf_data(std::uint8_t const *data, std::
 		m_format = fetch_32bits(&data[16]);
 
 		/* extra extraction for HuffYUV data */
-		if ((m_format == FORMAT_HFYU) && (size >= 56))
+		if ((m_format == FORMAT_HFYU) && (m_depth == 16) && (size >= 56))
 		{
 			avi_file::error const avierr = huffyuv_extract_tables(data, size);
 			if (avierr != avi_file::error::NONE)
@@ -824,6 +854,15 @@ inline avi_stream *avi_file_impl::get_video_stream()
 	return nullptr;
 }
 
+inline avi_stream const *avi_file_impl::get_video_stream() const
+{
+	for (int streamnum = 0; streamnum < m_streams.size(); streamnum++)
+		if (m_streams[streamnum].type() == STREAMTYPE_VIDS)
+			return &m_streams[streamnum];
+
+	return nullptr;
+}
+
 
 /*-------------------------------------------------
     get_audio_stream - return a pointer to the
@@ -1485,6 +1524,217 @@ avi_file::error avi_stream::huffyuv_decompress_to_yuy16(const std::uint8_t *data
 }
 
 
+/*-------------------------------------------------
+    huffyuv_build_encoder - build the fixed
+    HuffYUV code tables used when writing
+-------------------------------------------------*/
+
+/**
+ * @fn  void huffyuv_build_encoder()
+ *
+ * @brief   Builds the HuffYUV compression tables.
+ *
+ * HuffYUV stores its code tables once in the stream header, so they have
+ * to be chosen before the first frame is seen. Left-predicted residuals of
+ * emulated screens are overwhelmingly zero and fall off quickly on either
+ * side, so the tables are built from a distribution modelling exactly that.
+ */
+
+void avi_stream::huffyuv_build_encoder()
+{
+	std::unique_ptr<huffyuv_encoder> encoder = std::make_unique<huffyuv_encoder>();
+
+	/* weight each residual by the inverse square of its distance from zero */
+	std::uint32_t weight[256];
+	for (int value = 0; value < 256; value++)
+	{
+		int const distance = (std::min)(value, 256 - value);
+		weight[value] = (1 << 20) / ((distance + 1) * (distance + 1));
+	}
+
+	/* build a Huffman tree over all 256 symbols; nodes 256 and up are internal */
+	typedef std::pair<std::uint32_t, int> node;
+	std::priority_queue<node, std::vector<node>, std::greater<node> > queue;
+	int parent[511];
+	for (int value = 0; value < 256; value++)
+		queue.emplace(weight[value], value);
+	for (int next = 256; queue.size() > 1; next++)
+	{
+		node const a = queue.top(); queue.pop();
+		node const b = queue.top(); queue.pop();
+		parent[a.second] = parent[b.second] = next;
+		parent[next] = -1;
+		queue.emplace(a.first + b.first, next);
+	}
+
+	/* code lengths are the depths of the leaves */
+	std::uint8_t length[256];
+	for (int value = 0; value < 256; value++)
+	{
+		int depth = 0;
+		for (int scan = value; parent[scan] != -1; scan = parent[scan])
+			depth++;
+		assert(depth > 0 && depth < 32);
+		length[value] = depth;
+	}
+
+	/* assign canonical codes the way the decoder rebuilds them: longest first */
+	for (int tabnum = 0; tabnum < 3; tabnum++)
+	{
+		std::uint32_t bits = 0;
+		std::memcpy(encoder->length[tabnum], length, sizeof(length));
+		for (int len = 31; len > 0; len--)
+		{
+			for (int value = 0; value < 256; value++)
+				if (length[value] == len)
+					encoder->code[tabnum][value] = bits++;
+			bits >>= 1;
+		}
+	}
+
+	m_huffyuv_encoder = std::move(encoder);
+}
+
+
+/*-------------------------------------------------
+    huffyuv_append_header - append the HuffYUV
+    part of the video strf chunk
+-------------------------------------------------*/
+
+/**
+ * @fn  void huffyuv_append_header(std::vector<std::uint8_t> &data) const
+ *
+ * @brief   Appends the predictor and run-length coded code tables.
+ *
+ * @param [in,out]  data    The strf data following the BITMAPINFOHEADER.
+ */
+
+void avi_stream::huffyuv_append_header(std::vector<std::uint8_t> &data) const
+{
+	assert(m_huffyuv_encoder);
+
+	data.push_back(HUFFYUV_PREDICT_LEFT | HUFFYUV_PREDICT_DECORR);
+	data.push_back(m_depth);
+	data.push_back(HUFFYUV_PROGRESSIVE);
+	data.push_back(0);
+
+	/* runs of equal lengths; a zero count means the next byte holds the count */
+	for (int tabnum = 0; tabnum < 3; tabnum++)
+	{
+		std::uint8_t const *const length = m_huffyuv_encoder->length[tabnum];
+		for (int offset = 0; offset < 256; )
+		{
+			int count = 0;
+			while (offset + count < 256 && length[offset + count] == length[offset] && count < 255)
+				count++;
+			if (count > 7)
+			{
+				data.push_back(length[offset]);
+				data.push_back(count);
+			}
+			else
+				data.push_back(length[offset] | (count << 5));
+			offset += count;
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    rgb32_compress_to_huffyuv - compress an RGB32
+    bitmap to left-predicted, decorrelated RGB
+    HuffYUV data
+-------------------------------------------------*/
+
+/**
+ * @fn  avi_error rgb32_compress_to_huffyuv(const bitmap_rgb32 &bitmap, std::vector<std::uint8_t> &data) const
+ *
+ * @brief   RGB 32 compress to HuffYUV.
+ *
+ * Rows are coded bottom-up like any other RGB DIB. The first pixel is
+ * stored raw; every following pixel codes G, B-G and R-G of its difference
+ * to the pixel before it, carrying over from one row to the next.
+ *
+ * @param   bitmap          The bitmap.
+ * @param [in,out]  data    Receives the compressed frame.
+ *
+ * @return  An avi_error.
+ */
+
+avi_file::error avi_stream::rgb32_compress_to_huffyuv(const bitmap_rgb32 &bitmap, std::vector<std::uint8_t> &data) const
+{
+	if (!m_huffyuv_encoder || m_depth != 24)
+		return avi_file::error::UNSUPPORTED_VIDEO_FORMAT;
+	huffyuv_encoder const &encoder = *m_huffyuv_encoder;
+
+	int const height = (std::min<int>)(m_height, bitmap.height());
+	int const width = (std::min<int>)(m_width, bitmap.width());
+
+	/* size the output for the worst case */
+	int maxlength = 0;
+	for (int tabnum = 0; tabnum < 3; tabnum++)
+		maxlength = (std::max<int>)(maxlength, *std::max_element(&encoder.length[tabnum][0], &encoder.length[tabnum][256]));
+	std::uint64_t const maxbits = 32 + std::uint64_t(m_width) * m_height * 3 * maxlength;
+	try { data.resize(((maxbits + 31) / 32) * 4); }
+	catch (...) { return avi_file::error::NO_MEMORY; }
+
+	/* bits are packed MSB-first into little-endian DWORDs */
+	std::uint8_t *dest = &data[0];
+	std::uint64_t bitbuffer = 0;
+	int bitsinbuffer = 0;
+	auto const put = [&dest, &bitbuffer, &bitsinbuffer] (std::uint32_t code, int bits)
+	{
+		bitbuffer = (bitbuffer << bits) | code;
+		bitsinbuffer += bits;
+		if (bitsinbuffer >= 32)
+		{
+			bitsinbuffer -= 32;
+			put_32bits(dest, std::uint32_t(bitbuffer >> bitsinbuffer));
+			dest += 4;
+		}
+	};
+
+	std::uint8_t lastr = 0, lastg = 0, lastb = 0;
+	bool first = true;
+	for (int y = m_height - 1; y >= 0; y--)
+	{
+		std::uint32_t const *const source = (y < height) ? &bitmap.pix32(y) : nullptr;
+		for (int x = 0; x < m_width; x++)
+		{
+			rgb_t const pix = (source != nullptr && x < width) ? rgb_t(source[x]) : rgb_t(0, 0, 0);
+			if (first)
+			{
+				/* first pixel goes out raw */
+				put(pix.r(), 8);
+				put(pix.g(), 8);
+				put(pix.b(), 8);
+				put(0, 8);
+				first = false;
+			}
+			else
+			{
+				std::uint8_t const g = pix.g() - lastg;
+				std::uint8_t const b = pix.b() - lastb - g;
+				std::uint8_t const r = pix.r() - lastr - g;
+				put(encoder.code[1][g], encoder.length[1][g]);
+				put(encoder.code[0][b], encoder.length[0][b]);
+				put(encoder.code[2][r], encoder.length[2][r]);
+			}
+			lastr = pix.r();
+			lastg = pix.g();
+			lastb = pix.b();
+		}
+	}
+
+	/* flush the final partial DWORD */
+	if (bitsinbuffer > 0)
+		put(0, 32 - bitsinbuffer);
+	data.resize(dest - &data[0]);
+
+	return avi_file::error::NONE;
+}
+
+
 /*-------------------------------------------------
     avi_close - close an AVI movie file
 -------------------------------------------------*/
@@ -1631,6 +1881,8 @@ avi_file::error avi_file_impl::read_video_frame(std::uint32_t framenum, bitmap_y
 	/* validate our ability to handle the data */
 	if (stream->format() != FORMAT_UYVY && stream->format() != FORMAT_VYUY && stream->format() != FORMAT_YUY2 && stream->format() != FORMAT_HFYU)
 		return error::UNSUPPORTED_VIDEO_FORMAT;
+	if (stream->format() == FORMAT_HFYU && !stream->huffyuv_can_decompress())
+		return error::UNSUPPORTED_VIDEO_FORMAT;
 
 	/* assume one chunk == one frame */
 	if (framenum >= stream->chunks())
@@ -1862,41 +2114,91 @@ avi_file::error avi_file_impl::append_video_frame(bitmap_yuy16 &bitmap)
 
 avi_file::error avi_file_impl::append_video_frame(bitmap_rgb32 &bitmap)
 {
-	avi_stream *const stream = get_video_stream();
-	error avierr;
-	std::uint32_t maxlength;
+	/* compress into our temporary buffer and append that */
+	error const avierr = compress_video_frame(bitmap, m_tempbuffer);
+	if (avierr != error::NONE)
+		return avierr;
 
-	/* validate our ability to handle the data */
-	if (stream->format() != 0)
-		return error::UNSUPPORTED_VIDEO_FORMAT;
+	return append_compressed_video_frame(&m_tempbuffer[0], m_tempbuffer.size());
+}
+
+
+/*-------------------------------------------------
+    avi_compress_video_frame - compress a frame
+    of video in RGB32 format without writing it
+-------------------------------------------------*/
+
+/**
+ * @fn  avi_error compress_video_frame(bitmap_rgb32 const &bitmap, std::vector<std::uint8_t> &data) const
+ *
+ * @brief   Compresses a video frame for the stream's format.
+ *
+ * Only reads the stream setup, so frames can be compressed on several
+ * threads at once and appended in order afterwards.
+ *
+ * @param   bitmap          The bitmap.
+ * @param [in,out]  data    Receives the frame data.
+ *
+ * @return  An avi_error.
+ */
+
+avi_file::error avi_file_impl::compress_video_frame(bitmap_rgb32 const &bitmap, std::vector<std::uint8_t> &data) const
+{
+	avi_stream const *const stream = get_video_stream();
+	if (!stream)
+		return error::INVALID_STREAM;
 
 	/* depth must be 24 */
 	if (stream->depth() != 24)
 		return error::UNSUPPORTED_VIDEO_FORMAT;
 
-	/* write out any sound data first */
-	avierr = soundbuf_write_chunk(stream->chunks());
-	if (avierr != error::NONE)
-		return avierr;
+	/* HuffYUV sizes its own output */
+	if (stream->format() == FORMAT_HFYU)
+		return stream->rgb32_compress_to_huffyuv(bitmap, data);
+
+	/* otherwise only uncompressed RGB is supported */
+	if (stream->format() != 0)
+		return error::UNSUPPORTED_VIDEO_FORMAT;
+
+	try { data.resize(3 * stream->width() * stream->height()); }
+	catch (...) { return error::NO_MEMORY; }
+	return stream->rgb32_compress_to_rgb(bitmap, &data[0], data.size());
+}
 
-	/* make sure we have enough room */
-	maxlength = 3 * stream->width() * stream->height();
-	avierr = expand_tempbuffer(maxlength);
-	if (avierr != error::NONE)
-		return avierr;
 
-	/* copy the RGB data to the destination */
-	avierr = stream->rgb32_compress_to_rgb(bitmap, &m_tempbuffer[0], maxlength);
+/*-------------------------------------------------
+    avi_append_compressed_video_frame - append a
+    frame produced by compress_video_frame
+-------------------------------------------------*/
+
+/**
+ * @fn  avi_error append_compressed_video_frame(std::uint8_t const *data, std::uint32_t length)
+ *
+ * @brief   Appends a compressed video frame.
+ *
+ * @param   data    The frame data.
+ * @param   length  The length of the frame data.
+ *
+ * @return  An avi_error.
+ */
+
+avi_file::error avi_file_impl::append_compressed_video_frame(std::uint8_t const *data, std::uint32_t length)
+{
+	avi_stream *const stream = get_video_stream();
+	error avierr;
+
+	/* write out any sound data first */
+	avierr = soundbuf_write_chunk(stream->chunks());
 	if (avierr != error::NONE)
 		return avierr;
 
 	/* write the data */
-	avierr = chunk_write(get_chunkid_for_stream(stream), &m_tempbuffer[0], maxlength);
+	avierr = chunk_write(get_chunkid_for_stream(stream), data, length);
 	if (avierr != error::NONE)
 		return avierr;
 
 	/* set the info for this new chunk */
-	avierr = stream->set_chunk_info(stream->chunks(), m_writeoffs - maxlength - 8, maxlength + 8);
+	avierr = stream->set_chunk_info(stream->chunks(), m_writeoffs - length - 8, length + 8);
 	if (avierr != error::NONE)
 		return avierr;
 
@@ -3059,12 +3361,13 @@ avi_file::error avi_file_impl::write_strf_chunk(avi_stream const &stream)
 	/* video stream */
 	if (stream.type() == STREAMTYPE_VIDS)
 	{
-		std::uint8_t buffer[40];
+		std::vector<std::uint8_t> buffer(40, 0);
 
-		/* reset the buffer */
-		std::memset(buffer, 0, sizeof(buffer));
+		/* HuffYUV appends its tables to the header */
+		if (stream.format() == FORMAT_HFYU)
+			stream.huffyuv_append_header(buffer);
 
-		put_32bits(&buffer[0], sizeof(buffer));         /* biSize */
+		put_32bits(&buffer[0], buffer.size());          /* biSize */
 		put_32bits(&buffer[4], stream.width());         /* biWidth */
 		put_32bits(&buffer[8], stream.height());        /* biHeight */
 		put_16bits(&buffer[12], 1);                     /* biPlanes */
@@ -3074,7 +3377,7 @@ avi_file::error avi_file_impl::write_strf_chunk(avi_stream const &stream)
 					stream.width() * stream.height() * (stream.depth() + 7) / 8);
 
 		/* write the chunk */
-		return chunk_write(CHUNKTYPE_STRF, buffer, sizeof(buffer));
+		return chunk_write(CHUNKTYPE_STRF, &buffer[0], buffer.size());
 	}
 
 	/* audio stream */
@@ -3594,7 +3897,8 @@ avi_file::error avi_file::open(std::string const &filename, ptr &file)
 avi_file::error avi_file::create(std::string const &filename, movie_info const &info, ptr &file)
 {
 	/* validate video info */
-	if ((info.video_format != 0 && info.video_format != FORMAT_UYVY && info.video_format != FORMAT_VYUY && info.video_format != FORMAT_YUY2) ||
+	if ((info.video_format != 0 && info.video_format != FORMAT_UYVY && info.video_format != FORMAT_VYUY && info.video_format != FORMAT_YUY2 && info.video_format != FORMAT_HFYU) ||
+		(info.video_format == FORMAT_HFYU && info.video_depth != 24) ||
 		(info.video_width == 0) ||
 		(info.video_height == 0) ||
 		(info.video_depth == 0) ||
@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 
 /***************************************************************************
@@ -122,6 +123,11 @@ public:
 	virtual error append_video_frame(bitmap_rgb32 &bitmap) = 0;
 	virtual error append_sound_samples(int channel, std::int16_t const *samples, std::uint32_t numsamples, std::uint32_t sampleskip) = 0;
 
+	// compress_video_frame only reads the stream setup and may be called from
+	// several threads at once; appending must still happen one frame at a time
+	virtual error compress_video_frame(bitmap_rgb32 const &bitmap, std::vector<std::uint8_t> &data) const = 0;
+	virtual error append_compressed_video_frame(std::uint8_t const *data, std::uint32_t length) = 0;
+
 protected:
 	avi_file();
 };
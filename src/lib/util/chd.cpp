@@ -189,7 +189,8 @@ inline void chd_file::file_read(UINT64 offset, void *dest, UINT32 length)
 	if (m_file == nullptr)
 		throw CHDERR_NOT_OPEN;
 
-	// seek and read
+	// seek and read; read-ahead may be using the file from another thread
+	std::lock_guard<std::recursive_mutex> lock(m_read_mutex);
 	m_file->seek(offset, SEEK_SET);
 	UINT32 count = m_file->read(dest, length);
 	if (count != length)
@@ -289,10 +290,21 @@ inline UINT8 chd_file::bits_for_value(UINT64 value)
 
 chd_file::chd_file()
 	: m_file(nullptr),
-		m_owns_file(false)
+		m_owns_file(false),
+		m_hunk_cache_limit(0),
+		m_cache_hits(0),
+		m_cache_misses(0),
+		m_readahead_queue(nullptr),
+		m_decompress_queue(nullptr),
+		m_readahead_hunks(0),
+		m_readahead_start(0),
+		m_readahead_last(~0),
+		m_readahead_busy(false),
+		m_readahead_abort(false)
 {
 	// reset state
 	memset(m_decompressor, 0, sizeof(m_decompressor));
+	memset(m_readahead_decompressor, 0, sizeof(m_readahead_decompressor));
 	close();
 }
 
@@ -801,6 +813,9 @@ chd_error chd_file::open(util::core_file &file, bool writeable, chd_file *parent
 
 void chd_file::close()
 {
+	// stop any background decompression before tearing things down
+	readahead_stop();
+
 	// reset file characteristics
 	if (m_owns_file && m_file)
 		delete m_file;
@@ -844,13 +859,62 @@ void chd_file::close()
 	// reset caching
 	m_cache.clear();
 	m_cachehunk = ~0;
+	m_hunk_cache.clear();
+	m_hunk_cache_map.clear();
+	m_hunk_cache_limit = 0;
+	m_cache_hits = 0;
+	m_cache_misses = 0;
 }
 
 /**
  * @fn  chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
  *
  * @brief   -------------------------------------------------
- *            read - read a single hunk from the CHD file
+ *            read - read a single hunk from the CHD file, using the decompressed hunk cache
+ *            for compressed hunks when it is enabled
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [in,out]  buffer  If non-null, the buffer.
+ *
+ * @return  The hunk.
+ */
+
+chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
+{
+	// only decompressed data is worth keeping; everything else is read straight through
+	if (m_hunk_cache_limit == 0 || buffer == nullptr || !hunk_is_compressed(hunknum))
+		return read_hunk_uncached(hunknum, buffer);
+
+	// look in the cache first, waiting for the read-ahead if it is working on this hunk
+	{
+		std::unique_lock<std::mutex> lock(m_hunk_cache_mutex);
+		m_readahead_done.wait(lock, [this, hunknum] { return m_readahead_pending.find(hunknum) == m_readahead_pending.end(); });
+		if (hunk_cache_fetch(hunknum, buffer))
+		{
+			m_cache_hits++;
+			readahead_check(hunknum);
+			return CHDERR_NONE;
+		}
+	}
+
+	// decompress it and remember the result
+	m_cache_misses++;
+	chd_error err = read_hunk_uncached(hunknum, buffer);
+	if (err == CHDERR_NONE)
+	{
+		std::lock_guard<std::mutex> lock(m_hunk_cache_mutex);
+		hunk_cache_insert(hunknum, buffer);
+		readahead_check(hunknum);
+	}
+	return err;
+}
+
+/**
+ * @fn  chd_error chd_file::read_hunk_uncached(UINT32 hunknum, void *buffer)
+ *
+ * @brief   -------------------------------------------------
+ *            read_hunk_uncached - read and decompress a single hunk from the CHD file
  *          -------------------------------------------------.
  *
  * @exception   CHDERR_NOT_OPEN             Thrown when a chderr not open error condition occurs.
@@ -869,7 +933,7 @@ void chd_file::close()
  * @return  The hunk.
  */
 
-chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
+chd_error chd_file::read_hunk_uncached(UINT32 hunknum, void *buffer)
 {
 	// wrap this for clean reporting
 	try
@@ -899,12 +963,14 @@ chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
 				switch (rawmap[15] & V34_MAP_ENTRY_FLAG_TYPE_MASK)
 				{
 					case V34_MAP_ENTRY_TYPE_COMPRESSED:
+					{
+						// the decompressors and compressed data buffer are shared between threads
+						std::lock_guard<std::recursive_mutex> readlock(m_read_mutex);
 						blocklen = be_read(&rawmap[12], 2) + (rawmap[14] << 16);
 						file_read(blockoffs, &m_compressed[0], blocklen);
-						m_decompressor[0]->decompress(&m_compressed[0], blocklen, dest, m_hunkbytes);
-						if (!(rawmap[15] & V34_MAP_ENTRY_FLAG_NO_CRC) && dest != nullptr && util::crc32_creator::simple(dest, m_hunkbytes) != blockcrc)
-							throw CHDERR_DECOMPRESSION_ERROR;
+						hunk_decompress(m_decompressor, hunknum, &m_compressed[0], blocklen, dest);
 						return CHDERR_NONE;
+					}
 
 					case V34_MAP_ENTRY_TYPE_UNCOMPRESSED:
 						file_read(blockoffs, dest, m_hunkbytes);
@@ -959,13 +1025,13 @@ chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
 					case COMPRESSION_TYPE_1:
 					case COMPRESSION_TYPE_2:
 					case COMPRESSION_TYPE_3:
+					{
+						// the decompressors and compressed data buffer are shared between threads
+						std::lock_guard<std::recursive_mutex> readlock(m_read_mutex);
 						file_read(blockoffs, &m_compressed[0], blocklen);
-						m_decompressor[rawmap[0]]->decompress(&m_compressed[0], blocklen, dest, m_hunkbytes);
-						if (!m_decompressor[rawmap[0]]->lossy() && dest != nullptr && util::crc16_creator::simple(dest, m_hunkbytes) != blockcrc)
-							throw CHDERR_DECOMPRESSION_ERROR;
-						if (m_decompressor[rawmap[0]]->lossy() && util::crc16_creator::simple(&m_compressed[0], blocklen) != blockcrc)
-							throw CHDERR_DECOMPRESSION_ERROR;
+						hunk_decompress(m_decompressor, hunknum, &m_compressed[0], blocklen, dest);
 						return CHDERR_NONE;
+					}
 
 					case COMPRESSION_NONE:
 						file_read(blockoffs, dest, m_hunkbytes);
@@ -1226,6 +1292,478 @@ chd_error chd_file::write_bytes(UINT64 offset, const void *buffer, UINT32 bytes)
 	return CHDERR_NONE;
 }
 
+/**
+ * @fn  void chd_file::set_hunk_cache_size(UINT32 hunks)
+ *
+ * @brief   -------------------------------------------------
+ *            set_hunk_cache_size - set the number of decompressed hunks to keep; 0 disables the
+ *            cache (and read-ahead along with it)
+ *          -------------------------------------------------.
+ *
+ * @param   hunks   The maximum number of hunks.
+ */
+
+void chd_file::set_hunk_cache_size(UINT32 hunks)
+{
+	if (hunks == 0)
+		readahead_stop();
+
+	std::lock_guard<std::mutex> lock(m_hunk_cache_mutex);
+	m_hunk_cache_limit = hunks;
+	hunk_cache_trim(hunks);
+
+	// read-ahead must not push out the hunks being asked for
+	if (m_readahead_hunks > hunks / 2)
+		m_readahead_hunks = hunks / 2;
+}
+
+/**
+ * @fn  void chd_file::set_readahead(UINT32 hunks, bool multithreaded)
+ *
+ * @brief   -------------------------------------------------
+ *            set_readahead - when hunks are read in order, decompress up to this many of the
+ *            following hunks in the background; 0 disables read-ahead
+ *          -------------------------------------------------.
+ *
+ * @param   hunks           The number of hunks to read ahead.
+ * @param   multithreaded   true to decompress on all available processors rather than a
+ *                          single background thread.
+ */
+
+void chd_file::set_readahead(UINT32 hunks, bool multithreaded)
+{
+	// read-ahead fills the hunk cache, so it can't be any bigger than half of it
+	if (hunks > m_hunk_cache_limit / 2)
+		hunks = m_hunk_cache_limit / 2;
+
+	// start over with fresh queues
+	readahead_stop();
+	if (hunks == 0)
+		return;
+
+	m_readahead_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	if (m_readahead_queue == nullptr)
+		return;
+	if (multithreaded)
+		m_decompress_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
+	// allocate buffers for a full batch
+	m_readahead_item.resize(hunks);
+	for (auto &item : m_readahead_item)
+	{
+		item.m_chd = this;
+		item.m_compressed.resize(m_hunkbytes);
+		item.m_data.resize(m_hunkbytes);
+	}
+
+	std::lock_guard<std::mutex> lock(m_hunk_cache_mutex);
+	m_readahead_hunks = hunks;
+	m_readahead_last = ~0;
+	m_readahead_busy = false;
+	m_readahead_abort = false;
+}
+
+/**
+ * @fn  bool chd_file::hunk_is_compressed(UINT32 hunknum) const
+ *
+ * @brief   -------------------------------------------------
+ *            hunk_is_compressed - return true if reading the given hunk means decompressing it
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  true if the hunk is stored compressed.
+ */
+
+bool chd_file::hunk_is_compressed(UINT32 hunknum) const
+{
+	if (m_file == nullptr || hunknum >= m_hunkcount)
+		return false;
+
+	switch (m_version)
+	{
+		case 3:
+		case 4:
+			return (m_rawmap[16 * hunknum + 15] & V34_MAP_ENTRY_FLAG_TYPE_MASK) == V34_MAP_ENTRY_TYPE_COMPRESSED;
+
+		case 5:
+			return compressed() && m_rawmap[m_mapentrybytes * hunknum] <= COMPRESSION_TYPE_3;
+	}
+	return false;
+}
+
+/**
+ * @fn  bool chd_file::hunk_cache_fetch(UINT32 hunknum, void *buffer)
+ *
+ * @brief   -------------------------------------------------
+ *            hunk_cache_fetch - copy a hunk out of the cache if it is there, marking it as most
+ *            recently used; the cache lock must be held
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [in,out]  buffer  If non-null, the buffer; may be null to just check for presence.
+ *
+ * @return  true if the hunk was found.
+ */
+
+bool chd_file::hunk_cache_fetch(UINT32 hunknum, void *buffer)
+{
+	auto found = m_hunk_cache_map.find(hunknum);
+	if (found == m_hunk_cache_map.end())
+		return false;
+
+	m_hunk_cache.splice(m_hunk_cache.begin(), m_hunk_cache, found->second);
+	if (buffer != nullptr)
+		memcpy(buffer, &found->second->m_data[0], m_hunkbytes);
+	return true;
+}
+
+/**
+ * @fn  void chd_file::hunk_cache_insert(UINT32 hunknum, const void *buffer)
+ *
+ * @brief   -------------------------------------------------
+ *            hunk_cache_insert - add a freshly decompressed hunk to the cache, recycling the
+ *            least recently used entry if it is full; the cache lock must be held
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ * @param   buffer  The decompressed data.
+ */
+
+void chd_file::hunk_cache_insert(UINT32 hunknum, const void *buffer)
+{
+	if (m_hunk_cache_limit == 0 || m_hunk_cache_map.find(hunknum) != m_hunk_cache_map.end())
+		return;
+
+	// reuse the oldest entry if we're full, otherwise make a new one
+	if (m_hunk_cache.size() >= m_hunk_cache_limit)
+	{
+		hunk_cache_trim(m_hunk_cache_limit);
+		m_hunk_cache.splice(m_hunk_cache.begin(), m_hunk_cache, std::prev(m_hunk_cache.end()));
+		m_hunk_cache_map.erase(m_hunk_cache.front().m_hunknum);
+	}
+	else
+	{
+		m_hunk_cache.emplace_front();
+		m_hunk_cache.front().m_data.resize(m_hunkbytes);
+	}
+
+	hunk_cache_entry &entry = m_hunk_cache.front();
+	entry.m_hunknum = hunknum;
+	memcpy(&entry.m_data[0], buffer, m_hunkbytes);
+	m_hunk_cache_map[hunknum] = m_hunk_cache.begin();
+}
+
+/**
+ * @fn  void chd_file::hunk_cache_trim(UINT32 limit)
+ *
+ * @brief   -------------------------------------------------
+ *            hunk_cache_trim - discard the least recently used hunks until no more than the
+ *            given number remain; the cache lock must be held
+ *          -------------------------------------------------.
+ *
+ * @param   limit   The number of hunks to keep.
+ */
+
+void chd_file::hunk_cache_trim(UINT32 limit)
+{
+	while (m_hunk_cache.size() > limit)
+	{
+		m_hunk_cache_map.erase(m_hunk_cache.back().m_hunknum);
+		m_hunk_cache.pop_back();
+	}
+}
+
+/**
+ * @fn  UINT64 chd_file::hunk_compressed_location(UINT32 hunknum, UINT32 &complen)
+ *
+ * @brief   -------------------------------------------------
+ *            hunk_compressed_location - return the file offset and length of the data for a
+ *            hunk that hunk_is_compressed() says is compressed
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [out] complen     The length of the compressed data.
+ *
+ * @return  The offset of the compressed data within the file.
+ */
+
+UINT64 chd_file::hunk_compressed_location(UINT32 hunknum, UINT32 &complen)
+{
+	if (m_version < 5)
+	{
+		UINT8 *rawmap = &m_rawmap[16 * hunknum];
+		complen = be_read(&rawmap[12], 2) + (rawmap[14] << 16);
+		return be_read(&rawmap[0], 8);
+	}
+
+	UINT8 *rawmap = &m_rawmap[m_mapentrybytes * hunknum];
+	complen = be_read(&rawmap[1], 3);
+	return be_read(&rawmap[4], 6);
+}
+
+/**
+ * @fn  void chd_file::hunk_decompress(chd_decompressor *const *decompressor, UINT32 hunknum, const UINT8 *compressed, UINT32 complen, UINT8 *dest)
+ *
+ * @brief   -------------------------------------------------
+ *            hunk_decompress - decompress a compressed hunk with the given set of codecs and
+ *            check it against the CRC in the map
+ *          -------------------------------------------------.
+ *
+ * @exception   CHDERR_DECOMPRESSION_ERROR  Thrown when a chderr decompression error error
+ *                                          condition occurs.
+ *
+ * @param   decompressor    The codecs, one for each entry in m_compression.
+ * @param   hunknum         The hunknum.
+ * @param   compressed      The compressed data.
+ * @param   complen         The length of the compressed data.
+ * @param [in,out]  dest    If non-null, the destination.
+ */
+
+void chd_file::hunk_decompress(chd_decompressor *const *decompressor, UINT32 hunknum, const UINT8 *compressed, UINT32 complen, UINT8 *dest)
+{
+	// v3/v4 have a single codec and a CRC-32
+	if (m_version < 5)
+	{
+		UINT8 *rawmap = &m_rawmap[16 * hunknum];
+		decompressor[0]->decompress(compressed, complen, dest, m_hunkbytes);
+		if (!(rawmap[15] & V34_MAP_ENTRY_FLAG_NO_CRC) && dest != nullptr && util::crc32_creator::simple(dest, m_hunkbytes) != be_read(&rawmap[8], 4))
+			throw CHDERR_DECOMPRESSION_ERROR;
+		return;
+	}
+
+	// v5 picks one of four codecs, with a CRC-16 of the compressed data for lossy ones
+	UINT8 *rawmap = &m_rawmap[m_mapentrybytes * hunknum];
+	chd_decompressor *codec = decompressor[rawmap[0]];
+	UINT32 blockcrc = be_read(&rawmap[10], 2);
+	codec->decompress(compressed, complen, dest, m_hunkbytes);
+	if (!codec->lossy() && dest != nullptr && util::crc16_creator::simple(dest, m_hunkbytes) != blockcrc)
+		throw CHDERR_DECOMPRESSION_ERROR;
+	if (codec->lossy() && util::crc16_creator::simple(compressed, complen) != blockcrc)
+		throw CHDERR_DECOMPRESSION_ERROR;
+}
+
+/**
+ * @fn  void chd_file::readahead_check(UINT32 hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            readahead_check - note a hunk that was just read, and start decompressing the
+ *            ones after it in the background if reads look sequential; the cache lock must be
+ *            held
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ */
+
+void chd_file::readahead_check(UINT32 hunknum)
+{
+	if (m_readahead_queue == nullptr)
+		return;
+
+	bool sequential = (hunknum == m_readahead_last + 1);
+	m_readahead_last = hunknum;
+	if (!sequential || m_readahead_busy || m_readahead_abort || hunknum + 1 >= m_hunkcount)
+		return;
+
+	m_readahead_start = hunknum + 1;
+	m_readahead_busy = (osd_work_item_queue(m_readahead_queue, readahead_callback, this, WORK_ITEM_FLAG_AUTO_RELEASE) != nullptr);
+}
+
+/**
+ * @fn  void chd_file::readahead_stop()
+ *
+ * @brief   -------------------------------------------------
+ *            readahead_stop - wait for any background decompression to finish and release the
+ *            read-ahead queues and codecs
+ *          -------------------------------------------------.
+ */
+
+void chd_file::readahead_stop()
+{
+	if (m_readahead_queue == nullptr)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_hunk_cache_mutex);
+		m_readahead_abort = true;
+	}
+	osd_work_queue_wait(m_readahead_queue, osd_ticks_per_second() * 10);
+	osd_work_queue_free(m_readahead_queue);
+	m_readahead_queue = nullptr;
+	if (m_decompress_queue != nullptr)
+	{
+		osd_work_queue_free(m_decompress_queue);
+		m_decompress_queue = nullptr;
+	}
+
+	for (auto &codecs : m_readahead_decompressor)
+		for (auto &elem : codecs)
+		{
+			delete elem;
+			elem = nullptr;
+		}
+	m_readahead_item.clear();
+	m_readahead_hunks = 0;
+}
+
+/**
+ * @fn  void *chd_file::readahead_callback(void *param, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            readahead_callback - work queue entry point for read-ahead
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  param   The chd_file.
+ * @param   threadid        The threadid.
+ *
+ * @return  null.
+ */
+
+void *chd_file::readahead_callback(void *param, int threadid)
+{
+	reinterpret_cast<chd_file *>(param)->readahead();
+	return nullptr;
+}
+
+/**
+ * @fn  void chd_file::readahead()
+ *
+ * @brief   -------------------------------------------------
+ *            readahead - read the compressed data for the hunks following the last one read,
+ *            in file order, and hand each one off to be decompressed into the cache
+ *          -------------------------------------------------.
+ */
+
+void chd_file::readahead()
+{
+	// claim the hunks that need decompressing, so readers wait for them rather than doing the
+	// work twice
+	UINT32 batch = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_hunk_cache_mutex);
+		for (UINT32 hunknum = m_readahead_start; hunknum < m_readahead_start + m_readahead_hunks && hunknum < m_hunkcount; hunknum++)
+			if (hunk_is_compressed(hunknum) && m_hunk_cache_map.find(hunknum) == m_hunk_cache_map.end() && m_readahead_pending.insert(hunknum).second)
+				m_readahead_item[batch++].m_hunknum = hunknum;
+	}
+
+	for (UINT32 itemnum = 0; itemnum < batch; itemnum++)
+	{
+		readahead_item &item = m_readahead_item[itemnum];
+
+		// read the compressed data; on failure or shutdown, release the hunk so a reader can
+		// report the error itself
+		bool success;
+		{
+			std::lock_guard<std::mutex> lock(m_hunk_cache_mutex);
+			success = !m_readahead_abort;
+		}
+		if (success)
+		{
+			try
+			{
+				file_read(hunk_compressed_location(item.m_hunknum, item.m_complen), &item.m_compressed[0], item.m_complen);
+			}
+			catch (chd_error &)
+			{
+				success = false;
+			}
+		}
+		if (!success)
+		{
+			readahead_complete(item.m_hunknum, nullptr);
+			continue;
+		}
+
+		// decompress here if we don't have other threads to do it, or couldn't queue it; the
+		// spare codec slot is only ever used by this thread while waiting on the queue
+		if (m_decompress_queue == nullptr)
+			readahead_decompress(item, 0);
+		else if (osd_work_item_queue(m_decompress_queue, readahead_decompress_callback, &item, WORK_ITEM_FLAG_AUTO_RELEASE) == nullptr)
+			readahead_decompress(item, WORK_MAX_THREADS);
+	}
+
+	// the items are reused by the next batch, so wait for them all to finish
+	if (m_decompress_queue != nullptr)
+		while (!osd_work_queue_wait(m_decompress_queue, osd_ticks_per_second())) { }
+
+	std::lock_guard<std::mutex> lock(m_hunk_cache_mutex);
+	m_readahead_busy = false;
+}
+
+/**
+ * @fn  void *chd_file::readahead_decompress_callback(void *param, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            readahead_decompress_callback - work queue entry point for decompressing a hunk
+ *            that has been read ahead
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  param   The readahead_item.
+ * @param   threadid        The threadid.
+ *
+ * @return  null.
+ */
+
+void *chd_file::readahead_decompress_callback(void *param, int threadid)
+{
+	readahead_item *item = reinterpret_cast<readahead_item *>(param);
+	item->m_chd->readahead_decompress(*item, threadid);
+	return nullptr;
+}
+
+/**
+ * @fn  void chd_file::readahead_decompress(readahead_item &item, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            readahead_decompress - decompress a hunk that has been read ahead and add it to
+ *            the cache
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  item    The item to decompress.
+ * @param   threadid        The threadid, which selects the codecs to use.
+ */
+
+void chd_file::readahead_decompress(readahead_item &item, int threadid)
+{
+	chd_decompressor **decompressor = m_readahead_decompressor[threadid];
+	try
+	{
+		// each thread gets its own codecs, created the first time it needs them
+		if (decompressor[0] == nullptr)
+			for (int decompnum = 0; decompnum < ARRAY_LENGTH(m_compression); decompnum++)
+				decompressor[decompnum] = chd_codec_list::new_decompressor(m_compression[decompnum], *this);
+
+		hunk_decompress(decompressor, item.m_hunknum, &item.m_compressed[0], item.m_complen, &item.m_data[0]);
+	}
+	catch (chd_error &)
+	{
+		readahead_complete(item.m_hunknum, nullptr);
+		return;
+	}
+	readahead_complete(item.m_hunknum, &item.m_data[0]);
+}
+
+/**
+ * @fn  void chd_file::readahead_complete(UINT32 hunknum, const UINT8 *data)
+ *
+ * @brief   -------------------------------------------------
+ *            readahead_complete - add a hunk from the read-ahead to the cache and wake up
+ *            anyone waiting on it
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ * @param   data    The decompressed data, or nullptr if it could not be read.
+ */
+
+void chd_file::readahead_complete(UINT32 hunknum, const UINT8 *data)
+{
+	std::lock_guard<std::mutex> lock(m_hunk_cache_mutex);
+	if (data != nullptr)
+		hunk_cache_insert(hunknum, data);
+	m_readahead_pending.erase(hunknum);
+	m_readahead_done.notify_all();
+}
+
 /**
  * @fn  chd_error chd_file::read_metadata(chd_metadata_tag searchtag, UINT32 searchindex, std::string &output)
  *
@@ -2428,6 +2966,13 @@ chd_error chd_file::open_common(bool writeable)
 
 		// finish opening the file
 		create_open_common();
+
+		// keep recently decompressed hunks around for read-only compressed files
+		if (!writeable && compressed())
+		{
+			UINT32 hunks = DEFAULT_HUNK_CACHE_BYTES / m_hunkbytes;
+			set_hunk_cache_size((hunks < MIN_HUNK_CACHE_HUNKS) ? MIN_HUNK_CACHE_HUNKS : hunks);
+		}
 		return CHDERR_NONE;
 	}
 
@@ -22,6 +22,12 @@
 #include "hashing.h"
 #include "chdcodec.h"
 #include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 /***************************************************************************
 
@@ -298,6 +304,10 @@ class chd_file
 	static const UINT32 V5_HEADER_SIZE = 124;
 	static const UINT32 MAX_HEADER_SIZE = V5_HEADER_SIZE;
 
+	// decompressed hunks kept by default for read-only compressed files
+	static const UINT32 DEFAULT_HUNK_CACHE_BYTES = 8 * 1024 * 1024;
+	static const UINT32 MIN_HUNK_CACHE_HUNKS = 4;
+
 public:
 	// construction/destruction
 	chd_file();
@@ -347,6 +357,13 @@ public:
 	chd_error read_bytes(UINT64 offset, void *buffer, UINT32 bytes);
 	chd_error write_bytes(UINT64 offset, const void *buffer, UINT32 bytes);
 
+	// decompressed hunk cache
+	void set_hunk_cache_size(UINT32 hunks);
+	void set_readahead(UINT32 hunks, bool multithreaded = false);
+	UINT32 hunk_cache_size() const { return m_hunk_cache_limit; }
+	UINT64 cache_hits() const { return m_cache_hits; }
+	UINT64 cache_misses() const { return m_cache_misses; }
+
 	// metadata management
 	chd_error read_metadata(chd_metadata_tag searchtag, UINT32 searchindex, std::string &output);
 	chd_error read_metadata(chd_metadata_tag searchtag, UINT32 searchindex, dynamic_buffer &output);
@@ -370,6 +387,7 @@ public:
 private:
 	struct metadata_entry;
 	struct metadata_hash;
+	struct readahead_item;
 
 	// inline helpers
 	UINT64 be_read(const UINT8 *base, int numbytes);
@@ -395,6 +413,20 @@ private:
 	void hunk_write_compressed(UINT32 hunknum, INT8 compression, const UINT8 *compressed, UINT32 complength, util::crc16_t crc16);
 	void hunk_copy_from_self(UINT32 hunknum, UINT32 otherhunk);
 	void hunk_copy_from_parent(UINT32 hunknum, UINT64 parentunit);
+	chd_error read_hunk_uncached(UINT32 hunknum, void *buffer);
+	bool hunk_is_compressed(UINT32 hunknum) const;
+	UINT64 hunk_compressed_location(UINT32 hunknum, UINT32 &complen);
+	void hunk_decompress(chd_decompressor *const *decompressor, UINT32 hunknum, const UINT8 *compressed, UINT32 complen, UINT8 *dest);
+	bool hunk_cache_fetch(UINT32 hunknum, void *buffer);
+	void hunk_cache_insert(UINT32 hunknum, const void *buffer);
+	void hunk_cache_trim(UINT32 limit);
+	void readahead_check(UINT32 hunknum);
+	void readahead_stop();
+	static void *readahead_callback(void *param, int threadid);
+	void readahead();
+	static void *readahead_decompress_callback(void *param, int threadid);
+	void readahead_decompress(readahead_item &item, int threadid);
+	void readahead_complete(UINT32 hunknum, const UINT8 *data);
 	bool metadata_find(chd_metadata_tag metatag, INT32 metaindex, metadata_entry &metaentry, bool resume = false);
 	void metadata_set_previous_next(UINT64 prevoffset, UINT64 nextoffset);
 	void metadata_update_hash();
@@ -437,6 +469,41 @@ private:
 	// caching
 	dynamic_buffer          m_cache;            // single-hunk cache for partial reads/writes
 	UINT32                  m_cachehunk;        // which hunk is in the cache?
+
+	// decompressed hunk cache, most recently used first
+	struct hunk_cache_entry
+	{
+		UINT32              m_hunknum;          // hunk held in this entry
+		dynamic_buffer      m_data;             // decompressed data
+	};
+	std::recursive_mutex    m_read_mutex;       // serializes file access and decompression
+	std::mutex              m_hunk_cache_mutex; // protects the hunk cache and read-ahead state
+	std::list<hunk_cache_entry> m_hunk_cache;   // cached hunks in LRU order
+	std::unordered_map<UINT32, std::list<hunk_cache_entry>::iterator> m_hunk_cache_map; // lookup by hunk number
+	UINT32                  m_hunk_cache_limit; // maximum number of cached hunks, or 0 if disabled
+	std::atomic<UINT64>     m_cache_hits;       // reads satisfied by the hunk cache
+	std::atomic<UINT64>     m_cache_misses;     // reads that had to decompress
+
+	// read-ahead; compressed data is read in order on one thread and decompressed on others
+	struct readahead_item
+	{
+		chd_file *          m_chd;              // file being read
+		UINT32              m_hunknum;          // hunk being decompressed
+		UINT32              m_complen;          // length of the compressed data
+		dynamic_buffer      m_compressed;       // compressed data read from the file
+		dynamic_buffer      m_data;             // decompressed data
+	};
+	osd_work_queue *        m_readahead_queue;  // queue for reading compressed data
+	osd_work_queue *        m_decompress_queue; // queue for decompressing on multiple threads, or nullptr
+	std::vector<readahead_item> m_readahead_item; // one entry per hunk in a read-ahead batch
+	chd_decompressor *      m_readahead_decompressor[WORK_MAX_THREADS + 1][4]; // codecs for each decompression thread
+	std::unordered_set<UINT32> m_readahead_pending; // hunks claimed by the read-ahead but not yet cached
+	std::condition_variable m_readahead_done;   // signalled whenever a pending hunk is finished
+	UINT32                  m_readahead_hunks;  // number of hunks to decompress ahead
+	UINT32                  m_readahead_start;  // first hunk for the pending read-ahead
+	UINT32                  m_readahead_last;   // last hunk read, to detect sequential access
+	bool                    m_readahead_busy;   // is a read-ahead in progress?
+	bool                    m_readahead_abort;  // stop the read-ahead early
 };
 
 
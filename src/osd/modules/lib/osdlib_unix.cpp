@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/types.h>
 #include <signal.h>
 #include <dlfcn.h>
@@ -127,6 +128,20 @@ void osd_free_executable(void *ptr, size_t size)
 #endif
 }
 
+//============================================================
+//  osd_get_peak_memory
+//============================================================
+
+UINT64 osd_get_peak_memory(void)
+{
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+	// ru_maxrss is in kilobytes here
+	return UINT64(usage.ru_maxrss) * 1024;
+}
+
 //============================================================
 //  osd_break_into_debugger
 //============================================================
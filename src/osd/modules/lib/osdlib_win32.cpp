@@ -11,6 +11,7 @@
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 #include <mmsystem.h>
+#include <psapi.h>
 
 #include <stdlib.h>
 #ifndef _MSC_VER
@@ -224,6 +225,21 @@ void osd_free_executable(void *ptr, size_t size)
 }
 
 
+//============================================================
+//  osd_get_peak_memory
+//============================================================
+
+UINT64 osd_get_peak_memory(void)
+{
+#if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return counters.PeakWorkingSetSize;
+#endif
+	return 0;
+}
+
+
 //============================================================
 //  osd_break_into_debugger
 //============================================================
@@ -18,6 +18,9 @@ renderer_gdi::~renderer_gdi()
 	// free the bitmap memory
 	if (m_bmdata != nullptr)
 		global_free_array(m_bmdata);
+
+	if (m_band_queue != nullptr)
+		osd_work_queue_free(m_band_queue);
 }
 
 //============================================================
@@ -36,6 +39,15 @@ int renderer_gdi::create()
 	m_bminfo.bmiHeader.biYPelsPerMeter   = 0;
 	m_bminfo.bmiHeader.biClrUsed         = 0;
 	m_bminfo.bmiHeader.biClrImportant    = 0;
+
+	// draw in bands on several threads if asked to
+	auto win = assert_window();
+	m_bands = win->machine().options().swrender_bands();
+
+	// we redraw only what changed, so ask the core to work that out
+	win->target()->set_track_damage(true);
+	if (m_bands > 1)
+		m_band_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
 	return 0;
 }
 
@@ -77,17 +89,29 @@ int renderer_gdi::draw(const int update)
 	int pitch = (width + 3) & ~3;
 
 	// make sure our temporary bitmap is big enough
+	bool reuse = (width == m_drawn_width && height == m_drawn_height);
 	if (pitch * height * 4 > m_bmsize)
 	{
 		m_bmsize = pitch * height * 4 * 2;
 		global_free_array(m_bmdata);
 		m_bmdata = global_alloc_array(UINT8, m_bmsize);
+		reuse = false;
 	}
 
-	// draw the primitives to the bitmap
-	win->m_primlist->acquire_lock();
-	software_renderer<UINT32, 0,0,0, 16,8,0>::draw_primitives(*win->m_primlist, m_bmdata, width, height, pitch);
-	win->m_primlist->release_lock();
+	// draw the primitives to the bitmap; if it still holds the previous list, only redraw what changed
+	render_primitive_list &primlist = *win->m_primlist;
+	primlist.acquire_lock();
+	if (!reuse || primlist.serial() != m_drawn_serial)
+	{
+		if (reuse && primlist.damage_valid_since(m_drawn_serial))
+			software_renderer<UINT32, 0,0,0, 16,8,0>::draw_damage(primlist, m_bmdata, width, height, pitch, m_band_queue, m_bands);
+		else
+			software_renderer<UINT32, 0,0,0, 16,8,0>::draw_primitives(primlist, m_bmdata, width, height, pitch, m_band_queue, m_bands);
+		m_drawn_serial = primlist.serial();
+		m_drawn_width = width;
+		m_drawn_height = height;
+	}
+	primlist.release_lock();
 
 	// fill in bitmap-specific info
 	m_bminfo.bmiHeader.biWidth = pitch;
@@ -33,6 +33,11 @@ public:
 		: osd_renderer(window, FLAG_NONE)
 		, m_bmdata(nullptr)
 		, m_bmsize(0)
+		, m_band_queue(nullptr)
+		, m_bands(0)
+		, m_drawn_serial(0)
+		, m_drawn_width(0)
+		, m_drawn_height(0)
 	{
 	}
 	virtual ~renderer_gdi();
@@ -52,6 +57,15 @@ private:
 	BITMAPINFO              m_bminfo;
 	UINT8 *                 m_bmdata;
 	size_t                  m_bmsize;
+
+	// parallel drawing
+	osd_work_queue *        m_band_queue;
+	int                     m_bands;
+
+	// what the bitmap currently holds
+	UINT32                  m_drawn_serial;
+	int                     m_drawn_width;
+	int                     m_drawn_height;
 };
 
 #endif // __DRAWGDI__
@@ -243,6 +243,11 @@ int renderer_sdl1::create()
 	m_yuv_lookup = nullptr;
 	m_blittimer = 0;
 
+	// draw in bands on several threads if asked to
+	m_bands = win->machine().options().swrender_bands();
+	if (m_bands > 1)
+		m_band_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
 	yuv_init();
 	osd_printf_verbose("Leave renderer_sdl2::create\n");
 	return 0;
@@ -266,6 +271,11 @@ renderer_sdl1::~renderer_sdl1()
 		global_free_array(m_yuv_bitmap);
 		m_yuv_bitmap = nullptr;
 	}
+	if (m_band_queue != nullptr)
+	{
+		osd_work_queue_free(m_band_queue);
+		m_band_queue = nullptr;
+	}
 	SDL_DestroyRenderer(m_sdl_renderer);
 }
 
@@ -415,23 +425,23 @@ int renderer_sdl1::draw(int update)
 		switch (rmask)
 		{
 			case 0x0000ff00:
-				software_renderer<UINT32, 0,0,0, 8,16,24>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 4);
+				software_renderer<UINT32, 0,0,0, 8,16,24>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 4, m_band_queue, m_bands);
 				break;
 
 			case 0x00ff0000:
-				software_renderer<UINT32, 0,0,0, 16,8,0>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 4);
+				software_renderer<UINT32, 0,0,0, 16,8,0>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 4, m_band_queue, m_bands);
 				break;
 
 			case 0x000000ff:
-				software_renderer<UINT32, 0,0,0, 0,8,16>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 4);
+				software_renderer<UINT32, 0,0,0, 0,8,16>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 4, m_band_queue, m_bands);
 				break;
 
 			case 0xf800:
-				software_renderer<UINT16, 3,2,3, 11,5,0>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 2);
+				software_renderer<UINT16, 3,2,3, 11,5,0>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 2, m_band_queue, m_bands);
 				break;
 
 			case 0x7c00:
-				software_renderer<UINT16, 3,3,3, 10,5,0>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 2);
+				software_renderer<UINT16, 3,3,3, 10,5,0>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 2, m_band_queue, m_bands);
 				break;
 
 			default:
@@ -443,7 +453,7 @@ int renderer_sdl1::draw(int update)
 	{
 		assert (m_yuv_bitmap != nullptr);
 		assert (surfptr != nullptr);
-		software_renderer<UINT16, 3,3,3, 10,5,0>::draw_primitives(*win->m_primlist, m_yuv_bitmap, mamewidth, mameheight, mamewidth);
+		software_renderer<UINT16, 3,3,3, 10,5,0>::draw_primitives(*win->m_primlist, m_yuv_bitmap, mamewidth, mameheight, mamewidth, m_band_queue, m_bands);
 		sm->yuv_blit((UINT16 *)m_yuv_bitmap, surfptr, pitch, m_yuv_lookup, mamewidth, mameheight);
 	}
 
@@ -34,6 +34,8 @@ public:
 		, m_last_vofs(0)
 		, m_blit_dim(0, 0)
 		, m_last_dim(0, 0)
+		, m_band_queue(nullptr)
+		, m_bands(0)
 	{
 	}
 	virtual ~renderer_sdl1();
@@ -71,6 +73,10 @@ private:
 	int                 m_last_vofs;
 	osd_dim             m_blit_dim;
 	osd_dim             m_last_dim;
+
+	// parallel drawing
+	osd_work_queue *    m_band_queue;
+	int                 m_bands;
 };
 
 struct sdl_scale_mode
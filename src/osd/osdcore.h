@@ -774,6 +774,21 @@ void *osd_alloc_executable(size_t size);
 void osd_free_executable(void *ptr, size_t size);
 
 
+/*-----------------------------------------------------------------------------
+    osd_get_peak_memory: return the peak amount of physical memory used by
+        the process so far
+
+    Parameters:
+
+        None
+
+    Return value:
+
+        the peak resident set size in bytes, or 0 if it cannot be determined
+-----------------------------------------------------------------------------*/
+UINT64 osd_get_peak_memory(void);
+
+
 /*-----------------------------------------------------------------------------
     osd_break_into_debugger: break into the hosting system's debugger if one
         is attached
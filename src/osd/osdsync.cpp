@@ -49,6 +49,9 @@
 
 #define SPIN_LOOP_TIME          (osd_ticks_per_second() / 10000)
 
+#define WORK_DEQUE_SIZE         (1024)      // items each thread can hold; must be a power of 2
+#define CACHE_LINE_SIZE         (64)
+
 //============================================================
 //  MACROS
 //============================================================
@@ -98,6 +101,79 @@ int osd_get_num_processors(void)
 //  TYPE DEFINITIONS
 //============================================================
 
+// Chase-Lev work-stealing deque: the owning thread pushes and pops at
+// the bottom, any other thread may steal from the top
+struct work_deque
+{
+	work_deque()
+	: top(0)
+	, bottom(0)
+	{
+		for (auto &entry : slot)
+			entry.store(nullptr, std::memory_order_relaxed);
+	}
+
+	bool empty() const { return top.load(std::memory_order_acquire) >= bottom.load(std::memory_order_acquire); }
+
+	// owner only: add an item at the bottom; fails if the deque is full
+	bool push(osd_work_item *item)
+	{
+		INT64 b = bottom.load(std::memory_order_relaxed);
+		if (b - top.load(std::memory_order_acquire) >= WORK_DEQUE_SIZE)
+			return false;
+		slot[b & (WORK_DEQUE_SIZE - 1)].store(item, std::memory_order_release);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	// owner only: remove the most recently pushed item
+	osd_work_item *pop()
+	{
+		INT64 b = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		INT64 t = top.load(std::memory_order_relaxed);
+		if (t > b)
+		{
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		// if this is the last item, race any thieves for it
+		osd_work_item *item = slot[b & (WORK_DEQUE_SIZE - 1)].load(std::memory_order_relaxed);
+		if (t == b)
+		{
+			if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				item = nullptr;
+			bottom.store(b + 1, std::memory_order_relaxed);
+		}
+		return item;
+	}
+
+	// any thread: remove the oldest item; may return nullptr if another thread got there first
+	osd_work_item *steal()
+	{
+		INT64 t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		INT64 b = bottom.load(std::memory_order_acquire);
+		if (t >= b)
+			return nullptr;
+		osd_work_item *item = slot[t & (WORK_DEQUE_SIZE - 1)].load(std::memory_order_acquire);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr;
+		return item;
+	}
+
+	// keep the thieves' and the owner's ends on separate cache lines
+	std::atomic<INT64>  top;
+	UINT8               toppad[CACHE_LINE_SIZE - sizeof(std::atomic<INT64>)];
+	std::atomic<INT64>  bottom;
+	UINT8               bottompad[CACHE_LINE_SIZE - sizeof(std::atomic<INT64>)];
+	std::atomic<osd_work_item *> slot[WORK_DEQUE_SIZE];
+};
+
+
 struct work_thread_info
 {
 	work_thread_info(UINT32 aid, osd_work_queue &aqueue)
@@ -106,6 +182,7 @@ struct work_thread_info
 	, wakeevent(FALSE, FALSE)  // auto-reset, not signalled
 	, active(0)
 	, id(aid)
+	, spill(nullptr)
 #if KEEP_STATISTICS
 	, itemsdone(0)
 	, actruntime(0)
@@ -120,6 +197,8 @@ struct work_thread_info
 	osd_event           wakeevent;      // wake event for the thread
 	std::atomic<INT32>  active;         // are we actively processing work?
 	UINT32              id;
+	work_deque          deque;          // items this thread has claimed
+	std::atomic<osd_work_item *> spill; // claimed items that didn't fit in the deque, oldest first
 
 #if KEEP_STATISTICS
 	INT32               itemsdone;
@@ -135,7 +214,6 @@ struct osd_work_queue
 {
 	osd_work_queue()
 	: list(nullptr)
-	, tailptr(nullptr)
 	, free(nullptr)
 	, items(0)
 	, livethreads(0)
@@ -149,13 +227,14 @@ struct osd_work_queue
 	, setevents(0)
 	, extraitems(0)
 	, spinloops(0)
+	, steals(0)
 #endif
 	{
 	}
 
-	std::mutex          lock;           // lock for protecting the queue
-	std::atomic<osd_work_item *> list;  // list of items in the queue
-	osd_work_item ** volatile tailptr;  // pointer to the tail pointer of work items in the queue
+	std::mutex          lock;           // lock for protecting item events
+	std::recursive_mutex helplock;      // held by the thread using the helper slot
+	std::atomic<osd_work_item *> list;  // newly queued items not yet claimed by a thread, newest first
 	std::atomic<osd_work_item *> free;  // free list of work items
 	std::atomic<INT32>  items;          // items in the queue
 	std::atomic<INT32>  livethreads;    // number of live threads
@@ -171,6 +250,7 @@ struct osd_work_queue
 	std::atomic<INT32>  setevents;      // number of times we called SetEvent
 	std::atomic<INT32>  extraitems;     // how many extra items we got after the first in the queue loop
 	std::atomic<INT32>  spinloops;      // how many times spinning bought us more items
+	std::atomic<INT32>  steals;         // how many items were taken from another thread
 #endif
 };
 
@@ -213,6 +293,9 @@ static int effective_num_processors(void);
 static void * worker_thread_entry(void *param);
 static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread);
 static bool queue_has_list_items(osd_work_queue *queue);
+static void push_item_list(std::atomic<osd_work_item *> &list, osd_work_item *first, osd_work_item *last);
+static osd_work_item *claim_list_items(osd_work_queue *queue, work_thread_info *thread);
+static osd_work_item *steal_item(osd_work_queue *queue, work_thread_info *thread);
 
 //============================================================
 //  osd_thread_adjust_priority
@@ -259,7 +342,6 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 	queue = new osd_work_queue();
 
 	// initialize basic queue members
-	queue->tailptr = (osd_work_item **)&queue->list;
 	queue->flags = flags;
 
 	// determine how many threads to create...
@@ -276,11 +358,8 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 	// clamp to the maximum
 	queue->threads = std::min(threadnum, WORK_MAX_THREADS);
 
-	// allocate memory for thread array (+1 to count the calling thread if WORK_QUEUE_FLAG_MULTI)
-	if (flags & WORK_QUEUE_FLAG_MULTI)
-		allocthreadnum = queue->threads + 1;
-	else
-		allocthreadnum = queue->threads;
+	// allocate memory for thread array (+1 for a calling thread that helps out)
+	allocthreadnum = queue->threads + 1;
 
 #if KEEP_STATISTICS
 	printf("osdprocs: %d effecprocs: %d threads: %d allocthreads: %d osdthreads: %d maxthreads: %d queuethreads: %d\n", osd_num_processors, numprocs, threadnum, allocthreadnum, osdthreadnum, WORK_MAX_THREADS, queue->threads);
@@ -345,8 +424,9 @@ int osd_work_queue_wait(osd_work_queue *queue, osd_ticks_t timeout)
 	if (queue->items == 0)
 		return TRUE;
 
-	// if this is a multi queue, help out rather than doing nothing
-	if (queue->flags & WORK_QUEUE_FLAG_MULTI)
+	// if this is a multi queue, help out rather than doing nothing; only
+	// one calling thread at a time can own the helper slot's deque
+	if ((queue->flags & WORK_QUEUE_FLAG_MULTI) && queue->helplock.try_lock())
 	{
 		work_thread_info *thread = queue->thread[queue->threads];
 
@@ -354,6 +434,7 @@ int osd_work_queue_wait(osd_work_queue *queue, osd_ticks_t timeout)
 
 		// process what we can as a worker thread
 		worker_thread_process(queue, thread);
+		queue->helplock.unlock();
 
 		// if we're a high frequency queue, spin until done
 		if (queue->flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue->items != 0)
@@ -430,9 +511,19 @@ void osd_work_queue_free(osd_work_queue *queue)
 	}
 #endif
 
-	// free the list
+	// free the list, along with any items still waiting to go into a deque
 	for (auto & th : queue->thread)
+	{
+		while (th->spill.load() != nullptr)
+		{
+			osd_work_item *item = th->spill;
+			th->spill = item->next;
+			if (item->event != nullptr)
+				delete item->event;
+			delete item;
+		}
 		delete th;
+	}
 	queue->thread.clear();
 
 	// free all items in the free list
@@ -460,6 +551,7 @@ void osd_work_queue_free(osd_work_queue *queue)
 	printf("SetEvent calls = %9d\n", queue->setevents.load());
 	printf("Extra items    = %9d\n", queue->extraitems.load());
 	printf("Spin loops     = %9d\n", queue->spinloops.load());
+	printf("Steals         = %9d\n", queue->steals.load());
 #endif
 
 	// free the queue itself
@@ -473,23 +565,21 @@ void osd_work_queue_free(osd_work_queue *queue)
 
 osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_callback callback, INT32 numitems, void *parambase, INT32 paramstep, UINT32 flags)
 {
-	osd_work_item *itemlist = nullptr, *lastitem = nullptr;
-	osd_work_item **item_tailptr = &itemlist;
+	osd_work_item *itemlist = nullptr, *lastitem = nullptr, *firstitem = nullptr;
 	int itemnum;
 
-	// loop over items, building up a local list of work
+	// take the whole free list at once; unlike popping single items, this can't suffer from ABA
+	osd_work_item *freelist = queue->free.exchange(nullptr, std::memory_order_acquire);
+
+	// loop over items, building up a local list of work, newest first
 	for (itemnum = 0; itemnum < numitems; itemnum++)
 	{
 		osd_work_item *item;
 
 		// first allocate a new work item; try the free list first
-		{
-			std::lock_guard<std::mutex> lock(queue->lock);
-			do
-			{
-				item = (osd_work_item *)queue->free;
-			} while (item != nullptr && !queue->free.compare_exchange_weak(item, item->next, std::memory_order_release, std::memory_order_relaxed));
-		}
+		item = freelist;
+		if (item != nullptr)
+			freelist = item->next;
 
 		// if nothing, allocate something new
 		if (item == nullptr)
@@ -505,26 +595,33 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 		}
 
 		// fill in the basics
-		item->next = nullptr;
+		item->next = itemlist;
 		item->callback = callback;
 		item->param = parambase;
 		item->result = nullptr;
 		item->flags = flags;
 
 		// advance to the next
+		if (firstitem == nullptr)
+			firstitem = item;
 		lastitem = item;
-		*item_tailptr = item;
-		item_tailptr = &item->next;
+		itemlist = item;
 		parambase = (UINT8 *)parambase + paramstep;
 	}
 
-	// enqueue the whole thing within the critical section
+	// hand back any free items we didn't need
+	if (freelist != nullptr)
 	{
-		std::lock_guard<std::mutex> lock(queue->lock);
-		*queue->tailptr = itemlist;
-		queue->tailptr = item_tailptr;
+		osd_work_item *freetail = freelist;
+		while (freetail->next != nullptr)
+			freetail = freetail->next;
+		push_item_list(queue->free, freelist, freetail);
 	}
 
+	// publish the whole thing for the threads to claim
+	if (itemlist != nullptr)
+		push_item_list(queue->list, itemlist, firstitem);
+
 	// increment the number of items in the queue
 	queue->items += numitems;
 	add_to_stat(queue->itemsqueued, numitems);
@@ -555,6 +652,7 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 	// if no threads, run the queue now on this thread
 	if (queue->threads == 0)
 	{
+		std::lock_guard<std::recursive_mutex> lock(queue->helplock);
 		end_timing(queue->thread[0]->waittime);
 		worker_thread_process(queue, queue->thread[0]);
 		begin_timing(queue->thread[0]->waittime);
@@ -615,18 +713,11 @@ void *osd_work_item_result(osd_work_item *item)
 
 void osd_work_item_release(osd_work_item *item)
 {
-	osd_work_item *next;
-
 	// make sure we're done first
 	osd_work_item_wait(item, 100 * osd_ticks_per_second());
 
 	// add us to the free list on our queue
-	std::lock_guard<std::mutex> lock(item->queue.lock);
-	do
-	{
-		next = (osd_work_item *) item->queue.free;
-		item->next = next;
-	} while (!item->queue.free.compare_exchange_weak(next, item, std::memory_order_release, std::memory_order_relaxed));
+	push_item_list(item->queue.free, item, item);
 }
 
 
@@ -697,7 +788,7 @@ static void *worker_thread_entry(void *param)
 			worker_thread_process(&queue, thread);
 
 			// if we're a high frequency queue, spin for a while before giving up
-			if (queue.flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue.list.load() == nullptr)
+			if (queue.flags & WORK_QUEUE_FLAG_HIGH_FREQ && !queue_has_list_items(&queue))
 			{
 				// spin for a while looking for more work
 				begin_timing(thread->spintime);
@@ -733,32 +824,13 @@ static void worker_thread_process(osd_work_queue *queue, work_thread_info *threa
 	// loop until everything is processed
 	while (true)
 	{
-		osd_work_item *item = nullptr;
-
-		bool end_loop = false;
-
-		// use a critical section to synchronize the removal of items
-		{
-			std::lock_guard<std::mutex> lock(queue->lock);
-
-			if (queue->list.load() == nullptr)
-			{
-				end_loop = true;
-			}
-			else
-			{
-				// pull the item from the queue
-				item = (osd_work_item *)queue->list;
-				if (item != nullptr)
-				{
-					queue->list = item->next;
-					if (queue->list.load() == nullptr)
-						queue->tailptr = (osd_work_item **)&queue->list;
-				}
-			}
-		}
-
-		if (end_loop)
+		// prefer our own items, then newly queued ones, then other threads' items
+		osd_work_item *item = thread->deque.pop();
+		if (item == nullptr)
+			item = claim_list_items(queue, thread);
+		if (item == nullptr)
+			item = steal_item(queue, thread);
+		if (item == nullptr)
 			break;
 
 		// process non-NULL items
@@ -790,9 +862,11 @@ static void worker_thread_process(osd_work_queue *queue, work_thread_info *threa
 				}
 			}
 
+#if KEEP_STATISTICS
 			// if we removed an item and there's still work to do, bump the stats
 			if (queue_has_list_items(queue))
 				add_to_stat(queue->extraitems, 1);
+#endif
 		}
 	}
 
@@ -806,9 +880,105 @@ static void worker_thread_process(osd_work_queue *queue, work_thread_info *threa
 	end_timing(thread->runtime);
 }
 
+
+
+//============================================================
+//  queue_has_list_items
+//============================================================
+
 bool queue_has_list_items(osd_work_queue *queue)
 {
-	std::lock_guard<std::mutex> lock(queue->lock);
-	bool has_list_items = (queue->list.load() != nullptr);
-	return has_list_items;
+	if (queue->list.load() != nullptr)
+		return true;
+	for (work_thread_info *thread : queue->thread)
+		if (!thread->deque.empty() || thread->spill.load() != nullptr)
+			return true;
+	return false;
+}
+
+
+//============================================================
+//  push_item_list - atomically prepend a chain of
+//  items; pushing can't suffer from ABA
+//============================================================
+
+static void push_item_list(std::atomic<osd_work_item *> &list, osd_work_item *first, osd_work_item *last)
+{
+	osd_work_item *head = list.load(std::memory_order_relaxed);
+	do
+	{
+		last->next = head;
+	} while (!list.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+}
+
+
+//============================================================
+//  claim_list_items - move the oldest claimed or
+//  newly queued items into the thread's deque,
+//  returning the oldest; only called once the
+//  thread's deque is empty
+//============================================================
+
+static osd_work_item *claim_list_items(osd_work_queue *queue, work_thread_info *thread)
+{
+	// anything left over from an earlier claim is older than what's on the list
+	osd_work_item *item = thread->spill.load(std::memory_order_relaxed);
+	if (item == nullptr)
+	{
+		// the list is newest first, so reverse it
+		osd_work_item *list = queue->list.exchange(nullptr, std::memory_order_acquire);
+		while (list != nullptr)
+		{
+			osd_work_item *next = list->next;
+			list->next = item;
+			item = list;
+			list = next;
+		}
+		if (item == nullptr)
+			return nullptr;
+	}
+
+	// take as many of the oldest items as fit, keeping the rest for next time
+	osd_work_item *batch[WORK_DEQUE_SIZE + 1];
+	int count = 0;
+	while (item != nullptr && count < WORK_DEQUE_SIZE + 1)
+	{
+		batch[count++] = item;
+		item = item->next;
+	}
+	thread->spill.store(item, std::memory_order_relaxed);
+
+	// push newest first, which leaves the oldest items at the bottom for us and
+	// the newest at the top for thieves; the oldest of all we run right away, so
+	// the rest always fit in our empty deque
+	for (int index = count - 1; index > 0; index--)
+		thread->deque.push(batch[index]);
+	return batch[0];
+}
+
+
+//============================================================
+//  steal_item - take the oldest item from another
+//  thread's deque
+//============================================================
+
+static osd_work_item *steal_item(osd_work_queue *queue, work_thread_info *thread)
+{
+	int count = queue->thread.size();
+
+	// start with our neighbour so that thieves spread out over the victims
+	for (int offset = 1; offset < count; offset++)
+	{
+		work_deque &victim = queue->thread[(thread->id + offset) % count]->deque;
+		while (!victim.empty())
+		{
+			osd_work_item *item = victim.steal();
+			if (item != nullptr)
+			{
+				add_to_stat(queue->steals, 1);
+				return item;
+			}
+		}
+	}
+	return nullptr;
 }
@@ -29,6 +29,7 @@
 #include <limits>
 #include <memory>
 #include <new>
+#include <thread>
 #include <unordered_map>
 
 
@@ -575,7 +576,7 @@ static const option_description s_options[] =
 	{ OPTION_INDEX,                 "ix",   true, " <index>: indexed instance of this metadata tag" },
 	{ OPTION_VALUE_TEXT,            "vt",   true, " <text>: text for the metadata" },
 	{ OPTION_VALUE_FILE,            "vf",   true, " <file>: file containing data to add" },
-	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression" },
+	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression or decompression" },
 	{ OPTION_NO_CHECKSUM,           "nocs", false, ": do not include this metadata information in the overall SHA-1" },
 	{ OPTION_FIX,                   "f",    false, ": fix the SHA-1 if it is incorrect" },
 	{ OPTION_VERBOSE,               "v",    false, ": output additional information" },
@@ -596,7 +597,8 @@ static const command_description s_commands[] =
 	{ COMMAND_VERIFY, do_verify, ": verifies a CHD's integrity",
 		{
 			REQUIRED OPTION_INPUT,
-			OPTION_INPUT_PARENT
+			OPTION_INPUT_PARENT,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -672,7 +674,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -685,7 +688,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -696,6 +700,7 @@ static const command_description s_commands[] =
 			OPTION_OUTPUT_FORCE,
 			REQUIRED OPTION_INPUT,
 			OPTION_INPUT_PARENT,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -706,7 +711,8 @@ static const command_description s_commands[] =
 			REQUIRED OPTION_INPUT,
 			OPTION_INPUT_PARENT,
 			OPTION_INPUT_START_FRAME,
-			OPTION_INPUT_LENGTH_FRAMES
+			OPTION_INPUT_LENGTH_FRAMES,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -1156,6 +1162,28 @@ static void parse_numprocessors(const parameters_t &params)
 }
 
 
+//-------------------------------------------------
+//  enable_parallel_decompression - have a CHD
+//  decompress the hunks ahead of sequential
+//  reads on all available processors
+//-------------------------------------------------
+
+static void enable_parallel_decompression(chd_file &chd)
+{
+	// with a single processor, decompressing in the background just competes with the reader
+	extern int osd_num_processors;
+	int processors = (osd_num_processors > 0) ? osd_num_processors : std::thread::hardware_concurrency();
+	if (!chd.compressed() || processors < 2)
+		return;
+
+	// decompress about 16MB at a time, and leave room in the cache for the
+	// batch being consumed as well as the one being decompressed
+	UINT32 hunks = (std::max)(UINT32(16 * 1024 * 1024) / chd.hunk_bytes(), 4U);
+	chd.set_hunk_cache_size(hunks * 3);
+	chd.set_readahead(hunks, true);
+}
+
+
 //-------------------------------------------------
 //  compression_string - create a friendly string
 //  describing a set of compressors
@@ -1534,6 +1562,10 @@ static void do_verify(parameters_t &params)
 	if (raw_sha1 == util::sha1_t::null)
 		report_error(0, "No verification to be done; CHD has no checksum");
 
+	// decompress in parallel with the hashing
+	parse_numprocessors(params);
+	enable_parallel_decompression(input_chd);
+
 	// create an array to read into
 	dynamic_buffer buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
 
@@ -2253,6 +2285,10 @@ static void do_extract_raw(parameters_t &params)
 	UINT64 input_end;
 	parse_input_start_end(params, input_chd.logical_bytes(), input_chd.hunk_bytes(), input_chd.hunk_bytes(), input_start, input_end);
 
+	// decompress in parallel with the writing
+	parse_numprocessors(params);
+	enable_parallel_decompression(input_chd);
+
 	// verify output file doesn't exist
 	auto output_file_str = params.find(OPTION_OUTPUT);
 	if (output_file_str != params.end())
@@ -2333,6 +2369,10 @@ static void do_extract_cd(parameters_t &params)
 		report_error(1, "Unable to recognize CHD file as a CD");
 	const cdrom_toc *toc = cdrom_get_toc(cdrom);
 
+	// decompress in parallel with the writing
+	parse_numprocessors(params);
+	enable_parallel_decompression(input_chd);
+
 	// verify output file doesn't exist
 	auto output_file_str = params.find(OPTION_OUTPUT);
 	if (output_file_str != params.end())
@@ -2562,6 +2602,10 @@ static void do_extract_ld(parameters_t &params)
 	input_start *= interlace_factor;
 	input_end *= interlace_factor;
 
+	// decompress in parallel with the writing
+	parse_numprocessors(params);
+	enable_parallel_decompression(input_chd);
+
 	// build up the movie info
 	avi_file::movie_info info;
 	info.video_format = FORMAT_YUY2;
@@ -2601,17 +2645,11 @@ static void do_extract_ld(parameters_t &params)
 		if (avierr != avi_file::error::NONE)
 			report_error(1, "Unable to open file (%s)", output_file_str->second->c_str());
 
-		// create the codec configuration
-		avhuff_decompress_config avconfig;
+		// allocate buffers for the raw A/V data and the unpacked audio
+		dynamic_buffer rawdata(input_chd.hunk_bytes());
 		std::vector<INT16> audio_data[16];
-		UINT32 actsamples;
-		avconfig.maxsamples = max_samples_per_frame;
-		avconfig.actsamples = &actsamples;
 		for (int chnum = 0; chnum < ARRAY_LENGTH(audio_data); chnum++)
-		{
 			audio_data[chnum].resize(std::max(1U,max_samples_per_frame));
-			avconfig.audio[chnum] = &audio_data[chnum][0];
-		}
 
 		// iterate over frames
 		bitmap_yuy16 fullbitmap(width, height * interlace_factor);
@@ -2619,22 +2657,40 @@ static void do_extract_ld(parameters_t &params)
 		{
 			progress(framenum == input_start, "Extracting, %.1f%% complete...  \r", 100.0 * double(framenum - input_start) / double(input_end - input_start));
 
-			// set up the fake bitmap for this frame
-			avconfig.video.wrap(&fullbitmap.pix(framenum % interlace_factor), fullbitmap.width(), fullbitmap.height() / interlace_factor, fullbitmap.rowpixels() * interlace_factor);
-			input_chd.codec_configure(CHD_CODEC_AVHUFF, AVHUFF_CODEC_DECOMPRESS_CONFIG, &avconfig);
-
-			// read the hunk into the buffers
-			chd_error err = input_chd.read_hunk(framenum, nullptr);
+			// read the hunk as raw A/V data, which lets it be decompressed ahead of time
+			chd_error err = input_chd.read_hunk(framenum, &rawdata[0]);
 			if (err != CHDERR_NONE)
 			{
 				UINT64 filepos = static_cast<util::core_file &>(input_chd).tell();
 				report_error(1, "Error reading hunk %d at offset %d from CHD file (%s): %s\n", framenum, filepos, params.find(OPTION_INPUT)->second->c_str(), chd_file::error_string(err));
 			}
 
+			// validate the header
+			const UINT8 *source = &rawdata[0];
+			int rawchannels = source[5];
+			UINT32 actsamples = (source[6] << 8) | source[7];
+			UINT32 rawwidth = (source[8] << 8) | source[9];
+			UINT32 rawheight = (source[10] << 8) | source[11];
+			if (source[0] != 'c' || source[1] != 'h' || source[2] != 'a' || source[3] != 'v' || avhuff_encoder::raw_data_size(source) > rawdata.size() ||
+				rawchannels > ARRAY_LENGTH(audio_data) || actsamples > max_samples_per_frame || rawwidth > fullbitmap.width() || rawheight * interlace_factor > fullbitmap.height())
+				report_error(1, "Invalid A/V data in hunk %d of CHD file (%s)\n", framenum, params.find(OPTION_INPUT)->second->c_str());
+			source += 12 + source[4];
+
+			// unpack the big-endian audio, followed by the big-endian video into every other line for interlaced sources
+			for (int chnum = 0; chnum < rawchannels; chnum++)
+				for (UINT32 sampnum = 0; sampnum < actsamples; sampnum++, source += 2)
+					audio_data[chnum][sampnum] = (source[0] << 8) | source[1];
+			for (UINT32 y = 0; y < rawheight; y++)
+			{
+				UINT16 *dest = &fullbitmap.pix(y * interlace_factor + framenum % interlace_factor);
+				for (UINT32 x = 0; x < rawwidth; x++, source += 2)
+					dest[x] = (source[0] << 8) | source[1];
+			}
+
 			// write audio
 			for (int chnum = 0; chnum < channels; chnum++)
 			{
-				avi_file::error avierr = output_file->append_sound_samples(chnum, avconfig.audio[chnum], actsamples, 0);
+				avi_file::error avierr = output_file->append_sound_samples(chnum, &audio_data[chnum][0], actsamples, 0);
 				if (avierr != avi_file::error::NONE)
 					report_error(1, "Error writing samples for hunk %d to file (%s): %s\n", framenum, output_file_str->second->c_str(), avi_file::error_string(avierr));
 			}
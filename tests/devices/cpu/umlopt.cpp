@@ -0,0 +1,276 @@
+#include "gtest/gtest.h"
+#include "emu.h"
+#include "cpu/drcuml.h"
+#include <algorithm>
+
+using namespace uml;
+
+// the optimizer never disassembles, so these tests don't need a real drcuml_state
+const char *drcuml_state::symbol_find(void *base, UINT32 *offset) { return nullptr; }
+
+// each test builds a block, optimizes a copy, and runs both through a small
+// evaluator covering the opcodes used here, checking that the registers and
+// memory come out the same and that the expected rewrites happened
+namespace {
+
+// memory the blocks address directly
+UINT32 test_memory[16];
+
+struct uml_test_block
+{
+	uml_test_block() : inst(64), count(0) { }
+
+	instruction &append() { return inst[count++]; }
+
+	int count_opcode(opcode_t opcode) const
+	{
+		int result = 0;
+		for (UINT32 instnum = 0; instnum < count; instnum++)
+			if (inst[instnum].opcode() == opcode)
+				result++;
+		return result;
+	}
+
+	std::vector<instruction> inst;
+	UINT32 count;
+};
+
+class uml_test_evaluator
+{
+public:
+	uml_test_evaluator()
+	{
+		for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+			r[regnum] = 0x01234567 * (regnum + 1);
+		for (int memnum = 0; memnum < ARRAY_LENGTH(test_memory); memnum++)
+			test_memory[memnum] = 0x89abcdef ^ (memnum * 0x10001);
+	}
+
+	void execute(const uml_test_block &block)
+	{
+		for (UINT32 instnum = 0; instnum < block.count; instnum++)
+		{
+			const instruction &inst = block.inst[instnum];
+			ASSERT_EQ(COND_ALWAYS, inst.condition());
+			switch (inst.opcode())
+			{
+				case OP_NOP:
+				case OP_COMMENT:
+					break;
+
+				case OP_MOV:    write(inst, 0, read(inst, 1)); break;
+				case OP_ADD:    write(inst, 0, read(inst, 1) + read(inst, 2)); break;
+				case OP_SUB:    write(inst, 0, read(inst, 1) - read(inst, 2)); break;
+				case OP_AND:    write(inst, 0, read(inst, 1) & read(inst, 2)); break;
+				case OP_OR:     write(inst, 0, read(inst, 1) | read(inst, 2)); break;
+				case OP_XOR:    write(inst, 0, read(inst, 1) ^ read(inst, 2)); break;
+
+				case OP_LOAD:
+				case OP_LOADS:
+				{
+					const UINT8 *src = address(inst, 1);
+					bool sign = (inst.opcode() == OP_LOADS);
+					switch (inst.param(3).size())
+					{
+						case SIZE_BYTE:     write(inst, 0, sign ? UINT64(INT8(*src)) : *src); break;
+						case SIZE_WORD:     write(inst, 0, sign ? UINT64(INT16(*reinterpret_cast<const UINT16 *>(src))) : *reinterpret_cast<const UINT16 *>(src)); break;
+						case SIZE_DWORD:    write(inst, 0, sign ? UINT64(INT32(*reinterpret_cast<const UINT32 *>(src))) : *reinterpret_cast<const UINT32 *>(src)); break;
+						default:            write(inst, 0, *reinterpret_cast<const UINT64 *>(src)); break;
+					}
+					break;
+				}
+
+				case OP_STORE:
+				{
+					UINT8 *dst = address(inst, 0);
+					UINT64 value = read(inst, 2);
+					switch (inst.param(3).size())
+					{
+						case SIZE_BYTE:     *dst = value; break;
+						case SIZE_WORD:     *reinterpret_cast<UINT16 *>(dst) = value; break;
+						case SIZE_DWORD:    *reinterpret_cast<UINT32 *>(dst) = value; break;
+						default:            *reinterpret_cast<UINT64 *>(dst) = value; break;
+					}
+					break;
+				}
+
+				default:
+					FAIL() << "unexpected opcode " << int(inst.opcode());
+			}
+		}
+	}
+
+	UINT64 r[REG_I_COUNT];
+
+private:
+	// the value of a parameter that is read
+	UINT64 read(const instruction &inst, int pnum)
+	{
+		const parameter &param = inst.param(pnum);
+		if (param.is_immediate())
+			return (inst.size() == 4) ? UINT32(param.immediate()) : param.immediate();
+		if (param.is_int_register())
+			return (inst.size() == 4) ? UINT32(r[param.ireg() - REG_I0]) : r[param.ireg() - REG_I0];
+		if (inst.size() == 8)
+			return *reinterpret_cast<const UINT64 *>(param.memory());
+		return *reinterpret_cast<const UINT32 *>(param.memory());
+	}
+
+	// write the result of an operation, zero-extending 32-bit results
+	void write(const instruction &inst, int pnum, UINT64 value)
+	{
+		const parameter &param = inst.param(pnum);
+		if (param.is_int_register())
+			r[param.ireg() - REG_I0] = (inst.size() == 4) ? UINT32(value) : value;
+		else if (inst.size() == 8)
+			*reinterpret_cast<UINT64 *>(param.memory()) = value;
+		else
+			*reinterpret_cast<UINT32 *>(param.memory()) = value;
+	}
+
+	// the address touched by a LOAD, LOADS or STORE
+	UINT8 *address(const instruction &inst, int basenum)
+	{
+		const parameter &sizescale = inst.param(3);
+		int scale = (sizescale.scale() == SCALE_DEFAULT) ? int(sizescale.size()) : int(sizescale.scale());
+		return reinterpret_cast<UINT8 *>(inst.param(basenum).memory()) + (read(inst, basenum + 1) << scale);
+	}
+};
+
+// optimize a copy of the block and check that it computes the same thing;
+// the cache registers are scratch, so they aren't compared
+drcuml_opt_stats optimize_and_compare(const uml_test_block &block, uml_test_block &optimized, UINT32 cacheregs = 0, int direct_iregs = 0)
+{
+	optimized = block;
+	drcuml_optimizer optimizer(optimized.inst, optimized.count, DRCUML_OPT_DEFAULT, cacheregs, direct_iregs);
+	optimizer.optimize();
+
+	uml_test_evaluator expected;
+	expected.execute(block);
+	std::vector<UINT32> expectedmem(std::begin(test_memory), std::end(test_memory));
+
+	uml_test_evaluator result;
+	result.execute(optimized);
+	std::vector<UINT32> resultmem(std::begin(test_memory), std::end(test_memory));
+
+	for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+		if ((cacheregs & (1 << regnum)) == 0)
+		{
+			EXPECT_EQ(expected.r[regnum], result.r[regnum]) << "register i" << regnum;
+		}
+	EXPECT_EQ(expectedmem, resultmem);
+	return optimizer.stats();
+}
+
+}
+
+TEST(drcumlopt,constprop)
+{
+	uml_test_block block;
+	block.append().mov(I0, 5);
+	block.append().add(I1, I0, I2);
+	block.append().sub(I3, I1, I0);
+	block.append().mov(I0, I3);
+	block.append().add(I4, I0, I0);
+
+	uml_test_block optimized;
+	drcuml_opt_stats stats = optimize_and_compare(block, optimized);
+	EXPECT_EQ(2U, stats.constants);
+}
+
+TEST(drcumlopt,loadstore)
+{
+	uml_test_block block;
+	block.append().store(&test_memory[0], 0, I0, SIZE_DWORD, SCALE_x4);     // dead: overwritten below before being read
+	block.append().add(I1, I0, 1);
+	block.append().store(&test_memory[0], 0, I1, SIZE_DWORD, SCALE_x4);
+	block.append().load(I2, &test_memory[0], 0, SIZE_DWORD, SCALE_x4);      // becomes a move from i1
+	block.append().store(&test_memory[0], 0, I2, SIZE_DWORD, SCALE_x4);
+	block.append().load(I3, &test_memory[1], 0, SIZE_DWORD, SCALE_x4);
+	block.append().store(&test_memory[1], 0, I3, SIZE_DWORD, SCALE_x4);     // redundant: stores back what was loaded
+	block.append().load(I4, &test_memory[2], 0, SIZE_WORD, SCALE_x2);       // narrower, so it can't reuse anything
+	block.append().load(I5, &test_memory[2], 0, SIZE_WORD, SCALE_x2);       // becomes a move from i4
+
+	uml_test_block optimized;
+	drcuml_opt_stats stats = optimize_and_compare(block, optimized);
+	EXPECT_EQ(2U, stats.loads);
+	EXPECT_EQ(2U, stats.stores);
+	EXPECT_EQ(2, optimized.count_opcode(OP_LOAD));
+	EXPECT_EQ(2, optimized.count_opcode(OP_STORE));
+}
+
+TEST(drcumlopt,loadstore_aliasing)
+{
+	// a store through a register index may touch anything, so nothing is reused across it
+	uml_test_block block;
+	block.append().load(I0, &test_memory[3], 0, SIZE_DWORD, SCALE_x4);
+	block.append().mov(I6, 3);
+	block.append()._and(I6, I6, I7);
+	block.append().store(&test_memory[0], I6, I1, SIZE_DWORD, SCALE_x4);
+	block.append().load(I2, &test_memory[3], 0, SIZE_DWORD, SCALE_x4);
+
+	uml_test_block optimized;
+	drcuml_opt_stats stats = optimize_and_compare(block, optimized);
+	EXPECT_EQ(0U, stats.loads);
+	EXPECT_EQ(2, optimized.count_opcode(OP_LOAD));
+}
+
+TEST(drcumlopt,regcache)
+{
+	// the destination is reused between loads, so only a spare register can keep the value
+	uml_test_block block;
+	for (int pass = 0; pass < 3; pass++)
+	{
+		block.append().load(I0, &test_memory[4], 0, SIZE_DWORD, SCALE_x4);
+		block.append().add(I0, I0, I1);
+		block.append().store(&test_memory[5 + pass], 0, I0, SIZE_DWORD, SCALE_x4);
+	}
+
+	// nothing is cached unless the register is offered and mapped directly
+	uml_test_block optimized;
+	drcuml_opt_stats stats = optimize_and_compare(block, optimized);
+	EXPECT_EQ(0U, stats.cached);
+	stats = optimize_and_compare(block, optimized, 1 << 4, 4);
+	EXPECT_EQ(0U, stats.cached);
+	EXPECT_EQ(3, optimized.count_opcode(OP_LOAD));
+
+	stats = optimize_and_compare(block, optimized, 1 << 4, 5);
+	EXPECT_EQ(1U, stats.cached);
+	EXPECT_EQ(2U, stats.loads);
+	EXPECT_EQ(1, optimized.count_opcode(OP_LOAD));
+}
+
+TEST(drcumlopt,regcache_barriers)
+{
+	// a store that may change the value ends the region, leaving too few reloads to be worth caching
+	uml_test_block block;
+	block.append()._and(I6, I7, 7);
+	for (int pass = 0; pass < 3; pass++)
+	{
+		block.append().load(I0, &test_memory[4], 0, SIZE_DWORD, SCALE_x4);
+		block.append().add(I0, I0, I1);
+		if (pass == 0)
+			block.append().store(&test_memory[0], I6, I0, SIZE_DWORD, SCALE_x4);
+		else
+			block.append().store(&test_memory[8 + pass], 0, I0, SIZE_DWORD, SCALE_x4);
+	}
+
+	uml_test_block optimized;
+	drcuml_opt_stats stats = optimize_and_compare(block, optimized, 1 << 4, 5);
+	EXPECT_EQ(0U, stats.cached);
+	EXPECT_EQ(3, optimized.count_opcode(OP_LOAD));
+
+	// a block that uses the register itself leaves it alone
+	uml_test_block usesreg;
+	for (int pass = 0; pass < 3; pass++)
+	{
+		usesreg.append().load(I0, &test_memory[4], 0, SIZE_DWORD, SCALE_x4);
+		usesreg.append().add(I0, I0, I1);
+		usesreg.append().store(&test_memory[5 + pass], 0, I0, SIZE_DWORD, SCALE_x4);
+	}
+	usesreg.append().mov(I4, I0);
+
+	stats = optimize_and_compare(usesreg, optimized, 1 << 4, 5);
+	EXPECT_EQ(0U, stats.cached);
+	EXPECT_EQ(3, optimized.count_opcode(OP_LOAD));
+}
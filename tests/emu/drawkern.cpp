@@ -0,0 +1,198 @@
+#include "gtest/gtest.h"
+#include "osdcomm.h"
+#include "drawkern.h"
+#include <vector>
+
+// each test draws random rows with the optimized kernel and the generic
+// kernel into identical copies of a random destination and priority
+// bitmap, and checks that they come out identical
+namespace {
+
+class drawkern_random
+{
+public:
+	drawkern_random() : m_seed(0x332533) { }
+
+	UINT32 next()
+	{
+		m_seed = m_seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		return m_seed >> 32;
+	}
+
+	// pens and masks biased towards runs, which the kernels special case
+	template<typename _Type> std::vector<_Type> fill(int count, UINT32 range)
+	{
+		std::vector<_Type> result(count);
+		for (int i = 0; i < count; i++)
+			result[i] = (i != 0 && (next() & 3) != 0) ? result[i - 1] : _Type(next() % range);
+		return result;
+	}
+
+private:
+	UINT64 m_seed;
+};
+
+const int MAX_COUNT = 80;
+const int TRIALS = 2000;
+
+// priority codes including the "leave priority alone" case
+UINT32 random_pcode(drawkern_random &rand, bool palette)
+{
+	UINT32 pcode = (rand.next() & 1) ? 0xff00 : (rand.next() & 0xffff);
+	if (palette && (rand.next() & 1))
+		pcode |= (rand.next() & 0xff) << 16;
+	return pcode;
+}
+
+std::vector<rgb_t> random_pens(drawkern_random &rand)
+{
+	std::vector<rgb_t> pens(0x10000 + 0x100);
+	for (auto &pen : pens)
+		pen = rgb_t(rand.next());
+	return pens;
+}
+
+}
+
+TEST(drawkern,scanline_null)
+{
+	drawkern_random rand;
+	for (int trial = 0; trial < TRIALS; trial++)
+	{
+		int count = rand.next() % MAX_COUNT;
+		int mask = rand.next() & 0xff, value = rand.next() & mask;
+		UINT32 pcode = random_pcode(rand, false);
+		std::vector<UINT8> maskbytes = rand.fill<UINT8>(count, 0x100);
+		std::vector<UINT8> pri = rand.fill<UINT8>(count, 0x100), expected = pri;
+
+		drawkern_scanline_opaque_null(count, pri.data(), pcode);
+		drawkern_scanline_opaque_null_generic(count, expected.data(), pcode);
+		ASSERT_EQ(expected, pri);
+
+		drawkern_scanline_masked_null(maskbytes.data(), mask, value, count, pri.data(), pcode);
+		drawkern_scanline_masked_null_generic(maskbytes.data(), mask, value, count, expected.data(), pcode);
+		ASSERT_EQ(expected, pri);
+	}
+}
+
+TEST(drawkern,scanline_ind16)
+{
+	drawkern_random rand;
+	for (int trial = 0; trial < TRIALS; trial++)
+	{
+		int count = rand.next() % MAX_COUNT;
+		int mask = rand.next() & 0xff, value = rand.next() & mask;
+		UINT32 pcode = random_pcode(rand, true);
+		std::vector<UINT16> source = rand.fill<UINT16>(count, 0x10000);
+		std::vector<UINT8> maskbytes = rand.fill<UINT8>(count, 0x100);
+		std::vector<UINT16> dest = rand.fill<UINT16>(count, 0x10000), expecteddest = dest;
+		std::vector<UINT8> pri = rand.fill<UINT8>(count, 0x100), expectedpri = pri;
+
+		drawkern_scanline_opaque_ind16(dest.data(), source.data(), count, pri.data(), pcode);
+		drawkern_scanline_opaque_ind16_generic(expecteddest.data(), source.data(), count, expectedpri.data(), pcode);
+		ASSERT_EQ(expecteddest, dest);
+		ASSERT_EQ(expectedpri, pri);
+
+		drawkern_scanline_masked_ind16(dest.data(), source.data(), maskbytes.data(), mask, value, count, pri.data(), pcode);
+		drawkern_scanline_masked_ind16_generic(expecteddest.data(), source.data(), maskbytes.data(), mask, value, count, expectedpri.data(), pcode);
+		ASSERT_EQ(expecteddest, dest);
+		ASSERT_EQ(expectedpri, pri);
+	}
+}
+
+TEST(drawkern,scanline_rgb32)
+{
+	drawkern_random rand;
+	std::vector<rgb_t> pens = random_pens(rand);
+	for (int trial = 0; trial < TRIALS; trial++)
+	{
+		int count = rand.next() % MAX_COUNT;
+		int mask = rand.next() & 0xff, value = rand.next() & mask;
+		UINT32 pcode = random_pcode(rand, true);
+		UINT8 alpha = rand.next();
+		std::vector<UINT16> source = rand.fill<UINT16>(count, 0x10000);
+		std::vector<UINT8> maskbytes = rand.fill<UINT8>(count, 0x100);
+		std::vector<UINT32> dest = rand.fill<UINT32>(count, 0xffffffff), expecteddest = dest;
+		std::vector<UINT8> pri = rand.fill<UINT8>(count, 0x100), expectedpri = pri;
+
+		drawkern_scanline_opaque_rgb32(dest.data(), source.data(), count, pens.data(), pri.data(), pcode);
+		drawkern_scanline_opaque_rgb32_generic(expecteddest.data(), source.data(), count, pens.data(), expectedpri.data(), pcode);
+		ASSERT_EQ(expecteddest, dest);
+		ASSERT_EQ(expectedpri, pri);
+
+		drawkern_scanline_masked_rgb32(dest.data(), source.data(), maskbytes.data(), mask, value, count, pens.data(), pri.data(), pcode);
+		drawkern_scanline_masked_rgb32_generic(expecteddest.data(), source.data(), maskbytes.data(), mask, value, count, pens.data(), expectedpri.data(), pcode);
+		ASSERT_EQ(expecteddest, dest);
+		ASSERT_EQ(expectedpri, pri);
+
+		drawkern_scanline_opaque_rgb32_alpha(dest.data(), source.data(), count, pens.data(), pri.data(), pcode, alpha);
+		drawkern_scanline_opaque_rgb32_alpha_generic(expecteddest.data(), source.data(), count, pens.data(), expectedpri.data(), pcode, alpha);
+		ASSERT_EQ(expecteddest, dest);
+		ASSERT_EQ(expectedpri, pri);
+
+		drawkern_scanline_masked_rgb32_alpha(dest.data(), source.data(), maskbytes.data(), mask, value, count, pens.data(), pri.data(), pcode, alpha);
+		drawkern_scanline_masked_rgb32_alpha_generic(expecteddest.data(), source.data(), maskbytes.data(), mask, value, count, pens.data(), expectedpri.data(), pcode, alpha);
+		ASSERT_EQ(expecteddest, dest);
+		ASSERT_EQ(expectedpri, pri);
+	}
+}
+
+TEST(drawkern,gfx_ind16)
+{
+	drawkern_random rand;
+	for (int trial = 0; trial < TRIALS; trial++)
+	{
+		int count = rand.next() % MAX_COUNT;
+		UINT32 color = rand.next() & 0xffff;
+		UINT32 pmask = rand.next() | (1U << 31);
+		UINT32 trans_pen = (rand.next() & 7) ? (rand.next() & 0x0f) : 0x100;
+		std::vector<UINT8> source = rand.fill<UINT8>(count, 0x10);
+		std::vector<UINT16> dest = rand.fill<UINT16>(count, 0x10000), expecteddest = dest;
+		std::vector<UINT8> pri = rand.fill<UINT8>(count, 0x40), expectedpri = pri;
+
+		drawkern_gfx_transpen_ind16(dest.data(), source.data(), count, color, trans_pen);
+		drawkern_gfx_transpen_ind16_generic(expecteddest.data(), source.data(), count, color, trans_pen);
+		ASSERT_EQ(expecteddest, dest);
+
+		drawkern_gfx_prio_transpen_ind16(dest.data(), pri.data(), source.data(), count, color, pmask, trans_pen);
+		drawkern_gfx_prio_transpen_ind16_generic(expecteddest.data(), expectedpri.data(), source.data(), count, color, pmask, trans_pen);
+		ASSERT_EQ(expecteddest, dest);
+		ASSERT_EQ(expectedpri, pri);
+	}
+}
+
+TEST(drawkern,gfx_rgb32)
+{
+	drawkern_random rand;
+	std::vector<UINT32> paldata(0x100);
+	for (auto &pen : paldata)
+		pen = rand.next();
+	for (int trial = 0; trial < TRIALS; trial++)
+	{
+		int count = rand.next() % MAX_COUNT;
+		UINT32 pmask = rand.next() | (1U << 31);
+		UINT32 trans_pen = (rand.next() & 7) ? (rand.next() & 0x0f) : 0x100;
+		UINT8 alpha = rand.next();
+		std::vector<UINT8> source = rand.fill<UINT8>(count, 0x10);
+		std::vector<UINT32> dest = rand.fill<UINT32>(count, 0xffffffff), expecteddest = dest;
+		std::vector<UINT8> pri = rand.fill<UINT8>(count, 0x40), expectedpri = pri;
+
+		drawkern_gfx_transpen_rgb32(dest.data(), source.data(), count, paldata.data(), trans_pen);
+		drawkern_gfx_transpen_rgb32_generic(expecteddest.data(), source.data(), count, paldata.data(), trans_pen);
+		ASSERT_EQ(expecteddest, dest);
+
+		drawkern_gfx_alpha_rgb32(dest.data(), source.data(), count, paldata.data(), trans_pen, alpha);
+		drawkern_gfx_alpha_rgb32_generic(expecteddest.data(), source.data(), count, paldata.data(), trans_pen, alpha);
+		ASSERT_EQ(expecteddest, dest);
+
+		drawkern_gfx_prio_transpen_rgb32(dest.data(), pri.data(), source.data(), count, paldata.data(), pmask, trans_pen);
+		drawkern_gfx_prio_transpen_rgb32_generic(expecteddest.data(), expectedpri.data(), source.data(), count, paldata.data(), pmask, trans_pen);
+		ASSERT_EQ(expecteddest, dest);
+		ASSERT_EQ(expectedpri, pri);
+
+		drawkern_gfx_prio_alpha_rgb32(dest.data(), pri.data(), source.data(), count, paldata.data(), pmask, trans_pen, alpha);
+		drawkern_gfx_prio_alpha_rgb32_generic(expecteddest.data(), expectedpri.data(), source.data(), count, paldata.data(), pmask, trans_pen, alpha);
+		ASSERT_EQ(expecteddest, dest);
+		ASSERT_EQ(expectedpri, pri);
+	}
+}